@@ -0,0 +1,10 @@
+# The mesh keyword of compute saed and xrd requires KSPACE to be installed
+set(USER-DIFFRACTION_SOURCES_DIR ${LAMMPS_SOURCE_DIR}/USER-DIFFRACTION)
+
+if(PKG_KSPACE)
+  target_compile_definitions(lammps PRIVATE -DLMP_DIFFRACTION_MESH)
+else()
+  get_target_property(LAMMPS_SOURCES lammps SOURCES)
+  list(REMOVE_ITEM LAMMPS_SOURCES ${USER-DIFFRACTION_SOURCES_DIR}/diffraction_mesh.cpp)
+  set_property(TARGET lammps PROPERTY SOURCES ${LAMMPS_SOURCES})
+endif()
@@ -172,6 +172,11 @@ class lammps(object):
       [c_void_p,POINTER(c_double),POINTER(c_double),c_double,c_double,c_double]
     self.lib.lammps_reset_box.restype = None
 
+    self.lib.lammps_checkpoint_save.argtypes = [c_void_p,c_char_p,c_int]
+    self.lib.lammps_checkpoint_save.restype = None
+    self.lib.lammps_checkpoint_restore.argtypes = [c_void_p,c_char_p,c_int]
+    self.lib.lammps_checkpoint_restore.restype = None
+
     self.lib.lammps_gather_atoms.argtypes = \
       [c_void_p,c_char_p,c_int,c_int,c_void_p]
     self.lib.lammps_gather_atoms.restype = None
@@ -650,6 +655,42 @@ class lammps(object):
 
   # -------------------------------------------------------------------------
 
+  def checkpoint_save(self,name,buddy=False):
+    """Save the current state of the simulation in memory
+
+    This is a wrapper around the :cpp:func:`lammps_checkpoint_save`
+    function of the C-library interface.
+
+    :param name: name of the checkpoint
+    :type name: string
+    :param buddy: also keep a copy of each processor's data on the next processor
+    :type buddy: bool
+    """
+    self.lib.lammps_checkpoint_save(self.lmp,name.encode(),int(buddy))
+
+    if self.has_exceptions and self.lib.lammps_has_error(self.lmp):
+      raise self._lammps_exception
+
+  # -------------------------------------------------------------------------
+
+  def checkpoint_restore(self,name,buddy=False):
+    """Reset the simulation to a state saved in memory
+
+    This is a wrapper around the :cpp:func:`lammps_checkpoint_restore`
+    function of the C-library interface.
+
+    :param name: name of the checkpoint
+    :type name: string
+    :param buddy: restore from the copies held by the next processors
+    :type buddy: bool
+    """
+    self.lib.lammps_checkpoint_restore(self.lmp,name.encode(),int(buddy))
+
+    if self.has_exceptions and self.lib.lammps_has_error(self.lmp):
+      raise self._lammps_exception
+
+  # -------------------------------------------------------------------------
+
   def get_thermo(self,name):
     """Get current value of a thermo keyword
 
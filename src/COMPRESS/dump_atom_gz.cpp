@@ -149,17 +149,14 @@ void DumpAtomGZ::write_data(int n, double *mybuf)
 
 /* ---------------------------------------------------------------------- */
 
-void DumpAtomGZ::write()
+void DumpAtomGZ::close_snapshot()
 {
-  DumpAtom::write();
-  if (filewriter) {
-    if (multifile) {
-      gzclose(gzFp);
-      gzFp = nullptr;
-    } else {
-      if (flush_flag)
-        gzflush(gzFp,Z_SYNC_FLUSH);
-    }
+  if (multifile) {
+    gzclose(gzFp);
+    gzFp = nullptr;
+  } else {
+    if (flush_flag)
+      gzflush(gzFp,Z_SYNC_FLUSH);
   }
 }
 
@@ -152,16 +152,13 @@ void DumpAtomZstd::write_data(int n, double *mybuf)
 
 /* ---------------------------------------------------------------------- */
 
-void DumpAtomZstd::write()
+void DumpAtomZstd::close_snapshot()
 {
-  DumpAtom::write();
-  if (filewriter) {
-    if (multifile) {
-      writer.close();
-    } else {
-      if (flush_flag && writer.isopen()) {
-        writer.flush();
-      }
+  if (multifile) {
+    writer.close();
+  } else {
+    if (flush_flag && writer.isopen()) {
+      writer.flush();
     }
   }
 }
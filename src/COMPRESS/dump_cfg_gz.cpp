@@ -157,17 +157,14 @@ void DumpCFGGZ::write_data(int n, double *mybuf)
 
 /* ---------------------------------------------------------------------- */
 
-void DumpCFGGZ::write()
+void DumpCFGGZ::close_snapshot()
 {
-  DumpCFG::write();
-  if (filewriter) {
-    if (multifile) {
-      gzclose(gzFp);
-      gzFp = nullptr;
-    } else {
-      if (flush_flag)
-        gzflush(gzFp,Z_SYNC_FLUSH);
-    }
+  if (multifile) {
+    gzclose(gzFp);
+    gzFp = nullptr;
+  } else {
+    if (flush_flag)
+      gzflush(gzFp,Z_SYNC_FLUSH);
   }
 }
 
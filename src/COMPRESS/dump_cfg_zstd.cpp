@@ -154,16 +154,13 @@ void DumpCFGZstd::write_data(int n, double *mybuf)
 
 /* ---------------------------------------------------------------------- */
 
-void DumpCFGZstd::write()
+void DumpCFGZstd::close_snapshot()
 {
-  DumpCFG::write();
-  if (filewriter) {
-    if (multifile) {
-      writer.close();
-    } else {
-      if (flush_flag && writer.isopen()) {
-        writer.flush();
-      }
+  if (multifile) {
+    writer.close();
+  } else {
+    if (flush_flag && writer.isopen()) {
+      writer.flush();
     }
   }
 }
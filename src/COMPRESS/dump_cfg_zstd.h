@@ -41,7 +41,7 @@ class DumpCFGZstd : public DumpCFG {
   virtual void openfile();
   virtual void write_header(bigint);
   virtual void write_data(int, double *);
-  virtual void write();
+  virtual void close_snapshot();
 
   virtual int modify_param(int, char **);
 };
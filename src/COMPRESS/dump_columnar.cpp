@@ -0,0 +1,545 @@
+/* ----------------------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://lammps.sandia.gov/, Sandia National Laboratories
+   Steve Plimpton, sjplimp@sandia.gov
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#include "dump_columnar.h"
+
+#include "atom.h"
+#include "domain.h"
+#include "error.h"
+#include "memory.h"
+#include "update.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <zlib.h>
+#ifdef LAMMPS_ZSTD
+#include <zstd.h>
+#endif
+
+using namespace LAMMPS_NS;
+
+// file layout, also in reader_columnar.cpp
+//   file header: magic, endian flag, revision
+//   per frame: FRME, # of bytes that follow, timestep, natoms, triclinic,
+//     boundary flags, box, # of columns, per-column descriptor
+//     (name, type, [quantum, origin,] codec, raw size, stored size),
+//     column blocks
+//   at end of file: INDX, nframes, (timestep,offset) per frame,
+//     offset of index, index magic
+
+static const char MAGIC[8] = {'L','M','P','C','O','L','v','1'};
+static const char MAGIC_INDEX[8] = {'L','M','P','C','O','L','I','X'};
+static const char TAG_FRAME[4] = {'F','R','M','E'};
+static const char TAG_INDEX[4] = {'I','N','D','X'};
+
+enum{NONE,ZLIB,ZSTD};           // block codec
+enum{COL_DOUBLE,COL_INT,COL_QUANT};   // column type in file
+
+#define ENDIAN 0x0001
+#define REVISION 2
+#define DELTA 1024
+#define MAXQUANT 4.0e15         // largest quantized value that is exact
+
+// interleave lowest 21 bits of ix,iy,iz into a Morton (Z-order) key
+
+static uint64_t morton_key(uint64_t ix, uint64_t iy, uint64_t iz)
+{
+  uint64_t key = 0;
+  for (int b = 0; b < 21; b++) {
+    key |= ((ix >> b) & 1) << (3*b);
+    key |= ((iy >> b) & 1) << (3*b+1);
+    key |= ((iz >> b) & 1) << (3*b+2);
+  }
+  return key;
+}
+
+/* ---------------------------------------------------------------------- */
+
+DumpColumnar::DumpColumnar(LAMMPS *lmp, int narg, char **arg) :
+  DumpCustom(lmp, narg, arg)
+{
+  if (compressed)
+    error->all(FLERR,"Dump columnar cannot write gzipped files");
+
+  // columns are stored as raw doubles or ints, never as text
+  // sort by atom ID by default, which makes the ID column compress well
+
+  binary = 1;
+  buffer_allow = 0;
+  buffer_flag = 0;
+  if (!multiproc && atom->tag_enable) {
+    sort_flag = 1;
+    sortcol = 0;
+  }
+
+#ifdef LAMMPS_ZSTD
+  codec = ZSTD;
+#else
+  codec = ZLIB;
+#endif
+  compression_level = -1;
+
+  // column labels and which box dimension a coordinate column refers to
+  // unscaled coordinates are quantized relative to the lower box bound
+
+  colbuffer = utils::strdup(columns);
+  colnames = new char*[size_one];
+  coldim = new int[size_one];
+  colscaled = new int[size_one];
+  quantum = new double[size_one];
+  char *ptr = strtok(colbuffer," ");
+  for (int j = 0; j < size_one; j++) {
+    colnames[j] = ptr;
+    ptr = strtok(nullptr," ");
+    quantum[j] = 0.0;
+    coldim[j] = -1;
+    colscaled[j] = 0;
+    const char *name = colnames[j];
+    if (name[0] >= 'x' && name[0] <= 'z' &&
+        (name[1] == '\0' || strcmp(&name[1],"u") == 0 ||
+         strcmp(&name[1],"s") == 0 || strcmp(&name[1],"su") == 0)) {
+      coldim[j] = name[0] - 'x';
+      if (name[1] == 's') colscaled[j] = 1;
+    }
+  }
+  spatial_flag = 0;
+  maxorder = 0;
+  order = nullptr;
+  key = nullptr;
+
+  ndump = ntimestep = 0;
+  triclinic = 0;
+  nrows = maxrows = 0;
+  rows = nullptr;
+  maxcol = maxpack = 0;
+  colbuf = shufbuf = packbuf = nullptr;
+  blockraw = blocksize = nullptr;
+  blockcodec = nullptr;
+
+  fileoffset = 0;
+  nindex = maxindex = 0;
+  index_step = index_offset = nullptr;
+
+  memory->create(blockraw,size_one,"dump:blockraw");
+  memory->create(blocksize,size_one,"dump:blocksize");
+  memory->create(blockcodec,size_one,"dump:blockcodec");
+  memory->create(coltype,size_one,"dump:coltype");
+  memory->create(colorigin,size_one,"dump:colorigin");
+}
+
+/* ---------------------------------------------------------------------- */
+
+DumpColumnar::~DumpColumnar()
+{
+  // complete single file with its frame index
+  // Dump destructor closes the file
+
+  if (filewriter && fp && multifile == 0) write_index();
+
+  memory->destroy(rows);
+  memory->destroy(colbuf);
+  memory->destroy(shufbuf);
+  memory->destroy(packbuf);
+  memory->destroy(blockraw);
+  memory->destroy(blocksize);
+  memory->destroy(blockcodec);
+  memory->destroy(coltype);
+  memory->destroy(colorigin);
+  memory->destroy(index_step);
+  memory->destroy(index_offset);
+  memory->destroy(order);
+  memory->destroy(key);
+  delete [] colnames;
+  delete [] colbuffer;
+  delete [] coldim;
+  delete [] colscaled;
+  delete [] quantum;
+}
+
+/* ---------------------------------------------------------------------- */
+
+void DumpColumnar::init_style()
+{
+  if (append_flag)
+    error->all(FLERR,"Dump columnar cannot append to a file");
+  DumpCustom::init_style();
+}
+
+/* ----------------------------------------------------------------------
+   open file and write file header if it was not opened before
+------------------------------------------------------------------------- */
+
+void DumpColumnar::openfile()
+{
+  if (singlefile_opened) return;
+  Dump::openfile();
+
+  nindex = 0;
+  fileoffset = 0;
+  if (!filewriter) return;
+
+  int endian = ENDIAN;
+  int revision = REVISION;
+  fwrite(MAGIC,sizeof(char),8,fp);
+  fwrite(&endian,sizeof(int),1,fp);
+  fwrite(&revision,sizeof(int),1,fp);
+  fileoffset = 8 + 2*sizeof(int);
+}
+
+/* ----------------------------------------------------------------------
+   remember snapshot info, frame is written when all data is received
+------------------------------------------------------------------------- */
+
+void DumpColumnar::write_header(bigint n)
+{
+  ndump = n;
+  ntimestep = update->ntimestep;
+  triclinic = domain->triclinic;
+  box[0] = boxxlo; box[1] = boxxhi; box[2] = boxxy;
+  box[3] = boxylo; box[4] = boxyhi; box[5] = boxxz;
+  box[6] = boxzlo; box[7] = boxzhi; box[8] = boxyz;
+  if (!triclinic) box[2] = box[5] = box[8] = 0.0;
+  nrows = 0;
+}
+
+/* ----------------------------------------------------------------------
+   collect rows from one proc until the snapshot is complete
+------------------------------------------------------------------------- */
+
+void DumpColumnar::write_data(int n, double *mybuf)
+{
+  if (nrows + n > maxrows) {
+    maxrows = nrows + n;
+    memory->grow(rows,maxrows*size_one,"dump:rows");
+  }
+  if (n) memcpy(&rows[nrows*size_one],mybuf,n*size_one*sizeof(double));
+  nrows += n;
+}
+
+/* ---------------------------------------------------------------------- */
+
+void DumpColumnar::close_snapshot()
+{
+  write_frame();
+
+  if (multifile) {
+    write_index();
+    fclose(fp);
+    fp = nullptr;
+  } else if (flush_flag) fflush(fp);
+}
+
+/* ----------------------------------------------------------------------
+   transpose rows into columns, filter and compress each column,
+   write frame and add it to the index
+------------------------------------------------------------------------- */
+
+void DumpColumnar::write_frame()
+{
+  const bigint nbytes = nrows * 8;
+
+  if (nbytes > maxcol) {
+    maxcol = nbytes;
+    memory->destroy(colbuf);
+    memory->destroy(shufbuf);
+    memory->create(colbuf,maxcol,"dump:colbuf");
+    memory->create(shufbuf,maxcol,"dump:shufbuf");
+  }
+
+  // order of rows in the frame
+
+  if (nrows > maxorder) {
+    maxorder = nrows;
+    memory->destroy(order);
+    memory->destroy(key);
+    memory->create(order,maxorder,"dump:order");
+    memory->create(key,maxorder,"dump:key");
+  }
+  for (bigint i = 0; i < nrows; i++) order[i] = i;
+  if (spatial_flag) spatial_order();
+
+  bigint packed = 0;
+  for (int j = 0; j < size_one; j++) {
+    coltype[j] = (vtype[j] == Dump::DOUBLE) ? COL_DOUBLE : COL_INT;
+    colorigin[j] = 0.0;
+
+    // quantized doubles become integers relative to an origin
+    // fall back to exact doubles if a value does not fit
+
+    if (coltype[j] == COL_DOUBLE && quantum[j] > 0.0) {
+      if (coldim[j] >= 0 && !colscaled[j]) colorigin[j] = box[3*coldim[j]];
+      const double inv = 1.0/quantum[j];
+      int64_t *col = (int64_t *) colbuf;
+      int64_t last = 0;
+      bigint i;
+      for (i = 0; i < nrows; i++) {
+        double q = (rows[order[i]*size_one+j] - colorigin[j]) * inv;
+        if (!(fabs(q) < MAXQUANT)) break;
+        int64_t value = static_cast<int64_t> (llround(q));
+        int64_t diff = value - last;
+        col[i] = (diff << 1) ^ (diff >> 63);
+        last = value;
+      }
+      if (i == nrows) coltype[j] = COL_QUANT;
+    }
+
+    // doubles are stored as is, integers as int64 differences to
+    // the previous row, so that sorted IDs and types become small
+    // quantized values also as differences, zigzag encoded so that
+    // small negative differences have no leading 0xff bytes
+
+    if (coltype[j] == COL_DOUBLE) {
+      double *col = (double *) colbuf;
+      for (bigint i = 0; i < nrows; i++) col[i] = rows[order[i]*size_one+j];
+    } else if (coltype[j] == COL_INT) {
+      int64_t *col = (int64_t *) colbuf;
+      int64_t last = 0;
+      for (bigint i = 0; i < nrows; i++) {
+        int64_t value = static_cast<int64_t> (rows[order[i]*size_one+j]);
+        col[i] = value - last;
+        last = value;
+      }
+    }
+
+    // shuffle bytes, so that all 1st bytes come first, then 2nd etc
+    // this groups sign/exponent bytes together which compress much better
+
+    for (bigint i = 0; i < nrows; i++)
+      for (int b = 0; b < 8; b++)
+        shufbuf[b*nrows+i] = colbuf[8*i+b];
+
+    bigint bound = nbytes + nbytes/16 + 1024;
+    if (packed + bound > maxpack) {
+      maxpack = packed + bound;
+      memory->grow(packbuf,maxpack,"dump:packbuf");
+    }
+
+    bigint size = -1;
+    if (codec != NONE && nbytes > 0)
+      size = compress_block(codec,nbytes,&packbuf[packed],bound);
+    if (size < 0 || size >= nbytes) {
+      memcpy(&packbuf[packed],shufbuf,nbytes);
+      size = nbytes;
+      blockcodec[j] = NONE;
+    } else blockcodec[j] = codec;
+
+    blockraw[j] = nbytes;
+    blocksize[j] = size;
+    packed += size;
+  }
+
+  // frame header, column descriptors, blocks
+
+  int64_t framebytes = 2*sizeof(int64_t) + 8*sizeof(int) + 9*sizeof(double);
+  for (int j = 0; j < size_one; j++) {
+    framebytes += 3*sizeof(int) + strlen(colnames[j]) + 2*sizeof(int64_t);
+    if (coltype[j] == COL_QUANT) framebytes += 2*sizeof(double);
+  }
+  framebytes += packed;
+
+  if (nindex == maxindex) {
+    maxindex += DELTA;
+    memory->grow(index_step,maxindex,"dump:index_step");
+    memory->grow(index_offset,maxindex,"dump:index_offset");
+  }
+  index_step[nindex] = ntimestep;
+  index_offset[nindex] = fileoffset;
+  nindex++;
+
+  int64_t step = ntimestep;
+  int64_t natoms = nrows;
+  int ncol = size_one;
+  int boundary[6];
+  for (int i = 0; i < 3; i++) {
+    boundary[2*i] = domain->boundary[i][0];
+    boundary[2*i+1] = domain->boundary[i][1];
+  }
+
+  fwrite(TAG_FRAME,sizeof(char),4,fp);
+  fwrite(&framebytes,sizeof(int64_t),1,fp);
+  fwrite(&step,sizeof(int64_t),1,fp);
+  fwrite(&natoms,sizeof(int64_t),1,fp);
+  fwrite(&triclinic,sizeof(int),1,fp);
+  fwrite(boundary,sizeof(int),6,fp);
+  fwrite(box,sizeof(double),9,fp);
+  fwrite(&ncol,sizeof(int),1,fp);
+
+  for (int j = 0; j < size_one; j++) {
+    int len = strlen(colnames[j]);
+    int64_t raw = blockraw[j];
+    int64_t size = blocksize[j];
+    fwrite(&len,sizeof(int),1,fp);
+    fwrite(colnames[j],sizeof(char),len,fp);
+    fwrite(&coltype[j],sizeof(int),1,fp);
+    if (coltype[j] == COL_QUANT) {
+      fwrite(&quantum[j],sizeof(double),1,fp);
+      fwrite(&colorigin[j],sizeof(double),1,fp);
+    }
+    fwrite(&blockcodec[j],sizeof(int),1,fp);
+    fwrite(&raw,sizeof(int64_t),1,fp);
+    fwrite(&size,sizeof(int64_t),1,fp);
+  }
+  fwrite(packbuf,sizeof(char),packed,fp);
+
+  fileoffset += 4 + sizeof(int64_t) + framebytes;
+}
+
+/* ----------------------------------------------------------------------
+   reorder rows along a Z-order curve through the box
+   neighboring rows are then also close in space, which makes
+     differences of quantized coordinates small
+   only done if x,y,z are all quantized
+------------------------------------------------------------------------- */
+
+void DumpColumnar::spatial_order()
+{
+  int dimcol[3] = {-1,-1,-1};
+  for (int j = 0; j < size_one; j++)
+    if (coldim[j] >= 0 && quantum[j] > 0.0 && dimcol[coldim[j]] < 0)
+      dimcol[coldim[j]] = j;
+  if (dimcol[0] < 0 || dimcol[1] < 0 || dimcol[2] < 0) return;
+
+  const double maxbin = (1 << 21) - 1;
+  double lo[3],scale[3];
+  for (int d = 0; d < 3; d++) {
+    int j = dimcol[d];
+    lo[d] = colscaled[j] ? 0.0 : box[3*d];
+    double len = colscaled[j] ? 1.0 : box[3*d+1] - box[3*d];
+    scale[d] = (len > 0.0) ? maxbin/len : 0.0;
+  }
+
+  uint64_t ibin[3];
+  for (bigint i = 0; i < nrows; i++) {
+    for (int d = 0; d < 3; d++) {
+      double f = (rows[i*size_one+dimcol[d]] - lo[d]) * scale[d];
+      f = MAX(0.0,MIN(f,maxbin));
+      ibin[d] = static_cast<uint64_t> (f);
+    }
+    key[i] = morton_key(ibin[0],ibin[1],ibin[2]);
+  }
+
+  const uint64_t *k = key;
+  std::stable_sort(order,order+nrows,
+                   [k](bigint a, bigint b) { return k[a] < k[b]; });
+}
+
+/* ----------------------------------------------------------------------
+   append frame index to current file
+------------------------------------------------------------------------- */
+
+void DumpColumnar::write_index()
+{
+  int64_t nframes = nindex;
+  int64_t offset = fileoffset;
+
+  fwrite(TAG_INDEX,sizeof(char),4,fp);
+  fwrite(&nframes,sizeof(int64_t),1,fp);
+  for (int i = 0; i < nindex; i++) {
+    int64_t entry[2] = {index_step[i],index_offset[i]};
+    fwrite(entry,sizeof(int64_t),2,fp);
+  }
+  fwrite(&offset,sizeof(int64_t),1,fp);
+  fwrite(MAGIC_INDEX,sizeof(char),8,fp);
+
+  fileoffset += 4 + (2 + 2*nframes)*sizeof(int64_t) + 8;
+}
+
+/* ----------------------------------------------------------------------
+   compress shuffled column into dest with at most maxdest bytes
+   return compressed size or -1 on failure
+------------------------------------------------------------------------- */
+
+bigint DumpColumnar::compress_block(int which, bigint nraw, char *dest,
+                                    bigint maxdest)
+{
+  if (which == ZLIB) {
+    uLongf ndest = maxdest;
+    int level = compression_level;
+    if (level < 0) level = Z_DEFAULT_COMPRESSION;
+    int rv = compress2((Bytef *) dest,&ndest,(const Bytef *) shufbuf,
+                       nraw,level);
+    if (rv != Z_OK) return -1;
+    return ndest;
+  }
+
+#ifdef LAMMPS_ZSTD
+  if (which == ZSTD) {
+    int level = compression_level;
+    if (level < 0) level = 0;
+    size_t rv = ZSTD_compress(dest,maxdest,shufbuf,nraw,level);
+    if (ZSTD_isError(rv)) return -1;
+    return rv;
+  }
+#endif
+
+  return -1;
+}
+
+/* ---------------------------------------------------------------------- */
+
+int DumpColumnar::modify_param(int narg, char **arg)
+{
+  int consumed = DumpCustom::modify_param(narg, arg);
+  if (consumed) return consumed;
+
+  if (strcmp(arg[0],"codec") == 0) {
+    if (narg < 2) error->all(FLERR,"Illegal dump_modify command");
+    if (strcmp(arg[1],"none") == 0) codec = NONE;
+    else if (strcmp(arg[1],"zlib") == 0) codec = ZLIB;
+    else if (strcmp(arg[1],"zstd") == 0) {
+#ifdef LAMMPS_ZSTD
+      codec = ZSTD;
+#else
+      error->all(FLERR,"Dump columnar requires LAMMPS built with zstd support");
+#endif
+    } else error->all(FLERR,"Illegal dump_modify command");
+    return 2;
+  }
+
+  if (strcmp(arg[0],"quantize") == 0) {
+    if (narg < 3) error->all(FLERR,"Illegal dump_modify command");
+    double value = utils::numeric(FLERR,arg[2],false,lmp);
+    if (value < 0.0) error->all(FLERR,"Illegal dump_modify command");
+    int count = 0;
+    for (int j = 0; j < size_one; j++) {
+      if (vtype[j] != Dump::DOUBLE) continue;
+      if (strcmp(arg[1],"*") == 0 || strcmp(arg[1],colnames[j]) == 0) {
+        quantum[j] = value;
+        count++;
+      }
+    }
+    if (count == 0)
+      error->all(FLERR,fmt::format("Dump_modify quantize column {} "
+                                   "is not a floating point column",arg[1]));
+    return 3;
+  }
+
+  if (strcmp(arg[0],"spatial") == 0) {
+    if (narg < 2) error->all(FLERR,"Illegal dump_modify command");
+    if (strcmp(arg[1],"yes") == 0) spatial_flag = 1;
+    else if (strcmp(arg[1],"no") == 0) spatial_flag = 0;
+    else error->all(FLERR,"Illegal dump_modify command");
+    return 2;
+  }
+
+  if (strcmp(arg[0],"compression_level") == 0) {
+    if (narg < 2) error->all(FLERR,"Illegal dump_modify command");
+    compression_level = utils::inumeric(FLERR,arg[1],false,lmp);
+    if (compression_level < 0 || compression_level > 22)
+      error->all(FLERR,"Illegal dump_modify command");
+    return 2;
+  }
+
+  return 0;
+}
@@ -0,0 +1,112 @@
+/* -*- c++ -*- ----------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://lammps.sandia.gov/, Sandia National Laboratories
+   Steve Plimpton, sjplimp@sandia.gov
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#ifdef DUMP_CLASS
+
+DumpStyle(columnar,DumpColumnar)
+
+#else
+
+#ifndef LMP_DUMP_COLUMNAR_H
+#define LMP_DUMP_COLUMNAR_H
+
+#include "dump_custom.h"
+
+namespace LAMMPS_NS {
+
+class DumpColumnar : public DumpCustom {
+ public:
+  DumpColumnar(class LAMMPS *, int, char **);
+  virtual ~DumpColumnar();
+
+ protected:
+  int codec;                 // compression of column blocks
+  int compression_level;
+
+  bigint ndump;              // # of atoms in current snapshot
+  bigint ntimestep;          // timestep of current snapshot
+  double box[9];             // box bounds and tilt of current snapshot
+  int triclinic;
+
+  bigint nrows;              // # of atoms received for current snapshot
+  bigint maxrows;
+  double *rows;              // per-atom values of current snapshot
+
+  bigint maxcol;
+  char *colbuf;              // one column as contiguous doubles or ints
+  char *shufbuf;             // same column with bytes shuffled
+  bigint maxpack;
+  char *packbuf;             // all compressed column blocks of a frame
+  bigint *blockraw;          // uncompressed size of each block
+  bigint *blocksize;         // size of each block in file
+  int *blockcodec;           // codec actually used for each block
+
+  char *colbuffer;
+  char **colnames;           // label of each column
+  int *coldim;               // 0,1,2 if column is x,y,z coordinate, else -1
+  int *colscaled;            // 1 if coordinate column is scaled
+  double *quantum;           // quantization step of each column, 0 = exact
+  int *coltype;              // type of each column in current frame
+  double *colorigin;         // quantization origin in current frame
+
+  int spatial_flag;          // 1 to order rows along a space-filling curve
+  bigint maxorder;
+  bigint *order;             // row order of current frame
+  uint64_t *key;             // Z-order key of each row
+
+  bigint fileoffset;         // # of bytes written to current file
+  int nindex,maxindex;       // # of frames in current file
+  bigint *index_step;        // timestep of each frame
+  bigint *index_offset;      // file offset of each frame
+
+  void init_style();
+  void openfile();
+  void write_header(bigint);
+  void write_data(int, double *);
+  void close_snapshot();
+  int modify_param(int, char **);
+
+  void write_frame();
+  void write_index();
+  void spatial_order();
+  bigint compress_block(int, bigint, char *, bigint);
+};
+
+}
+
+#endif
+#endif
+
+/* ERROR/WARNING messages:
+
+E: Dump columnar cannot write gzipped files
+
+The file name must not end in .gz or .zst, since dump columnar
+compresses each column itself.
+
+E: Dump_modify quantize column %s is not a floating point column
+
+Only columns with floating point values can be quantized.  Use "*" to
+quantize all of them.
+
+E: Dump columnar cannot append to a file
+
+The frame index is written at the end of the file, so appending is not
+supported.
+
+E: Dump columnar requires LAMMPS built with zstd support
+
+The zstd codec was requested but the COMPRESS package was compiled
+without the Zstd library.
+
+*/
@@ -149,17 +149,14 @@ void DumpCustomGZ::write_data(int n, double *mybuf)
 
 /* ---------------------------------------------------------------------- */
 
-void DumpCustomGZ::write()
+void DumpCustomGZ::close_snapshot()
 {
-  DumpCustom::write();
-  if (filewriter) {
-    if (multifile) {
-      gzclose(gzFp);
-      gzFp = nullptr;
-    } else {
-      if (flush_flag)
-        gzflush(gzFp,Z_SYNC_FLUSH);
-    }
+  if (multifile) {
+    gzclose(gzFp);
+    gzFp = nullptr;
+  } else {
+    if (flush_flag)
+      gzflush(gzFp,Z_SYNC_FLUSH);
   }
 }
 
@@ -152,16 +152,13 @@ void DumpCustomZstd::write_data(int n, double *mybuf)
 
 /* ---------------------------------------------------------------------- */
 
-void DumpCustomZstd::write()
+void DumpCustomZstd::close_snapshot()
 {
-  DumpCustom::write();
-  if (filewriter) {
-    if (multifile) {
-      writer.close();
-    } else {
-      if (flush_flag && writer.isopen()) {
-        writer.flush();
-      }
+  if (multifile) {
+    writer.close();
+  } else {
+    if (flush_flag && writer.isopen()) {
+      writer.flush();
     }
   }
 }
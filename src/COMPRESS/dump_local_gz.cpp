@@ -164,17 +164,14 @@ void DumpLocalGZ::write_data(int n, double *mybuf)
 
 /* ---------------------------------------------------------------------- */
 
-void DumpLocalGZ::write()
+void DumpLocalGZ::close_snapshot()
 {
-  DumpLocal::write();
-  if (filewriter) {
-    if (multifile) {
-      gzclose(gzFp);
-      gzFp = nullptr;
-    } else {
-      if (flush_flag)
-        gzflush(gzFp,Z_SYNC_FLUSH);
-    }
+  if (multifile) {
+    gzclose(gzFp);
+    gzFp = nullptr;
+  } else {
+    if (flush_flag)
+      gzflush(gzFp,Z_SYNC_FLUSH);
   }
 }
 
@@ -128,17 +128,14 @@ void DumpXYZGZ::write_data(int n, double *mybuf)
 
 /* ---------------------------------------------------------------------- */
 
-void DumpXYZGZ::write()
+void DumpXYZGZ::close_snapshot()
 {
-  DumpXYZ::write();
-  if (filewriter) {
-    if (multifile) {
-      gzclose(gzFp);
-      gzFp = nullptr;
-    } else {
-      if (flush_flag)
-        gzflush(gzFp,Z_SYNC_FLUSH);
-    }
+  if (multifile) {
+    gzclose(gzFp);
+    gzFp = nullptr;
+  } else {
+    if (flush_flag)
+      gzflush(gzFp,Z_SYNC_FLUSH);
   }
 }
 
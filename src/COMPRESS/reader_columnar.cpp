@@ -0,0 +1,383 @@
+/* ----------------------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://lammps.sandia.gov/, Sandia National Laboratories
+   Steve Plimpton, sjplimp@sandia.gov
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#include "reader_columnar.h"
+
+#include "error.h"
+#include "memory.h"
+
+#include <cstring>
+#include <map>
+#include <zlib.h>
+#ifdef LAMMPS_ZSTD
+#include <zstd.h>
+#endif
+
+using namespace LAMMPS_NS;
+
+// file layout is described in dump_columnar.cpp
+
+static const char MAGIC[8] = {'L','M','P','C','O','L','v','1'};
+static const char MAGIC_INDEX[8] = {'L','M','P','C','O','L','I','X'};
+static const char TAG_FRAME[4] = {'F','R','M','E'};
+static const char TAG_INDEX[4] = {'I','N','D','X'};
+
+enum{NONE,ZLIB,ZSTD};           // block codec
+enum{COL_DOUBLE,COL_INT,COL_QUANT};   // column type in file
+
+#define ENDIAN 0x0001
+#define REVISION 2
+#define HEADERSIZE (8 + 2*sizeof(int))
+
+/* ---------------------------------------------------------------------- */
+
+ReaderColumnar::ReaderColumnar(LAMMPS *lmp) : ReaderNative(lmp)
+{
+  iframe = 0;
+  natoms = nread = 0;
+  nfield_loaded = 0;
+  values = nullptr;
+  packbuf = shufbuf = nullptr;
+  maxpack = maxshuf = maxvalues = 0;
+}
+
+/* ---------------------------------------------------------------------- */
+
+ReaderColumnar::~ReaderColumnar()
+{
+  memory->destroy(values);
+  memory->destroy(packbuf);
+  memory->destroy(shufbuf);
+}
+
+/* ----------------------------------------------------------------------
+   open binary file, check header and load frame index
+   index is at end of file, scan all frames if it is missing,
+     e.g. when the writing run did not finish
+------------------------------------------------------------------------- */
+
+void ReaderColumnar::open_file(const char *file)
+{
+  if (fp != nullptr) close_file();
+
+  compressed = 0;
+  fp = fopen(file,"rb");
+  if (fp == nullptr)
+    error->one(FLERR,fmt::format("Cannot open file {}: {}",
+                                 file, utils::getsyserror()));
+
+  char magic[8];
+  int endian,revision;
+  read_block(magic,8);
+  if (memcmp(magic,MAGIC,8) != 0)
+    error->one(FLERR,"Columnar dump file is incorrectly formatted");
+  read_block(&endian,sizeof(int));
+  if (endian != ENDIAN)
+    error->one(FLERR,"Columnar dump file was written on a machine "
+               "with different endianness");
+  read_block(&revision,sizeof(int));
+  if (revision < 1 || revision > REVISION)
+    error->one(FLERR,"Columnar dump file is incorrectly formatted");
+
+  index_step.clear();
+  index_offset.clear();
+  iframe = 0;
+  read_index();
+}
+
+/* ---------------------------------------------------------------------- */
+
+void ReaderColumnar::close_file()
+{
+  if (fp == nullptr) return;
+  fclose(fp);
+  fp = nullptr;
+  index_step.clear();
+  index_offset.clear();
+  cols.clear();
+}
+
+/* ----------------------------------------------------------------------
+   load frame index from end of file
+------------------------------------------------------------------------- */
+
+void ReaderColumnar::read_index()
+{
+  int64_t offset,nframes;
+  char magic[8];
+
+  if (fseek(fp,-8-(long)sizeof(int64_t),SEEK_END) == 0 &&
+      fread(&offset,sizeof(int64_t),1,fp) == 1 &&
+      fread(magic,sizeof(char),8,fp) == 8 &&
+      memcmp(magic,MAGIC_INDEX,8) == 0 &&
+      fseek(fp,offset,SEEK_SET) == 0 &&
+      fread(magic,sizeof(char),4,fp) == 4 &&
+      memcmp(magic,TAG_INDEX,4) == 0 &&
+      fread(&nframes,sizeof(int64_t),1,fp) == 1) {
+    int64_t entry[2];
+    for (int64_t i = 0; i < nframes; i++) {
+      read_block(entry,2*sizeof(int64_t));
+      index_step.push_back(entry[0]);
+      index_offset.push_back(entry[1]);
+    }
+  } else scan_frames();
+}
+
+/* ----------------------------------------------------------------------
+   build frame index by hopping from frame header to frame header
+   a truncated last frame is ignored
+------------------------------------------------------------------------- */
+
+void ReaderColumnar::scan_frames()
+{
+  fseek(fp,0,SEEK_END);
+  const bigint filesize = ftell(fp);
+
+  bigint offset = HEADERSIZE;
+  char tag[4];
+  int64_t framebytes,step;
+
+  while (fseek(fp,offset,SEEK_SET) == 0 &&
+         fread(tag,sizeof(char),4,fp) == 4 &&
+         memcmp(tag,TAG_FRAME,4) == 0 &&
+         fread(&framebytes,sizeof(int64_t),1,fp) == 1 &&
+         fread(&step,sizeof(int64_t),1,fp) == 1) {
+    bigint next = offset + 4 + sizeof(int64_t) + framebytes;
+    if (next > filesize) break;
+    index_step.push_back(step);
+    index_offset.push_back(offset);
+    offset = next;
+  }
+  clearerr(fp);
+}
+
+/* ----------------------------------------------------------------------
+   return time stamp of next frame from index
+   return 1 if no frames are left so caller can open next file
+   only called by proc 0
+------------------------------------------------------------------------- */
+
+int ReaderColumnar::read_time(bigint &ntimestep)
+{
+  if (iframe >= (int) index_step.size()) return 1;
+  ntimestep = index_step[iframe];
+  return 0;
+}
+
+/* ----------------------------------------------------------------------
+   skip snapshot, frames are located through the index
+   only called by proc 0
+------------------------------------------------------------------------- */
+
+void ReaderColumnar::skip()
+{
+  iframe++;
+}
+
+/* ----------------------------------------------------------------------
+   read frame header and column descriptors, see ReaderNative for args
+   only called by proc 0
+------------------------------------------------------------------------- */
+
+bigint ReaderColumnar::read_header(double box[3][3], int &boxinfo,
+                                   int &triclinic, int fieldinfo, int nfield,
+                                   int *fieldtype, char **fieldlabel,
+                                   int scaleflag, int wrapflag, int &fieldflag,
+                                   int &xflag, int &yflag, int &zflag)
+{
+  char tag[4];
+  int64_t framebytes,step,n;
+  int boundary[6],ncol;
+  double fbox[9];
+
+  if (fseek(fp,index_offset[iframe],SEEK_SET) != 0)
+    error->one(FLERR,"Unexpected end of dump file");
+  read_block(tag,4);
+  if (memcmp(tag,TAG_FRAME,4) != 0)
+    error->one(FLERR,"Columnar dump file is incorrectly formatted");
+  read_block(&framebytes,sizeof(int64_t));
+  read_block(&step,sizeof(int64_t));
+  read_block(&n,sizeof(int64_t));
+  read_block(&triclinic,sizeof(int));
+  read_block(boundary,6*sizeof(int));
+  read_block(fbox,9*sizeof(double));
+  read_block(&ncol,sizeof(int));
+
+  boxinfo = 1;
+  for (int i = 0; i < 3; i++)
+    for (int j = 0; j < 3; j++)
+      box[i][j] = fbox[3*i+j];
+
+  // column descriptors, blocks follow in the same order
+
+  cols.resize(ncol);
+  for (int j = 0; j < ncol; j++) {
+    int len;
+    int64_t raw,size;
+    read_block(&len,sizeof(int));
+    if (len <= 0 || len > 1024)
+      error->one(FLERR,"Columnar dump file is incorrectly formatted");
+    std::string name(len,' ');
+    read_block(&name[0],len);
+    cols[j].name = name;
+    read_block(&cols[j].type,sizeof(int));
+    cols[j].quantum = cols[j].origin = 0.0;
+    if (cols[j].type == COL_QUANT) {
+      read_block(&cols[j].quantum,sizeof(double));
+      read_block(&cols[j].origin,sizeof(double));
+    }
+    read_block(&cols[j].codec,sizeof(int));
+    read_block(&raw,sizeof(int64_t));
+    read_block(&size,sizeof(int64_t));
+    cols[j].raw = raw;
+    cols[j].size = size;
+  }
+  bigint offset = ftell(fp);
+  for (int j = 0; j < ncol; j++) {
+    cols[j].offset = offset;
+    offset += cols[j].size;
+  }
+
+  iframe++;
+  natoms = n;
+  nread = 0;
+  nfield_loaded = 0;
+
+  // if no field info requested, just return
+
+  if (!fieldinfo) return natoms;
+
+  std::map<std::string, int> labels;
+  for (int j = 0; j < ncol; j++) labels[cols[j].name] = j;
+  nwords = ncol;
+  if (nwords == 0) return 1;
+
+  match_fields(labels,nfield,fieldtype,fieldlabel,scaleflag,wrapflag,
+               fieldflag,xflag,yflag,zflag);
+
+  return natoms;
+}
+
+/* ----------------------------------------------------------------------
+   return next N atoms of current frame
+   only columns of requested fields are decompressed, on first call
+   only called by proc 0
+------------------------------------------------------------------------- */
+
+void ReaderColumnar::read_atoms(int n, int nfield, double **fields)
+{
+  if (nfield_loaded != nfield) load_columns(nfield);
+  if (nread + n > natoms) error->one(FLERR,"Unexpected end of dump file");
+
+  for (int i = 0; i < n; i++)
+    for (int m = 0; m < nfield; m++)
+      fields[i][m] = values[m*natoms + nread + i];
+  nread += n;
+}
+
+/* ----------------------------------------------------------------------
+   read, decompress and decode columns for all Nfield fields of frame
+------------------------------------------------------------------------- */
+
+void ReaderColumnar::load_columns(int nfield)
+{
+  if (nfield*natoms > maxvalues) {
+    maxvalues = nfield*natoms;
+    memory->destroy(values);
+    memory->create(values,maxvalues,"read_dump:values");
+  }
+  if (natoms*8 > maxshuf) {
+    maxshuf = natoms*8;
+    memory->destroy(shufbuf);
+    memory->create(shufbuf,maxshuf,"read_dump:shufbuf");
+  }
+
+  for (int m = 0; m < nfield; m++) {
+    const Column &col = cols[fieldindex[m]];
+    const bigint nbytes = natoms*8;
+    if (col.raw != nbytes)
+      error->one(FLERR,"Columnar dump file is incorrectly formatted");
+
+    if (col.size > maxpack) {
+      maxpack = col.size;
+      memory->destroy(packbuf);
+      memory->create(packbuf,maxpack,"read_dump:packbuf");
+    }
+    if (fseek(fp,col.offset,SEEK_SET) != 0)
+      error->one(FLERR,"Unexpected end of dump file");
+    read_block(packbuf,col.size);
+
+    // decompress into shufbuf
+
+    if (col.codec == NONE) {
+      if (col.size != nbytes)
+        error->one(FLERR,"Columnar dump file is incorrectly formatted");
+      memcpy(shufbuf,packbuf,nbytes);
+    } else if (col.codec == ZLIB) {
+      uLongf ndest = nbytes;
+      int rv = uncompress((Bytef *) shufbuf,&ndest,
+                          (const Bytef *) packbuf,col.size);
+      if (rv != Z_OK || (bigint) ndest != nbytes)
+        error->one(FLERR,"Columnar dump file block cannot be decompressed");
+    } else if (col.codec == ZSTD) {
+#ifdef LAMMPS_ZSTD
+      size_t rv = ZSTD_decompress(shufbuf,nbytes,packbuf,col.size);
+      if (ZSTD_isError(rv) || (bigint) rv != nbytes)
+        error->one(FLERR,"Columnar dump file block cannot be decompressed");
+#else
+      error->one(FLERR,"Columnar dump file uses zstd compression");
+#endif
+    } else error->one(FLERR,"Columnar dump file is incorrectly formatted");
+
+    // undo byte shuffle, integer differences, and quantization
+
+    double *value = &values[m*natoms];
+    if (col.type == COL_DOUBLE) {
+      unsigned char *out = (unsigned char *) value;
+      for (bigint i = 0; i < natoms; i++)
+        for (int b = 0; b < 8; b++)
+          out[8*i+b] = shufbuf[b*natoms+i];
+    } else if (col.type == COL_INT) {
+      int64_t last = 0;
+      for (bigint i = 0; i < natoms; i++) {
+        int64_t delta;
+        unsigned char *out = (unsigned char *) &delta;
+        for (int b = 0; b < 8; b++) out[b] = shufbuf[b*natoms+i];
+        last += delta;
+        value[i] = last;
+      }
+    } else if (col.type == COL_QUANT) {
+      int64_t last = 0;
+      for (bigint i = 0; i < natoms; i++) {
+        uint64_t zigzag;
+        unsigned char *out = (unsigned char *) &zigzag;
+        for (int b = 0; b < 8; b++) out[b] = shufbuf[b*natoms+i];
+        last += static_cast<int64_t> (zigzag >> 1) ^ -static_cast<int64_t> (zigzag & 1);
+        value[i] = col.origin + last*col.quantum;
+      }
+    } else error->one(FLERR,"Columnar dump file is incorrectly formatted");
+  }
+
+  nfield_loaded = nfield;
+}
+
+/* ----------------------------------------------------------------------
+   read N bytes from file
+------------------------------------------------------------------------- */
+
+void ReaderColumnar::read_block(void *buf, bigint n)
+{
+  if (n <= 0) return;
+  if ((bigint) fread(buf,sizeof(char),n,fp) != n)
+    error->one(FLERR,"Unexpected end of dump file");
+}
@@ -0,0 +1,102 @@
+/* -*- c++ -*- ----------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://lammps.sandia.gov/, Sandia National Laboratories
+   Steve Plimpton, sjplimp@sandia.gov
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#ifdef READER_CLASS
+
+ReaderStyle(columnar,ReaderColumnar)
+
+#else
+
+#ifndef LMP_READER_COLUMNAR_H
+#define LMP_READER_COLUMNAR_H
+
+#include "reader_native.h"
+
+#include <string>
+#include <vector>
+
+namespace LAMMPS_NS {
+
+class ReaderColumnar : public ReaderNative {
+ public:
+  ReaderColumnar(class LAMMPS *);
+  ~ReaderColumnar();
+
+  int read_time(bigint &);
+  void skip();
+  bigint read_header(double [3][3], int &, int &, int, int, int *, char **,
+                     int, int, int &, int &, int &, int &);
+  void read_atoms(int, int, double **);
+
+  void open_file(const char *);
+  void close_file();
+
+ private:
+  std::vector<bigint> index_step;     // timestep of each frame in file
+  std::vector<bigint> index_offset;   // file offset of each frame
+  int iframe;                         // next frame to read
+
+  struct Column {
+    std::string name;
+    int type,codec;
+    double quantum,origin;            // for quantized columns
+    bigint raw,size;
+    bigint offset;                    // file offset of column block
+  };
+  std::vector<Column> cols;           // columns of current frame
+
+  bigint natoms;                      // # of atoms in current frame
+  bigint nread;                       // # of atoms already returned
+  int nfield_loaded;                  // # of fields in values
+  double *values;                     // requested fields, column major
+  char *packbuf,*shufbuf;
+  bigint maxpack,maxshuf,maxvalues;
+
+  void read_index();
+  void scan_frames();
+  void load_columns(int);
+  void read_block(void *, bigint);
+};
+
+}
+
+#endif
+#endif
+
+/* ERROR/WARNING messages:
+
+E: Columnar dump file is incorrectly formatted
+
+The file does not start with the header written by dump columnar, or a
+frame in the file is damaged.
+
+E: Columnar dump file was written on a machine with different endianness
+
+Columnar dump files store values in native byte order and can only be
+read on machines with the same byte order.
+
+E: Columnar dump file uses zstd compression
+
+The file contains blocks compressed with zstd, but LAMMPS was compiled
+without the Zstd library.
+
+E: Columnar dump file block cannot be decompressed
+
+The compression library reported an error for a column block, the file
+is likely corrupted.
+
+E: Unexpected end of dump file
+
+A read operation from the file failed.
+
+*/
@@ -82,6 +82,7 @@ if (test $1 = "KSPACE") then
   depend USER-INTEL
   depend USER-PHONON
   depend USER-FEP
+  depend USER-DIFFRACTION
 fi
 
 if (test $1 = "MANYBODY") then
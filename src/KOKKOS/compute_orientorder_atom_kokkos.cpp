@@ -19,6 +19,7 @@
 
 #include "atom_kokkos.h"
 #include "atom_masks.h"
+#include "error.h"
 #include "kokkos.h"
 #include "math_const.h"
 #include "math_special.h"
@@ -50,6 +51,10 @@ template<class DeviceType>
 ComputeOrientOrderAtomKokkos<DeviceType>::ComputeOrientOrderAtomKokkos(LAMMPS *lmp, int narg, char **arg) :
   ComputeOrientOrderAtom(lmp, narg, arg)
 {
+  if (avgflag)
+    error->all(FLERR,"Compute orientorder/atom/kk does not support "
+               "keyword average");
+
   kokkosable = 1;
   atomKK = (AtomKokkos *) atom;
   execution_space = ExecutionSpaceFromDevice<DeviceType>::space;
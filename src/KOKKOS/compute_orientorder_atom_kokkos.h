@@ -137,4 +137,8 @@ class ComputeOrientOrderAtomKokkos : public ComputeOrientOrderAtom {
 
 /* ERROR/WARNING messages:
 
+E: Compute orientorder/atom/kk does not support keyword average
+
+Self-explanatory.
+
 */
@@ -85,6 +85,10 @@ void FixQEqReaxKokkos<DeviceType>::init()
 
   FixQEqReax::init();
 
+  if (pipelined || precond)
+    error->all(FLERR,"Fix qeq/reax/kk does not support the pipelined "
+               "and precond bjacobi keywords");
+
   neighflag = lmp->kokkos->neighflag_qeq;
   int irequest = neighbor->nrequest - 1;
 
@@ -136,6 +136,9 @@ void PairReaxCKokkos<DeviceType>::allocate()
 template<class DeviceType>
 void PairReaxCKokkos<DeviceType>::init_style()
 {
+  if (system->exactlists)
+    error->all(FLERR,"Pair reax/c/kk does not support exactlists yes");
+
   PairReaxC::init_style();
   if (fix_reax) modify->delete_fix(fix_id); // not needed in the Kokkos version
   fix_reax = nullptr;
@@ -495,4 +495,9 @@ struct PairReaxCKokkosPackBondBufferFunctor  {
 
 /* ERROR/WARNING messages:
 
+E: Pair reax/c/kk does not support exactlists yes
+
+The Kokkos version builds its own bond and hydrogen bond lists and
+does not use the exact list sizes.  Use exactlists no with this style.
+
 */
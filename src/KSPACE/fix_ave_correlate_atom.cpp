@@ -0,0 +1,843 @@
+/* ----------------------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://lammps.sandia.gov/, Sandia National Laboratories
+   Steve Plimpton, sjplimp@sandia.gov
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#include "fix_ave_correlate_atom.h"
+
+#include "arg_info.h"
+#include "atom.h"
+#include "compute.h"
+#include "domain.h"
+#include "error.h"
+#include "fft3d_wrap.h"
+#include "input.h"
+#include "memory.h"
+#include "modify.h"
+#include "update.h"
+#include "variable.h"
+
+#include <cstring>
+
+using namespace LAMMPS_NS;
+using namespace FixConst;
+
+enum{AUTO,MSD,SUM};
+enum{ONE,RUNNING};
+
+/* ---------------------------------------------------------------------- */
+
+FixAveCorrelateAtom::FixAveCorrelateAtom(LAMMPS *lmp, int narg, char **arg) :
+  Fix(lmp, narg, arg),
+  nvalues(0), which(nullptr), argindex(nullptr), unwrap(nullptr),
+  value2index(nullptr), ids(nullptr), fp(nullptr), samples(nullptr),
+  sums(nullptr), corr(nullptr), corrall(nullptr), accum(nullptr), spec(nullptr),
+  fft(nullptr), fftspec(nullptr), work(nullptr)
+{
+  if (narg < 7) error->all(FLERR,"Illegal fix ave/correlate/atom command");
+
+  MPI_Comm_rank(world,&me);
+
+  nevery = utils::inumeric(FLERR,arg[3],false,lmp);
+  nrepeat = utils::inumeric(FLERR,arg[4],false,lmp);
+  nfreq = utils::inumeric(FLERR,arg[5],false,lmp);
+
+  global_freq = nfreq;
+
+  // expand args if any have wildcard character "*"
+
+  int expand = 0;
+  char **earg;
+  int iarg = 6;
+  while (iarg < narg) {
+    if (strcmp(arg[iarg],"type") == 0 || strcmp(arg[iarg],"ave") == 0 ||
+        strcmp(arg[iarg],"spectrum") == 0 || strcmp(arg[iarg],"file") == 0)
+      break;
+    iarg++;
+  }
+  nvalues = utils::expand_args(FLERR,iarg-6,&arg[6],1,earg,lmp);
+  if (earg != &arg[6]) expand = 1;
+
+  // parse values
+
+  which = new int[nvalues];
+  argindex = new int[nvalues];
+  unwrap = new int[nvalues];
+  ids = new char*[nvalues];
+  value2index = new int[nvalues];
+
+  for (int i = 0; i < nvalues; i++) {
+    ids[i] = nullptr;
+    unwrap[i] = 0;
+
+    if (strcmp(earg[i],"x") == 0) {
+      which[i] = ArgInfo::X;
+      argindex[i] = 0;
+    } else if (strcmp(earg[i],"y") == 0) {
+      which[i] = ArgInfo::X;
+      argindex[i] = 1;
+    } else if (strcmp(earg[i],"z") == 0) {
+      which[i] = ArgInfo::X;
+      argindex[i] = 2;
+
+    } else if (strcmp(earg[i],"xu") == 0) {
+      which[i] = ArgInfo::X;
+      argindex[i] = 0;
+      unwrap[i] = 1;
+    } else if (strcmp(earg[i],"yu") == 0) {
+      which[i] = ArgInfo::X;
+      argindex[i] = 1;
+      unwrap[i] = 1;
+    } else if (strcmp(earg[i],"zu") == 0) {
+      which[i] = ArgInfo::X;
+      argindex[i] = 2;
+      unwrap[i] = 1;
+
+    } else if (strcmp(earg[i],"vx") == 0) {
+      which[i] = ArgInfo::V;
+      argindex[i] = 0;
+    } else if (strcmp(earg[i],"vy") == 0) {
+      which[i] = ArgInfo::V;
+      argindex[i] = 1;
+    } else if (strcmp(earg[i],"vz") == 0) {
+      which[i] = ArgInfo::V;
+      argindex[i] = 2;
+
+    } else if (strcmp(earg[i],"fx") == 0) {
+      which[i] = ArgInfo::F;
+      argindex[i] = 0;
+    } else if (strcmp(earg[i],"fy") == 0) {
+      which[i] = ArgInfo::F;
+      argindex[i] = 1;
+    } else if (strcmp(earg[i],"fz") == 0) {
+      which[i] = ArgInfo::F;
+      argindex[i] = 2;
+
+    } else {
+      ArgInfo argi(earg[i]);
+
+      which[i] = argi.get_type();
+      argindex[i] = argi.get_index1();
+      ids[i] = argi.copy_name();
+
+      if ((which[i] == ArgInfo::UNKNOWN) || (which[i] == ArgInfo::NONE)
+        || (argi.get_dim() > 1))
+        error->all(FLERR,"Illegal fix ave/correlate/atom command");
+    }
+  }
+
+  // if wildcard expansion occurred, free earg memory from expand_args()
+
+  if (expand) {
+    for (int i = 0; i < nvalues; i++) delete [] earg[i];
+    memory->sfree(earg);
+  }
+
+  // optional args
+
+  type = AUTO;
+  ave = ONE;
+  specflag = 0;
+
+  while (iarg < narg) {
+    if (strcmp(arg[iarg],"type") == 0) {
+      if (iarg+2 > narg)
+        error->all(FLERR,"Illegal fix ave/correlate/atom command");
+      if (strcmp(arg[iarg+1],"auto") == 0) type = AUTO;
+      else if (strcmp(arg[iarg+1],"msd") == 0) type = MSD;
+      else if (strcmp(arg[iarg+1],"sum") == 0) type = SUM;
+      else error->all(FLERR,"Illegal fix ave/correlate/atom command");
+      iarg += 2;
+    } else if (strcmp(arg[iarg],"ave") == 0) {
+      if (iarg+2 > narg)
+        error->all(FLERR,"Illegal fix ave/correlate/atom command");
+      if (strcmp(arg[iarg+1],"one") == 0) ave = ONE;
+      else if (strcmp(arg[iarg+1],"running") == 0) ave = RUNNING;
+      else error->all(FLERR,"Illegal fix ave/correlate/atom command");
+      iarg += 2;
+    } else if (strcmp(arg[iarg],"spectrum") == 0) {
+      if (iarg+2 > narg)
+        error->all(FLERR,"Illegal fix ave/correlate/atom command");
+      if (strcmp(arg[iarg+1],"no") == 0) specflag = 0;
+      else if (strcmp(arg[iarg+1],"yes") == 0) specflag = 1;
+      else error->all(FLERR,"Illegal fix ave/correlate/atom command");
+      iarg += 2;
+    } else if (strcmp(arg[iarg],"file") == 0) {
+      if (iarg+2 > narg)
+        error->all(FLERR,"Illegal fix ave/correlate/atom command");
+      if (me == 0) {
+        fp = fopen(arg[iarg+1],"w");
+        if (fp == nullptr)
+          error->one(FLERR,fmt::format("Cannot open fix ave/correlate/atom "
+                                       "file {}: {}",arg[iarg+1],
+                                       utils::getsyserror()));
+      }
+      iarg += 2;
+    } else error->all(FLERR,"Illegal fix ave/correlate/atom command");
+  }
+
+  // setup and error check
+  // for fix inputs, check that fix frequency is acceptable
+
+  if (nvalues == 0 || nevery <= 0 || nrepeat <= 1 || nfreq <= 0)
+    error->all(FLERR,"Illegal fix ave/correlate/atom command");
+  if (nfreq % nevery || (bigint) nrepeat*nevery > nfreq)
+    error->all(FLERR,"Illegal fix ave/correlate/atom command");
+  if (specflag && type == MSD)
+    error->all(FLERR,"Fix ave/correlate/atom spectrum requires type auto or sum");
+
+  for (int i = 0; i < nvalues; i++) {
+    if (which[i] == ArgInfo::COMPUTE) {
+      int icompute = modify->find_compute(ids[i]);
+      if (icompute < 0)
+        error->all(FLERR,"Compute ID for fix ave/correlate/atom does not exist");
+      if (modify->compute[icompute]->peratom_flag == 0)
+        error->all(FLERR,"Fix ave/correlate/atom compute does not "
+                   "calculate per-atom values");
+      if (argindex[i] == 0 &&
+          modify->compute[icompute]->size_peratom_cols != 0)
+        error->all(FLERR,"Fix ave/correlate/atom compute does not "
+                   "calculate a per-atom vector");
+      if (argindex[i] && modify->compute[icompute]->size_peratom_cols == 0)
+        error->all(FLERR,"Fix ave/correlate/atom compute does not "
+                   "calculate a per-atom array");
+      if (argindex[i] &&
+          argindex[i] > modify->compute[icompute]->size_peratom_cols)
+        error->all(FLERR,"Fix ave/correlate/atom compute array is "
+                   "accessed out-of-range");
+
+    } else if (which[i] == ArgInfo::FIX) {
+      int ifix = modify->find_fix(ids[i]);
+      if (ifix < 0)
+        error->all(FLERR,"Fix ID for fix ave/correlate/atom does not exist");
+      if (modify->fix[ifix]->peratom_flag == 0)
+        error->all(FLERR,"Fix ave/correlate/atom fix does not "
+                   "calculate per-atom values");
+      if (argindex[i] == 0 && modify->fix[ifix]->size_peratom_cols != 0)
+        error->all(FLERR,"Fix ave/correlate/atom fix does not "
+                   "calculate a per-atom vector");
+      if (argindex[i] && modify->fix[ifix]->size_peratom_cols == 0)
+        error->all(FLERR,"Fix ave/correlate/atom fix does not "
+                   "calculate a per-atom array");
+      if (argindex[i] && argindex[i] > modify->fix[ifix]->size_peratom_cols)
+        error->all(FLERR,"Fix ave/correlate/atom fix array is "
+                   "accessed out-of-range");
+      if (nevery % modify->fix[ifix]->peratom_freq)
+        error->all(FLERR,"Fix for fix ave/correlate/atom not "
+                   "computed at compatible time");
+
+    } else if (which[i] == ArgInfo::VARIABLE) {
+      int ivariable = input->variable->find(ids[i]);
+      if (ivariable < 0)
+        error->all(FLERR,"Variable name for fix ave/correlate/atom "
+                   "does not exist");
+      if (input->variable->atomstyle(ivariable) == 0)
+        error->all(FLERR,"Fix ave/correlate/atom variable is not "
+                   "atom-style variable");
+    }
+  }
+
+  // print file comment lines
+
+  if (fp && me == 0) {
+    clearerr(fp);
+    fprintf(fp,"# Time-correlated per-atom data for fix %s\n",id);
+    fprintf(fp,"# Timestep Number-of-rows\n");
+    fprintf(fp,"# Index TimeDelta");
+    for (int i = 0; i < nvalues; i++) fprintf(fp," C%d",i+1);
+    if (specflag) {
+      fprintf(fp," Frequency");
+      for (int i = 0; i < nvalues; i++) fprintf(fp," S%d",i+1);
+    }
+    fprintf(fp,"\n");
+    if (ferror(fp))
+      error->one(FLERR,"Error writing file header");
+  }
+
+  // this fix produces a global array
+  // columns = time delta, correlations, optional frequency and spectra
+
+  array_flag = 1;
+  size_array_rows = nrepeat;
+  size_array_cols = 1 + nvalues;
+  if (specflag) size_array_cols += 1 + nvalues;
+  extarray = 0;
+
+  // type sum only needs the latest per-atom sample, its group sums
+  //   are stored for the whole window
+
+  if (type == SUM) {
+    nstore = 1;
+    memory->create(sums,nrepeat,nvalues,"ave/correlate/atom:sums");
+  } else nstore = nrepeat;
+
+  memory->create(corr,nrepeat,nvalues,"ave/correlate/atom:corr");
+  memory->create(corrall,nrepeat,nvalues,"ave/correlate/atom:corrall");
+  memory->create(accum,nrepeat,nvalues,"ave/correlate/atom:accum");
+  if (specflag) memory->create(spec,nrepeat,nvalues,"ave/correlate/atom:spec");
+
+  nwindow = 0;
+  for (int i = 0; i < nrepeat; i++)
+    for (int m = 0; m < nvalues; m++) accum[i][m] = 0.0;
+
+  // 1d FFTs on each proc
+  // correlation FFTs are zero padded to 2*nrepeat to avoid wrap-around,
+  // spectra are FFTs of the even extension of the correlation
+
+  int tmp;
+  nfft = 2*nrepeat;
+  fft = new FFT3d(lmp,MPI_COMM_SELF,nfft,1,1,0,nfft-1,0,0,0,0,
+                  0,nfft-1,0,0,0,0,0,0,&tmp,0);
+  nspec = 2*(nrepeat-1);
+  if (specflag)
+    fftspec = new FFT3d(lmp,MPI_COMM_SELF,nspec,1,1,0,nspec-1,0,0,0,0,
+                        0,nspec-1,0,0,0,0,0,0,&tmp,0);
+  memory->create(work,2*nfft,"ave/correlate/atom:work");
+
+  // perform initial allocation of atom-based array
+  // register with Atom class
+  // all stored samples of an atom migrate with it
+
+  grow_arrays(atom->nmax);
+  atom->add_callback(Atom::GROW);
+  maxexchange = nstore*nvalues;
+
+  // nvalid = next step on which end_of_step does something
+  // add nvalid to all computes that store invocation times
+  // since don't know a priori which are invoked by this fix
+  // once in end_of_step() can set timestep for ones actually invoked
+
+  irepeat = 0;
+  nvalid_last = -1;
+  nvalid = nextvalid();
+  modify->addstep_compute_all(nvalid);
+}
+
+/* ---------------------------------------------------------------------- */
+
+FixAveCorrelateAtom::~FixAveCorrelateAtom()
+{
+  // unregister callback to this fix from Atom class
+
+  atom->delete_callback(id,Atom::GROW);
+
+  delete [] which;
+  delete [] argindex;
+  delete [] unwrap;
+  for (int m = 0; m < nvalues; m++) delete [] ids[m];
+  delete [] ids;
+  delete [] value2index;
+
+  memory->destroy(samples);
+  memory->destroy(sums);
+  memory->destroy(corr);
+  memory->destroy(corrall);
+  memory->destroy(accum);
+  memory->destroy(spec);
+  memory->destroy(work);
+  delete fft;
+  delete fftspec;
+
+  if (fp && me == 0) fclose(fp);
+}
+
+/* ---------------------------------------------------------------------- */
+
+int FixAveCorrelateAtom::setmask()
+{
+  int mask = 0;
+  mask |= END_OF_STEP;
+  return mask;
+}
+
+/* ---------------------------------------------------------------------- */
+
+void FixAveCorrelateAtom::init()
+{
+  // set indices and check validity of all computes,fixes,variables
+
+  for (int m = 0; m < nvalues; m++) {
+    if (which[m] == ArgInfo::COMPUTE) {
+      int icompute = modify->find_compute(ids[m]);
+      if (icompute < 0)
+        error->all(FLERR,"Compute ID for fix ave/correlate/atom does not exist");
+      value2index[m] = icompute;
+
+    } else if (which[m] == ArgInfo::FIX) {
+      int ifix = modify->find_fix(ids[m]);
+      if (ifix < 0)
+        error->all(FLERR,"Fix ID for fix ave/correlate/atom does not exist");
+      value2index[m] = ifix;
+
+    } else if (which[m] == ArgInfo::VARIABLE) {
+      int ivariable = input->variable->find(ids[m]);
+      if (ivariable < 0)
+        error->all(FLERR,"Variable name for fix ave/correlate/atom "
+                   "does not exist");
+      value2index[m] = ivariable;
+
+    } else value2index[m] = -1;
+  }
+
+  // need to reset nvalid if nvalid < ntimestep b/c minimize was performed
+
+  if (nvalid < update->ntimestep) {
+    irepeat = 0;
+    nvalid = nextvalid();
+    modify->addstep_compute_all(nvalid);
+  }
+}
+
+/* ----------------------------------------------------------------------
+   only does something if nvalid = current timestep
+------------------------------------------------------------------------- */
+
+void FixAveCorrelateAtom::setup(int /*vflag*/)
+{
+  end_of_step();
+}
+
+/* ---------------------------------------------------------------------- */
+
+void FixAveCorrelateAtom::end_of_step()
+{
+  int i,j,m,n;
+
+  // skip if not step which requires doing something
+  // error check if timestep was reset in an invalid manner
+
+  bigint ntimestep = update->ntimestep;
+  if (ntimestep < nvalid_last || ntimestep > nvalid)
+    error->all(FLERR,"Invalid timestep reset for fix ave/correlate/atom");
+  if (ntimestep != nvalid) return;
+  nvalid_last = nvalid;
+
+  // store results of attributes,computes,fixes,variables in sample slot
+  // compute/fix/variable may invoke computes so wrap with clear/add
+
+  modify->clearstep_compute();
+
+  int nlocal = atom->nlocal;
+  int *mask = atom->mask;
+  int stride = nstore*nvalues;
+  int offset = (type == SUM) ? 0 : irepeat*nvalues;
+
+  for (m = 0; m < nvalues; m++) {
+    n = value2index[m];
+    j = argindex[m];
+    int k = offset + m;
+
+    if (which[m] == ArgInfo::X) {
+      double **x = atom->x;
+      if (unwrap[m]) {
+        imageint *image = atom->image;
+        double xu[3];
+        for (i = 0; i < nlocal; i++)
+          if (mask[i] & groupbit) {
+            domain->unmap(x[i],image[i],xu);
+            samples[i][k] = xu[j];
+          } else samples[i][k] = 0.0;
+      } else {
+        for (i = 0; i < nlocal; i++)
+          if (mask[i] & groupbit) samples[i][k] = x[i][j];
+          else samples[i][k] = 0.0;
+      }
+
+    } else if (which[m] == ArgInfo::V) {
+      double **v = atom->v;
+      for (i = 0; i < nlocal; i++)
+        if (mask[i] & groupbit) samples[i][k] = v[i][j];
+        else samples[i][k] = 0.0;
+
+    } else if (which[m] == ArgInfo::F) {
+      double **f = atom->f;
+      for (i = 0; i < nlocal; i++)
+        if (mask[i] & groupbit) samples[i][k] = f[i][j];
+        else samples[i][k] = 0.0;
+
+    // invoke compute if not previously invoked
+
+    } else if (which[m] == ArgInfo::COMPUTE) {
+      Compute *compute = modify->compute[n];
+      if (!(compute->invoked_flag & Compute::INVOKED_PERATOM)) {
+        compute->compute_peratom();
+        compute->invoked_flag |= Compute::INVOKED_PERATOM;
+      }
+
+      if (j == 0) {
+        double *compute_vector = compute->vector_atom;
+        for (i = 0; i < nlocal; i++)
+          if (mask[i] & groupbit) samples[i][k] = compute_vector[i];
+          else samples[i][k] = 0.0;
+      } else {
+        int jm1 = j - 1;
+        double **compute_array = compute->array_atom;
+        for (i = 0; i < nlocal; i++)
+          if (mask[i] & groupbit) samples[i][k] = compute_array[i][jm1];
+          else samples[i][k] = 0.0;
+      }
+
+    // access fix fields, guaranteed to be ready
+
+    } else if (which[m] == ArgInfo::FIX) {
+      if (j == 0) {
+        double *fix_vector = modify->fix[n]->vector_atom;
+        for (i = 0; i < nlocal; i++)
+          if (mask[i] & groupbit) samples[i][k] = fix_vector[i];
+          else samples[i][k] = 0.0;
+      } else {
+        int jm1 = j - 1;
+        double **fix_array = modify->fix[n]->array_atom;
+        for (i = 0; i < nlocal; i++)
+          if (mask[i] & groupbit) samples[i][k] = fix_array[i][jm1];
+          else samples[i][k] = 0.0;
+      }
+
+    // evaluate atom-style variable
+    // final argument = 0 stores result in sample slot
+
+    } else if (which[m] == ArgInfo::VARIABLE) {
+      if (samples)
+        input->variable->compute_atom(n,igroup,&samples[0][k],stride,0);
+      else input->variable->compute_atom(n,igroup,nullptr,stride,0);
+    }
+  }
+
+  // type sum: store group sums of this sample
+
+  if (type == SUM) {
+    double *one = corr[0];
+    for (m = 0; m < nvalues; m++) one[m] = 0.0;
+    for (i = 0; i < nlocal; i++)
+      if (mask[i] & groupbit)
+        for (m = 0; m < nvalues; m++) one[m] += samples[i][m];
+    MPI_Allreduce(one,sums[irepeat],nvalues,MPI_DOUBLE,MPI_SUM,world);
+  }
+
+  // done if irepeat < nrepeat
+  // else reset irepeat and nvalid
+
+  irepeat++;
+  if (irepeat < nrepeat) {
+    nvalid += nevery;
+    modify->addstep_compute(nvalid);
+    return;
+  }
+
+  irepeat = 0;
+  nvalid = ntimestep+nfreq - ((bigint)nrepeat-1)*nevery;
+  modify->addstep_compute(nvalid);
+
+  // correlate the samples of this window and average over windows
+
+  correlate();
+
+  if (ave == ONE) nwindow = 0;
+  for (i = 0; i < nrepeat; i++)
+    for (m = 0; m < nvalues; m++) {
+      if (nwindow) accum[i][m] += corrall[i][m];
+      else accum[i][m] = corrall[i][m];
+    }
+  nwindow++;
+
+  if (specflag) spectrum();
+
+  // output result to file
+
+  if (fp && me == 0) {
+    clearerr(fp);
+    fprintf(fp,BIGINT_FORMAT " %d\n",ntimestep,nrepeat);
+    for (i = 0; i < nrepeat; i++) {
+      fprintf(fp,"%d %d",i+1,i*nevery);
+      for (m = 0; m < nvalues; m++) fprintf(fp," %g",accum[i][m]/nwindow);
+      if (specflag) {
+        fprintf(fp," %g",compute_array(i,nvalues+1));
+        for (m = 0; m < nvalues; m++) fprintf(fp," %g",spec[i][m]);
+      }
+      fprintf(fp,"\n");
+    }
+    if (ferror(fp))
+      error->one(FLERR,"Error writing out correlation data");
+    fflush(fp);
+  }
+}
+
+/* ----------------------------------------------------------------------
+   correlate samples of the current window over all time origins
+   result in corrall is averaged over origins and atoms in group
+   per-atom series are processed in pairs, one FFT per pair
+------------------------------------------------------------------------- */
+
+void FixAveCorrelateAtom::correlate()
+{
+  int i,m,n;
+
+  double *sa = new double[nrepeat];
+  double *sb = new double[nrepeat];
+
+  // type sum: correlate group sums, identical on all procs
+
+  if (type == SUM) {
+    for (m = 0; m < nvalues; m += 2) {
+      if (m+1 < nvalues) autocorrelate(nvalues,&sums[0][m],&sums[0][m+1],sa,sb);
+      else autocorrelate(nvalues,&sums[0][m],nullptr,sa,sb);
+      for (n = 0; n < nrepeat; n++) {
+        corrall[n][m] = sa[n]/(nrepeat-n);
+        if (m+1 < nvalues) corrall[n][m+1] = sb[n]/(nrepeat-n);
+      }
+    }
+    delete [] sa;
+    delete [] sb;
+    return;
+  }
+
+  // sum correlations of my atoms into corr
+
+  for (i = 0; i < nrepeat; i++)
+    for (m = 0; m < nvalues; m++) corr[i][m] = 0.0;
+
+  int nlocal = atom->nlocal;
+  int *mask = atom->mask;
+  double *pending = nullptr;
+  int mpending = 0;
+  bigint mycount = 0;
+
+  for (i = 0; i < nlocal; i++) {
+    if (!(mask[i] & groupbit)) continue;
+    mycount++;
+    for (m = 0; m < nvalues; m++) {
+      if (!pending) {
+        pending = &samples[i][m];
+        mpending = m;
+        continue;
+      }
+      autocorrelate(nvalues,pending,&samples[i][m],sa,sb);
+      accumulate(mpending,nvalues,pending,sa);
+      accumulate(m,nvalues,&samples[i][m],sb);
+      pending = nullptr;
+    }
+  }
+  if (pending) {
+    autocorrelate(nvalues,pending,nullptr,sa,sb);
+    accumulate(mpending,nvalues,pending,sa);
+  }
+
+  delete [] sa;
+  delete [] sb;
+
+  // average over all atoms in group
+
+  bigint count;
+  MPI_Allreduce(&mycount,&count,1,MPI_LMP_BIGINT,MPI_SUM,world);
+  MPI_Allreduce(&corr[0][0],&corrall[0][0],nrepeat*nvalues,
+                MPI_DOUBLE,MPI_SUM,world);
+  if (count)
+    for (i = 0; i < nrepeat; i++)
+      for (m = 0; m < nvalues; m++) corrall[i][m] /= count;
+}
+
+/* ----------------------------------------------------------------------
+   sums over time origins of products of series A and B at all lags
+   A,B = nrepeat samples with given stride, B may be null
+   SA,SB = Sum_t A(t)*A(t+lag) and same for B, for lag = 0 to nrepeat-1
+   Wiener-Khinchin: A and B are the real and imaginary part of one
+     zero-padded FFT, their power spectra are separated via Z(k) and Z(-k)
+------------------------------------------------------------------------- */
+
+void FixAveCorrelateAtom::autocorrelate(int stride, double *a, double *b,
+                                        double *sa, double *sb)
+{
+  int k,kc;
+
+  for (k = 0; k < nrepeat; k++) {
+    work[2*k] = a[k*stride];
+    work[2*k+1] = b ? b[k*stride] : 0.0;
+  }
+  for (k = nrepeat; k < nfft; k++) work[2*k] = work[2*k+1] = 0.0;
+
+  fft->compute(work,work,FFT3d::FORWARD);
+
+  // |A(k)|^2 = |Z(k) + Z*(-k)|^2/4 and |B(k)|^2 = |Z(k) - Z*(-k)|^2/4
+  // both are even in k and real, so A and B correlations come back as
+  //   real and imaginary part of one backward FFT
+
+  double re,im,rec,imc,pa,pb;
+
+  for (k = 0; k <= nfft/2; k++) {
+    kc = (nfft-k) % nfft;
+    re = work[2*k];
+    im = work[2*k+1];
+    rec = work[2*kc];
+    imc = work[2*kc+1];
+    pa = 0.25*((re+rec)*(re+rec) + (im-imc)*(im-imc));
+    pb = 0.25*((re-rec)*(re-rec) + (im+imc)*(im+imc));
+    work[2*k] = work[2*kc] = pa;
+    work[2*k+1] = work[2*kc+1] = pb;
+  }
+
+  fft->compute(work,work,FFT3d::BACKWARD);
+
+  double norm = 1.0/nfft;
+  for (k = 0; k < nrepeat; k++) {
+    sa[k] = norm*work[2*k];
+    sb[k] = norm*work[2*k+1];
+  }
+}
+
+/* ----------------------------------------------------------------------
+   add origin average of one series A of value M to corr
+   S = sums over origins of A(t)*A(t+lag)
+   type msd: <(A(t+lag)-A(t))^2> = S1(lag) - 2*S(lag)/(N-lag),
+     with S1 = average of A(t)^2 + A(t+lag)^2 built up from both ends
+------------------------------------------------------------------------- */
+
+void FixAveCorrelateAtom::accumulate(int m, int stride, double *a, double *s)
+{
+  int k;
+
+  if (type == AUTO) {
+    for (k = 0; k < nrepeat; k++) corr[k][m] += s[k]/(nrepeat-k);
+    return;
+  }
+
+  double q = 0.0;
+  for (k = 0; k < nrepeat; k++) q += a[k*stride]*a[k*stride];
+  q *= 2.0;
+
+  double d0,d1;
+  for (k = 0; k < nrepeat; k++) {
+    if (k) {
+      d0 = a[(k-1)*stride];
+      d1 = a[(nrepeat-k)*stride];
+      q -= d0*d0 + d1*d1;
+    }
+    corr[k][m] += (q - 2.0*s[k])/(nrepeat-k);
+  }
+}
+
+/* ----------------------------------------------------------------------
+   spectrum of averaged correlation C(lag) = cosine transform via FFT
+     of its even extension of length 2*(nrepeat-1)
+   S(k) = dt*Nevery * (C(0) + 2 Sum_lag C(lag) cos(pi k lag/(nrepeat-1))
+     + C(nrepeat-1) (-1)^k), pairs of values share one FFT
+------------------------------------------------------------------------- */
+
+void FixAveCorrelateAtom::spectrum()
+{
+  int k,m;
+  double ca,cb;
+  double scale = nevery*update->dt/nwindow;
+
+  for (m = 0; m < nvalues; m += 2) {
+    for (k = 0; k < nspec; k++) {
+      int lag = (k < nrepeat) ? k : nspec-k;
+      work[2*k] = accum[lag][m];
+      work[2*k+1] = (m+1 < nvalues) ? accum[lag][m+1] : 0.0;
+    }
+
+    fftspec->compute(work,work,FFT3d::FORWARD);
+
+    for (k = 0; k < nrepeat; k++) {
+      ca = work[2*k];
+      cb = work[2*k+1];
+      spec[k][m] = scale*ca;
+      if (m+1 < nvalues) spec[k][m+1] = scale*cb;
+    }
+  }
+}
+
+/* ----------------------------------------------------------------------
+   return I,J array value
+   columns = time delta, correlations, frequency, spectra
+------------------------------------------------------------------------- */
+
+double FixAveCorrelateAtom::compute_array(int i, int j)
+{
+  if (j == 0) return 1.0*i*nevery;
+  if (j <= nvalues) {
+    if (nwindow) return accum[i][j-1]/nwindow;
+    return 0.0;
+  }
+  if (j == nvalues+1) return i/(nspec*nevery*update->dt);
+  if (nwindow) return spec[i][j-nvalues-2];
+  return 0.0;
+}
+
+/* ----------------------------------------------------------------------
+   memory usage of local atom-based array and FFT data
+------------------------------------------------------------------------- */
+
+double FixAveCorrelateAtom::memory_usage()
+{
+  double bytes;
+  bytes = (double)atom->nmax*nstore*nvalues * sizeof(double);
+  bytes += (double)4*nrepeat*nvalues * sizeof(double);
+  if (type == SUM) bytes += (double)nrepeat*nvalues * sizeof(double);
+  if (specflag) bytes += (double)nrepeat*nvalues * sizeof(double);
+  bytes += (double)2*nfft * sizeof(FFT_SCALAR);
+  return bytes;
+}
+
+/* ----------------------------------------------------------------------
+   allocate atom-based array
+------------------------------------------------------------------------- */
+
+void FixAveCorrelateAtom::grow_arrays(int nmax)
+{
+  memory->grow(samples,nmax,nstore*nvalues,"ave/correlate/atom:samples");
+}
+
+/* ----------------------------------------------------------------------
+   copy values within local atom-based array
+------------------------------------------------------------------------- */
+
+void FixAveCorrelateAtom::copy_arrays(int i, int j, int /*delflag*/)
+{
+  int n = nstore*nvalues;
+  for (int m = 0; m < n; m++)
+    samples[j][m] = samples[i][m];
+}
+
+/* ----------------------------------------------------------------------
+   pack values in local atom-based array for exchange with another proc
+------------------------------------------------------------------------- */
+
+int FixAveCorrelateAtom::pack_exchange(int i, double *buf)
+{
+  int n = nstore*nvalues;
+  for (int m = 0; m < n; m++) buf[m] = samples[i][m];
+  return n;
+}
+
+/* ----------------------------------------------------------------------
+   unpack values in local atom-based array from exchange with another proc
+------------------------------------------------------------------------- */
+
+int FixAveCorrelateAtom::unpack_exchange(int nlocal, double *buf)
+{
+  int n = nstore*nvalues;
+  for (int m = 0; m < n; m++) samples[nlocal][m] = buf[m];
+  return n;
+}
+
+/* ----------------------------------------------------------------------
+   calculate nvalid = next step on which end_of_step does something
+   can be this timestep if multiple of nfreq and nrepeat = 1
+   else backup from next multiple of nfreq
+------------------------------------------------------------------------- */
+
+bigint FixAveCorrelateAtom::nextvalid()
+{
+  bigint nvalid = (update->ntimestep/nfreq)*nfreq + nfreq;
+  nvalid -= ((bigint)nrepeat-1)*nevery;
+  if (nvalid < update->ntimestep) nvalid += nfreq;
+  return nvalid;
+}
@@ -0,0 +1,159 @@
+/* -*- c++ -*- ----------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://lammps.sandia.gov/, Sandia National Laboratories
+   Steve Plimpton, sjplimp@sandia.gov
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#ifdef FIX_CLASS
+
+FixStyle(ave/correlate/atom,FixAveCorrelateAtom)
+
+#else
+
+#ifndef LMP_FIX_AVE_CORRELATE_ATOM_H
+#define LMP_FIX_AVE_CORRELATE_ATOM_H
+
+#include "fix.h"
+
+#ifdef FFT_SINGLE
+typedef float FFT_SCALAR;
+#else
+typedef double FFT_SCALAR;
+#endif
+
+namespace LAMMPS_NS {
+
+class FixAveCorrelateAtom : public Fix {
+ public:
+  FixAveCorrelateAtom(class LAMMPS *, int, char **);
+  ~FixAveCorrelateAtom();
+  int setmask();
+  void init();
+  void setup(int);
+  void end_of_step();
+  double compute_array(int, int);
+
+  double memory_usage();
+  void grow_arrays(int);
+  void copy_arrays(int, int, int);
+  int pack_exchange(int, double *);
+  int unpack_exchange(int, double *);
+
+ private:
+  int me,nvalues;
+  int nrepeat,nfreq,irepeat;
+  bigint nvalid,nvalid_last;
+  int *which,*argindex,*unwrap,*value2index;
+  char **ids;
+  FILE *fp;
+
+  int type,ave,specflag;
+  int nstore;            // # of samples stored per atom
+  double **samples;      // per-atom samples of current window
+  double **sums;         // group sums of samples of current window, type sum
+
+  int nwindow;           // # of windows in running average
+  double **corr;         // correlation of current window, my atoms
+  double **corrall;      // correlation of current window, all atoms
+  double **accum;        // sum of correlation of all windows
+  double **spec;         // spectrum of averaged correlation
+
+  int nfft,nspec;        // lengths of correlation and spectrum FFTs
+  class FFT3d *fft,*fftspec;
+  FFT_SCALAR *work;
+
+  void correlate();
+  void autocorrelate(int, double *, double *, double *, double *);
+  void accumulate(int, int, double *, double *);
+  void spectrum();
+  bigint nextvalid();
+};
+
+}
+
+#endif
+#endif
+
+/* ERROR/WARNING messages:
+
+E: Illegal ... command
+
+Self-explanatory.  Check the input script syntax and compare to the
+documentation for the command.  You can use -echo screen as a
+command-line option when running LAMMPS to see the offending line.
+
+E: Compute ID for fix ave/correlate/atom does not exist
+
+Self-explanatory.
+
+E: Fix ave/correlate/atom compute does not calculate per-atom values
+
+A compute used by fix ave/correlate/atom must generate per-atom values.
+
+E: Fix ave/correlate/atom compute does not calculate a per-atom vector
+
+A compute used by fix ave/correlate/atom must generate per-atom values.
+
+E: Fix ave/correlate/atom compute does not calculate a per-atom array
+
+Self-explanatory.
+
+E: Fix ave/correlate/atom compute array is accessed out-of-range
+
+Self-explanatory.
+
+E: Fix ID for fix ave/correlate/atom does not exist
+
+Self-explanatory.
+
+E: Fix ave/correlate/atom fix does not calculate per-atom values
+
+A fix used by fix ave/correlate/atom must generate per-atom values.
+
+E: Fix ave/correlate/atom fix does not calculate a per-atom vector
+
+A fix used by fix ave/correlate/atom must generate per-atom values.
+
+E: Fix ave/correlate/atom fix does not calculate a per-atom array
+
+Self-explanatory.
+
+E: Fix ave/correlate/atom fix array is accessed out-of-range
+
+Self-explanatory.
+
+E: Fix for fix ave/correlate/atom not computed at compatible time
+
+Fixes generate their values on specific timesteps.  Fix
+ave/correlate/atom is requesting a value on a non-allowed timestep.
+
+E: Variable name for fix ave/correlate/atom does not exist
+
+Self-explanatory.
+
+E: Fix ave/correlate/atom variable is not atom-style variable
+
+A variable used by fix ave/correlate/atom must generate per-atom values.
+
+E: Fix ave/correlate/atom spectrum requires type auto or sum
+
+A spectrum of a mean-squared displacement is not defined.
+
+E: Cannot open fix ave/correlate/atom file %s
+
+The specified file cannot be opened.  Check that the path and name are
+correct.
+
+E: Invalid timestep reset for fix ave/correlate/atom
+
+Resetting the timestep has invalidated the sequence of timesteps this
+fix needs to process.
+
+*/
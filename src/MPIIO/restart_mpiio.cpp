@@ -18,6 +18,9 @@
 #include "restart_mpiio.h"
 
 #include "error.h"
+#include "memory.h"
+
+#include <vector>
 
 using namespace LAMMPS_NS;
 
@@ -34,10 +37,33 @@ using namespace LAMMPS_NS;
 RestartMPIIO::RestartMPIIO(LAMMPS *lmp) : Pointers(lmp)
 {
   mpiio_exists = 1;
+  mpiinfo = MPI_INFO_NULL;
   MPI_Comm_size(world,&nprocs);
   MPI_Comm_rank(world,&myrank);
 }
 
+/* ---------------------------------------------------------------------- */
+
+RestartMPIIO::~RestartMPIIO()
+{
+  if (mpiinfo != MPI_INFO_NULL) MPI_Info_free(&mpiinfo);
+}
+
+/* ----------------------------------------------------------------------
+   request collective buffering with N aggregator procs
+   the hints are used by ROMIO and ignored by MPI-IO implementations
+     that do not know them
+------------------------------------------------------------------------- */
+
+void RestartMPIIO::set_aggregators(int n)
+{
+  if (mpiinfo == MPI_INFO_NULL) MPI_Info_create(&mpiinfo);
+  std::string cb_nodes = std::to_string(n);
+  MPI_Info_set(mpiinfo,(char *) "cb_nodes",(char *) cb_nodes.c_str());
+  MPI_Info_set(mpiinfo,(char *) "romio_cb_write",(char *) "enable");
+  MPI_Info_set(mpiinfo,(char *) "romio_cb_read",(char *) "enable");
+}
+
 /* ----------------------------------------------------------------------
    calls MPI_File_open in read-only mode, read_restart should call this
    for some file servers it is most efficient to only read or only write
@@ -46,7 +72,7 @@ RestartMPIIO::RestartMPIIO(LAMMPS *lmp) : Pointers(lmp)
 void RestartMPIIO::openForRead(const char *filename)
 {
   int err = MPI_File_open(world, ROMIO_COMPAT_CAST filename, MPI_MODE_RDONLY,
-                          MPI_INFO_NULL, &mpifh);
+                          mpiinfo, &mpifh);
   if (err != MPI_SUCCESS) {
     char str[MPI_MAX_ERROR_STRING+128];
     char mpiErrorString[MPI_MAX_ERROR_STRING];
@@ -66,7 +92,7 @@ void RestartMPIIO::openForRead(const char *filename)
 void RestartMPIIO::openForWrite(const char *filename)
 {
   int err = MPI_File_open(world, ROMIO_COMPAT_CAST filename, MPI_MODE_WRONLY,
-                          MPI_INFO_NULL, &mpifh);
+                          mpiinfo, &mpifh);
   if (err != MPI_SUCCESS) {
     char str[MPI_MAX_ERROR_STRING+128];
     char mpiErrorString[MPI_MAX_ERROR_STRING];
@@ -84,9 +110,11 @@ void RestartMPIIO::openForWrite(const char *filename)
    compute the file size based off the MPI_Scan send size value on the last rank
    set the filesize with ftruncate via MPI_File_set_size
    write the data via collective MPI-IO by calling MPI_File_write_at_all
+   if segsize > 0, append checksums of all segments of segsize doubles
 ------------------------------------------------------------------------- */
 
-void RestartMPIIO::write(MPI_Offset headerOffset, int send_size, double *buf)
+void RestartMPIIO::write(MPI_Offset headerOffset, int send_size, double *buf,
+                         bigint segsize)
 {
   bigint incPrefix = 0;
   bigint bigintSendSize = (bigint) send_size;
@@ -95,8 +123,14 @@ void RestartMPIIO::write(MPI_Offset headerOffset, int send_size, double *buf)
   bigint largestIncPrefix = incPrefix;
   MPI_Bcast(&largestIncPrefix, 1, MPI_LMP_BIGINT, (nprocs-1), world);
 
+  bigint nseg = 0;
+  if (segsize > 0) nseg = (largestIncPrefix + segsize-1) / segsize;
+  MPI_Offset trailerSize = 0;
+  if (segsize > 0) trailerSize = 2*sizeof(bigint) + 2*nseg*sizeof(uint64_t);
+
   int err = MPI_File_set_size(mpifh,
-                              (headerOffset+(largestIncPrefix*sizeof(double))));
+                              (headerOffset+(largestIncPrefix*sizeof(double))) +
+                              trailerSize);
   if (err != MPI_SUCCESS) {
     char str[MPI_MAX_ERROR_STRING+128];
     char mpiErrorString[MPI_MAX_ERROR_STRING];
@@ -119,6 +153,68 @@ void RestartMPIIO::write(MPI_Offset headerOffset, int send_size, double *buf)
             mpiErrorString);
     error->one(FLERR,str);
   }
+
+  if (segsize <= 0) return;
+
+  // checksums are combined from the contributions of all procs
+  // proc 0 writes them after the per-atom data
+
+  std::vector<uint64_t> mysums(2*nseg,0),sums(2*nseg,0);
+  checksum(incPrefix-bigintSendSize,bigintSendSize,buf,segsize,nseg,
+           mysums.data());
+  MPI_Reduce(mysums.data(),sums.data(),2*nseg,MPI_UINT64_T,MPI_SUM,0,world);
+
+  if (myrank == 0) {
+    MPI_Offset offset = headerOffset + largestIncPrefix*sizeof(double);
+    bigint trailer[2] = {nseg,segsize};
+    err = MPI_File_write_at(mpifh,offset,trailer,2,MPI_LMP_BIGINT,
+                            MPI_STATUS_IGNORE);
+    if (err == MPI_SUCCESS)
+      err = MPI_File_write_at(mpifh,offset+2*sizeof(bigint),sums.data(),
+                              2*nseg,MPI_UINT64_T,MPI_STATUS_IGNORE);
+    if (err != MPI_SUCCESS) {
+      char str[MPI_MAX_ERROR_STRING+128];
+      char mpiErrorString[MPI_MAX_ERROR_STRING];
+      int mpiErrorStringLength;
+      MPI_Error_string(err, mpiErrorString, &mpiErrorStringLength);
+      sprintf(str,"Cannot write to restart file - MPI error: %s",
+              mpiErrorString);
+      error->one(FLERR,str);
+    }
+  }
+}
+
+/* ----------------------------------------------------------------------
+   add checksums of N doubles in buf, which start at global index first,
+     to the two sums of each segment of segsize doubles
+   sum1 = sum of 64-bit words, sum2 = sum of words weighted by their
+     1-based position in the segment, all modulo 2^64
+   since only sums are used, the contributions of different procs can
+     be added up, so that the result is independent of the # of procs
+------------------------------------------------------------------------- */
+
+void RestartMPIIO::checksum(bigint first, bigint n, double *buf,
+                            bigint segsize, bigint nseg, uint64_t *sums)
+{
+  const uint64_t *words = (const uint64_t *) buf;
+  bigint i = 0;
+  while (i < n) {
+    bigint global = first + i;
+    bigint iseg = global / segsize;
+    if (iseg >= nseg) break;
+    bigint pos = global - iseg*segsize;
+    bigint nlocal = MIN(segsize - pos, n - i);
+
+    uint64_t sum1 = 0, sum2 = 0;
+    uint64_t weight = pos + 1;
+    for (bigint k = 0; k < nlocal; k++, weight++) {
+      sum1 += words[i+k];
+      sum2 += weight * words[i+k];
+    }
+    sums[2*iseg] += sum1;
+    sums[2*iseg+1] += sum2;
+    i += nlocal;
+  }
 }
 
 /* ----------------------------------------------------------------------
@@ -180,6 +276,42 @@ void RestartMPIIO::read(MPI_Offset chunkOffset, bigint chunkSize, double *buf)
   }
 }
 
+/* ----------------------------------------------------------------------
+   compare checksums after all procs read their chunk of per-atom data
+   total = # of doubles of per-atom data in file
+   chunkOffset/chunkSize = byte offset and # of doubles read by this proc
+   all procs read the checksums, no proc needs to read data of others
+------------------------------------------------------------------------- */
+
+void RestartMPIIO::verify(MPI_Offset headerOffset, bigint total,
+                          MPI_Offset chunkOffset, bigint chunkSize,
+                          double *buf, bigint segsize)
+{
+  MPI_Offset offset = headerOffset + total*sizeof(double);
+  bigint trailer[2];
+  int err = MPI_File_read_at_all(mpifh,offset,trailer,2,MPI_LMP_BIGINT,
+                                 MPI_STATUS_IGNORE);
+  bigint nseg = trailer[0];
+  if (err != MPI_SUCCESS || trailer[1] != segsize ||
+      nseg != (total + segsize-1) / segsize)
+    error->all(FLERR,"Incomplete or corrupted LAMMPS restart file");
+
+  std::vector<uint64_t> stored(2*nseg),mysums(2*nseg,0),sums(2*nseg);
+  err = MPI_File_read_at_all(mpifh,offset+2*sizeof(bigint),stored.data(),
+                             2*nseg,MPI_UINT64_T,MPI_STATUS_IGNORE);
+  if (err != MPI_SUCCESS)
+    error->all(FLERR,"Incomplete or corrupted LAMMPS restart file");
+
+  checksum(chunkOffset/sizeof(double),chunkSize,buf,segsize,nseg,
+           mysums.data());
+  MPI_Allreduce(mysums.data(),sums.data(),2*nseg,MPI_UINT64_T,MPI_SUM,world);
+
+  for (bigint iseg = 0; iseg < nseg; iseg++)
+    if (sums[2*iseg] != stored[2*iseg] || sums[2*iseg+1] != stored[2*iseg+1])
+      error->all(FLERR,fmt::format("Restart file checksum mismatch in "
+                                   "data block {} of {}",iseg+1,nseg));
+}
+
 /* ----------------------------------------------------------------------
    calls MPI_File_close
 ------------------------------------------------------------------------- */
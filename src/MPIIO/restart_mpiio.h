@@ -21,17 +21,22 @@ namespace LAMMPS_NS {
 class RestartMPIIO  : protected Pointers {
  private:
    MPI_File mpifh;
+   MPI_Info mpiinfo;
    int nprocs, myrank;
 
+   void checksum(bigint, bigint, double *, bigint, bigint, uint64_t *);
+
  public:
   int mpiio_exists;
 
   RestartMPIIO(class LAMMPS *);
-  ~RestartMPIIO() {}
+  ~RestartMPIIO();
+  void set_aggregators(int);
   void openForRead(const char *);
   void openForWrite(const char *);
-  void write(MPI_Offset, int, double *);
+  void write(MPI_Offset, int, double *, bigint);
   void read(MPI_Offset, bigint, double *);
+  void verify(MPI_Offset, bigint, MPI_Offset, bigint, double *, bigint);
   void close();
 };
 
@@ -61,6 +66,17 @@ E: Cannot write to restart file - MPI error: %s
 This error was generated by MPI when reading/writing an MPI-IO restart
 file.
 
+E: Restart file checksum mismatch in data block %d of %d
+
+The per-atom data read from an MPI-IO restart file differs from what
+was written.  The file is corrupted, e.g. by a failed or incomplete
+write.
+
+E: Incomplete or corrupted LAMMPS restart file
+
+The checksum table at the end of an MPI-IO restart file is missing or
+inconsistent with the file layout.
+
 E: Cannot read from restart file - MPI error: %s
 
 This error was generated by MPI when reading/writing an MPI-IO restart
@@ -46,5 +46,7 @@ action pair_lj_long_coul_long_opt.cpp pair_lj_long_coul_long.cpp
 action pair_lj_long_coul_long_opt.h pair_lj_long_coul_long.cpp
 action pair_morse_opt.cpp
 action pair_morse_opt.h
+action pair_table_opt.cpp
+action pair_table_opt.h
 action pair_ufm_opt.cpp
 action pair_ufm_opt.h
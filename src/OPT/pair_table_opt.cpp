@@ -0,0 +1,302 @@
+/* ----------------------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://lammps.sandia.gov/, Sandia National Laboratories
+   Steve Plimpton, sjplimp@sandia.gov
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#include "pair_table_opt.h"
+
+#include <cmath>
+#include "atom.h"
+#include "force.h"
+#include "neigh_list.h"
+#include "memory.h"
+#include "error.h"
+
+using namespace LAMMPS_NS;
+
+/* ----------------------------------------------------------------------
+   doubles per table entry in the packed tables
+   LOOKUP: f,e  LINEAR: f,df,e,de  SPLINE: f,f2,e,e2
+   BITMAP: rsq,drsq,f,df,e,de padded to one cache line
+------------------------------------------------------------------------- */
+
+static inline int packed_stride(int tabstyle)
+{
+  if (tabstyle == PairTable::LOOKUP) return 2;
+  if (tabstyle == PairTable::BITMAP) return 8;
+  return 4;
+}
+
+/* ---------------------------------------------------------------------- */
+
+PairTableOpt::PairTableOpt(LAMMPS *lmp) : PairTable(lmp)
+{
+  packed = nullptr;
+  npacked = 0;
+}
+
+/* ---------------------------------------------------------------------- */
+
+PairTableOpt::~PairTableOpt()
+{
+  for (int m = 0; m < npacked; m++) memory->destroy(packed[m]);
+  memory->sfree(packed);
+}
+
+/* ----------------------------------------------------------------------
+   tables are final once all pair_coeff commands are processed
+------------------------------------------------------------------------- */
+
+void PairTableOpt::init_style()
+{
+  PairTable::init_style();
+  pack_tables();
+}
+
+/* ----------------------------------------------------------------------
+   copy the values needed for one table lookup into adjacent memory
+------------------------------------------------------------------------- */
+
+void PairTableOpt::pack_tables()
+{
+  for (int m = 0; m < npacked; m++) memory->destroy(packed[m]);
+  packed = (double **)
+    memory->srealloc(packed,ntables*sizeof(double *),"pair:packed");
+  npacked = ntables;
+
+  const int stride = packed_stride(tabstyle);
+  int n = tablength;
+  if (tabstyle == LOOKUP) n = tablength-1;
+  else if (tabstyle == BITMAP) n = 1 << tablength;
+
+  for (int m = 0; m < ntables; m++) {
+    Table *tb = &tables[m];
+    memory->create(packed[m],n*stride,"pair:packed");
+    double *p = packed[m];
+
+    for (int i = 0; i < n; i++, p += stride) {
+      if (tabstyle == LOOKUP) {
+        p[0] = tb->f[i];
+        p[1] = tb->e[i];
+      } else if (tabstyle == LINEAR) {
+        p[0] = tb->f[i];
+        p[1] = (i < n-1) ? tb->df[i] : 0.0;
+        p[2] = tb->e[i];
+        p[3] = (i < n-1) ? tb->de[i] : 0.0;
+      } else if (tabstyle == SPLINE) {
+        p[0] = tb->f[i];
+        p[1] = tb->f2[i];
+        p[2] = tb->e[i];
+        p[3] = tb->e2[i];
+      } else {
+        p[0] = tb->rsq[i];
+        p[1] = tb->drsq[i];
+        p[2] = tb->f[i];
+        p[3] = tb->df[i];
+        p[4] = tb->e[i];
+        p[5] = tb->de[i];
+        p[6] = p[7] = 0.0;
+      }
+    }
+  }
+}
+
+/* ---------------------------------------------------------------------- */
+
+void PairTableOpt::compute(int eflag, int vflag)
+{
+  ev_init(eflag,vflag);
+
+  if (tabstyle == LOOKUP) eval_style<LOOKUP>(eflag);
+  else if (tabstyle == LINEAR) eval_style<LINEAR>(eflag);
+  else if (tabstyle == SPLINE) eval_style<SPLINE>(eflag);
+  else eval_style<BITMAP>(eflag);
+}
+
+/* ---------------------------------------------------------------------- */
+
+template < int TABSTYLE >
+void PairTableOpt::eval_style(int eflag)
+{
+  if (evflag) {
+    if (eflag) {
+      if (force->newton_pair) return eval<1,1,1,TABSTYLE>();
+      else return eval<1,1,0,TABSTYLE>();
+    } else {
+      if (force->newton_pair) return eval<1,0,1,TABSTYLE>();
+      else return eval<1,0,0,TABSTYLE>();
+    }
+  } else {
+    if (force->newton_pair) return eval<0,0,1,TABSTYLE>();
+    else return eval<0,0,0,TABSTYLE>();
+  }
+}
+
+/* ---------------------------------------------------------------------- */
+
+template < int EVFLAG, int EFLAG, int NEWTON_PAIR, int TABSTYLE >
+void PairTableOpt::eval()
+{
+  typedef struct { double x,y,z; } vec3_t;
+
+  typedef struct {
+    double cutsq,innersq,delta,invdelta,deltasq6;
+    const double *tab;
+    int nmask,nshiftbits;
+  } fast_table_t;
+
+  int i,j,ii,jj,inum,jnum,itype,jtype,itable;
+  double factor_lj,value;
+  double fraction = 0.0, a = 0.0, b = 0.0;
+  double evdwl = 0.0;
+  union_int_float_t rsq_lookup;
+
+  const int stride = (TABSTYLE == LOOKUP) ? 2 : ((TABSTYLE == BITMAP) ? 8 : 4);
+  const int tlm1 = tablength - 1;
+
+  double** _noalias x = atom->x;
+  double** _noalias f = atom->f;
+  int* _noalias type = atom->type;
+  int nlocal = atom->nlocal;
+  double* _noalias special_lj = force->special_lj;
+
+  inum = list->inum;
+  int* _noalias ilist = list->ilist;
+  int** _noalias firstneigh = list->firstneigh;
+  int* _noalias numneigh = list->numneigh;
+
+  vec3_t* _noalias xx = (vec3_t*)x[0];
+  vec3_t* _noalias ff = (vec3_t*)f[0];
+
+  int ntypes = atom->ntypes;
+  int ntypes2 = ntypes*ntypes;
+
+  fast_table_t* _noalias fast_table =
+    (fast_table_t*) malloc(ntypes2*sizeof(fast_table_t));
+  for (i = 0; i < ntypes; i++) for (j = 0; j < ntypes; j++) {
+    fast_table_t& t = fast_table[i*ntypes+j];
+    t.cutsq = cutsq[i+1][j+1];
+    if (t.cutsq > 0.0) {
+      const int m = tabindex[i+1][j+1];
+      const Table *tb = &tables[m];
+      t.innersq = tb->innersq;
+      t.delta = tb->delta;
+      t.invdelta = tb->invdelta;
+      t.deltasq6 = tb->deltasq6;
+      t.nmask = tb->nmask;
+      t.nshiftbits = tb->nshiftbits;
+      t.tab = packed[m];
+    }
+  }
+
+  // loop over neighbors of my atoms
+
+  for (ii = 0; ii < inum; ii++) {
+    i = ilist[ii];
+    double xtmp = xx[i].x;
+    double ytmp = xx[i].y;
+    double ztmp = xx[i].z;
+    itype = type[i] - 1;
+    int* _noalias jlist = firstneigh[i];
+    jnum = numneigh[i];
+
+    double tmpfx = 0.0;
+    double tmpfy = 0.0;
+    double tmpfz = 0.0;
+
+    fast_table_t* _noalias tabi = &fast_table[itype*ntypes];
+
+    for (jj = 0; jj < jnum; jj++) {
+      j = jlist[jj];
+      factor_lj = special_lj[sbmask(j)];
+      j &= NEIGHMASK;
+
+      double delx = xtmp - xx[j].x;
+      double dely = ytmp - xx[j].y;
+      double delz = ztmp - xx[j].z;
+      double rsq = delx*delx + dely*dely + delz*delz;
+      jtype = type[j] - 1;
+
+      const fast_table_t& t = tabi[jtype];
+
+      if (rsq < t.cutsq) {
+        if (rsq < t.innersq)
+          error->one(FLERR,fmt::format("Pair distance < table inner cutoff: "
+                                       "ijtype {} {} dist {}",itype+1,jtype+1,
+                                       sqrt(rsq)));
+
+        const double *p;
+        if (TABSTYLE == BITMAP) {
+          rsq_lookup.f = rsq;
+          itable = rsq_lookup.i & t.nmask;
+          itable >>= t.nshiftbits;
+          p = t.tab + stride*itable;
+          fraction = (rsq_lookup.f - p[0]) * p[1];
+          value = p[2] + fraction*p[3];
+        } else {
+          itable = static_cast<int> ((rsq - t.innersq) * t.invdelta);
+          if (itable >= tlm1)
+            error->one(FLERR,fmt::format("Pair distance > table outer cutoff: "
+                                         "ijtype {} {} dist {}",itype+1,
+                                         jtype+1,sqrt(rsq)));
+          p = t.tab + stride*itable;
+
+          if (TABSTYLE == LOOKUP) {
+            value = p[0];
+          } else if (TABSTYLE == LINEAR) {
+            fraction = (rsq - (t.innersq + itable*t.delta)) * t.invdelta;
+            value = p[0] + fraction*p[1];
+          } else {
+            b = (rsq - (t.innersq + itable*t.delta)) * t.invdelta;
+            a = 1.0 - b;
+            value = a * p[0] + b * p[4] +
+              ((a*a*a-a)*p[1] + (b*b*b-b)*p[5]) * t.deltasq6;
+          }
+        }
+
+        double fpair = factor_lj * value;
+
+        tmpfx += delx*fpair;
+        tmpfy += dely*fpair;
+        tmpfz += delz*fpair;
+        if (NEWTON_PAIR || j < nlocal) {
+          ff[j].x -= delx*fpair;
+          ff[j].y -= dely*fpair;
+          ff[j].z -= delz*fpair;
+        }
+
+        if (EFLAG) {
+          if (TABSTYLE == LOOKUP)
+            evdwl = p[1];
+          else if (TABSTYLE == LINEAR)
+            evdwl = p[2] + fraction*p[3];
+          else if (TABSTYLE == BITMAP)
+            evdwl = p[4] + fraction*p[5];
+          else
+            evdwl = a * p[2] + b * p[6] +
+              ((a*a*a-a)*p[3] + (b*b*b-b)*p[7]) * t.deltasq6;
+          evdwl *= factor_lj;
+        }
+
+        if (EVFLAG) ev_tally(i,j,nlocal,NEWTON_PAIR,
+                             evdwl,0.0,fpair,delx,dely,delz);
+      }
+    }
+
+    ff[i].x += tmpfx;
+    ff[i].y += tmpfy;
+    ff[i].z += tmpfz;
+  }
+
+  free(fast_table); fast_table = 0;
+
+  if (vflag_fdotr) virial_fdotr_compute();
+}
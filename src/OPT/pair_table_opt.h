@@ -0,0 +1,59 @@
+/* -*- c++ -*- ----------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   http://lammps.sandia.gov, Sandia National Laboratories
+   Steve Plimpton, sjplimp@sandia.gov
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#ifdef PAIR_CLASS
+
+PairStyle(table/opt,PairTableOpt)
+
+#else
+
+#ifndef LMP_PAIR_TABLE_OPT_H
+#define LMP_PAIR_TABLE_OPT_H
+
+#include "pair_table.h"
+
+namespace LAMMPS_NS {
+
+class PairTableOpt : public PairTable {
+ public:
+  PairTableOpt(class LAMMPS *);
+  virtual ~PairTableOpt();
+  void compute(int, int);
+  void init_style();
+
+ private:
+  double **packed;      // per table: interleaved f,df,e,de or f,f2,e,e2
+  int npacked;
+
+  void pack_tables();
+  template < int TABSTYLE > void eval_style(int);
+  template < int EVFLAG, int EFLAG, int NEWTON_PAIR, int TABSTYLE >
+    void eval();
+};
+
+}
+
+#endif
+#endif
+
+/* ERROR/WARNING messages:
+
+E: Pair distance < table inner cutoff
+
+Two atoms are closer together than the pairwise table allows.
+
+E: Pair distance > table outer cutoff
+
+Two atoms are further apart than the pairwise table allows.
+
+*/
@@ -41,7 +41,8 @@ FixQEq::FixQEq(LAMMPS *lmp, int narg, char **arg) :
   gamma(nullptr), zeta(nullptr), zcore(nullptr), chizj(nullptr), shld(nullptr),
   s(nullptr), t(nullptr), s_hist(nullptr), t_hist(nullptr), Hdia_inv(nullptr), b_s(nullptr),
   b_t(nullptr), p(nullptr), q(nullptr), r(nullptr), d(nullptr),
-  qf(nullptr), q1(nullptr), q2(nullptr), qv(nullptr)
+  qf(nullptr), q1(nullptr), q2(nullptr), qv(nullptr), s_xl(nullptr),
+  t_xl(nullptr)
 {
   if (narg < 8) error->all(FLERR,"Illegal fix qeq command");
 
@@ -54,6 +55,21 @@ FixQEq::FixQEq(LAMMPS *lmp, int narg, char **arg) :
   if ((nevery <= 0) || (cutoff <= 0.0) || (tolerance <= 0.0) || (maxiter <= 0))
     error->all(FLERR,"Illegal fix qeq command");
 
+  // optional xl keyword is shared by all QEq styles with a CG solver,
+  // the styles check the remaining keywords themselves
+
+  xlflag = 0;
+  xlscf = 0;
+  xl_start = 1;
+  for (int iarg = 8; iarg < narg; iarg++) {
+    if (strcmp(arg[iarg],"xl") == 0) {
+      if (iarg+2 > narg) error->all(FLERR,"Illegal fix qeq command");
+      xlscf = utils::inumeric(FLERR,arg[iarg+1],false,lmp);
+      if (xlscf <= 0) error->all(FLERR,"Fix qeq xl iterations must be > 0");
+      xlflag = 1;
+    }
+  }
+
   alpha = 0.20;
   swa = 0.0;
   swb = cutoff;
@@ -95,6 +111,8 @@ FixQEq::FixQEq(LAMMPS *lmp, int narg, char **arg) :
   qv = nullptr;
 
   comm_forward = comm_reverse = 1;
+  maxexchange = 2*nprev;
+  if (xlflag) maxexchange += 2*(XL_K+1);
 
   // perform initial allocation of atom-based arrays
   // register with Atom class
@@ -107,6 +125,11 @@ FixQEq::FixQEq(LAMMPS *lmp, int narg, char **arg) :
     for (int j = 0; j < nprev; ++j )
       s_hist[i][j] = t_hist[i][j] = atom->q[i];
 
+  if (xlflag)
+    for (int i = 0; i < atom->nmax; i++)
+      for (int j = 0; j <= XL_K; ++j )
+        s_xl[i][j] = t_xl[i][j] = 0.0;
+
   if (strcmp(arg[7],"coul/streitz") == 0) {
     streitz_flag = 1;
   } else if (strcmp(arg[7],"reax/c") == 0) {
@@ -126,6 +149,8 @@ FixQEq::~FixQEq()
 
   memory->destroy(s_hist);
   memory->destroy(t_hist);
+  memory->destroy(s_xl);
+  memory->destroy(t_xl);
 
   deallocate_storage();
   deallocate_matrix();
@@ -288,6 +313,7 @@ void FixQEq::setup_pre_force(int vflag)
   deallocate_matrix();
   allocate_matrix();
 
+  xl_start = 1;
   pre_force(vflag);
 }
 
@@ -346,6 +372,11 @@ int FixQEq::CG( double *b, double *x )
   inum = list->inum;
   ilist = list->ilist;
 
+  // with propagated auxiliary charges only a few iterations correct them
+
+  int loopmax = maxiter;
+  if (xl_active() && !xl_start) loopmax = MIN(xlscf+1,maxiter);
+
   pack_flag = 1;
   sparse_matvec( &H, x, q );
   comm->reverse_comm_fix( this );
@@ -362,7 +393,7 @@ int FixQEq::CG( double *b, double *x )
   b_norm = parallel_norm( b, inum );
   sig_new = parallel_dot( r, d, inum);
 
-  for (loop = 1; loop < maxiter && sqrt(sig_new)/b_norm > tolerance; ++loop) {
+  for (loop = 1; loop < loopmax && sqrt(sig_new)/b_norm > tolerance; ++loop) {
     comm->forward_comm_fix(this);
     sparse_matvec( &H, d, q );
     comm->reverse_comm_fix(this);
@@ -462,6 +493,99 @@ void FixQEq::calculate_Q()
   comm->forward_comm_fix( this ); //Dist_vector( atom->q );
 }
 
+/* ----------------------------------------------------------------------
+   extended Lagrangian charge propagation (Niklasson)
+   the auxiliary s and t follow a time-reversible Verlet integrator with
+   a weak dissipation term and are pulled towards the partially converged
+   CG solution of each step, so they stay close to the ground state while
+   CG only needs a few iterations.  only used during a run, minimizations
+   solve the full QEq problem.
+------------------------------------------------------------------------- */
+
+int FixQEq::xl_active()
+{
+  return (xlflag && update->whichflag == 1);
+}
+
+/* ----------------------------------------------------------------------
+   use the auxiliary charges as initial guess for s and t
+------------------------------------------------------------------------- */
+
+void FixQEq::xl_predict()
+{
+  if (!xl_active() || xl_start) return;
+
+  int i, ii, inum, *ilist;
+
+  inum = list->inum;
+  ilist = list->ilist;
+
+  for (ii = 0; ii < inum; ++ii) {
+    i = ilist[ii];
+    if (atom->mask[i] & groupbit) {
+      s[i] = s_xl[i][0];
+      t[i] = t_xl[i][0];
+    }
+  }
+
+  pack_flag = 2;
+  comm->forward_comm_fix(this); //Dist_vector( s );
+  pack_flag = 3;
+  comm->forward_comm_fix(this); //Dist_vector( t );
+}
+
+/* ----------------------------------------------------------------------
+   advance the auxiliary charges with the current CG solution
+   coefficients for K = 5 from Niklasson et al, JCP 130, 214109 (2009)
+------------------------------------------------------------------------- */
+
+void FixQEq::xl_propagate()
+{
+  if (!xl_active()) return;
+
+  static const double kappa = 1.82;
+  static const double alpha_xl = 0.018;
+  static const double c[XL_K+1] = {-6.0, 14.0, -8.0, -3.0, 4.0, -1.0};
+
+  int i, ii, k, inum, *ilist;
+  double snew, tnew;
+
+  inum = list->inum;
+  ilist = list->ilist;
+
+  for (ii = 0; ii < inum; ++ii) {
+    i = ilist[ii];
+    if (atom->mask[i] & groupbit) {
+
+      // first step of a run: start from the converged solution
+
+      if (xl_start) {
+        for (k = 0; k <= XL_K; ++k) {
+          s_xl[i][k] = s[i];
+          t_xl[i][k] = t[i];
+        }
+        continue;
+      }
+
+      snew = 2.0*s_xl[i][0] - s_xl[i][1] + kappa*(s[i] - s_xl[i][0]);
+      tnew = 2.0*t_xl[i][0] - t_xl[i][1] + kappa*(t[i] - t_xl[i][0]);
+      for (k = 0; k <= XL_K; ++k) {
+        snew += alpha_xl * c[k] * s_xl[i][k];
+        tnew += alpha_xl * c[k] * t_xl[i][k];
+      }
+
+      for (k = XL_K; k > 0; --k) {
+        s_xl[i][k] = s_xl[i][k-1];
+        t_xl[i][k] = t_xl[i][k-1];
+      }
+      s_xl[i][0] = snew;
+      t_xl[i][0] = tnew;
+    }
+  }
+
+  xl_start = 0;
+}
+
 /* ---------------------------------------------------------------------- */
 
 int FixQEq::pack_forward_comm(int n, int *list, double *buf,
@@ -529,6 +653,7 @@ double FixQEq::memory_usage()
   bytes += (double)n_cap*2 * sizeof(int); // matrix...
   bytes += (double)m_cap * sizeof(int);
   bytes += (double)m_cap * sizeof(double);
+  if (xlflag) bytes += (double)atom->nmax*(XL_K+1)*2 * sizeof(double);
 
   return bytes;
 }
@@ -541,6 +666,10 @@ void FixQEq::grow_arrays(int nmax)
 {
   memory->grow(s_hist,nmax,nprev,"qeq:s_hist");
   memory->grow(t_hist,nmax,nprev,"qeq:t_hist");
+  if (xlflag) {
+    memory->grow(s_xl,nmax,XL_K+1,"qeq:s_xl");
+    memory->grow(t_xl,nmax,XL_K+1,"qeq:t_xl");
+  }
 }
 
 /* ----------------------------------------------------------------------
@@ -553,6 +682,11 @@ void FixQEq::copy_arrays(int i, int j, int /*delflag*/)
     s_hist[j][m] = s_hist[i][m];
     t_hist[j][m] = t_hist[i][m];
   }
+  if (xlflag)
+    for (int m = 0; m <= XL_K; m++) {
+      s_xl[j][m] = s_xl[i][m];
+      t_xl[j][m] = t_xl[i][m];
+    }
 }
 
 /* ----------------------------------------------------------------------
@@ -563,7 +697,12 @@ int FixQEq::pack_exchange(int i, double *buf)
 {
   for (int m = 0; m < nprev; m++) buf[m] = s_hist[i][m];
   for (int m = 0; m < nprev; m++) buf[nprev+m] = t_hist[i][m];
-  return nprev*2;
+  if (!xlflag) return nprev*2;
+
+  int n = nprev*2;
+  for (int m = 0; m <= XL_K; m++) buf[n++] = s_xl[i][m];
+  for (int m = 0; m <= XL_K; m++) buf[n++] = t_xl[i][m];
+  return n;
 }
 
 /* ----------------------------------------------------------------------
@@ -574,7 +713,12 @@ int FixQEq::unpack_exchange(int n, double *buf)
 {
   for (int m = 0; m < nprev; m++) s_hist[n][m] = buf[m];
   for (int m = 0; m < nprev; m++) t_hist[n][m] = buf[nprev+m];
-  return nprev*2;
+  if (!xlflag) return nprev*2;
+
+  int k = nprev*2;
+  for (int m = 0; m <= XL_K; m++) s_xl[n][m] = buf[k++];
+  for (int m = 0; m <= XL_K; m++) t_xl[n][m] = buf[k++];
+  return k;
 }
 
 /* ---------------------------------------------------------------------- */
@@ -21,6 +21,7 @@
 #define MIN_CAP            50
 #define SAFE_ZONE          1.2
 #define MIN_NBRS           100
+#define XL_K               5
 
 namespace LAMMPS_NS {
 
@@ -104,7 +105,17 @@ class FixQEq : public Fix {
   // fire
   double *qv;
 
+  // extended Lagrangian propagation of s and t
+
+  int xlflag;            // 1 if auxiliary charges are propagated
+  int xlscf;             // max CG iterations per step with xl
+  int xl_start;          // 1 until the auxiliary history is initialized
+  double **s_xl, **t_xl; // auxiliary s and t at the last XL_K+1 steps
+
   void calculate_Q();
+  int xl_active();
+  void xl_predict();
+  void xl_propagate();
 
   double parallel_norm(double*, int);
   double parallel_dot(double*, double*, int);
@@ -146,6 +157,11 @@ W: Fix qeq CG convergence failed (%g) after %d iterations at %ld step
 
 Self-explanatory.
 
+E: Fix qeq xl iterations must be > 0
+
+At least one CG iteration per step is required to correct the
+propagated auxiliary charges.
+
 E: Cannot open fix qeq parameter file %s
 
 The specified file cannot be opened.  Check that the path and name are
@@ -139,8 +139,12 @@ void FixQEqShielded::pre_force(int /*vflag*/)
     reallocate_matrix();
 
   init_matvec();
+  if (xlflag) xl_predict();
+
   matvecs = CG(b_s, s);         // CG on s - parallel
   matvecs += CG(b_t, t);        // CG on t - parallel
+
+  if (xlflag) xl_propagate();
   calculate_Q();
 
   if (force->kspace) force->kspace->qsum_qsq();
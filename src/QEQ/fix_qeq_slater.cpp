@@ -51,6 +51,8 @@ FixQEqSlater::FixQEqSlater(LAMMPS *lmp, int narg, char **arg) :
       if (iarg+2 > narg) error->all(FLERR,"Illegal fix qeq/slater command");
       alpha = atof(arg[iarg+1]);
       iarg += 2;
+    } else if (strcmp(arg[iarg],"xl") == 0) {
+      iarg += 2; // processed in FixQEq
     } else error->all(FLERR,"Illegal fix qeq/slater command");
   }
 
@@ -117,8 +119,12 @@ void FixQEqSlater::pre_force(int /*vflag*/)
     reallocate_matrix();
 
   init_matvec();
+  if (xlflag) xl_predict();
+
   matvecs = CG(b_s, s);         // CG on s - parallel
   matvecs += CG(b_t, t);        // CG on t - parallel
+
+  if (xlflag) xl_propagate();
   calculate_Q();
 
   if (force->kspace) force->kspace->qsum_qsq();
@@ -290,6 +290,7 @@ int MPI_Irecv(void *buf, int count, MPI_Datatype datatype,
 int MPI_Wait(MPI_Request *request, MPI_Status *status)
 {
   static int callcount=0;
+  if (*request == MPI_REQUEST_NULL) return 0;
   if (callcount == 0) {
     printf("MPI Stub WARNING: Should not wait on message from self\n");
     ++callcount;
@@ -525,6 +526,22 @@ int MPI_Allreduce(void *sendbuf, void *recvbuf, int count,
 
 /* ---------------------------------------------------------------------- */
 
+/* copy values from data1 to data2, the request completes immediately */
+
+int MPI_Iallreduce(void *sendbuf, void *recvbuf, int count,
+                   MPI_Datatype datatype, MPI_Op op, MPI_Comm comm,
+                   MPI_Request *request)
+{
+  int n = count * stubtypesize(datatype);
+
+  *request = MPI_REQUEST_NULL;
+  if (sendbuf == MPI_IN_PLACE || recvbuf == MPI_IN_PLACE) return 0;
+  memcpy(recvbuf,sendbuf,n);
+  return 0;
+}
+
+/* ---------------------------------------------------------------------- */
+
 /* copy values from data1 to data2 */
 
 int MPI_Reduce(void *sendbuf, void *recvbuf, int count,
@@ -131,6 +131,7 @@ public:
 DumpCustomADIOS::DumpCustomADIOS(LAMMPS *lmp, int narg, char **arg)
 : DumpCustom(lmp, narg, arg)
 {
+    async_allow = 0;
     internal = new DumpCustomADIOSInternal();
     try {
         internal->ad =
@@ -0,0 +1,61 @@
+# Install/unInstall package files in LAMMPS
+# mode = 0/1/2 for uninstall/install/update
+
+mode=$1
+
+# enforce using portable C locale
+LC_ALL=C
+export LC_ALL
+
+# arg1 = file, arg2 = file it depends on
+
+action () {
+  if (test $mode = 0) then
+    rm -f ../$1
+  elif (! cmp -s $1 ../$1) then
+    if (test -z "$2" || test -e ../$2) then
+      cp $1 ..
+      if (test $mode = 2) then
+        echo "  updating src/$1"
+      fi
+    fi
+  elif (test -n "$2") then
+    if (test ! -e ../$2) then
+      rm -f ../$1
+    fi
+  fi
+}
+
+# list of files with optional dependencies
+# the mesh keyword of compute saed and xrd uses the parallel FFT wrapper
+# of the KSPACE package and is only available when it is installed
+
+action compute_saed.cpp
+action compute_saed.h
+action compute_saed_consts.h
+action compute_xrd.cpp
+action compute_xrd.h
+action compute_xrd_consts.h
+action diffraction_mesh.cpp fft3d_wrap.h
+action diffraction_mesh.h fft3d_wrap.h
+action fix_saed_vtk.cpp
+action fix_saed_vtk.h
+
+# edit Makefile.package to include/exclude the mesh define
+
+if (test $mode = 1 || test $mode = 2) then
+
+  if (test -e ../Makefile.package) then
+    sed -i -e 's/[^ \t]*-DLMP_DIFFRACTION_MESH[^ \t]* //g' ../Makefile.package
+    if (test -e ../fft3d_wrap.h) then
+      sed -i -e 's|^PKG_INC =[ \t]*|&-DLMP_DIFFRACTION_MESH |' ../Makefile.package
+    fi
+  fi
+
+elif (test $mode = 0) then
+
+  if (test -e ../Makefile.package) then
+    sed -i -e 's/[^ \t]*-DLMP_DIFFRACTION_MESH[^ \t]* //g' ../Makefile.package
+  fi
+
+fi
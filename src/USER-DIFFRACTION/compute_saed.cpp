@@ -32,6 +32,11 @@
 #include <cstring>
 
 #include "omp_compat.h"
+
+#if defined(LMP_DIFFRACTION_MESH)
+#include "diffraction_mesh.h"
+#endif
+
 using namespace LAMMPS_NS;
 using namespace MathConst;
 
@@ -49,7 +54,7 @@ static const char cite_compute_saed_c[] =
 /* ---------------------------------------------------------------------- */
 
 ComputeSAED::ComputeSAED(LAMMPS *lmp, int narg, char **arg) :
-  Compute(lmp, narg, arg), ztype(nullptr), store_tmp(nullptr)
+  Compute(lmp, narg, arg), ztype(nullptr), store_tmp(nullptr), mesh(nullptr)
 {
   if (lmp->citeme) lmp->citeme->add(cite_compute_saed_c);
 
@@ -101,6 +106,7 @@ ComputeSAED::ComputeSAED(LAMMPS *lmp, int narg, char **arg) :
   manual = false;
   double manual_double=0;
   echo = false;
+  meshflag = 0;
 
   // Process optional args
   while (iarg < narg) {
@@ -144,6 +150,16 @@ ComputeSAED::ComputeSAED(LAMMPS *lmp, int narg, char **arg) :
       manual_double = 1;
       iarg += 1;
 
+    } else if (strcmp(arg[iarg],"mesh") == 0) {
+      if (iarg+3 > narg) error->all(FLERR,"Illegal Compute SAED Command");
+#if !defined(LMP_DIFFRACTION_MESH)
+      error->all(FLERR,"Compute SAED mesh requires the KSPACE package");
+#endif
+      meshflag = 1;
+      mesh_order = atoi(arg[iarg+1]);
+      mesh_oversample = atof(arg[iarg+2]);
+      iarg += 3;
+
     } else error->all(FLERR,"Illegal Compute SAED Command");
   }
 
@@ -261,6 +277,31 @@ ComputeSAED::ComputeSAED(LAMMPS *lmp, int narg, char **arg) :
   memory->create(vector,size_vector,"saed:vector");
   memory->create(store_tmp,3*size_vector,"saed:store_tmp");
 
+  // mesh for structure factors of all relp with Fourier transforms
+  // relp must be integer multiples of the reciprocal box vectors
+
+#if defined(LMP_DIFFRACTION_MESH)
+  if (meshflag) {
+    if (manual)
+      error->all(FLERR,"Compute SAED mesh cannot be used with manual spacing");
+    if (!periodicity[0] || !periodicity[1] || !periodicity[2])
+      error->all(FLERR,"Compute SAED mesh requires a fully periodic box");
+    int hmax[3];
+    for (int i=0; i<3; i++) {
+      cmesh[i] = static_cast<int> (c[i]);
+      if (cmesh[i] < 1 || cmesh[i] != c[i])
+        error->all(FLERR,"Compute SAED mesh requires integer c's");
+      hmax[i] = Knmax[i]*cmesh[i];
+    }
+    mesh = new DiffractionMesh(lmp,mesh_order,mesh_oversample);
+    mesh->setup(hmax);
+
+    if (me == 0 && screen && echo)
+      fprintf(screen,"Compute SAED mesh = %d %d %d\n-----\n",
+              mesh->nx,mesh->ny,mesh->nz);
+  }
+#endif
+
 
   // Create vector of variables to be passed to fix ave/time/saed
   saed_var[0] = lambda;
@@ -282,6 +323,9 @@ ComputeSAED::~ComputeSAED()
   memory->destroy(vector);
   memory->destroy(store_tmp);
   delete[] ztype;
+#if defined(LMP_DIFFRACTION_MESH)
+  delete mesh;
+#endif
 }
 
 /* ---------------------------------------------------------------------- */
@@ -361,9 +405,15 @@ void ComputeSAED::compute_vector()
   int *mask = atom->mask;
 
   nlocalgroup = 0;
-  for (int ii = 0; ii < nlocal; ii++) {
-    if (mask[ii] & groupbit) {
-     nlocalgroup++;
+#if defined(LMP_DIFFRACTION_MESH)
+  if (meshflag) mesh->compute(groupbit);
+  else
+#endif
+  {
+    for (int ii = 0; ii < nlocal; ii++) {
+      if (mask[ii] & groupbit) {
+       nlocalgroup++;
+      }
     }
   }
 
@@ -371,7 +421,7 @@ void ComputeSAED::compute_vector()
   int *typelocal = new int [nlocalgroup];
 
   nlocalgroup = 0;
-  for (int ii = 0; ii < nlocal; ii++) {
+  for (int ii = 0; ii < nlocal && !meshflag; ii++) {
     if (mask[ii] & groupbit) {
      xlocal[3*nlocalgroup+0] = atom->x[ii][0];
      xlocal[3*nlocalgroup+1] = atom->x[ii][1];
@@ -423,6 +473,8 @@ void ComputeSAED::compute_vector()
 #endif
   {
     double *f = new double[ntypes];    // atomic structure factor by type
+    double *rhore = new double[ntypes]; // transformed density by type (real)
+    double *rhoim = new double[ntypes]; // transformed density by type (imaginary)
     int typei = 0;
     double Fatom1 = 0.0;               // structure factor per atom
     double Fatom2 = 0.0;               // structure factor per atom (imaginary)
@@ -461,12 +513,24 @@ void ComputeSAED::compute_vector()
       }
 
       // Evaluate the structure factor equation -- looping over all atoms
-      for (int ii = 0; ii < nlocalgroup; ii++) {
-        typei=typelocal[ii]-1;
-        inners = 2 * MY_PI * (K[0] * xlocal[3*ii+0] + K[1] * xlocal[3*ii+1] +
-                  K[2] * xlocal[3*ii+2]);
-        Fatom1 += f[typei] * cos(inners);
-        Fatom2 += f[typei] * sin(inners);
+      // or summing transformed densities of types if relp is on my mesh
+      if (meshflag) {
+#if defined(LMP_DIFFRACTION_MESH)
+        if (mesh->density(i*cmesh[0],j*cmesh[1],k*cmesh[2],rhore,rhoim)) {
+          for (int ii = 0; ii < ntypes; ii++) {
+            Fatom1 += f[ii] * rhore[ii];
+            Fatom2 += f[ii] * rhoim[ii];
+          }
+        }
+#endif
+      } else {
+        for (int ii = 0; ii < nlocalgroup; ii++) {
+          typei=typelocal[ii]-1;
+          inners = 2 * MY_PI * (K[0] * xlocal[3*ii+0] + K[1] * xlocal[3*ii+1] +
+                    K[2] * xlocal[3*ii+2]);
+          Fatom1 += f[typei] * cos(inners);
+          Fatom2 += f[typei] * sin(inners);
+        }
       }
 
       Fvec[2*n] = Fatom1;
@@ -488,6 +552,8 @@ void ComputeSAED::compute_vector()
       }
     } // End of pragma omp for region
     delete [] f;
+    delete [] rhore;
+    delete [] rhoim;
   }
 
   double *scratch = new double[2*nRows];
@@ -527,6 +593,9 @@ double ComputeSAED::memory_usage()
   bytes += (double)3.0 * nlocalgroup * sizeof(double); // xlocal
   bytes += (double)nlocalgroup * sizeof(int); // typelocal
   bytes += (double)3.0 * nRows * sizeof(int); // store_temp
+#if defined(LMP_DIFFRACTION_MESH)
+  if (mesh) bytes += mesh->memory_usage(); // transformed densities
+#endif
 
   return bytes;
 }
@@ -33,6 +33,11 @@
 #include <cstring>
 
 #include "omp_compat.h"
+
+#if defined(LMP_DIFFRACTION_MESH)
+#include "diffraction_mesh.h"
+#endif
+
 using namespace LAMMPS_NS;
 using namespace MathConst;
 
@@ -50,7 +55,7 @@ static const char cite_compute_xrd_c[] =
 /* ---------------------------------------------------------------------- */
 
 ComputeXRD::ComputeXRD(LAMMPS *lmp, int narg, char **arg) :
-  Compute(lmp, narg, arg), ztype(nullptr), store_tmp(nullptr)
+  Compute(lmp, narg, arg), ztype(nullptr), store_tmp(nullptr), mesh(nullptr)
 {
   if (lmp->citeme) lmp->citeme->add(cite_compute_xrd_c);
 
@@ -102,6 +107,7 @@ ComputeXRD::ComputeXRD(LAMMPS *lmp, int narg, char **arg) :
   LP = 1;
   manual = false;
   echo = false;
+  meshflag = 0;
 
   // Process optional args
   while (iarg < narg) {
@@ -147,6 +153,16 @@ ComputeXRD::ComputeXRD(LAMMPS *lmp, int narg, char **arg) :
       manual = true;
       iarg += 1;
 
+    } else if (strcmp(arg[iarg],"mesh") == 0) {
+      if (iarg+3 > narg) error->all(FLERR,"Illegal Compute XRD Command");
+#if !defined(LMP_DIFFRACTION_MESH)
+      error->all(FLERR,"Compute XRD mesh requires the KSPACE package");
+#endif
+      meshflag = 1;
+      mesh_order = atoi(arg[iarg+1]);
+      mesh_oversample = atof(arg[iarg+2]);
+      iarg += 3;
+
     } else error->all(FLERR,"Illegal Compute XRD Command");
   }
 
@@ -239,6 +255,31 @@ ComputeXRD::ComputeXRD(LAMMPS *lmp, int narg, char **arg) :
 
   memory->create(array,size_array_rows,size_array_cols,"xrd:array");
   memory->create(store_tmp,3*size_array_rows,"xrd:store_tmp");
+
+  // mesh for structure factors of all relp with Fourier transforms
+  // relp must be integer multiples of the reciprocal box vectors
+
+#if defined(LMP_DIFFRACTION_MESH)
+  if (meshflag) {
+    if (manual)
+      error->all(FLERR,"Compute XRD mesh cannot be used with manual spacing");
+    if (!periodicity[0] || !periodicity[1] || !periodicity[2])
+      error->all(FLERR,"Compute XRD mesh requires a fully periodic box");
+    int hmax[3];
+    for (int i=0; i<3; i++) {
+      cmesh[i] = static_cast<int> (c[i]);
+      if (cmesh[i] < 1 || cmesh[i] != c[i])
+        error->all(FLERR,"Compute XRD mesh requires integer c's");
+      hmax[i] = Knmax[i]*cmesh[i];
+    }
+    mesh = new DiffractionMesh(lmp,mesh_order,mesh_oversample);
+    mesh->setup(hmax);
+
+    if (me == 0 && screen && echo)
+      fprintf(screen,"Compute XRD mesh = %d %d %d\n-----\n",
+              mesh->nx,mesh->ny,mesh->nz);
+  }
+#endif
 }
 
 /* ---------------------------------------------------------------------- */
@@ -248,6 +289,9 @@ ComputeXRD::~ComputeXRD()
   memory->destroy(array);
   memory->destroy(store_tmp);
   delete[] ztype;
+#if defined(LMP_DIFFRACTION_MESH)
+  delete mesh;
+#endif
 }
 
 /* ---------------------------------------------------------------------- */
@@ -315,9 +359,15 @@ void ComputeXRD::compute_array()
   int *mask = atom->mask;
 
   nlocalgroup = 0;
-  for (int ii = 0; ii < nlocal; ii++) {
-    if (mask[ii] & groupbit) {
-     nlocalgroup++;
+#if defined(LMP_DIFFRACTION_MESH)
+  if (meshflag) mesh->compute(groupbit);
+  else
+#endif
+  {
+    for (int ii = 0; ii < nlocal; ii++) {
+      if (mask[ii] & groupbit) {
+       nlocalgroup++;
+      }
     }
   }
 
@@ -325,7 +375,7 @@ void ComputeXRD::compute_array()
   int *typelocal = new int [nlocalgroup];
 
   nlocalgroup = 0;
-  for (int ii = 0; ii < nlocal; ii++) {
+  for (int ii = 0; ii < nlocal && !meshflag; ii++) {
     if (mask[ii] & groupbit) {
      xlocal[3*nlocalgroup+0] = atom->x[ii][0];
      xlocal[3*nlocalgroup+1] = atom->x[ii][1];
@@ -358,6 +408,8 @@ void ComputeXRD::compute_array()
 #endif
   {
     double *f = new double[ntypes];    // atomic structure factor by type
+    double *rhore = new double[ntypes]; // transformed density by type (real)
+    double *rhoim = new double[ntypes]; // transformed density by type (imaginary)
     int n,typei = 0;
 
     double Fatom1 = 0.0;               // structure factor per atom (real)
@@ -409,12 +461,24 @@ void ComputeXRD::compute_array()
         }
 
         // Evaluate the structure factor equation -- looping over all atoms
-        for (int ii = 0; ii < nlocalgroup; ii++) {
-          typei=typelocal[ii]-1;
-          inners = 2 * MY_PI * (K[0] * xlocal[3*ii] + K[1] * xlocal[3*ii+1] +
-                    K[2] * xlocal[3*ii+2]);
-          Fatom1 += f[typei] * cos(inners);
-          Fatom2 += f[typei] * sin(inners);
+        // or summing transformed densities of types if relp is on my mesh
+        if (meshflag) {
+#if defined(LMP_DIFFRACTION_MESH)
+          if (mesh->density(i*cmesh[0],j*cmesh[1],k*cmesh[2],rhore,rhoim)) {
+            for (int ii = 0; ii < ntypes; ii++) {
+              Fatom1 += f[ii] * rhore[ii];
+              Fatom2 += f[ii] * rhoim[ii];
+            }
+          }
+#endif
+        } else {
+          for (int ii = 0; ii < nlocalgroup; ii++) {
+            typei=typelocal[ii]-1;
+            inners = 2 * MY_PI * (K[0] * xlocal[3*ii] + K[1] * xlocal[3*ii+1] +
+                      K[2] * xlocal[3*ii+2]);
+            Fatom1 += f[typei] * cos(inners);
+            Fatom2 += f[typei] * sin(inners);
+          }
         }
         sqrt_lp = sqrt( (1 + Cos2Theta * Cos2Theta) /
              ( CosTheta * SinTheta * SinTheta) );
@@ -465,12 +529,24 @@ void ComputeXRD::compute_array()
         }
 
         // Evaluate the structure factor equation -- looping over all atoms
-        for (int ii = 0; ii < nlocalgroup; ii++) {
-          typei=typelocal[ii]-1;
-          inners = 2 * MY_PI * (K[0] * xlocal[3*ii] + K[1] * xlocal[3*ii+1] +
-                    K[2] * xlocal[3*ii+2]);
-          Fatom1 += f[typei] * cos(inners);
-          Fatom2 += f[typei] * sin(inners);
+        // or summing transformed densities of types if relp is on my mesh
+        if (meshflag) {
+#if defined(LMP_DIFFRACTION_MESH)
+          if (mesh->density(i*cmesh[0],j*cmesh[1],k*cmesh[2],rhore,rhoim)) {
+            for (int ii = 0; ii < ntypes; ii++) {
+              Fatom1 += f[ii] * rhore[ii];
+              Fatom2 += f[ii] * rhoim[ii];
+            }
+          }
+#endif
+        } else {
+          for (int ii = 0; ii < nlocalgroup; ii++) {
+            typei=typelocal[ii]-1;
+            inners = 2 * MY_PI * (K[0] * xlocal[3*ii] + K[1] * xlocal[3*ii+1] +
+                      K[2] * xlocal[3*ii+2]);
+            Fatom1 += f[typei] * cos(inners);
+            Fatom2 += f[typei] * sin(inners);
+          }
         }
         Fvec[2*n] = Fatom1;
         Fvec[2*n+1] = Fatom2;
@@ -491,6 +567,8 @@ void ComputeXRD::compute_array()
       } // End of pragma omp for region
     } // End of if LP=1 check
     delete [] f;
+    delete [] rhore;
+    delete [] rhoim;
   } // End of pragma omp parallel region
 
   double *scratch = new double[2*size_array_rows];
@@ -530,6 +608,9 @@ double ComputeXRD::memory_usage()
   bytes += (double)nlocalgroup * sizeof(int); // typelocal
   bytes += (double)ntypes * sizeof(double); // f
   bytes += (double)3.0 * size_array_rows * sizeof(int); // store_temp
+#if defined(LMP_DIFFRACTION_MESH)
+  if (mesh) bytes += mesh->memory_usage(); // transformed densities
+#endif
 
   return bytes;
 }
@@ -52,6 +52,12 @@ class ComputeXRD : public Compute {
   int radflag;
   int *store_tmp;
 
+  int meshflag;              // 1 if structure factors are computed on a mesh
+  int mesh_order;            // order of mesh assignment function
+  double mesh_oversample;    // oversampling of mesh
+  int cmesh[3];              // integer c's = mesh index stride of relp
+  class DiffractionMesh *mesh;
+
 };
 
 }
@@ -0,0 +1,396 @@
+/* ----------------------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://lammps.sandia.gov/, Sandia National Laboratories
+   Steve Plimpton, sjplimp@sandia.gov
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#include "diffraction_mesh.h"
+
+#include "atom.h"
+#include "domain.h"
+#include "error.h"
+#include "fft3d_wrap.h"
+#include "irregular.h"
+#include "math_const.h"
+#include "memory.h"
+
+#include <cmath>
+#include <cstring>
+
+using namespace LAMMPS_NS;
+using namespace MathConst;
+
+#define MAXORDER 10
+
+/* ---------------------------------------------------------------------- */
+
+DiffractionMesh::DiffractionMesh(LAMMPS *lmp, int order_caller,
+                                 double oversample_caller) :
+  Pointers(lmp), yloc(nullptr), zloc(nullptr), present(nullptr),
+  rhok(nullptr), gfx(nullptr), gfy(nullptr), gfz(nullptr), fft(nullptr)
+{
+  MPI_Comm_rank(world,&me);
+  MPI_Comm_size(world,&nprocs);
+
+  order = order_caller;
+  oversample = oversample_caller;
+  if (order < 2 || order > MAXORDER)
+    error->all(FLERR,"Diffraction mesh order must be between 2 and 10");
+  if (oversample < 1.0)
+    error->all(FLERR,"Diffraction mesh oversampling must be at least 1");
+  nx = ny = nz = 0;
+  nfft = 0;
+  ntypes = 0;
+}
+
+/* ---------------------------------------------------------------------- */
+
+DiffractionMesh::~DiffractionMesh()
+{
+  if (rhok)
+    for (int itype = 0; itype < ntypes; itype++) memory->destroy(rhok[itype]);
+  delete [] rhok;
+  delete [] present;
+  memory->destroy(yloc);
+  memory->destroy(zloc);
+  memory->destroy(gfx);
+  memory->destroy(gfy);
+  memory->destroy(gfz);
+  delete fft;
+}
+
+/* ----------------------------------------------------------------------
+   set up mesh and FFT for frequency indices up to hmax in each dim
+   mesh is oversampled and boosted until it is factorable
+------------------------------------------------------------------------- */
+
+void DiffractionMesh::setup(int *hmax)
+{
+  nx = static_cast<int> (ceil(oversample*(2*hmax[0]+1)));
+  ny = static_cast<int> (ceil(oversample*(2*hmax[1]+1)));
+  nz = static_cast<int> (ceil(oversample*(2*hmax[2]+1)));
+  while (!factorable(nx)) nx++;
+  while (!factorable(ny)) ny++;
+  while (!factorable(nz)) nz++;
+
+  if ((double) nx * ny * nz > MAXSMALLINT)
+    error->all(FLERR,"Diffraction mesh is too large");
+
+  // x-pencil decomposition of mesh, same as for PPPM FFTs
+  // each proc owns entire x-dimension, clumps of columns in y,z dimensions
+
+  if (nz >= nprocs) {
+    npey = 1;
+    npez = nprocs;
+  } else procs2grid2d(nprocs,ny,nz,&npey,&npez);
+
+  int me_y = me % npey;
+  int me_z = me / npey;
+
+  nylo = me_y*ny/npey;
+  nyhi = (me_y+1)*ny/npey - 1;
+  nzlo = me_z*nz/npez;
+  nzhi = (me_z+1)*nz/npez - 1;
+  nfft = nx * (nyhi-nylo+1) * (nzhi-nzlo+1);
+
+  // owning pencil of each y,z column of the mesh
+
+  memory->create(yloc,ny,"diffraction/mesh:yloc");
+  memory->create(zloc,nz,"diffraction/mesh:zloc");
+  for (int m = 0; m < npey; m++)
+    for (int j = m*ny/npey; j < (m+1)*ny/npey; j++) yloc[j] = m;
+  for (int m = 0; m < npez; m++)
+    for (int k = m*nz/npez; k < (m+1)*nz/npez; k++) zloc[k] = m;
+
+  memory->create(gfx,nx,"diffraction/mesh:gfx");
+  memory->create(gfy,ny,"diffraction/mesh:gfy");
+  memory->create(gfz,nz,"diffraction/mesh:gfz");
+  deconvolution(nx,gfx);
+  deconvolution(ny,gfy);
+  deconvolution(nz,gfz);
+
+  ntypes = atom->ntypes;
+  present = new int[ntypes];
+  rhok = new FFT_SCALAR*[ntypes];
+  for (int itype = 0; itype < ntypes; itype++) {
+    present[itype] = 0;
+    rhok[itype] = nullptr;
+  }
+
+  int tmp;
+  fft = new FFT3d(lmp,world,nx,ny,nz,
+                  0,nx-1,nylo,nyhi,nzlo,nzhi,
+                  0,nx-1,nylo,nyhi,nzlo,nzhi,
+                  0,0,&tmp,0);
+}
+
+/* ----------------------------------------------------------------------
+   assign atoms in group to the mesh with one density per atom type
+   each atom is sent to the procs owning the mesh points of its stencil
+   then forward FFT the density of each type present in the group
+------------------------------------------------------------------------- */
+
+void DiffractionMesh::compute(int groupbit)
+{
+  int i,j,m,n,iy,iz,ny_one,nz_one;
+  int ly[MAXORDER],lz[MAXORDER];
+  double w[MAXORDER];
+
+  double **x = atom->x;
+  int *type = atom->type;
+  int *mask = atom->mask;
+  int nlocal = atom->nlocal;
+  double *boxlo = domain->boxlo;
+  double *prd = domain->prd;
+
+  // types with atoms in group
+
+  int *mypresent = new int[ntypes];
+  for (m = 0; m < ntypes; m++) mypresent[m] = 0;
+  for (i = 0; i < nlocal; i++)
+    if (mask[i] & groupbit) mypresent[type[i]-1] = 1;
+  MPI_Allreduce(mypresent,present,ntypes,MPI_INT,MPI_MAX,world);
+  delete [] mypresent;
+
+  // list of atoms to send
+  // each atom goes to every pencil its y,z stencil touches
+
+  int nsend = 0;
+  int maxsend = 0;
+  int *proclist = nullptr;
+  MeshAtom *sendbuf = nullptr;
+
+  for (i = 0; i < nlocal; i++) {
+    if (!(mask[i] & groupbit)) continue;
+
+    MeshAtom one;
+    one.u[0] = (x[i][0]-boxlo[0]) * nx / prd[0];
+    one.u[1] = (x[i][1]-boxlo[1]) * ny / prd[1];
+    one.u[2] = (x[i][2]-boxlo[2]) * nz / prd[2];
+    one.type = type[i];
+
+    ny_one = 0;
+    weights(one.u[1],m,w);
+    for (j = 0; j < order; j++) {
+      int loc = yloc[((m+j) % ny + ny) % ny];
+      for (n = 0; n < ny_one; n++)
+        if (ly[n] == loc) break;
+      if (n == ny_one) ly[ny_one++] = loc;
+    }
+    nz_one = 0;
+    weights(one.u[2],m,w);
+    for (j = 0; j < order; j++) {
+      int loc = zloc[((m+j) % nz + nz) % nz];
+      for (n = 0; n < nz_one; n++)
+        if (lz[n] == loc) break;
+      if (n == nz_one) lz[nz_one++] = loc;
+    }
+
+    for (iy = 0; iy < ny_one; iy++)
+      for (iz = 0; iz < nz_one; iz++) {
+        if (nsend == maxsend) {
+          maxsend = 2*maxsend + 1;
+          proclist = (int *)
+            memory->srealloc(proclist,maxsend*sizeof(int),
+                             "diffraction/mesh:proclist");
+          sendbuf = (MeshAtom *)
+            memory->srealloc(sendbuf,maxsend*sizeof(MeshAtom),
+                             "diffraction/mesh:sendbuf");
+        }
+        proclist[nsend] = ly[iy] + lz[iz]*npey;
+        sendbuf[nsend++] = one;
+      }
+  }
+
+  Irregular *irregular = new Irregular(lmp);
+  int nrecv = irregular->create_data(nsend,proclist);
+  MeshAtom *recvbuf = (MeshAtom *)
+    memory->smalloc(MAX(nrecv,1)*sizeof(MeshAtom),"diffraction/mesh:recvbuf");
+  irregular->exchange_data((char *) sendbuf,sizeof(MeshAtom),(char *) recvbuf);
+  irregular->destroy_data();
+  delete irregular;
+  memory->sfree(proclist);
+  memory->sfree(sendbuf);
+
+  // spread received atoms onto my mesh points
+  // density is real, imaginary parts stay zero
+
+  for (m = 0; m < ntypes; m++) {
+    if (!present[m]) continue;
+    if (!rhok[m]) memory->create(rhok[m],2*nfft,"diffraction/mesh:rhok");
+    memset(rhok[m],0,2*nfft*sizeof(FFT_SCALAR));
+  }
+
+  int nxy = nx * (nyhi-nylo+1);
+  int mx,my,mz,jx,jy,jz,kx,ky,kz;
+  double wx[MAXORDER],wy[MAXORDER],wz[MAXORDER];
+
+  for (n = 0; n < nrecv; n++) {
+    MeshAtom &one = recvbuf[n];
+    FFT_SCALAR *rho = rhok[one.type-1];
+    weights(one.u[0],mx,wx);
+    weights(one.u[1],my,wy);
+    weights(one.u[2],mz,wz);
+
+    for (jz = 0; jz < order; jz++) {
+      kz = ((mz+jz) % nz + nz) % nz;
+      if (kz < nzlo || kz > nzhi) continue;
+      for (jy = 0; jy < order; jy++) {
+        ky = ((my+jy) % ny + ny) % ny;
+        if (ky < nylo || ky > nyhi) continue;
+        double wyz = wz[jz]*wy[jy];
+        int offset = (kz-nzlo)*nxy + (ky-nylo)*nx;
+        for (jx = 0; jx < order; jx++) {
+          kx = ((mx+jx) % nx + nx) % nx;
+          rho[2*(offset+kx)] += wyz*wx[jx];
+        }
+      }
+    }
+  }
+
+  memory->sfree(recvbuf);
+
+  for (m = 0; m < ntypes; m++)
+    if (present[m]) fft->compute(rhok[m],rhok[m],FFT3d::FORWARD);
+}
+
+/* ----------------------------------------------------------------------
+   structure factor of each type for frequency indices h,k,l
+   deconvolved by the transform of the assignment function
+   return 0 if the mesh point is not owned by me
+------------------------------------------------------------------------- */
+
+int DiffractionMesh::density(int h, int k, int l, double *re, double *im)
+{
+  int ix = (h % nx + nx) % nx;
+  int iy = (k % ny + ny) % ny;
+  int iz = (l % nz + nz) % nz;
+  if (iy < nylo || iy > nyhi || iz < nzlo || iz > nzhi) return 0;
+
+  int index = ((iz-nzlo)*(nyhi-nylo+1) + iy-nylo)*nx + ix;
+  double gf = gfx[ix]*gfy[iy]*gfz[iz];
+
+  for (int m = 0; m < ntypes; m++) {
+    if (present[m]) {
+      re[m] = gf*rhok[m][2*index];
+      im[m] = gf*rhok[m][2*index+1];
+    } else re[m] = im[m] = 0.0;
+  }
+  return 1;
+}
+
+/* ----------------------------------------------------------------------
+   B-spline weights of order points of the stencil of coord u in mesh units
+   m = index of first mesh point, not wrapped into the periodic mesh
+------------------------------------------------------------------------- */
+
+void DiffractionMesh::weights(double u, int &m, double *w)
+{
+  double t = u - 0.5*order;
+  m = static_cast<int> (ceil(t));
+  double frac = m - t;
+
+  w[0] = 1.0;
+  for (int j = 1; j < order; j++) w[j] = 0.0;
+
+  for (int k = 2; k <= order; k++) {
+    double denom = 1.0/(k-1);
+    for (int j = k-1; j > 0; j--) {
+      double s = frac + j;
+      w[j] = denom * (s*w[j] + (k-s)*w[j-1]);
+    }
+    w[0] = denom * frac*w[0];
+  }
+}
+
+/* ----------------------------------------------------------------------
+   inverse of the Fourier transform of the assignment function along
+   one dim = 1 / sinc(pi h/n)^order for signed frequency h
+------------------------------------------------------------------------- */
+
+void DiffractionMesh::deconvolution(int n, double *gf)
+{
+  for (int m = 0; m < n; m++) {
+    int h = (2*m <= n) ? m : m-n;
+    double arg = MY_PI*h/n;
+    double sinc = h ? sin(arg)/arg : 1.0;
+    gf[m] = 1.0/pow(sinc,order);
+  }
+}
+
+/* ---------------------------------------------------------------------- */
+
+int DiffractionMesh::factorable(int n)
+{
+  const int factors[3] = {2,3,5};
+  int i;
+
+  while (n > 1) {
+    for (i = 0; i < 3; i++) {
+      if (n % factors[i] == 0) {
+        n /= factors[i];
+        break;
+      }
+    }
+    if (i == 3) return 0;
+  }
+
+  return 1;
+}
+
+/* ----------------------------------------------------------------------
+   map nprocs to NX by NY grid as PX by PY procs
+------------------------------------------------------------------------- */
+
+void DiffractionMesh::procs2grid2d(int nprocs, int nx, int ny, int *px, int *py)
+{
+  // loop thru all possible factorizations of nprocs
+  // surf = surface area of largest proc sub-domain
+  // innermost if test minimizes surface area and surface/volume ratio
+
+  int bestsurf = 2 * (nx + ny);
+  int bestboxx = 0;
+  int bestboxy = 0;
+
+  int boxx,boxy,surf,ipx,ipy;
+
+  ipx = 1;
+  while (ipx <= nprocs) {
+    if (nprocs % ipx == 0) {
+      ipy = nprocs/ipx;
+      boxx = nx/ipx;
+      if (nx % ipx) boxx++;
+      boxy = ny/ipy;
+      if (ny % ipy) boxy++;
+      surf = boxx + boxy;
+      if (surf < bestsurf ||
+          (surf == bestsurf && boxx*boxy > bestboxx*bestboxy)) {
+        bestsurf = surf;
+        bestboxx = boxx;
+        bestboxy = boxy;
+        *px = ipx;
+        *py = ipy;
+      }
+    }
+    ipx++;
+  }
+}
+
+/* ---------------------------------------------------------------------- */
+
+double DiffractionMesh::memory_usage()
+{
+  double bytes = (double)(nx + ny + nz) * sizeof(double);
+  bytes += (double)(ny + nz) * sizeof(int);
+  if (rhok)
+    for (int m = 0; m < ntypes; m++)
+      if (rhok[m]) bytes += (double)2 * nfft * sizeof(FFT_SCALAR);
+  return bytes;
+}
@@ -0,0 +1,88 @@
+/* -*- c++ -*- ----------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://lammps.sandia.gov/, Sandia National Laboratories
+   Steve Plimpton, sjplimp@sandia.gov
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#ifndef LMP_DIFFRACTION_MESH_H
+#define LMP_DIFFRACTION_MESH_H
+
+#include "pointers.h"
+
+#ifdef FFT_SINGLE
+typedef float FFT_SCALAR;
+#else
+typedef double FFT_SCALAR;
+#endif
+
+namespace LAMMPS_NS {
+
+// Fourier transform of per-type atom densities on a periodic mesh
+// used by the diffraction computes instead of explicit sums over atoms
+
+class DiffractionMesh : protected Pointers {
+ public:
+  int nx,ny,nz;              // global mesh size
+
+  DiffractionMesh(class LAMMPS *, int, double);
+  ~DiffractionMesh();
+  void setup(int *);
+  void compute(int);
+  int density(int, int, int, double *, double *);
+  double memory_usage();
+
+ private:
+  int me,nprocs;
+  int order;                 // order of B-spline assignment function
+  double oversample;         // minimum ratio of mesh size to frequency range
+  int ntypes;
+
+  int npey,npez;             // # of procs in y,z dims of x-pencil layout
+  int nylo,nyhi,nzlo,nzhi;   // portion of mesh owned by me
+  int nfft;                  // # of mesh points owned by me
+  int *yloc,*zloc;           // pencil index in y,z of each mesh column
+  int *present;              // 1 if atoms of a type are in the group
+
+  FFT_SCALAR **rhok;         // transformed density of each type, my points
+  double *gfx,*gfy,*gfz;     // inverse Fourier transform of assignment fn
+  class FFT3d *fft;
+
+  struct MeshAtom {          // atom sent to owners of its stencil
+    double u[3];             // position in mesh units
+    int type;
+  };
+
+  void weights(double, int &, double *);
+  void deconvolution(int, double *);
+  int factorable(int);
+  void procs2grid2d(int, int, int, int *, int *);
+};
+
+}
+
+#endif
+
+/* ERROR/WARNING messages:
+
+E: Diffraction mesh order must be between 2 and 10
+
+Self-explanatory.
+
+E: Diffraction mesh oversampling must be at least 1
+
+Self-explanatory.
+
+E: Diffraction mesh is too large
+
+The mesh needed for the requested range of reciprocal lattice
+points and oversampling exceeds the size of a 32-bit integer.
+Reduce the range or the oversampling.
+
+*/
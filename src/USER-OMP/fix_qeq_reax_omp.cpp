@@ -89,6 +89,9 @@ void FixQEqReaxOMP::post_constructor()
       s_hist[i][j] = t_hist[i][j] = 0;
 
   pertype_parameters(pertype_option);
+  if (pipelined || precond)
+    error->all(FLERR,"Fix qeq/reax/omp does not support the pipelined "
+               "and precond bjacobi keywords");
 }
 
 /* ---------------------------------------------------------------------- */
@@ -290,7 +293,7 @@ void FixQEqReaxOMP::pre_force(int /* vflag */)
   // need to be atom->nmax in length
 
   if (atom->nmax > nmax) reallocate_storage();
-  if (n > n_cap*DANGER_ZONE || m_fill > m_cap*DANGER_ZONE)
+  if (check_matrix_size(n))
     reallocate_matrix();
 
 #ifdef OMP_TIMING
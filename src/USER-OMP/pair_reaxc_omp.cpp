@@ -328,6 +328,8 @@ void PairReaxCOMP::init_style( )
                    || (modify->find_fix_by_style("^qeq/shielded") != -1));
   if (!have_qeq && qeqflag == 1)
     error->all(FLERR,"Pair reax/c requires use of fix qeq/reax or qeq/shielded");
+  if (system->exactlists)
+    error->all(FLERR,"Pair reax/c/omp does not support exactlists yes");
 
   system->n = atom->nlocal; // my atoms
   system->N = atom->nlocal + atom->nghost; // mine + ghosts
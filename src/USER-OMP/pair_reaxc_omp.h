@@ -101,4 +101,9 @@ Number of ghost atoms has increased too much during simulation and has exceeded
 the size of reax/c arrays.  Increase safe_zone and min_cap in pair_style reax/c
 command
 
+E: Pair reax/c/omp does not support exactlists yes
+
+The threaded bond list reductions require the estimated list sizes.
+Use exactlists no with this style.
+
 */
@@ -31,6 +31,7 @@ under
 #include "modify.h"
 #include "neigh_list.h"
 #include "neigh_request.h"
+#include "neigh_shell.h"
 #include "neighbor.h"
 #include "update.h"
 #include "group.h"
@@ -61,7 +62,7 @@ static const char cite_user_ptm_package[] =
 /* ---------------------------------------------------------------------- */
 
 ComputePTMAtom::ComputePTMAtom(LAMMPS *lmp, int narg, char **arg)
-    : Compute(lmp, narg, arg), list(nullptr), output(nullptr) {
+    : Compute(lmp, narg, arg), list(nullptr), shell(nullptr), output(nullptr) {
   if (narg < 5 || narg > 6)
     error->all(FLERR, "Illegal compute ptm/atom command");
 
@@ -166,7 +167,18 @@ void ComputePTMAtom::init() {
 
 /* ---------------------------------------------------------------------- */
 
-void ComputePTMAtom::init_list(int /* id */, NeighList *ptr) { list = ptr; }
+void ComputePTMAtom::init_list(int /* id */, NeighList *ptr) {
+  list = ptr;
+
+  // nearest neighbors of owned atoms are taken from the shells shared with
+  // other computes that use an identical neighbor list, unless they are
+  // restricted to a group
+
+  shell = nullptr;
+  if (group2bit != group->bitmask[0]) return;
+  shell = list->get_shell();
+  shell->request(PTM_MAX_INPUT_POINTS - 1);
+}
 
 /* ---------------------------------------------------------------------- */
 
@@ -179,6 +191,8 @@ typedef struct
   int nlocal;
   int *mask;
   int group2bit;
+  int *numshell;
+  int **shell;
 
 } ptmnbrdata_t;
 
@@ -201,6 +215,28 @@ static int get_neighbours(void* vdata, size_t central_index, size_t atom_index,
   double **x = data->x;
   double *pos = x[atom_index];
 
+  // owned atoms: nearest neighbors are already sorted in the shell
+
+  if (data->shell && atom_index < (size_t) data->nlocal) {
+    int *nearest = data->shell[atom_index];
+    int num_nbrs = std::min(num - 1, data->numshell[atom_index]);
+
+    nbr_pos[0][0] = nbr_pos[0][1] = nbr_pos[0][2] = 0;
+    nbr_indices[0] = atom_index;
+    numbers[0] = 0;
+    for (int jj = 0; jj < num_nbrs; jj++) {
+      int j = nearest[jj];
+      nbr_pos[jj + 1][0] = x[j][0] - pos[0];
+      nbr_pos[jj + 1][1] = x[j][1] - pos[1];
+      nbr_pos[jj + 1][2] = x[j][2] - pos[2];
+
+      nbr_indices[jj + 1] = j;
+      numbers[jj + 1] = 0;
+    }
+
+    return num_nbrs + 1;
+  }
+
   int *jlist = nullptr;
   int jnum = 0;
   if (atom_index < data->nlocal) {
@@ -273,6 +309,7 @@ void ComputePTMAtom::compute_peratom() {
 
   // invoke full neighbor list (will copy or build if necessary)
   neighbor->build_one(list);
+  if (shell) shell->build();
 
   int inum = list->inum;
   int *ilist = list->ilist;
@@ -281,7 +318,12 @@ void ComputePTMAtom::compute_peratom() {
 
   double **x = atom->x;
   int *mask = atom->mask;
-  ptmnbrdata_t nbrlist = {x, numneigh, firstneigh, ilist, atom->nlocal, mask, group2bit};
+  ptmnbrdata_t nbrlist = {x, numneigh, firstneigh, ilist, atom->nlocal, mask, group2bit,
+                          nullptr, nullptr};
+  if (shell) {
+    nbrlist.numshell = shell->numshell;
+    nbrlist.shell = shell->shell;
+  }
 
   // zero output
 
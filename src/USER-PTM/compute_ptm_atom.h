@@ -38,6 +38,7 @@ class ComputePTMAtom : public Compute {
   smallint input_flags;
   double rmsd_threshold;
   class NeighList *list;
+  class NeighShell *shell;
   double **output;
   int group2bit;
 };
@@ -46,6 +46,14 @@ using namespace FixConst;
 #define SQR(x) ((x)*(x))
 #define CUBE(x) ((x)*(x)*(x))
 
+enum{PRECOND_JACOBI,PRECOND_BJACOBI};
+
+// relaxation factor of the SSOR sweep in the block Jacobi preconditioner.
+// QEq matrices are far from diagonally dominant, plain Gauss-Seidel
+// (1.0) converges no faster than the diagonal preconditioner.
+
+#define BJACOBI_OMEGA 0.5
+
 static const char cite_fix_qeq_reax[] =
   "fix qeq/reax command:\n\n"
   "@Article{Aktulga12,\n"
@@ -62,7 +70,7 @@ static const char cite_fix_qeq_reax[] =
 FixQEqReax::FixQEqReax(LAMMPS *lmp, int narg, char **arg) :
   Fix(lmp, narg, arg), pertype_option(nullptr)
 {
-  if (narg<8 || narg>11) error->all(FLERR,"Illegal fix qeq/reax command");
+  if (narg<8 || narg>14) error->all(FLERR,"Illegal fix qeq/reax command");
 
   nevery = utils::inumeric(FLERR,arg[3],false,lmp);
   if (nevery <= 0) error->all(FLERR,"Illegal fix qeq/reax command");
@@ -78,6 +86,8 @@ FixQEqReax::FixQEqReax(LAMMPS *lmp, int narg, char **arg) :
   // check for compatibility is in Fix::post_constructor()
   dual_enabled = 0;
   imax = 200;
+  pipelined = 0;
+  precond = PRECOND_JACOBI;
 
   int iarg = 8;
   while (iarg < narg) {
@@ -87,6 +97,14 @@ FixQEqReax::FixQEqReax(LAMMPS *lmp, int narg, char **arg) :
         error->all(FLERR,"Illegal fix qeq/reax command");
       imax = utils::numeric(FLERR,arg[iarg+1],false,lmp);
       iarg++;
+    } else if (strcmp(arg[iarg],"pipelined") == 0) pipelined = 1;
+    else if (strcmp(arg[iarg],"precond") == 0) {
+      if (iarg+1 > narg-1)
+        error->all(FLERR,"Illegal fix qeq/reax command");
+      if (strcmp(arg[iarg+1],"jacobi") == 0) precond = PRECOND_JACOBI;
+      else if (strcmp(arg[iarg+1],"bjacobi") == 0) precond = PRECOND_BJACOBI;
+      else error->all(FLERR,"Illegal fix qeq/reax command");
+      iarg++;
     } else error->all(FLERR,"Illegal fix qeq/reax command");
     iarg++;
   }
@@ -112,6 +130,14 @@ FixQEqReax::FixQEqReax(LAMMPS *lmp, int narg, char **arg) :
   r = nullptr;
   d = nullptr;
 
+  // pipelined CG
+  r2 = u2 = w2 = m2 = n2 = z2 = q2 = s2 = p2 = nullptr;
+
+  // local block preconditioner
+  L_first = L_num = L_jlist = nullptr;
+  L_val = nullptr;
+  L_cap = 0;
+
   // H matrix
   H.firstnbr = nullptr;
   H.numnbrs = nullptr;
@@ -120,7 +146,7 @@ FixQEqReax::FixQEqReax(LAMMPS *lmp, int narg, char **arg) :
 
   // dual CG support
   // Update comm sizes for this fix
-  if (dual_enabled) comm_forward = comm_reverse = 2;
+  if (dual_enabled || pipelined) comm_forward = comm_reverse = 2;
   else comm_forward = comm_reverse = 1;
 
   // perform initial allocation of atom-based arrays
@@ -150,6 +176,8 @@ FixQEqReax::~FixQEqReax()
 
   deallocate_storage();
   deallocate_matrix();
+  memory->destroy(L_jlist);
+  memory->destroy(L_val);
 
   memory->destroy(shld);
 
@@ -263,6 +291,23 @@ void FixQEqReax::allocate_storage()
   memory->create(q,size,"qeq:q");
   memory->create(r,size,"qeq:r");
   memory->create(d,size,"qeq:d");
+
+  if (pipelined) {
+    memory->create(r2,2*nmax,"qeq:r2");
+    memory->create(u2,2*nmax,"qeq:u2");
+    memory->create(w2,2*nmax,"qeq:w2");
+    memory->create(m2,2*nmax,"qeq:m2");
+    memory->create(n2,2*nmax,"qeq:n2");
+    memory->create(z2,2*nmax,"qeq:z2");
+    memory->create(q2,2*nmax,"qeq:q2");
+    memory->create(s2,2*nmax,"qeq:s2");
+    memory->create(p2,2*nmax,"qeq:p2");
+  }
+
+  if (precond == PRECOND_BJACOBI) {
+    memory->create(L_first,nmax,"qeq:L_first");
+    memory->create(L_num,nmax,"qeq:L_num");
+  }
 }
 
 /* ---------------------------------------------------------------------- */
@@ -282,6 +327,19 @@ void FixQEqReax::deallocate_storage()
   memory->destroy( q );
   memory->destroy( r );
   memory->destroy( d );
+
+  memory->destroy( r2 );
+  memory->destroy( u2 );
+  memory->destroy( w2 );
+  memory->destroy( m2 );
+  memory->destroy( n2 );
+  memory->destroy( z2 );
+  memory->destroy( q2 );
+  memory->destroy( s2 );
+  memory->destroy( p2 );
+
+  memory->destroy( L_first );
+  memory->destroy( L_num );
 }
 
 /* ---------------------------------------------------------------------- */
@@ -311,7 +369,6 @@ void FixQEqReax::allocate_matrix()
   }
 
   n = atom->nlocal;
-  n_cap = MAX( (int)(n * safezone), mincap);
 
   // determine the total space for the H matrix
 
@@ -320,7 +377,16 @@ void FixQEqReax::allocate_matrix()
     i = ilist[ii];
     m += numneigh[i];
   }
-  m_cap = MAX( (int)(m * safezone), mincap * REAX_MIN_NBRS);
+
+  // with pair reax/c exactlists size the matrix to the current neighbor list
+
+  if (exact_matrix()) {
+    n_cap = MAX(n, 1);
+    m_cap = MAX(m, 1);
+  } else {
+    n_cap = MAX( (int)(n * safezone), mincap);
+    m_cap = MAX( (int)(m * safezone), mincap * REAX_MIN_NBRS);
+  }
 
   H.n = n_cap;
   H.m = m_cap;
@@ -348,6 +414,29 @@ void FixQEqReax::reallocate_matrix()
   allocate_matrix();
 }
 
+/* ----------------------------------------------------------------------
+   check if the H matrix must be reallocated before it is filled.
+   an exactly sized matrix holds all pairs of the current neighbor list
+   and is shrunk again when it becomes mostly unused.
+------------------------------------------------------------------------- */
+
+int FixQEqReax::check_matrix_size(int n)
+{
+  if (!exact_matrix())
+    return (n > n_cap*DANGER_ZONE || m_fill > m_cap*DANGER_ZONE);
+
+  int m = 0;
+  for (int ii = 0; ii < nn; ii++) m += numneigh[ilist[ii]];
+  return (n > n_cap || m > m_cap || m < m_cap*LOOSE_ZONE);
+}
+
+/* ---------------------------------------------------------------------- */
+
+int FixQEqReax::exact_matrix()
+{
+  return (reaxflag && reaxc && reaxc->system->exactlists);
+}
+
 /* ---------------------------------------------------------------------- */
 
 void FixQEqReax::init()
@@ -528,14 +617,19 @@ void FixQEqReax::pre_force(int /*vflag*/)
   // need to be atom->nmax in length
 
   if (atom->nmax > nmax) reallocate_storage();
-  if (n > n_cap*DANGER_ZONE || m_fill > m_cap*DANGER_ZONE)
+  if (check_matrix_size(n))
     reallocate_matrix();
 
   init_matvec();
 
-  matvecs_s = CG(b_s, s);       // CG on s - parallel
-  matvecs_t = CG(b_t, t);       // CG on t - parallel
-  matvecs = matvecs_s + matvecs_t;
+  if (pipelined) {
+    matvecs = pipelined_CG(b_s, b_t, s, t); // s & t together - parallel
+    matvecs_s = matvecs_t = matvecs;
+  } else {
+    matvecs_s = CG(b_s, s);       // CG on s - parallel
+    matvecs_t = CG(b_t, t);       // CG on t - parallel
+    matvecs = matvecs_s + matvecs_t;
+  }
 
   calculate_Q();
 
@@ -585,6 +679,8 @@ void FixQEqReax::init_matvec()
     }
   }
 
+  if (precond == PRECOND_BJACOBI) build_local_block();
+
   pack_flag = 2;
   comm->forward_comm_fix(this); //Dist_vector( s );
   pack_flag = 3;
@@ -681,23 +777,17 @@ double FixQEqReax::calculate_H( double r, double gamma)
 
 int FixQEqReax::CG( double *b, double *x)
 {
-  int  i, j;
+  int  i;
   double tmp, alpha, beta, b_norm;
   double sig_old, sig_new;
 
-  int jj;
-
   pack_flag = 1;
   sparse_matvec( &H, x, q);
   comm->reverse_comm_fix(this); //Coll_Vector( q );
 
   vector_sum( r , 1.,  b, -1., q, nn);
 
-  for (jj = 0; jj < nn; ++jj) {
-    j = ilist[jj];
-    if (atom->mask[j] & groupbit)
-      d[j] = r[j] * Hdia_inv[j]; //pre-condition
-  }
+  precondition(r, d, 1); //pre-condition
 
   b_norm = parallel_norm( b, nn);
   sig_new = parallel_dot( r, d, nn);
@@ -714,11 +804,7 @@ int FixQEqReax::CG( double *b, double *x)
     vector_add( r, -alpha, q, nn );
 
     // pre-conditioning
-    for (jj = 0; jj < nn; ++jj) {
-      j = ilist[jj];
-      if (atom->mask[j] & groupbit)
-        p[j] = r[j] * Hdia_inv[j];
-    }
+    precondition(r, p, 1);
 
     sig_old = sig_new;
     sig_new = parallel_dot( r, p, nn);
@@ -738,6 +824,309 @@ int FixQEqReax::CG( double *b, double *x)
 }
 
 
+/* ----------------------------------------------------------------------
+   pipelined preconditioned CG (Ghysels and Vanroose) for the s and t
+   systems at once.  the dot products of both systems are combined into
+   a single non-blocking reduction which overlaps with the
+   preconditioner, the matvec and its ghost communication.
+   vectors hold the s and t values of atom i at 2*i and 2*i+1.
+------------------------------------------------------------------------- */
+
+int FixQEqReax::pipelined_CG(double *b1, double *b2, double *x1, double *x2)
+{
+  int i, ii, k, jj;
+  double my_buf[4], buf[4];
+  double b_norm[2], gamma[2], delta[2], gamma_old[2], alpha[2], beta[2];
+  int active[2];
+  MPI_Request request;
+
+  int *mask = atom->mask;
+
+  // r = b - A x, with x already communicated to the ghost atoms
+
+  for (jj = 0; jj < NN; ++jj) {
+    i = ilist[jj];
+    m2[2*i  ] = x1[i];
+    m2[2*i+1] = x2[i];
+  }
+
+  pack_flag = 6; // forward 2x m2 and reverse 2x n2
+  sparse_matvec2(&H, m2, n2);
+  comm->reverse_comm_fix(this);
+
+  my_buf[0] = my_buf[1] = 0.0;
+  for (jj = 0; jj < nn; ++jj) {
+    i = ilist[jj];
+    if (mask[i] & groupbit) {
+      r2[2*i  ] = b1[i] - n2[2*i  ];
+      r2[2*i+1] = b2[i] - n2[2*i+1];
+      my_buf[0] += b1[i] * b1[i];
+      my_buf[1] += b2[i] * b2[i];
+    }
+  }
+  MPI_Iallreduce(my_buf, buf, 2, MPI_DOUBLE, MPI_SUM, world, &request);
+
+  // u = M^-1 r, w = A u
+
+  precondition(r2, m2, 2);
+  comm->forward_comm_fix(this);
+  sparse_matvec2(&H, m2, n2);
+  comm->reverse_comm_fix(this);
+
+  for (jj = 0; jj < nn; ++jj) {
+    i = ilist[jj];
+    if (mask[i] & groupbit)
+      for (k = 0; k < 2; ++k) {
+        u2[2*i+k] = m2[2*i+k];
+        w2[2*i+k] = n2[2*i+k];
+        z2[2*i+k] = q2[2*i+k] = s2[2*i+k] = p2[2*i+k] = 0.0;
+      }
+  }
+
+  MPI_Wait(&request, MPI_STATUS_IGNORE);
+  b_norm[0] = sqrt(buf[0]);
+  b_norm[1] = sqrt(buf[1]);
+  active[0] = active[1] = 1;
+  alpha[0] = alpha[1] = gamma_old[0] = gamma_old[1] = 0.0;
+
+  for (ii = 1; ii < imax; ++ii) {
+
+    // gamma = (r,u) and delta = (w,u), reduced while m and n are computed
+
+    my_buf[0] = my_buf[1] = my_buf[2] = my_buf[3] = 0.0;
+    for (jj = 0; jj < nn; ++jj) {
+      i = ilist[jj];
+      if (mask[i] & groupbit)
+        for (k = 0; k < 2; ++k) {
+          my_buf[k]   += r2[2*i+k] * u2[2*i+k];
+          my_buf[2+k] += w2[2*i+k] * u2[2*i+k];
+        }
+    }
+    MPI_Iallreduce(my_buf, buf, 4, MPI_DOUBLE, MPI_SUM, world, &request);
+
+    // m = M^-1 w, n = A m
+
+    precondition(w2, m2, 2);
+    comm->forward_comm_fix(this);
+    sparse_matvec2(&H, m2, n2);
+    comm->reverse_comm_fix(this);
+
+    MPI_Wait(&request, MPI_STATUS_IGNORE);
+
+    for (k = 0; k < 2; ++k) {
+      gamma[k] = buf[k];
+      delta[k] = buf[2+k];
+      if (active[k] && sqrt(gamma[k])/b_norm[k] <= tolerance) active[k] = 0;
+      if (!active[k]) {
+        alpha[k] = beta[k] = 0.0;
+        continue;
+      }
+      if (ii > 1) {
+        beta[k] = gamma[k] / gamma_old[k];
+        alpha[k] = gamma[k] / (delta[k] - beta[k]*gamma[k]/alpha[k]);
+      } else {
+        beta[k] = 0.0;
+        alpha[k] = gamma[k] / delta[k];
+      }
+      gamma_old[k] = gamma[k];
+    }
+    if (!active[0] && !active[1]) break;
+
+    for (jj = 0; jj < nn; ++jj) {
+      i = ilist[jj];
+      if (mask[i] & groupbit)
+        for (k = 0; k < 2; ++k) {
+          if (!active[k]) continue;
+          const int ik = 2*i+k;
+          z2[ik] = n2[ik] + beta[k] * z2[ik];
+          q2[ik] = m2[ik] + beta[k] * q2[ik];
+          s2[ik] = w2[ik] + beta[k] * s2[ik];
+          p2[ik] = u2[ik] + beta[k] * p2[ik];
+          r2[ik] -= alpha[k] * s2[ik];
+          u2[ik] -= alpha[k] * q2[ik];
+          w2[ik] -= alpha[k] * z2[ik];
+        }
+      if (active[0]) x1[i] += alpha[0] * p2[2*i  ];
+      if (active[1]) x2[i] += alpha[1] * p2[2*i+1];
+    }
+  }
+
+  if (ii >= imax && comm->me == 0) {
+    char str[128];
+    sprintf(str,"Fix qeq/reax CG convergence failed after %d iterations "
+            "at " BIGINT_FORMAT " step",ii,update->ntimestep);
+    error->warning(FLERR,str);
+  }
+
+  return ii+1;
+}
+
+/* ----------------------------------------------------------------------
+   apply the preconditioner to r, store result in z
+   r and z hold stride values per atom.  with bjacobi a symmetric
+   SOR sweep over the local block of H approximates its inverse.
+------------------------------------------------------------------------- */
+
+void FixQEqReax::precondition(double *r, double *z, int stride)
+{
+  int i, ii, k, itr_j;
+  int *mask = atom->mask;
+
+  if (precond == PRECOND_JACOBI) {
+    for (ii = 0; ii < nn; ++ii) {
+      i = ilist[ii];
+      if (mask[i] & groupbit)
+        for (k = 0; k < stride; ++k)
+          z[stride*i+k] = r[stride*i+k] * Hdia_inv[i];
+    }
+    return;
+  }
+
+  // forward sweep solves (D/omega+L) y = r
+
+  int nlocal = atom->nlocal;
+  double sum[2];
+
+  for (i = 0; i < nlocal; ++i) {
+    if (!(mask[i] & groupbit)) continue;
+    for (k = 0; k < stride; ++k) sum[k] = r[stride*i+k];
+    for (itr_j = L_first[i]; itr_j < L_first[i]+L_num[i]; ++itr_j) {
+      const int j = L_jlist[itr_j];
+      if (j > i) break;
+      for (k = 0; k < stride; ++k) sum[k] -= L_val[itr_j] * z[stride*j+k];
+    }
+    for (k = 0; k < stride; ++k)
+      z[stride*i+k] = BJACOBI_OMEGA * sum[k] * Hdia_inv[i];
+  }
+
+  // backward sweep solves (D/omega+U) z = D/omega y
+
+  for (i = nlocal-1; i >= 0; --i) {
+    if (!(mask[i] & groupbit)) continue;
+    for (k = 0; k < stride; ++k) sum[k] = 0.0;
+    for (itr_j = L_first[i]+L_num[i]-1; itr_j >= L_first[i]; --itr_j) {
+      const int j = L_jlist[itr_j];
+      if (j < i) break;
+      for (k = 0; k < stride; ++k) sum[k] += L_val[itr_j] * z[stride*j+k];
+    }
+    for (k = 0; k < stride; ++k)
+      z[stride*i+k] -= BJACOBI_OMEGA * sum[k] * Hdia_inv[i];
+  }
+}
+
+/* ----------------------------------------------------------------------
+   copy the couplings among local group atoms from the half H matrix
+   into full rows sorted by atom index, for the block Jacobi preconditioner
+------------------------------------------------------------------------- */
+
+void FixQEqReax::build_local_block()
+{
+  int i, j, ii, itr_j, m;
+  int nlocal = atom->nlocal;
+  int *mask = atom->mask;
+
+  for (i = 0; i < nlocal; ++i) L_num[i] = 0;
+
+  for (ii = 0; ii < nn; ++ii) {
+    i = ilist[ii];
+    if (mask[i] & groupbit)
+      for (itr_j = H.firstnbr[i]; itr_j < H.firstnbr[i]+H.numnbrs[i]; ++itr_j) {
+        j = H.jlist[itr_j];
+        if (j < nlocal && (mask[j] & groupbit)) {
+          L_num[i]++;
+          L_num[j]++;
+        }
+      }
+  }
+
+  m = 0;
+  for (i = 0; i < nlocal; ++i) {
+    L_first[i] = m;
+    m += L_num[i];
+    L_num[i] = 0;
+  }
+
+  if (m > L_cap) {
+    L_cap = m;
+    memory->destroy(L_jlist);
+    memory->destroy(L_val);
+    memory->create(L_jlist,L_cap,"qeq:L_jlist");
+    memory->create(L_val,L_cap,"qeq:L_val");
+  }
+
+  for (ii = 0; ii < nn; ++ii) {
+    i = ilist[ii];
+    if (mask[i] & groupbit)
+      for (itr_j = H.firstnbr[i]; itr_j < H.firstnbr[i]+H.numnbrs[i]; ++itr_j) {
+        j = H.jlist[itr_j];
+        if (j < nlocal && (mask[j] & groupbit)) {
+          m = L_first[i] + L_num[i]++;
+          L_jlist[m] = j;
+          L_val[m] = H.val[itr_j];
+          m = L_first[j] + L_num[j]++;
+          L_jlist[m] = i;
+          L_val[m] = H.val[itr_j];
+        }
+      }
+  }
+
+  // sort each row by atom index so the sweeps can split it at the diagonal
+
+  for (i = 0; i < nlocal; ++i) {
+    const int first = L_first[i];
+    const int last = first + L_num[i];
+    for (itr_j = first+1; itr_j < last; ++itr_j) {
+      const int jtmp = L_jlist[itr_j];
+      const double vtmp = L_val[itr_j];
+      m = itr_j - 1;
+      while (m >= first && L_jlist[m] > jtmp) {
+        L_jlist[m+1] = L_jlist[m];
+        L_val[m+1] = L_val[m];
+        m--;
+      }
+      L_jlist[m+1] = jtmp;
+      L_val[m+1] = vtmp;
+    }
+  }
+}
+
+/* ----------------------------------------------------------------------
+   H times x for the interleaved s and t vectors of pipelined_CG()
+------------------------------------------------------------------------- */
+
+void FixQEqReax::sparse_matvec2(sparse_matrix *A, double *x, double *b)
+{
+  int i, j, itr_j;
+  int ii;
+
+  for (ii = 0; ii < nn; ++ii) {
+    i = ilist[ii];
+    if (atom->mask[i] & groupbit) {
+      b[2*i  ] = eta[ atom->type[i] ] * x[2*i  ];
+      b[2*i+1] = eta[ atom->type[i] ] * x[2*i+1];
+    }
+  }
+
+  for (ii = nn; ii < NN; ++ii) {
+    i = ilist[ii];
+    if (atom->mask[i] & groupbit)
+      b[2*i] = b[2*i+1] = 0;
+  }
+
+  for (ii = 0; ii < nn; ++ii) {
+    i = ilist[ii];
+    if (atom->mask[i] & groupbit) {
+      for (itr_j=A->firstnbr[i]; itr_j<A->firstnbr[i]+A->numnbrs[i]; itr_j++) {
+        j = A->jlist[itr_j];
+        b[2*i  ] += A->val[itr_j] * x[2*j  ];
+        b[2*i+1] += A->val[itr_j] * x[2*j+1];
+        b[2*j  ] += A->val[itr_j] * x[2*i  ];
+        b[2*j+1] += A->val[itr_j] * x[2*i+1];
+      }
+    }
+  }
+}
+
 /* ---------------------------------------------------------------------- */
 
 void FixQEqReax::sparse_matvec( sparse_matrix *A, double *x, double *b)
@@ -827,6 +1216,15 @@ int FixQEqReax::pack_forward_comm(int n, int *list, double *buf,
     }
     return m;
   }
+  else if (pack_flag == 6) {
+    m = 0;
+    for (int i = 0; i < n; i++) {
+      int j = 2 * list[i];
+      buf[m++] = m2[j  ];
+      buf[m++] = m2[j+1];
+    }
+    return m;
+  }
   return n;
 }
 
@@ -852,6 +1250,14 @@ void FixQEqReax::unpack_forward_comm(int n, int first, double *buf)
       d[j  ] = buf[m++];
       d[j+1] = buf[m++];
     }
+  } else if (pack_flag == 6) {
+    int last = first + n;
+    m = 0;
+    for (i = first; i < last; i++) {
+      int j = 2 * i;
+      m2[j  ] = buf[m++];
+      m2[j+1] = buf[m++];
+    }
   }
 }
 
@@ -869,6 +1275,15 @@ int FixQEqReax::pack_reverse_comm(int n, int first, double *buf)
       buf[m++] = q[indxI+1];
     }
     return m;
+  } else if (pack_flag == 6) {
+    m = 0;
+    int last = first + n;
+    for (i = first; i < last; i++) {
+      int indxI = 2 * i;
+      buf[m++] = n2[indxI  ];
+      buf[m++] = n2[indxI+1];
+    }
+    return m;
   } else {
     for (m = 0, i = first; m < n; m++, i++) buf[m] = q[i];
     return n;
@@ -886,6 +1301,13 @@ void FixQEqReax::unpack_reverse_comm(int n, int *list, double *buf)
       q[indxI  ] += buf[m++];
       q[indxI+1] += buf[m++];
     }
+  } else if (pack_flag == 6) {
+    int m = 0;
+    for (int i = 0; i < n; i++) {
+      int indxI = 2 * list[i];
+      n2[indxI  ] += buf[m++];
+      n2[indxI+1] += buf[m++];
+    }
   } else {
     for (int m = 0; m < n; m++) q[list[m]] += buf[m];
   }
@@ -907,6 +1329,12 @@ double FixQEqReax::memory_usage()
 
   if (dual_enabled)
     bytes += (double)atom->nmax*4 * sizeof(double); // double size for q, d, r, and p
+  if (pipelined)
+    bytes += (double)atom->nmax*18 * sizeof(double); // pipelined CG vectors
+  if (precond == PRECOND_BJACOBI) {
+    bytes += (double)atom->nmax*2 * sizeof(int); // local block
+    bytes += (double)L_cap * (sizeof(int) + sizeof(double));
+  }
 
   return bytes;
 }
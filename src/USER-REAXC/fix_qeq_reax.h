@@ -97,6 +97,14 @@ class FixQEqReax : public Fix {
   double *p, *q, *r, *d;
   int imax;
 
+  // pipelined CG storage, s and t values interleaved
+  double *r2, *u2, *w2, *m2, *n2, *z2, *q2, *s2, *p2;
+
+  // local block of H for the block Jacobi preconditioner
+  int *L_first, *L_num, *L_jlist;
+  double *L_val;
+  int L_cap;
+
   //GMRES storage
   //double *g,*y;
   //double **v;
@@ -113,6 +121,8 @@ class FixQEqReax : public Fix {
   virtual void allocate_matrix();
   void deallocate_matrix();
   void reallocate_matrix();
+  int check_matrix_size(int);
+  int exact_matrix();
 
   virtual void init_matvec();
   void init_H();
@@ -121,6 +131,10 @@ class FixQEqReax : public Fix {
   virtual void calculate_Q();
 
   virtual int CG(double*,double*);
+  int pipelined_CG(double*,double*,double*,double*);
+  void precondition(double*,double*,int);
+  void build_local_block();
+  void sparse_matvec2(sparse_matrix*,double*,double*);
   //int GMRES(double*,double*);
   virtual void sparse_matvec(sparse_matrix*,double*,double*);
 
@@ -144,6 +158,10 @@ class FixQEqReax : public Fix {
   // dual CG support
   int dual_enabled;  // 0: Original, separate s & t optimization; 1: dual optimization
   int matvecs_s, matvecs_t; // Iteration count for each system
+
+  // pipelined CG and preconditioner choice
+  int pipelined;     // 1: solve s & t together with pipelined PCG
+  int precond;       // PRECOND_JACOBI or PRECOND_BJACOBI
 };
 
 }
@@ -248,6 +248,7 @@ void PairReaxC::settings(int narg, char **arg)
   system->minhbonds = REAX_MIN_HBONDS;
   system->safezone = REAX_SAFE_ZONE;
   system->saferzone = REAX_SAFER_ZONE;
+  system->exactlists = 0;
 
   // process optional keywords
 
@@ -291,6 +292,12 @@ void PairReaxC::settings(int narg, char **arg)
       if (system->minhbonds < 0)
         error->all(FLERR,"Illegal pair_style reax/c minhbonds command");
       iarg += 2;
+    } else if (strcmp(arg[iarg],"exactlists") == 0) {
+      if (iarg+2 > narg) error->all(FLERR,"Illegal pair_style reax/c command");
+      if (strcmp(arg[iarg+1],"yes") == 0) system->exactlists = 1;
+      else if (strcmp(arg[iarg+1],"no") == 0) system->exactlists = 0;
+      else error->all(FLERR,"Illegal pair_style reax/c command");
+      iarg += 2;
     } else error->all(FLERR,"Illegal pair_style reax/c command");
   }
 
@@ -483,6 +490,8 @@ void PairReaxC::setup( )
       num_hbonds[k] = system->my_atoms[k].num_hbonds;
     }
 
+    report_list_memory();
+
   } else {
 
     // fill in reax datastructures
@@ -497,6 +506,24 @@ void PairReaxC::setup( )
     // check if I need to shrink/extend my data-structs
 
     ReAllocate( system, control, data, workspace, &lists );
+
+    // with exact lists the far neighbor list is resized on every
+    // reneighboring to hold all pairs that can come within the cutoff
+
+    reax_list *far_nbrs = lists + FAR_NBRS;
+    if (system->exactlists &&
+        (neighbor->ago == 0 || far_nbrs->n < system->total_cap)) {
+      int num_nbrs = estimate_reax_lists();
+      if (num_nbrs < 0)
+        error->one(FLERR,"Too many neighbors for pair style reax/c");
+      if ((num_nbrs > far_nbrs->num_intrs)
+          || (num_nbrs < LOOSE_ZONE*far_nbrs->num_intrs)
+          || (far_nbrs->n < system->total_cap)) {
+        Delete_List(far_nbrs);
+        if (!Make_List(system->total_cap, num_nbrs, TYP_FAR_NEIGHBOR, far_nbrs))
+          error->one(FLERR,"Pair reax/c problem in far neighbor list");
+      }
+    }
   }
 
   bigint local_ngroup = list->inum;
@@ -701,26 +728,40 @@ int PairReaxC::estimate_reax_lists()
   num_marked = 0;
   marked = (int*) calloc( system->N, sizeof(int) );
 
+  int inum = list->inum;
   int numall = list->inum + list->gnum;
 
+  // with exact lists count all pairs that can come within the cutoffs
+  // used in write_reax_lists() before the next reneighboring
+
+  double cutoff_sqr = SQR(control->nonb_cut);
+  double skin = neighbor->skin;
+
   for (itr_i = 0; itr_i < numall; ++itr_i) {
     i = ilist[itr_i];
     marked[i] = 1;
     ++num_marked;
     jlist = firstneigh[i];
 
+    if (system->exactlists) {
+      if (i < inum) cutoff_sqr = SQR(control->nonb_cut + skin);
+      else cutoff_sqr = SQR(control->bond_cut + skin);
+    }
+
     for (itr_j = 0; itr_j < numneigh[i]; ++itr_j) {
       j = jlist[itr_j];
       j &= NEIGHMASK;
       get_distance( x[j], x[i], &d_sqr, &dvec );
 
-      if (d_sqr <= SQR(control->nonb_cut))
+      if (d_sqr <= cutoff_sqr)
         ++num_nbrs;
     }
   }
 
   free( marked );
 
+  if (system->exactlists) return MAX(num_nbrs, 1);
+
   return static_cast<int> (MAX(num_nbrs*safezone, mincap*REAX_MIN_NBRS));
 }
 
@@ -767,6 +808,8 @@ int PairReaxC::write_reax_lists()
       get_distance( x[j], x[i], &d_sqr, &dvec );
 
       if (d_sqr <= (cutoff_sqr)) {
+        if (num_nbrs >= far_nbrs->num_intrs)
+          error->one(FLERR,"Pair reax/c far neighbor list overflow");
         dist[j] = sqrt( d_sqr );
         set_far_nbr( &far_list[num_nbrs], j, dist[j], dvec );
         ++num_nbrs;
@@ -838,13 +881,8 @@ double PairReaxC::memory_usage()
   bytes += (double)3.0 * system->total_cap * sizeof(int);
 
   // From reaxc_lists
-  bytes += (double)2.0 * lists->n * sizeof(int);
-  bytes += (double)lists->num_intrs * sizeof(three_body_interaction_data);
-  bytes += (double)lists->num_intrs * sizeof(bond_data);
-  bytes += (double)lists->num_intrs * sizeof(dbond_data);
-  bytes += (double)lists->num_intrs * sizeof(dDelta_data);
-  bytes += (double)lists->num_intrs * sizeof(far_neighbor_data);
-  bytes += (double)lists->num_intrs * sizeof(hbond_data);
+  for (int i = 0; i < LIST_N; ++i)
+    bytes += List_Memory(lists+i);
 
   if (fixspecies_flag)
     bytes += (double)2 * nmax * MAXSPECBOND * sizeof(double);
@@ -852,6 +890,30 @@ double PairReaxC::memory_usage()
   return bytes;
 }
 
+/* ----------------------------------------------------------------------
+   print memory used by the individual reax/c lists, max over all procs
+------------------------------------------------------------------------- */
+
+void PairReaxC::report_list_memory()
+{
+  double mine[4], all[4];
+
+  mine[0] = List_Memory(lists+FAR_NBRS);
+  mine[1] = List_Memory(lists+BONDS);
+  mine[2] = List_Memory(lists+HBONDS);
+  mine[3] = List_Memory(lists+THREE_BODIES);
+  MPI_Reduce(mine,all,4,MPI_DOUBLE,MPI_MAX,0,world);
+
+  if (comm->me == 0) {
+    const double mb = 1.0/1024.0/1024.0;
+    utils::logmesg(lmp,fmt::format("ReaxFF lists memory (Mbytes, max per proc): "
+                                   "far_nbrs {:.4} bonds {:.4} hbonds {:.4} "
+                                   "angles {:.4} ({} lists)\n",
+                                   all[0]*mb,all[1]*mb,all[2]*mb,all[3]*mb,
+                                   system->exactlists ? "exact" : "estimated"));
+  }
+}
+
 /* ---------------------------------------------------------------------- */
 
 void PairReaxC::FindBond()
@@ -82,6 +82,7 @@ class PairReaxC : public Pair {
   int estimate_reax_lists();
   int write_reax_lists();
   void read_reax_forces(int);
+  void report_list_memory();
 
   int nmax;
   void FindBond();
@@ -102,4 +103,11 @@ Number of ghost atoms has increased too much during simulation and has exceeded
 the size of reax/c arrays.  Increase safe_zone and min_cap in pair_style reax/c
 command
 
+E: Pair reax/c far neighbor list overflow
+
+More pairs are within the cutoff than the far neighbor list can hold.
+With exactlists yes the list is sized to the pairs within the cutoff
+plus the neighbor skin, so atoms moved too far between reneighborings.
+Reneighbor more often or use a larger skin.
+
 */
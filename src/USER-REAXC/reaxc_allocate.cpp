@@ -340,7 +340,10 @@ static int Reallocate_HBonds_List( reax_system *system, reax_list *hbonds )
     if ((system->my_atoms[i].Hindex) >= 0) {
       total_hbonds += system->my_atoms[i].num_hbonds;
     }
-  total_hbonds = (int)(MAX(total_hbonds*saferzone, mincap*system->minhbonds));
+  if (system->exactlists)
+    total_hbonds = MAX(total_hbonds, 1);
+  else
+    total_hbonds = (int)(MAX(total_hbonds*saferzone, mincap*system->minhbonds));
 
   Delete_List( hbonds);
   if (!Make_List( system->Hcap, total_hbonds, TYP_HBOND, hbonds )) {
@@ -365,7 +368,10 @@ static int Reallocate_Bonds_List( reax_system *system, reax_list *bonds,
     *est_3body += SQR(system->my_atoms[i].num_bonds);
     *total_bonds += system->my_atoms[i].num_bonds;
   }
-  *total_bonds = (int)(MAX( *total_bonds * safezone, mincap*MIN_BONDS ));
+  if (system->exactlists)
+    *total_bonds = MAX( *total_bonds, 1 );
+  else
+    *total_bonds = (int)(MAX( *total_bonds * safezone, mincap*MIN_BONDS ));
 
 #ifdef LMP_USER_OMP
   if (system->omp_active)
@@ -444,8 +450,8 @@ void ReAllocate( reax_system *system, control_params *control,
 
 
   renbr = (data->step - data->prev_steps) % control->reneighbor == 0;
-  /* far neighbors */
-  if (renbr) {
+  /* far neighbors, sized by the pair style itself with exact lists */
+  if (renbr && !system->exactlists) {
     far_nbrs = *lists + FAR_NBRS;
 
     if (Nflag || realloc->num_far >= far_nbrs->num_intrs * DANGER_ZONE) {
@@ -128,7 +128,10 @@ void Validate_Lists( reax_system *system, storage * /*workspace*/, reax_list **l
     bonds = *lists + BONDS;
 
     for (i = 0; i < N; ++i) {
-      system->my_atoms[i].num_bonds = MAX(Num_Entries(i,bonds)*2, MIN_BONDS);
+      if (system->exactlists)
+        system->my_atoms[i].num_bonds = Num_Entries(i,bonds);
+      else
+        system->my_atoms[i].num_bonds = MAX(Num_Entries(i,bonds)*2, MIN_BONDS);
 
       if (i < N-1)
         comp = Start_Index(i+1, bonds);
@@ -151,8 +154,11 @@ void Validate_Lists( reax_system *system, storage * /*workspace*/, reax_list **l
     for (i = 0; i < N; ++i) {
       Hindex = system->my_atoms[i].Hindex;
       if (Hindex > -1) {
-        system->my_atoms[i].num_hbonds =
-          (int)(MAX(Num_Entries(Hindex, hbonds)*saferzone, system->minhbonds));
+        if (system->exactlists)
+          system->my_atoms[i].num_hbonds = Num_Entries(Hindex, hbonds);
+        else
+          system->my_atoms[i].num_hbonds =
+            (int)(MAX(Num_Entries(Hindex, hbonds)*saferzone, system->minhbonds));
 
         //if( Num_Entries(i, hbonds) >=
         //(Start_Index(i+1,hbonds)-Start_Index(i,hbonds))*0.90/*DANGER_ZONE*/) {
@@ -174,6 +180,179 @@ void Validate_Lists( reax_system *system, storage * /*workspace*/, reax_list **l
 }
 
 
+/* first pass of the two-pass build used with pair_style reax/c exactlists:
+   update the far neighbor distances, count the bonds and hydrogen bonds
+   of each atom and lay out the bonds and hbonds lists so that every atom
+   gets exactly the space it needs. the lists are grown on demand and
+   shrunk again on reneighboring steps when they are mostly unused. */
+
+static void Count_Bonded_Interactions( reax_system *system,
+                                       control_params *control,
+                                       simulation_data *data,
+                                       reax_list **lists )
+{
+  int i, j, pj;
+  int type_i, type_j;
+  int ihb, jhb, Hindex;
+  int local, renbr;
+  int total_bonds, total_hbonds;
+  double cutoff, r_ij;
+  double C12, C34, C56;
+  double BO, BO_s, BO_pi, BO_pi2;
+  reax_list *far_nbrs, *bonds, *hbonds, *thb_intrs;
+  single_body_parameters *sbp_i, *sbp_j;
+  two_body_parameters *twbp;
+  far_neighbor_data *nbr_pj;
+  reax_atom *atom_i, *atom_j;
+
+  far_nbrs = *lists + FAR_NBRS;
+  bonds = *lists + BONDS;
+  hbonds = *lists + HBONDS;
+  thb_intrs = *lists + THREE_BODIES;
+
+  renbr = (data->step-data->prev_steps) % control->reneighbor == 0;
+
+  for (i = 0; i < system->N; ++i) {
+    system->my_atoms[i].num_bonds = 0;
+    system->my_atoms[i].num_hbonds = 0;
+  }
+
+  for (i = 0; i < system->N; ++i) {
+    atom_i = &(system->my_atoms[i]);
+    type_i  = atom_i->type;
+    if (type_i < 0) continue;
+    sbp_i = &(system->reax_param.sbp[type_i]);
+
+    if (i < system->n) {
+      local = 1;
+      cutoff = MAX( control->hbond_cut, control->bond_cut );
+    } else {
+      local = 0;
+      cutoff = control->bond_cut;
+    }
+
+    ihb = -1;
+    if (local && control->hbond_cut > 0)
+      ihb = sbp_i->p_hbond;
+
+    for (pj = Start_Index(i, far_nbrs); pj < End_Index(i, far_nbrs); ++pj) {
+      nbr_pj = &( far_nbrs->select.far_nbr_list[pj] );
+      j = nbr_pj->nbr;
+      atom_j = &(system->my_atoms[j]);
+
+      // distances are updated here once, the fill pass only compares.
+      // pairs beyond the cutoff keep the squared distance, which is
+      // still larger than any (> 1 Angstrom) bonded cutoff
+
+      if (!renbr) {
+        nbr_pj->dvec[0] = atom_j->x[0] - atom_i->x[0];
+        nbr_pj->dvec[1] = atom_j->x[1] - atom_i->x[1];
+        nbr_pj->dvec[2] = atom_j->x[2] - atom_i->x[2];
+        nbr_pj->d = rvec_Norm_Sqr( nbr_pj->dvec );
+        if (nbr_pj->d > SQR(cutoff)) continue;
+        nbr_pj->d = sqrt(nbr_pj->d);
+      } else if (nbr_pj->d > cutoff) continue;
+
+      type_j = atom_j->type;
+      if (type_j < 0) continue;
+      sbp_j = &(system->reax_param.sbp[type_j]);
+      twbp = &(system->reax_param.tbp[type_i][type_j]);
+      r_ij = nbr_pj->d;
+
+      if (local && control->hbond_cut > 0 && (ihb==1 || ihb==2) &&
+          r_ij <= control->hbond_cut) {
+        jhb = sbp_j->p_hbond;
+        if (ihb == 1 && jhb == 2)
+          ++atom_i->num_hbonds;
+        else if (j < system->n && ihb == 2 && jhb == 1)
+          ++atom_j->num_hbonds;
+      }
+
+      // same uncorrected bond order criterion as in BOp()
+
+      if (r_ij <= control->bond_cut) {
+        if (sbp_i->r_s > 0.0 && sbp_j->r_s > 0.0) {
+          C12 = twbp->p_bo1 * pow( r_ij / twbp->r_s, twbp->p_bo2 );
+          BO_s = (1.0 + control->bo_cut) * exp( C12 );
+        }
+        else BO_s = 0.0;
+
+        if (sbp_i->r_pi > 0.0 && sbp_j->r_pi > 0.0) {
+          C34 = twbp->p_bo3 * pow( r_ij / twbp->r_p, twbp->p_bo4 );
+          BO_pi = exp( C34 );
+        }
+        else BO_pi = 0.0;
+
+        if (sbp_i->r_pi_pi > 0.0 && sbp_j->r_pi_pi > 0.0) {
+          C56 = twbp->p_bo5 * pow( r_ij / twbp->r_pp, twbp->p_bo6 );
+          BO_pi2= exp( C56 );
+        }
+        else BO_pi2 = 0.0;
+
+        BO = BO_s + BO_pi + BO_pi2;
+
+        if (BO >= control->bo_cut) {
+          ++atom_i->num_bonds;
+          ++atom_j->num_bonds;
+        }
+      }
+    }
+  }
+
+  /* bonds list */
+  total_bonds = 0;
+  for (i = 0; i < system->N; ++i)
+    total_bonds += system->my_atoms[i].num_bonds;
+
+  if ((total_bonds > bonds->num_intrs) ||
+      (renbr && total_bonds < LOOSE_ZONE * bonds->num_intrs)) {
+    Delete_List( bonds );
+    if (!Make_List( system->total_cap, MAX( total_bonds, 1 ), TYP_BOND, bonds ))
+      system->error_ptr->one(FLERR, "Not enough space for bonds list");
+
+    // the 3-body list is indexed by bond
+
+    int num_3body = thb_intrs->num_intrs;
+    Delete_List( thb_intrs );
+    if (!Make_List( bonds->num_intrs, num_3body, TYP_THREE_BODY, thb_intrs ))
+      system->error_ptr->one(FLERR, "Problem in initializing angles list");
+  }
+
+  total_bonds = 0;
+  for (i = 0; i < system->N; ++i) {
+    Set_Start_Index( i, total_bonds, bonds );
+    Set_End_Index( i, total_bonds, bonds );
+    total_bonds += system->my_atoms[i].num_bonds;
+  }
+
+  /* hbonds list */
+  if (control->hbond_cut > 0 && system->numH > 0) {
+    total_hbonds = 0;
+    for (i = 0; i < system->n; ++i)
+      if (system->my_atoms[i].Hindex > -1)
+        total_hbonds += system->my_atoms[i].num_hbonds;
+
+    if ((system->numH > hbonds->n) || (total_hbonds > hbonds->num_intrs) ||
+        (renbr && total_hbonds < LOOSE_ZONE * hbonds->num_intrs)) {
+      system->Hcap = MAX( system->Hcap, system->numH );
+      Delete_List( hbonds );
+      if (!Make_List( system->Hcap, MAX( total_hbonds, 1 ), TYP_HBOND, hbonds ))
+        system->error_ptr->one(FLERR, "Not enough space for hydrogen bonds list");
+    }
+
+    total_hbonds = 0;
+    for (i = 0; i < system->n; ++i) {
+      Hindex = system->my_atoms[i].Hindex;
+      if (Hindex > -1) {
+        Set_Start_Index( Hindex, total_hbonds, hbonds );
+        Set_End_Index( Hindex, total_hbonds, hbonds );
+        total_hbonds += system->my_atoms[i].num_hbonds;
+      }
+    }
+  }
+}
+
+
 void Init_Forces_noQEq( reax_system *system, control_params *control,
                         simulation_data *data, storage *workspace,
                         reax_list **lists, output_controls * /*out_control*/) {
@@ -194,6 +373,9 @@ void Init_Forces_noQEq( reax_system *system, control_params *control,
   bonds = *lists + BONDS;
   hbonds = *lists + HBONDS;
 
+  if (system->exactlists)
+    Count_Bonded_Interactions( system, control, data, lists );
+
   for (i = 0; i < system->n; ++i)
     workspace->bond_mark[i] = 0;
   for (i = system->n; i < system->N; ++i) {
@@ -205,6 +387,10 @@ void Init_Forces_noQEq( reax_system *system, control_params *control,
   btop_i = 0;
   renbr = (data->step-data->prev_steps) % control->reneighbor == 0;
 
+  // with exact lists the distances were already updated in the count pass
+
+  if (system->exactlists) renbr = 1;
+
   for (i = 0; i < system->N; ++i) {
     atom_i = &(system->my_atoms[i]);
     type_i  = atom_i->type;
@@ -421,6 +607,14 @@ void Estimate_Storages( reax_system *system, control_params *control,
     }
   }
 
+  // with exact lists the counts are used as they are
+
+  if (system->exactlists) {
+    for (i = 0; i < system->N; ++i)
+      *num_3body += SQR(bond_top[i]);
+    return;
+  }
+
   *Htop = (int)(MAX( *Htop * safezone, mincap * MIN_HENTRIES ));
   for (i = 0; i < system->n; ++i)
     hb_top[i] = (int)(MAX(hb_top[i] * saferzone, system->minhbonds));
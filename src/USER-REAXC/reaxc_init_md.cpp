@@ -182,7 +182,10 @@ int  Init_Lists(reax_system *system, control_params *control,
       system->my_atoms[i].num_hbonds = hb_top[i];
       total_hbonds += hb_top[i];
     }
-    total_hbonds = (int)(MAX(total_hbonds*saferzone,mincap*system->minhbonds));
+    if (system->exactlists)
+      total_hbonds = MAX(total_hbonds,1);
+    else
+      total_hbonds = (int)(MAX(total_hbonds*saferzone,mincap*system->minhbonds));
 
     if (!Make_List(system->Hcap, total_hbonds, TYP_HBOND,
                     *lists+HBONDS))
@@ -196,7 +199,10 @@ int  Init_Lists(reax_system *system, control_params *control,
     system->my_atoms[i].num_bonds = bond_top[i];
     total_bonds += bond_top[i];
   }
-  bond_cap = (int)(MAX(total_bonds*safezone, mincap*MIN_BONDS));
+  if (system->exactlists)
+    bond_cap = MAX(total_bonds, 1);
+  else
+    bond_cap = (int)(MAX(total_bonds*safezone, mincap*MIN_BONDS));
 
   if (!Make_List(system->total_cap, bond_cap, TYP_BOND,
                   *lists+BONDS))
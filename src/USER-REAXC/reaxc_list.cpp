@@ -146,3 +146,30 @@ void Delete_List( reax_list *l )
   }
 }
 
+
+
+/************* memory used by a list ******************/
+double List_Memory( reax_list *l )
+{
+  double bytes;
+  rc_bigint size;
+
+  if (l->allocated == 0)
+    return 0.0;
+
+  switch(l->type) {
+  case TYP_VOID:         size = sizeof(void*); break;
+  case TYP_THREE_BODY:   size = sizeof(three_body_interaction_data); break;
+  case TYP_BOND:         size = sizeof(bond_data); break;
+  case TYP_DBO:          size = sizeof(dbond_data); break;
+  case TYP_DDELTA:       size = sizeof(dDelta_data); break;
+  case TYP_FAR_NEIGHBOR: size = sizeof(far_neighbor_data); break;
+  case TYP_HBOND:        size = sizeof(hbond_data); break;
+  default:               size = 0;
+  }
+
+  bytes = (double)2.0 * l->n * sizeof(int);
+  bytes += (double)l->num_intrs * size;
+
+  return bytes;
+}
@@ -31,6 +31,7 @@
 
 int  Make_List( int, int, int, reax_list* );
 void Delete_List( reax_list* );
+double List_Memory( reax_list* );
 
 inline int  Num_Entries(int,reax_list*);
 inline int  Start_Index( int, reax_list* );
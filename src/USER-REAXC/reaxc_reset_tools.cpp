@@ -130,6 +130,10 @@ void Reset_Neighbor_Lists( reax_system *system, control_params *control,
   int i, total_bonds, Hindex, total_hbonds;
   reax_list *bonds, *hbonds;
 
+  /* with exact lists the layout is done by the count pass of the force
+     computation once the number of bonds per atom is known */
+  if (system->exactlists) return;
+
   /* bonds list */
   if (system->N > 0) {
     bonds = (*lists) + BONDS;
@@ -49,10 +49,10 @@ double Calculate_Omega( rvec dvec_ij, double r_ij,
   double arg, poem, tel;
   rvec cross_jk_kl;
 
-  sin_ijk = sin( p_ijk->theta );
-  cos_ijk = cos( p_ijk->theta );
-  sin_jkl = sin( p_jkl->theta );
-  cos_jkl = cos( p_jkl->theta );
+  sin_ijk = p_ijk->sin_theta;
+  cos_ijk = p_ijk->cos_theta;
+  sin_jkl = p_jkl->sin_theta;
+  cos_jkl = p_jkl->cos_theta;
 
   /* omega */
   unnorm_cos_omega = -rvec_Dot(dvec_ij, dvec_jk) * rvec_Dot(dvec_jk, dvec_kl) +
@@ -136,7 +136,6 @@ void Torsion_Angles( reax_system *system, control_params *control,
   double exp_tor1, exp_tor3_DjDk, exp_tor4_DjDk, exp_tor34_inv;
   double exp_cot2_jk, exp_cot2_ij, exp_cot2_kl;
   double fn10, f11_DjDk, dfn11, fn12;
-  double theta_ijk, theta_jkl;
   double sin_ijk, sin_jkl;
   double cos_ijk, cos_jkl;
   double tan_ijk_i, tan_jkl_i;
@@ -224,9 +223,8 @@ void Torsion_Angles( reax_system *system, control_params *control,
               r_ij = pbond_ij->d;
               BOA_ij = bo_ij->BO - control->thb_cut;
 
-              theta_ijk = p_ijk->theta;
-              sin_ijk = sin( theta_ijk );
-              cos_ijk = cos( theta_ijk );
+              sin_ijk = p_ijk->sin_theta;
+              cos_ijk = p_ijk->cos_theta;
               //tan_ijk_i = 1. / tan( theta_ijk );
               if (sin_ijk >= 0 && sin_ijk <= MIN_SINE)
                 tan_ijk_i = cos_ijk / MIN_SINE;
@@ -256,9 +254,8 @@ void Torsion_Angles( reax_system *system, control_params *control,
                   r_kl = pbond_kl->d;
                   BOA_kl = bo_kl->BO - control->thb_cut;
 
-                  theta_jkl = p_jkl->theta;
-                  sin_jkl = sin( theta_jkl );
-                  cos_jkl = cos( theta_jkl );
+                  sin_jkl = p_jkl->sin_theta;
+                  cos_jkl = p_jkl->cos_theta;
                   //tan_jkl_i = 1. / tan( theta_jkl );
                   if (sin_jkl >= 0 && sin_jkl <= MIN_SINE)
                     tan_jkl_i = cos_jkl / MIN_SINE;
@@ -411,6 +411,7 @@ struct _reax_system
   int my_bonds;
   int mincap,minhbonds;
   double safezone, saferzone;
+  int exactlists;
 
   _LR_lookup_table **LR;
 
@@ -615,7 +616,7 @@ typedef struct
 typedef struct{
   int thb;
   int pthb; // pointer to the third body on the central atom's nbrlist
-  double theta, cos_theta;
+  double theta, cos_theta, sin_theta;
   rvec dcos_di, dcos_dj, dcos_dk;
 } three_body_interaction_data;
 
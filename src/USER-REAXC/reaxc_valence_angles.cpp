@@ -181,25 +181,29 @@ void Valence_Angles( reax_system *system, control_params *control,
         i = pbond_ij->nbr;
         type_i = system->my_atoms[i].type;
 
+        /* the angles of a bond pk < pi end with one entry for each
+           bond pk+1 .. end_j-1, so k-j-i is found directly instead of
+           searching the list of pk for i */
         for (pk = start_j; pk < pi; ++pk) {
           start_pk = Start_Index( pk, thb_intrs );
           end_pk = End_Index( pk, thb_intrs );
-
-          for (t = start_pk; t < end_pk; ++t)
-            if (thb_intrs->select.three_body_list[t].thb == i) {
-              p_ijk = &(thb_intrs->select.three_body_list[num_thb_intrs] );
-              p_kji = &(thb_intrs->select.three_body_list[t]);
-
-              p_ijk->thb = bonds->select.bond_list[pk].nbr;
-              p_ijk->pthb  = pk;
-              p_ijk->theta = p_kji->theta;
-              rvec_Copy( p_ijk->dcos_di, p_kji->dcos_dk );
-              rvec_Copy( p_ijk->dcos_dj, p_kji->dcos_dj );
-              rvec_Copy( p_ijk->dcos_dk, p_kji->dcos_di );
-
-              ++num_thb_intrs;
-              break;
-            }
+          t = end_pk - (end_j - pi);
+
+          if (t >= start_pk && thb_intrs->select.three_body_list[t].thb == i) {
+            p_ijk = &(thb_intrs->select.three_body_list[num_thb_intrs] );
+            p_kji = &(thb_intrs->select.three_body_list[t]);
+
+            p_ijk->thb = bonds->select.bond_list[pk].nbr;
+            p_ijk->pthb  = pk;
+            p_ijk->theta = p_kji->theta;
+            p_ijk->cos_theta = p_kji->cos_theta;
+            p_ijk->sin_theta = p_kji->sin_theta;
+            rvec_Copy( p_ijk->dcos_di, p_kji->dcos_dk );
+            rvec_Copy( p_ijk->dcos_dj, p_kji->dcos_dj );
+            rvec_Copy( p_ijk->dcos_dk, p_kji->dcos_di );
+
+            ++num_thb_intrs;
+          }
         }
 
         for (pk = pi+1; pk < end_j; ++pk) {
@@ -221,8 +225,11 @@ void Valence_Angles( reax_system *system, control_params *control,
           p_ijk->thb = k;
           p_ijk->pthb = pk;
           p_ijk->theta = theta;
+          p_ijk->cos_theta = cos_theta;
+
+          // sin(theta) is kept with the angle for reuse in the torsions
 
-          sin_theta = sin( theta );
+          sin_theta = p_ijk->sin_theta = sin( theta );
           if (sin_theta < 1.0e-5)
             sin_theta = 1.0e-5;
 
@@ -30,6 +30,8 @@
 #include "variable.h"
 #include "input.h"
 #include "force.h"
+#include "neighbor.h"
+#include "my_page.h"
 
 #include <vector>
 
@@ -37,6 +39,8 @@ using namespace LAMMPS_NS;
 using namespace voro;
 
 #define FACESDELTA 10000
+#define CELLPAGE 65536
+#define MAXCELLNEIGH 1024
 
 /* ---------------------------------------------------------------------- */
 
@@ -44,7 +48,9 @@ ComputeVoronoi::ComputeVoronoi(LAMMPS *lmp, int narg, char **arg) :
   Compute(lmp, narg, arg), con_mono(nullptr), con_poly(nullptr),
   radstr(nullptr), voro(nullptr), edge(nullptr), sendvector(nullptr),
   rfield(nullptr), tags(nullptr), occvec(nullptr), sendocc(nullptr),
-  lroot(nullptr), lnext(nullptr), faces(nullptr)
+  lroot(nullptr), lnext(nullptr), faces(nullptr), xlast(nullptr),
+  rlast(nullptr), moved(nullptr), recompute(nullptr), ncellneigh(nullptr),
+  maxcellneigh(nullptr), cellneigh(nullptr), cpage(nullptr)
 {
   int sgroup;
 
@@ -59,6 +65,8 @@ ComputeVoronoi::ComputeVoronoi(LAMMPS *lmp, int narg, char **arg) :
   radstr = nullptr;
   onlyGroup = false;
   occupation = false;
+  incremental = 0;
+  delta = 0.0;
 
   con_mono = nullptr;
   con_poly = nullptr;
@@ -116,6 +124,12 @@ ComputeVoronoi::ComputeVoronoi(LAMMPS *lmp, int narg, char **arg) :
       else if (strcmp(arg[iarg+1],"no") == 0) faces_flag = 0;
       else error->all(FLERR,"Illegal compute voronoi/atom command");
       iarg += 2;
+    } else if (strcmp(arg[iarg], "incremental") == 0) {
+      if (iarg + 2 > narg) error->all(FLERR,"Illegal compute voronoi/atom command");
+      delta = utils::numeric(FLERR,arg[iarg+1],false,lmp);
+      if (delta < 0.0) error->all(FLERR,"Illegal compute voronoi/atom command");
+      incremental = 1;
+      iarg += 2;
     } else if (strcmp(arg[iarg], "peratom") == 0) {
       if (iarg + 2 > narg) error->all(FLERR,"Illegal compute voronoi/atom command");
       if (strcmp(arg[iarg+1],"yes") == 0) peratom_flag = 1;
@@ -129,12 +143,25 @@ ComputeVoronoi::ComputeVoronoi(LAMMPS *lmp, int narg, char **arg) :
   if (occupation && ( surface!=VOROSURF_NONE || maxedge>0 ) )
     error->all(FLERR,"Illegal compute voronoi/atom command (occupation and (surface or edges))");
 
+  if (incremental && (occupation || maxedge>0 || faces_flag))
+    error->all(FLERR,"Illegal compute voronoi/atom command (incremental and (occupation or edges or neighbors))");
+
   if (occupation && (atom->map_style == Atom::MAP_NONE))
     error->all(FLERR,"Compute voronoi/atom occupation requires an atom map, see atom_modify");
 
   nmax = rmax = 0;
   edge = rfield = sendvector = nullptr;
   voro = nullptr;
+  reuse = 0;
+  last_ncalls = -1;
+  lastnall = 0;
+
+  // storage for Voronoi neighbors of each cell in incremental mode
+
+  if (incremental) {
+    cpage = new MyPage<int>;
+    cpage->init(MAXCELLNEIGH,CELLPAGE);
+  }
 
   if (maxedge > 0) {
     vector_flag = 1;
@@ -177,6 +204,16 @@ ComputeVoronoi::~ComputeVoronoi()
 #endif
   memory->destroy(tags);
   memory->destroy(faces);
+
+  // incremental mode stuff
+  memory->destroy(xlast);
+  memory->destroy(rlast);
+  memory->destroy(moved);
+  memory->destroy(recompute);
+  memory->destroy(ncellneigh);
+  memory->destroy(maxcellneigh);
+  memory->sfree(cellneigh);
+  delete cpage;
 }
 
 /* ---------------------------------------------------------------------- */
@@ -201,6 +238,26 @@ void ComputeVoronoi::compute_peratom()
     nmax = atom->nmax;
     memory->create(voro,nmax,size_peratom_cols,"voronoi/atom:voro");
     array_atom = voro;
+
+    // stored cells are lost, next tessellation is a full one
+    if (incremental) {
+      memory->destroy(xlast);
+      memory->destroy(rlast);
+      memory->destroy(moved);
+      memory->destroy(recompute);
+      memory->destroy(ncellneigh);
+      memory->destroy(maxcellneigh);
+      memory->sfree(cellneigh);
+      memory->create(xlast,nmax,3,"voronoi/atom:xlast");
+      if (radstr) memory->create(rlast,nmax,"voronoi/atom:rlast");
+      memory->create(moved,nmax,"voronoi/atom:moved");
+      memory->create(recompute,nmax,"voronoi/atom:recompute");
+      memory->create(ncellneigh,nmax,"voronoi/atom:ncellneigh");
+      memory->create(maxcellneigh,nmax,"voronoi/atom:maxcellneigh");
+      cellneigh = (int **)
+        memory->smalloc(nmax*sizeof(int *),"voronoi/atom:cellneigh");
+      last_ncalls = -1;
+    }
   }
 
   // decide between occupation or per-frame tesselation modes
@@ -248,15 +305,6 @@ void ComputeVoronoi::buildCells()
   int nlocal = atom->nlocal;
   int dim = domain->dimension;
 
-  // in the onlyGroup mode we are not setting values for all atoms later in the voro loop
-  // initialize everything to zero here
-  if (onlyGroup) {
-    if (surface == VOROSURF_NONE)
-      for (i = 0; i < nlocal; i++) voro[i][0] = voro[i][1] = 0.0;
-    else
-      for (i = 0; i < nlocal; i++) voro[i][0] = voro[i][1] = voro[i][2] = 0.0;
-  }
-
   double *sublo = domain->sublo, *sublo_lamda = domain->sublo_lamda, *boxlo = domain->boxlo;
   double *subhi = domain->subhi, *subhi_lamda = domain->subhi_lamda;
   double *cut = comm->cutghost;
@@ -304,8 +352,37 @@ void ComputeVoronoi::buildCells()
     }
   }
 
-  // n = # of voro++ spatial hash cells (with approximately cubic cells)
+  // in incremental mode the voro++ container and its blocks are reused
+  // until the next reneighboring, unless the box changed in between,
+  // and the results of the cells that are not recomputed are kept
   int nall = nlocal + atom->nghost;
+  reuse = 0;
+  if (incremental && (con_mono || con_poly) &&
+      last_ncalls == neighbor->ncalls && nall == lastnall) {
+    reuse = 1;
+    for (i=0; i<3; ++i)
+      if (sublo_bound[i] != bound_lo[i] || subhi_bound[i] != bound_hi[i])
+        reuse = 0;
+  }
+  if (incremental && !reuse) {
+    last_ncalls = neighbor->ncalls;
+    lastnall = nall;
+    for (i=0; i<3; ++i) {
+      bound_lo[i] = sublo_bound[i];
+      bound_hi[i] = subhi_bound[i];
+    }
+  }
+
+  // in the onlyGroup mode we are not setting values for all atoms later in the voro loop
+  // initialize everything to zero here
+  if (onlyGroup && !reuse) {
+    if (surface == VOROSURF_NONE)
+      for (i = 0; i < nlocal; i++) voro[i][0] = voro[i][1] = 0.0;
+    else
+      for (i = 0; i < nlocal; i++) voro[i][0] = voro[i][1] = voro[i][2] = 0.0;
+  }
+
+  // n = # of voro++ spatial hash cells (with approximately cubic cells)
   double n[3], V;
   for (i=0; i<3; ++i) n[i] = subhi_bound[i] - sublo_bound[i];
   V = n[0]*n[1]*n[2];
@@ -342,15 +419,18 @@ void ComputeVoronoi::buildCells()
     comm->forward_comm_compute(this);
 
     // polydisperse voro++ container
-    delete con_poly;
-    con_poly = new container_poly(sublo_bound[0],
-                                  subhi_bound[0],
-                                  sublo_bound[1],
-                                  subhi_bound[1],
-                                  sublo_bound[2],
-                                  subhi_bound[2],
-                                  int(n[0]),int(n[1]),int(n[2]),
-                                  false,false,false,8);
+    if (reuse) con_poly->clear();
+    else {
+      delete con_poly;
+      con_poly = new container_poly(sublo_bound[0],
+                                    subhi_bound[0],
+                                    sublo_bound[1],
+                                    subhi_bound[1],
+                                    sublo_bound[2],
+                                    subhi_bound[2],
+                                    int(n[0]),int(n[1]),int(n[2]),
+                                    false,false,false,8);
+    }
 
     // pass coordinates for local and ghost atoms to voro++
     for (i = 0; i < nall; i++) {
@@ -359,16 +439,19 @@ void ComputeVoronoi::buildCells()
     }
   } else {
     // monodisperse voro++ container
-    delete con_mono;
-
-    con_mono = new container(sublo_bound[0],
-                             subhi_bound[0],
-                             sublo_bound[1],
-                             subhi_bound[1],
-                             sublo_bound[2],
-                             subhi_bound[2],
-                             int(n[0]),int(n[1]),int(n[2]),
-                             false,false,false,8);
+    if (reuse) con_mono->clear();
+    else {
+      delete con_mono;
+
+      con_mono = new container(sublo_bound[0],
+                               subhi_bound[0],
+                               sublo_bound[1],
+                               subhi_bound[1],
+                               sublo_bound[2],
+                               subhi_bound[2],
+                               int(n[0]),int(n[1]),int(n[2]),
+                               false,false,false,8);
+    }
 
     // pass coordinates for local and ghost atoms to voro++
     for (i = 0; i < nall; i++)
@@ -465,24 +548,82 @@ void ComputeVoronoi::checkOccupation()
 void ComputeVoronoi::loopCells()
 {
   // invoke voro++ and fetch results for owned atoms in group
+  // cells of ghost atoms are not needed
+  // in incremental mode only flagged cells are recomputed
   voronoicell_neighbor c;
-  int i;
+  int i, nlocal = atom->nlocal;
   if (faces_flag) nfaces = 0;
+  if (incremental) markCells();
   if (radstr) {
     c_loop_all cl(*con_poly);
-    if (cl.start()) do if (con_poly->compute_cell(c,cl)) {
+    if (cl.start()) do {
       i = cl.pid();
-      processCell(c,i);
+      if (i >= nlocal || (reuse && !recompute[i])) continue;
+      if (con_poly->compute_cell(c,cl)) processCell(c,i);
     } while (cl.inc());
   } else {
     c_loop_all cl(*con_mono);
-    if (cl.start()) do if (con_mono->compute_cell(c,cl)) {
+    if (cl.start()) do {
       i = cl.pid();
-      processCell(c,i);
+      if (i >= nlocal || (reuse && !recompute[i])) continue;
+      if (con_mono->compute_cell(c,cl)) processCell(c,i);
     } while (cl.inc());
   }
   if (faces_flag) size_local_rows = nfaces;
 
+  // positions the stored cells were computed with
+  if (incremental) {
+    double **x = atom->x;
+    int nall = nlocal + atom->nghost;
+    for (i = 0; i < nall; i++)
+      if (!reuse || moved[i]) {
+        xlast[i][0] = x[i][0];
+        xlast[i][1] = x[i][1];
+        xlast[i][2] = x[i][2];
+        if (radstr) rlast[i] = rfield[i];
+      }
+  }
+}
+
+/* ----------------------------------------------------------------------
+   flag cells to recompute in incremental mode
+   a cell is recomputed if its atom or one of its Voronoi neighbors
+     moved by more than delta since the cell was computed
+   after a full tessellation all cells are computed and their
+     neighbors stored anew
+------------------------------------------------------------------------- */
+
+void ComputeVoronoi::markCells()
+{
+  int i, j, k,
+      nlocal = atom->nlocal,
+      nall = atom->nghost + nlocal;
+
+  if (!reuse) {
+    cpage->reset();
+    for (i = 0; i < nlocal; i++) ncellneigh[i] = maxcellneigh[i] = 0;
+    return;
+  }
+
+  double dx, dy, dz,
+         deltasq = delta*delta,
+         **x = atom->x;
+
+  for (i = 0; i < nall; i++) {
+    dx = x[i][0] - xlast[i][0];
+    dy = x[i][1] - xlast[i][1];
+    dz = x[i][2] - xlast[i][2];
+    moved[i] = (dx*dx + dy*dy + dz*dz > deltasq);
+    if (radstr && fabs(rfield[i] - rlast[i]) > delta) moved[i] = 1;
+  }
+
+  for (i = 0; i < nlocal; i++) {
+    recompute[i] = moved[i];
+    for (k = 0; k < ncellneigh[i] && !recompute[i]; k++) {
+      j = cellneigh[i][k];
+      if (j >= 0 && moved[j]) recompute[i] = 1;
+    }
+  }
 }
 
 /* ----------------------------------------------------------------------
@@ -506,6 +647,20 @@ void ComputeVoronoi::processCell(voronoicell_neighbor &c, int i)
     c.neighbors(neigh);
     int neighs = neigh.size();
 
+    // store neighbors, which are checked for moves in incremental mode
+    // a recomputed cell overwrites its storage if it fits,
+    //   else gets a new chunk, all chunks are recycled after a full tessellation
+    if (incremental) {
+      ncellneigh[i] = neighs;
+      if (neighs > maxcellneigh[i]) {
+        cellneigh[i] = cpage->get(neighs);
+        if (cpage->status())
+          error->one(FLERR,"Voronoi cell neighbor storage overflow in compute voronoi/atom");
+        maxcellneigh[i] = neighs;
+      }
+      for (j=0; j < neighs; ++j) cellneigh[i][j] = neigh[j];
+    }
+
     if (fthresh > 0) {
       // count only faces above area threshold
       c.face_areas(narea);
@@ -617,6 +772,11 @@ double ComputeVoronoi::memory_usage()
   double bytes = (double)size_peratom_cols * nmax * sizeof(double);
   // estimate based on average coordination of 12
   if (faces_flag) bytes += (double)12 * size_local_cols * nmax * sizeof(double);
+  if (incremental) {
+    bytes += (double)nmax * (3*sizeof(double) + 4*sizeof(int) + sizeof(int *));
+    if (radstr) bytes += (double)nmax * sizeof(double);
+    bytes += cpage->size();
+  }
   return bytes;
 }
 
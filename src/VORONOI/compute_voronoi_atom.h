@@ -50,6 +50,7 @@ class ComputeVoronoi : public Compute {
   void buildCells();
   void checkOccupation();
   void loopCells();
+  void markCells();
   void processCell(voro::voronoicell_neighbor&, int);
 
   int nmax, rmax, maxedge, sgroupbit;
@@ -64,6 +65,13 @@ class ComputeVoronoi : public Compute {
   int *occvec, *sendocc, *lroot, *lnext, lmax, oldnatoms, oldnall;
   int faces_flag, nfaces, nfacesmax;
   double **faces;
+
+  int incremental, reuse, lastnall;
+  double delta, bound_lo[3], bound_hi[3];
+  bigint last_ncalls;
+  double **xlast, *rlast;
+  int *moved, *recompute, *ncellneigh, *maxcellneigh, **cellneigh;
+  MyPage<int> *cpage;
 };
 
 }
@@ -107,4 +115,13 @@ E: Voro++ error: narea and neigh have a different size
 
 This error is returned by the Voro++ library.
 
+E: Illegal compute voronoi/atom command (incremental and (occupation or edges or neighbors))
+
+Self-explanatory.
+
+E: Voronoi cell neighbor storage overflow in compute voronoi/atom
+
+A Voronoi cell has more than 1024 neighbors, which are stored in
+incremental mode.
+
 */
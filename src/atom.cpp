@@ -1015,33 +1015,15 @@ void Atom::deallocate_topology()
 }
 
 /* ----------------------------------------------------------------------
-   unpack N lines from Atom section of data file
-   call style-specific routine to parse line
+   set bounds for my proc to read atoms from data file into
+   if periodic and I am lo/hi proc, adjust bounds by EPSILON
+   insures all data atoms will be owned even with round-off
+   if keepflag, bounds are global box, adjusted by EPSILON if periodic
+   bounds are in lamda coords for triclinic box
 ------------------------------------------------------------------------- */
 
-void Atom::data_atoms(int n, char *buf, tagint id_offset, tagint mol_offset,
-                      int type_offset, int shiftflag, double *shift)
+void Atom::data_bounds(double *sublo, double *subhi, int keepflag)
 {
-  int m,xptr,iptr;
-  imageint imagedata;
-  double xdata[3],lamda[3];
-  double *coord;
-  char *next;
-
-  next = strchr(buf,'\n');
-  *next = '\0';
-  int nwords = utils::trim_and_count_words(buf);
-  *next = '\n';
-
-  if (nwords != avec->size_data_atom && nwords != avec->size_data_atom + 3)
-    error->all(FLERR,"Incorrect atom format in data file");
-
-  char **values = new char*[nwords];
-
-  // set bounds for my proc
-  // if periodic and I am lo/hi proc, adjust bounds by EPSILON
-  // insures all data atoms will be owned even with round-off
-
   int triclinic = domain->triclinic;
 
   double epsilon[3];
@@ -1052,7 +1034,6 @@ void Atom::data_atoms(int n, char *buf, tagint id_offset, tagint mol_offset,
     epsilon[2] = domain->prd[2] * EPSILON;
   }
 
-  double sublo[3],subhi[3];
   if (triclinic == 0) {
     sublo[0] = domain->sublo[0]; subhi[0] = domain->subhi[0];
     sublo[1] = domain->sublo[1]; subhi[1] = domain->subhi[1];
@@ -1063,7 +1044,22 @@ void Atom::data_atoms(int n, char *buf, tagint id_offset, tagint mol_offset,
     sublo[2] = domain->sublo_lamda[2]; subhi[2] = domain->subhi_lamda[2];
   }
 
-  if (comm->layout != Comm::LAYOUT_TILED) {
+  if (keepflag) {
+    for (int idim = 0; idim < 3; idim++) {
+      if (triclinic == 0) {
+        sublo[idim] = domain->boxlo[idim];
+        subhi[idim] = domain->boxhi[idim];
+      } else {
+        sublo[idim] = domain->boxlo_lamda[idim];
+        subhi[idim] = domain->boxhi_lamda[idim];
+      }
+      if (domain->periodicity[idim]) {
+        sublo[idim] -= epsilon[idim];
+        subhi[idim] += epsilon[idim];
+      }
+    }
+
+  } else if (comm->layout != Comm::LAYOUT_TILED) {
     if (domain->xperiodic) {
       if (comm->myloc[0] == 0) sublo[0] -= epsilon[0];
       if (comm->myloc[0] == comm->procgrid[0]-1) subhi[0] += epsilon[0];
@@ -1091,6 +1087,45 @@ void Atom::data_atoms(int n, char *buf, tagint id_offset, tagint mol_offset,
       if (comm->mysplit[2][1] == 1.0) subhi[2] += epsilon[2];
     }
   }
+}
+
+/* ----------------------------------------------------------------------
+   unpack N lines from Atom section of data file
+   call style-specific routine to parse line
+   if keepflag set, keep all atoms inside global box, not just my sub-domain
+     caller must migrate them to their owning procs
+     errors are raised by this proc alone, since each proc parses other lines
+     image flag warnings are left to caller, which combines them of all procs
+   return bitmask of dimensions with image flags reset to zero
+------------------------------------------------------------------------- */
+
+int Atom::data_atoms(int n, char *buf, tagint id_offset, tagint mol_offset,
+                     int type_offset, int shiftflag, double *shift,
+                     int keepflag)
+{
+  int m,xptr,iptr;
+  imageint imagedata;
+  double xdata[3],lamda[3];
+  double *coord;
+  char *next;
+
+  next = strchr(buf,'\n');
+  *next = '\0';
+  int nwords = utils::trim_and_count_words(buf);
+  *next = '\n';
+
+  if (nwords != avec->size_data_atom && nwords != avec->size_data_atom + 3) {
+    if (keepflag) error->one(FLERR,"Incorrect atom format in data file");
+    else error->all(FLERR,"Incorrect atom format in data file");
+  }
+
+  char **values = new char*[nwords];
+
+  // set bounds for my proc, or for global box if keepflag
+
+  int triclinic = domain->triclinic;
+  double sublo[3],subhi[3];
+  data_bounds(sublo,subhi,keepflag);
 
   // xptr = which word in line starts xyz coords
   // iptr = which word in line starts ix,iy,iz image flags
@@ -1111,21 +1146,25 @@ void Atom::data_atoms(int n, char *buf, tagint id_offset, tagint mol_offset,
     next = strchr(buf,'\n');
 
     values[0] = strtok(buf," \t\n\r\f");
-    if (values[0] == nullptr)
-      error->all(FLERR,"Incorrect atom format in data file");
     for (m = 1; m < nwords; m++) {
       values[m] = strtok(nullptr," \t\n\r\f");
-      if (values[m] == nullptr)
-        error->all(FLERR,"Incorrect atom format in data file");
+      if (values[m] == nullptr) break;
+    }
+    if (values[0] == nullptr || m < nwords) {
+      if (keepflag) error->one(FLERR,"Incorrect atom format in data file");
+      else error->all(FLERR,"Incorrect atom format in data file");
     }
 
     int imx = 0, imy = 0, imz = 0;
     if (imageflag) {
-      imx = utils::inumeric(FLERR,values[iptr],false,lmp);
-      imy = utils::inumeric(FLERR,values[iptr+1],false,lmp);
-      imz = utils::inumeric(FLERR,values[iptr+2],false,lmp);
-      if ((domain->dimension == 2) && (imz != 0))
-        error->all(FLERR,"Z-direction image flag must be 0 for 2d-systems");
+      imx = utils::inumeric(FLERR,values[iptr],keepflag,lmp);
+      imy = utils::inumeric(FLERR,values[iptr+1],keepflag,lmp);
+      imz = utils::inumeric(FLERR,values[iptr+2],keepflag,lmp);
+      if ((domain->dimension == 2) && (imz != 0)) {
+        if (keepflag)
+          error->one(FLERR,"Z-direction image flag must be 0 for 2d-systems");
+        else error->all(FLERR,"Z-direction image flag must be 0 for 2d-systems");
+      }
       if ((!domain->xperiodic) && (imx != 0)) { flagx = 1; imx = 0; }
       if ((!domain->yperiodic) && (imy != 0)) { flagy = 1; imy = 0; }
       if ((!domain->zperiodic) && (imz != 0)) { flagz = 1; imz = 0; }
@@ -1134,9 +1173,9 @@ void Atom::data_atoms(int n, char *buf, tagint id_offset, tagint mol_offset,
         (((imageint) (imy + IMGMAX) & IMGMASK) << IMGBITS) |
         (((imageint) (imz + IMGMAX) & IMGMASK) << IMG2BITS);
 
-    xdata[0] = utils::numeric(FLERR,values[xptr],false,lmp);
-    xdata[1] = utils::numeric(FLERR,values[xptr+1],false,lmp);
-    xdata[2] = utils::numeric(FLERR,values[xptr+2],false,lmp);
+    xdata[0] = utils::numeric(FLERR,values[xptr],keepflag,lmp);
+    xdata[1] = utils::numeric(FLERR,values[xptr+1],keepflag,lmp);
+    xdata[2] = utils::numeric(FLERR,values[xptr+2],keepflag,lmp);
     if (shiftflag) {
       xdata[0] += shift[0];
       xdata[1] += shift[1];
@@ -1169,19 +1208,115 @@ void Atom::data_atoms(int n, char *buf, tagint id_offset, tagint mol_offset,
   // we may want to turn this into an error at some point, since this essentially
   // creates invalid position information that works by accident most of the time.
 
+  int imageflags = flagx | (flagy << 1) | (flagz << 2);
+  if (!keepflag) data_image_warnings(imageflags);
+
+  delete [] values;
+  return imageflags;
+}
+
+/* ----------------------------------------------------------------------
+   unpack N rows from binary Atoms section of data file
+   row has same layout as AtomVec::pack_data(), including 3 image flags
+   call style-specific routine to unpack row
+   return bitmask of dimensions with image flags reset to zero,
+     warnings are left to caller if keepflag set, as in data_atoms()
+------------------------------------------------------------------------- */
+
+int Atom::data_atoms_binary(int n, double *buf, tagint id_offset,
+                            tagint mol_offset, int type_offset,
+                            int shiftflag, double *shift, int keepflag)
+{
+  imageint imagedata;
+  double xdata[3],lamda[3];
+  double *coord;
+
+  // set bounds for my proc, or for global box if keepflag
+
+  int triclinic = domain->triclinic;
+  double sublo[3],subhi[3];
+  data_bounds(sublo,subhi,keepflag);
+
+  int ncol = avec->size_data_atom + 3;
+  int xptr = avec->xcol_data - 1;
+  int iptr = avec->size_data_atom;
+
+  // loop over rows of atom data
+  // remap atom into simulation box
+  // if atom is in my sub-domain, unpack its values
+
+  int flagx = 0, flagy = 0, flagz = 0;
+  for (int i = 0; i < n; i++) {
+    int imx = (int) ubuf(buf[iptr]).i;
+    int imy = (int) ubuf(buf[iptr+1]).i;
+    int imz = (int) ubuf(buf[iptr+2]).i;
+    if ((domain->dimension == 2) && (imz != 0)) {
+      if (keepflag)
+        error->one(FLERR,"Z-direction image flag must be 0 for 2d-systems");
+      else error->all(FLERR,"Z-direction image flag must be 0 for 2d-systems");
+    }
+    if ((!domain->xperiodic) && (imx != 0)) { flagx = 1; imx = 0; }
+    if ((!domain->yperiodic) && (imy != 0)) { flagy = 1; imy = 0; }
+    if ((!domain->zperiodic) && (imz != 0)) { flagz = 1; imz = 0; }
+    imagedata = ((imageint) (imx + IMGMAX) & IMGMASK) |
+        (((imageint) (imy + IMGMAX) & IMGMASK) << IMGBITS) |
+        (((imageint) (imz + IMGMAX) & IMGMASK) << IMG2BITS);
+
+    xdata[0] = buf[xptr];
+    xdata[1] = buf[xptr+1];
+    xdata[2] = buf[xptr+2];
+    if (shiftflag) {
+      xdata[0] += shift[0];
+      xdata[1] += shift[1];
+      xdata[2] += shift[2];
+    }
+
+    domain->remap(xdata,imagedata);
+    if (triclinic) {
+      domain->x2lamda(xdata,lamda);
+      coord = lamda;
+    } else coord = xdata;
+
+    if (coord[0] >= sublo[0] && coord[0] < subhi[0] &&
+        coord[1] >= sublo[1] && coord[1] < subhi[1] &&
+        coord[2] >= sublo[2] && coord[2] < subhi[2]) {
+      avec->unpack_data(xdata,imagedata,buf);
+      if (id_offset) tag[nlocal-1] += id_offset;
+      if (mol_offset) molecule[nlocal-1] += mol_offset;
+      if (type_offset) {
+        type[nlocal-1] += type_offset;
+        if (type[nlocal-1] > ntypes)
+          error->one(FLERR,"Invalid atom type in Atoms section of data file");
+      }
+    }
+
+    buf += ncol;
+  }
+
+  int imageflags = flagx | (flagy << 1) | (flagz << 2);
+  if (!keepflag) data_image_warnings(imageflags);
+  return imageflags;
+}
+
+/* ----------------------------------------------------------------------
+   warn about non-zero image flags reset to zero for non-periodic dims
+   flags = bitmask of dimensions as returned by data_atoms()
+   called by all procs with same flags, only proc 0 writes warnings
+------------------------------------------------------------------------- */
+
+void Atom::data_image_warnings(int flags)
+{
   if (comm->me == 0) {
-    if (flagx)
+    if ((flags & 1))
       error->warning(FLERR,"Non-zero imageflag(s) in x direction for "
                            "non-periodic boundary reset to zero");
-    if (flagy)
+    if ((flags & 2))
       error->warning(FLERR,"Non-zero imageflag(s) in y direction for "
                            "non-periodic boundary reset to zero");
-    if (flagz)
+    if ((flags & 4))
       error->warning(FLERR,"Non-zero imageflag(s) in z direction for "
                            "non-periodic boundary reset to zero");
   }
-
-  delete [] values;
 }
 
 /* ----------------------------------------------------------------------
@@ -1228,6 +1363,26 @@ void Atom::data_vels(int n, char *buf, tagint id_offset)
   delete [] values;
 }
 
+/* ----------------------------------------------------------------------
+   unpack N rows from binary Velocities section of data file
+   row = atom ID stored as ubuf, followed by AtomVec::pack_vel() values
+------------------------------------------------------------------------- */
+
+void Atom::data_vels_binary(int n, double *buf, tagint id_offset)
+{
+  int m;
+  tagint tagdata;
+  int ncol = avec->size_data_vel;
+
+  for (int i = 0; i < n; i++) {
+    tagdata = (tagint) ubuf(buf[0]).i + id_offset;
+    if (tagdata <= 0 || tagdata > map_tag_max)
+      error->one(FLERR,"Invalid atom ID in Velocities section of data file");
+    if ((m = map(tagdata)) >= 0) avec->unpack_vel(m,&buf[1]);
+    buf += ncol;
+  }
+}
+
 /* ----------------------------------------------------------------------
    process N bonds read into buf from data files
    if count is non-nullptr, just count bonds per atom
@@ -1238,10 +1393,9 @@ void Atom::data_vels(int n, char *buf, tagint id_offset)
 void Atom::data_bonds(int n, char *buf, int *count, tagint id_offset,
                       int type_offset)
 {
-  int m,tmp,itype,rv;
+  int tmp,itype,rv;
   tagint atom1,atom2;
   char *next;
-  int newton_bond = force->newton_bond;
 
   for (int i = 0; i < n; i++) {
     next = strchr(buf,'\n');
@@ -1256,30 +1410,68 @@ void Atom::data_bonds(int n, char *buf, int *count, tagint id_offset,
     }
     itype += type_offset;
 
-    if ((atom1 <= 0) || (atom1 > map_tag_max) ||
-        (atom2 <= 0) || (atom2 > map_tag_max) || (atom1 == atom2))
-      error->one(FLERR,"Invalid atom ID in Bonds section of data file");
-    if (itype <= 0 || itype > nbondtypes)
-      error->one(FLERR,"Invalid bond type in Bonds section of data file");
-    if ((m = map(atom1)) >= 0) {
+    store_bond(itype,atom1,atom2,count);
+    buf = next + 1;
+  }
+}
+
+/* ----------------------------------------------------------------------
+   check and store one bond read from data file
+   if count is non-nullptr, just count bonds per atom
+------------------------------------------------------------------------- */
+
+void Atom::store_bond(int itype, tagint atom1, tagint atom2, int *count)
+{
+  int m;
+  int newton_bond = force->newton_bond;
+
+  if ((atom1 <= 0) || (atom1 > map_tag_max) ||
+      (atom2 <= 0) || (atom2 > map_tag_max) || (atom1 == atom2))
+    error->one(FLERR,"Invalid atom ID in Bonds section of data file");
+  if (itype <= 0 || itype > nbondtypes)
+    error->one(FLERR,"Invalid bond type in Bonds section of data file");
+  if ((m = map(atom1)) >= 0) {
+    if (count) count[m]++;
+    else {
+      bond_type[m][num_bond[m]] = itype;
+      bond_atom[m][num_bond[m]] = atom2;
+      num_bond[m]++;
+    }
+  }
+  if (newton_bond == 0) {
+    if ((m = map(atom2)) >= 0) {
       if (count) count[m]++;
       else {
         bond_type[m][num_bond[m]] = itype;
-        bond_atom[m][num_bond[m]] = atom2;
+        bond_atom[m][num_bond[m]] = atom1;
         num_bond[m]++;
       }
     }
-    if (newton_bond == 0) {
-      if ((m = map(atom2)) >= 0) {
-        if (count) count[m]++;
-        else {
-          bond_type[m][num_bond[m]] = itype;
-          bond_atom[m][num_bond[m]] = atom1;
-          num_bond[m]++;
-        }
-      }
+  }
+}
+
+/* ----------------------------------------------------------------------
+   unpack N rows from binary Bonds section of data file
+   row = type and 2 atom IDs, stored as ubuf
+   if count is non-nullptr, just count bonds per atom
+------------------------------------------------------------------------- */
+
+void Atom::data_bonds_binary(int n, double *buf, int *count,
+                             tagint id_offset, int type_offset)
+{
+  int itype;
+  tagint atom1,atom2;
+
+  for (int i = 0; i < n; i++) {
+    itype = (int) ubuf(buf[0]).i + type_offset;
+    atom1 = (tagint) ubuf(buf[1]).i;
+    atom2 = (tagint) ubuf(buf[2]).i;
+    if (id_offset) {
+      atom1 += id_offset;
+      atom2 += id_offset;
     }
-    buf = next + 1;
+    store_bond(itype,atom1,atom2,count);
+    buf += 3;
   }
 }
 
@@ -1293,10 +1485,9 @@ void Atom::data_bonds(int n, char *buf, int *count, tagint id_offset,
 void Atom::data_angles(int n, char *buf, int *count, tagint id_offset,
                        int type_offset)
 {
-  int m,tmp,itype,rv;
+  int tmp,itype,rv;
   tagint atom1,atom2,atom3;
   char *next;
-  int newton_bond = force->newton_bond;
 
   for (int i = 0; i < n; i++) {
     next = strchr(buf,'\n');
@@ -1312,14 +1503,41 @@ void Atom::data_angles(int n, char *buf, int *count, tagint id_offset,
     }
     itype += type_offset;
 
-    if ((atom1 <= 0) || (atom1 > map_tag_max) ||
-        (atom2 <= 0) || (atom2 > map_tag_max) ||
-        (atom3 <= 0) || (atom3 > map_tag_max) ||
-        (atom1 == atom2) || (atom1 == atom3) || (atom2 == atom3))
-      error->one(FLERR,"Invalid atom ID in Angles section of data file");
-    if (itype <= 0 || itype > nangletypes)
-      error->one(FLERR,"Invalid angle type in Angles section of data file");
-    if ((m = map(atom2)) >= 0) {
+    store_angle(itype,atom1,atom2,atom3,count);
+    buf = next + 1;
+  }
+}
+
+/* ----------------------------------------------------------------------
+   check and store one angle read from data file
+   if count is non-nullptr, just count angles per atom
+------------------------------------------------------------------------- */
+
+void Atom::store_angle(int itype, tagint atom1, tagint atom2, tagint atom3,
+                       int *count)
+{
+  int m;
+  int newton_bond = force->newton_bond;
+
+  if ((atom1 <= 0) || (atom1 > map_tag_max) ||
+      (atom2 <= 0) || (atom2 > map_tag_max) ||
+      (atom3 <= 0) || (atom3 > map_tag_max) ||
+      (atom1 == atom2) || (atom1 == atom3) || (atom2 == atom3))
+    error->one(FLERR,"Invalid atom ID in Angles section of data file");
+  if (itype <= 0 || itype > nangletypes)
+    error->one(FLERR,"Invalid angle type in Angles section of data file");
+  if ((m = map(atom2)) >= 0) {
+    if (count) count[m]++;
+    else {
+      angle_type[m][num_angle[m]] = itype;
+      angle_atom1[m][num_angle[m]] = atom1;
+      angle_atom2[m][num_angle[m]] = atom2;
+      angle_atom3[m][num_angle[m]] = atom3;
+      num_angle[m]++;
+    }
+  }
+  if (newton_bond == 0) {
+    if ((m = map(atom1)) >= 0) {
       if (count) count[m]++;
       else {
         angle_type[m][num_angle[m]] = itype;
@@ -1329,29 +1547,43 @@ void Atom::data_angles(int n, char *buf, int *count, tagint id_offset,
         num_angle[m]++;
       }
     }
-    if (newton_bond == 0) {
-      if ((m = map(atom1)) >= 0) {
-        if (count) count[m]++;
-        else {
-          angle_type[m][num_angle[m]] = itype;
-          angle_atom1[m][num_angle[m]] = atom1;
-          angle_atom2[m][num_angle[m]] = atom2;
-          angle_atom3[m][num_angle[m]] = atom3;
-          num_angle[m]++;
-        }
-      }
-      if ((m = map(atom3)) >= 0) {
-        if (count) count[m]++;
-        else {
-          angle_type[m][num_angle[m]] = itype;
-          angle_atom1[m][num_angle[m]] = atom1;
-          angle_atom2[m][num_angle[m]] = atom2;
-          angle_atom3[m][num_angle[m]] = atom3;
-          num_angle[m]++;
-        }
+    if ((m = map(atom3)) >= 0) {
+      if (count) count[m]++;
+      else {
+        angle_type[m][num_angle[m]] = itype;
+        angle_atom1[m][num_angle[m]] = atom1;
+        angle_atom2[m][num_angle[m]] = atom2;
+        angle_atom3[m][num_angle[m]] = atom3;
+        num_angle[m]++;
       }
     }
-    buf = next + 1;
+  }
+}
+
+/* ----------------------------------------------------------------------
+   unpack N rows from binary Angles section of data file
+   row = type and 3 atom IDs, stored as ubuf
+   if count is non-nullptr, just count angles per atom
+------------------------------------------------------------------------- */
+
+void Atom::data_angles_binary(int n, double *buf, int *count,
+                              tagint id_offset, int type_offset)
+{
+  int itype;
+  tagint atom1,atom2,atom3;
+
+  for (int i = 0; i < n; i++) {
+    itype = (int) ubuf(buf[0]).i + type_offset;
+    atom1 = (tagint) ubuf(buf[1]).i;
+    atom2 = (tagint) ubuf(buf[2]).i;
+    atom3 = (tagint) ubuf(buf[3]).i;
+    if (id_offset) {
+      atom1 += id_offset;
+      atom2 += id_offset;
+      atom3 += id_offset;
+    }
+    store_angle(itype,atom1,atom2,atom3,count);
+    buf += 4;
   }
 }
 
@@ -1365,10 +1597,9 @@ void Atom::data_angles(int n, char *buf, int *count, tagint id_offset,
 void Atom::data_dihedrals(int n, char *buf, int *count, tagint id_offset,
                           int type_offset)
 {
-  int m,tmp,itype,rv;
+  int tmp,itype,rv;
   tagint atom1,atom2,atom3,atom4;
   char *next;
-  int newton_bond = force->newton_bond;
 
   for (int i = 0; i < n; i++) {
     next = strchr(buf,'\n');
@@ -1386,17 +1617,45 @@ void Atom::data_dihedrals(int n, char *buf, int *count, tagint id_offset,
     }
     itype += type_offset;
 
-    if ((atom1 <= 0) || (atom1 > map_tag_max) ||
-        (atom2 <= 0) || (atom2 > map_tag_max) ||
-        (atom3 <= 0) || (atom3 > map_tag_max) ||
-        (atom4 <= 0) || (atom4 > map_tag_max) ||
-        (atom1 == atom2) || (atom1 == atom3) || (atom1 == atom4) ||
-        (atom2 == atom3) || (atom2 == atom4) || (atom3 == atom4))
-      error->one(FLERR,"Invalid atom ID in Dihedrals section of data file");
-    if (itype <= 0 || itype > ndihedraltypes)
-      error->one(FLERR,
-                 "Invalid dihedral type in Dihedrals section of data file");
-    if ((m = map(atom2)) >= 0) {
+    store_dihedral(itype,atom1,atom2,atom3,atom4,count);
+    buf = next + 1;
+  }
+}
+
+/* ----------------------------------------------------------------------
+   check and store one dihedral read from data file
+   if count is non-nullptr, just count dihedrals per atom
+------------------------------------------------------------------------- */
+
+void Atom::store_dihedral(int itype, tagint atom1, tagint atom2,
+                          tagint atom3, tagint atom4, int *count)
+{
+  int m;
+  int newton_bond = force->newton_bond;
+
+  if ((atom1 <= 0) || (atom1 > map_tag_max) ||
+      (atom2 <= 0) || (atom2 > map_tag_max) ||
+      (atom3 <= 0) || (atom3 > map_tag_max) ||
+      (atom4 <= 0) || (atom4 > map_tag_max) ||
+      (atom1 == atom2) || (atom1 == atom3) || (atom1 == atom4) ||
+      (atom2 == atom3) || (atom2 == atom4) || (atom3 == atom4))
+    error->one(FLERR,"Invalid atom ID in Dihedrals section of data file");
+  if (itype <= 0 || itype > ndihedraltypes)
+    error->one(FLERR,
+               "Invalid dihedral type in Dihedrals section of data file");
+  if ((m = map(atom2)) >= 0) {
+    if (count) count[m]++;
+    else {
+      dihedral_type[m][num_dihedral[m]] = itype;
+      dihedral_atom1[m][num_dihedral[m]] = atom1;
+      dihedral_atom2[m][num_dihedral[m]] = atom2;
+      dihedral_atom3[m][num_dihedral[m]] = atom3;
+      dihedral_atom4[m][num_dihedral[m]] = atom4;
+      num_dihedral[m]++;
+    }
+  }
+  if (newton_bond == 0) {
+    if ((m = map(atom1)) >= 0) {
       if (count) count[m]++;
       else {
         dihedral_type[m][num_dihedral[m]] = itype;
@@ -1407,42 +1666,57 @@ void Atom::data_dihedrals(int n, char *buf, int *count, tagint id_offset,
         num_dihedral[m]++;
       }
     }
-    if (newton_bond == 0) {
-      if ((m = map(atom1)) >= 0) {
-        if (count) count[m]++;
-        else {
-          dihedral_type[m][num_dihedral[m]] = itype;
-          dihedral_atom1[m][num_dihedral[m]] = atom1;
-          dihedral_atom2[m][num_dihedral[m]] = atom2;
-          dihedral_atom3[m][num_dihedral[m]] = atom3;
-          dihedral_atom4[m][num_dihedral[m]] = atom4;
-          num_dihedral[m]++;
-        }
-      }
-      if ((m = map(atom3)) >= 0) {
-        if (count) count[m]++;
-        else {
-          dihedral_type[m][num_dihedral[m]] = itype;
-          dihedral_atom1[m][num_dihedral[m]] = atom1;
-          dihedral_atom2[m][num_dihedral[m]] = atom2;
-          dihedral_atom3[m][num_dihedral[m]] = atom3;
-          dihedral_atom4[m][num_dihedral[m]] = atom4;
-          num_dihedral[m]++;
-        }
+    if ((m = map(atom3)) >= 0) {
+      if (count) count[m]++;
+      else {
+        dihedral_type[m][num_dihedral[m]] = itype;
+        dihedral_atom1[m][num_dihedral[m]] = atom1;
+        dihedral_atom2[m][num_dihedral[m]] = atom2;
+        dihedral_atom3[m][num_dihedral[m]] = atom3;
+        dihedral_atom4[m][num_dihedral[m]] = atom4;
+        num_dihedral[m]++;
       }
-      if ((m = map(atom4)) >= 0) {
-        if (count) count[m]++;
-        else {
-          dihedral_type[m][num_dihedral[m]] = itype;
-          dihedral_atom1[m][num_dihedral[m]] = atom1;
-          dihedral_atom2[m][num_dihedral[m]] = atom2;
-          dihedral_atom3[m][num_dihedral[m]] = atom3;
-          dihedral_atom4[m][num_dihedral[m]] = atom4;
-          num_dihedral[m]++;
-        }
+    }
+    if ((m = map(atom4)) >= 0) {
+      if (count) count[m]++;
+      else {
+        dihedral_type[m][num_dihedral[m]] = itype;
+        dihedral_atom1[m][num_dihedral[m]] = atom1;
+        dihedral_atom2[m][num_dihedral[m]] = atom2;
+        dihedral_atom3[m][num_dihedral[m]] = atom3;
+        dihedral_atom4[m][num_dihedral[m]] = atom4;
+        num_dihedral[m]++;
       }
     }
-    buf = next + 1;
+  }
+}
+
+/* ----------------------------------------------------------------------
+   unpack N rows from binary Dihedrals section of data file
+   row = type and 4 atom IDs, stored as ubuf
+   if count is non-nullptr, just count dihedrals per atom
+------------------------------------------------------------------------- */
+
+void Atom::data_dihedrals_binary(int n, double *buf, int *count,
+                                 tagint id_offset, int type_offset)
+{
+  int itype;
+  tagint atom1,atom2,atom3,atom4;
+
+  for (int i = 0; i < n; i++) {
+    itype = (int) ubuf(buf[0]).i + type_offset;
+    atom1 = (tagint) ubuf(buf[1]).i;
+    atom2 = (tagint) ubuf(buf[2]).i;
+    atom3 = (tagint) ubuf(buf[3]).i;
+    atom4 = (tagint) ubuf(buf[4]).i;
+    if (id_offset) {
+      atom1 += id_offset;
+      atom2 += id_offset;
+      atom3 += id_offset;
+      atom4 += id_offset;
+    }
+    store_dihedral(itype,atom1,atom2,atom3,atom4,count);
+    buf += 5;
   }
 }
 
@@ -1456,10 +1730,9 @@ void Atom::data_dihedrals(int n, char *buf, int *count, tagint id_offset,
 void Atom::data_impropers(int n, char *buf, int *count, tagint id_offset,
                           int type_offset)
 {
-  int m,tmp,itype,rv;
+  int tmp,itype,rv;
   tagint atom1,atom2,atom3,atom4;
   char *next;
-  int newton_bond = force->newton_bond;
 
   for (int i = 0; i < n; i++) {
     next = strchr(buf,'\n');
@@ -1477,17 +1750,45 @@ void Atom::data_impropers(int n, char *buf, int *count, tagint id_offset,
     }
     itype += type_offset;
 
-    if ((atom1 <= 0) || (atom1 > map_tag_max) ||
-        (atom2 <= 0) || (atom2 > map_tag_max) ||
-        (atom3 <= 0) || (atom3 > map_tag_max) ||
-        (atom4 <= 0) || (atom4 > map_tag_max) ||
-        (atom1 == atom2) || (atom1 == atom3) || (atom1 == atom4) ||
-        (atom2 == atom3) || (atom2 == atom4) || (atom3 == atom4))
-      error->one(FLERR,"Invalid atom ID in Impropers section of data file");
-    if (itype <= 0 || itype > nimpropertypes)
-      error->one(FLERR,
-                 "Invalid improper type in Impropers section of data file");
-    if ((m = map(atom2)) >= 0) {
+    store_improper(itype,atom1,atom2,atom3,atom4,count);
+    buf = next + 1;
+  }
+}
+
+/* ----------------------------------------------------------------------
+   check and store one improper read from data file
+   if count is non-nullptr, just count impropers per atom
+------------------------------------------------------------------------- */
+
+void Atom::store_improper(int itype, tagint atom1, tagint atom2,
+                          tagint atom3, tagint atom4, int *count)
+{
+  int m;
+  int newton_bond = force->newton_bond;
+
+  if ((atom1 <= 0) || (atom1 > map_tag_max) ||
+      (atom2 <= 0) || (atom2 > map_tag_max) ||
+      (atom3 <= 0) || (atom3 > map_tag_max) ||
+      (atom4 <= 0) || (atom4 > map_tag_max) ||
+      (atom1 == atom2) || (atom1 == atom3) || (atom1 == atom4) ||
+      (atom2 == atom3) || (atom2 == atom4) || (atom3 == atom4))
+    error->one(FLERR,"Invalid atom ID in Impropers section of data file");
+  if (itype <= 0 || itype > nimpropertypes)
+    error->one(FLERR,
+               "Invalid improper type in Impropers section of data file");
+  if ((m = map(atom2)) >= 0) {
+    if (count) count[m]++;
+    else {
+      improper_type[m][num_improper[m]] = itype;
+      improper_atom1[m][num_improper[m]] = atom1;
+      improper_atom2[m][num_improper[m]] = atom2;
+      improper_atom3[m][num_improper[m]] = atom3;
+      improper_atom4[m][num_improper[m]] = atom4;
+      num_improper[m]++;
+    }
+  }
+  if (newton_bond == 0) {
+    if ((m = map(atom1)) >= 0) {
       if (count) count[m]++;
       else {
         improper_type[m][num_improper[m]] = itype;
@@ -1498,42 +1799,57 @@ void Atom::data_impropers(int n, char *buf, int *count, tagint id_offset,
         num_improper[m]++;
       }
     }
-    if (newton_bond == 0) {
-      if ((m = map(atom1)) >= 0) {
-        if (count) count[m]++;
-        else {
-          improper_type[m][num_improper[m]] = itype;
-          improper_atom1[m][num_improper[m]] = atom1;
-          improper_atom2[m][num_improper[m]] = atom2;
-          improper_atom3[m][num_improper[m]] = atom3;
-          improper_atom4[m][num_improper[m]] = atom4;
-          num_improper[m]++;
-        }
-      }
-      if ((m = map(atom3)) >= 0) {
-        if (count) count[m]++;
-        else {
-          improper_type[m][num_improper[m]] = itype;
-          improper_atom1[m][num_improper[m]] = atom1;
-          improper_atom2[m][num_improper[m]] = atom2;
-          improper_atom3[m][num_improper[m]] = atom3;
-          improper_atom4[m][num_improper[m]] = atom4;
-          num_improper[m]++;
-        }
+    if ((m = map(atom3)) >= 0) {
+      if (count) count[m]++;
+      else {
+        improper_type[m][num_improper[m]] = itype;
+        improper_atom1[m][num_improper[m]] = atom1;
+        improper_atom2[m][num_improper[m]] = atom2;
+        improper_atom3[m][num_improper[m]] = atom3;
+        improper_atom4[m][num_improper[m]] = atom4;
+        num_improper[m]++;
       }
-      if ((m = map(atom4)) >= 0) {
-        if (count) count[m]++;
-        else {
-          improper_type[m][num_improper[m]] = itype;
-          improper_atom1[m][num_improper[m]] = atom1;
-          improper_atom2[m][num_improper[m]] = atom2;
-          improper_atom3[m][num_improper[m]] = atom3;
-          improper_atom4[m][num_improper[m]] = atom4;
-          num_improper[m]++;
-        }
+    }
+    if ((m = map(atom4)) >= 0) {
+      if (count) count[m]++;
+      else {
+        improper_type[m][num_improper[m]] = itype;
+        improper_atom1[m][num_improper[m]] = atom1;
+        improper_atom2[m][num_improper[m]] = atom2;
+        improper_atom3[m][num_improper[m]] = atom3;
+        improper_atom4[m][num_improper[m]] = atom4;
+        num_improper[m]++;
       }
     }
-    buf = next + 1;
+  }
+}
+
+/* ----------------------------------------------------------------------
+   unpack N rows from binary Impropers section of data file
+   row = type and 4 atom IDs, stored as ubuf
+   if count is non-nullptr, just count impropers per atom
+------------------------------------------------------------------------- */
+
+void Atom::data_impropers_binary(int n, double *buf, int *count,
+                                 tagint id_offset, int type_offset)
+{
+  int itype;
+  tagint atom1,atom2,atom3,atom4;
+
+  for (int i = 0; i < n; i++) {
+    itype = (int) ubuf(buf[0]).i + type_offset;
+    atom1 = (tagint) ubuf(buf[1]).i;
+    atom2 = (tagint) ubuf(buf[2]).i;
+    atom3 = (tagint) ubuf(buf[3]).i;
+    atom4 = (tagint) ubuf(buf[4]).i;
+    if (id_offset) {
+      atom1 += id_offset;
+      atom2 += id_offset;
+      atom3 += id_offset;
+      atom4 += id_offset;
+    }
+    store_improper(itype,atom1,atom2,atom3,atom4,count);
+    buf += 5;
   }
 }
 
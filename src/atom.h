@@ -297,12 +297,20 @@ class Atom : protected Pointers {
 
   void deallocate_topology();
 
-  void data_atoms(int, char *, tagint, tagint, int, int, double *);
+  int data_atoms(int, char *, tagint, tagint, int, int, double *, int keepflag=0);
   void data_vels(int, char *, tagint);
   void data_bonds(int, char *, int *, tagint, int);
   void data_angles(int, char *, int *, tagint, int);
   void data_dihedrals(int, char *, int *, tagint, int);
   void data_impropers(int, char *, int *, tagint, int);
+  int data_atoms_binary(int, double *, tagint, tagint, int, int, double *,
+                        int keepflag=0);
+  void data_image_warnings(int);
+  void data_vels_binary(int, double *, tagint);
+  void data_bonds_binary(int, double *, int *, tagint, int);
+  void data_angles_binary(int, double *, int *, tagint, int);
+  void data_dihedrals_binary(int, double *, int *, tagint, int);
+  void data_impropers_binary(int, double *, int *, tagint, int);
   void data_bonus(int, char *, AtomVec *, tagint);
   void data_bodies(int, char *, AtomVec *, tagint);
   void data_fix_compute_variable(int, int);
@@ -402,6 +410,12 @@ class Atom : protected Pointers {
   void setup_sort_bins();
   int next_prime(int);
 
+  void data_bounds(double *, double *, int);
+  void store_bond(int, tagint, tagint, int *);
+  void store_angle(int, tagint, tagint, tagint, int *);
+  void store_dihedral(int, tagint, tagint, tagint, tagint, int *);
+  void store_improper(int, tagint, tagint, tagint, tagint, int *);
+
  private:
   template <typename T> static AtomVec *avec_creator(LAMMPS *);
 };
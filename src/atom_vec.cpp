@@ -1807,6 +1807,82 @@ void AtomVec::data_atom(double *coord, imageint imagetmp, char **values)
   atom->nlocal++;
 }
 
+/* ----------------------------------------------------------------------
+   unpack one row from binary Atoms section of data file
+   row has same layout as pack_data(), ints are stored as ubuf
+   initialize other peratom quantities
+------------------------------------------------------------------------- */
+
+void AtomVec::unpack_data(double *coord, imageint imagetmp, double *values)
+{
+  int m,n,datatype,cols;
+  void *pdata;
+
+  int nlocal = atom->nlocal;
+  if (nlocal == nmax) grow(0);
+
+  x[nlocal][0] = coord[0];
+  x[nlocal][1] = coord[1];
+  x[nlocal][2] = coord[2];
+  mask[nlocal] = 1;
+  image[nlocal] = imagetmp;
+  v[nlocal][0] = 0.0;
+  v[nlocal][1] = 0.0;
+  v[nlocal][2] = 0.0;
+
+  int ivalue = 0;
+  for (n = 0; n < ndata_atom; n++) {
+    pdata = mdata_atom.pdata[n];
+    datatype = mdata_atom.datatype[n];
+    cols = mdata_atom.cols[n];
+    if (datatype == Atom::DOUBLE) {
+      if (cols == 0) {
+        double *vec = *((double **) pdata);
+        vec[nlocal] = values[ivalue++];
+      } else {
+        double **array = *((double ***) pdata);
+        if (array == atom->x) {      // x was already set by coord arg
+          ivalue += cols;
+          continue;
+        }
+        for (m = 0; m < cols; m++)
+          array[nlocal][m] = values[ivalue++];
+      }
+    } else if (datatype == Atom::INT) {
+      if (cols == 0) {
+        int *vec = *((int **) pdata);
+        vec[nlocal] = (int) ubuf(values[ivalue++]).i;
+      } else {
+        int **array = *((int ***) pdata);
+        for (m = 0; m < cols; m++)
+          array[nlocal][m] = (int) ubuf(values[ivalue++]).i;
+      }
+    } else if (datatype == Atom::BIGINT) {
+      if (cols == 0) {
+        bigint *vec = *((bigint **) pdata);
+        vec[nlocal] = (bigint) ubuf(values[ivalue++]).i;
+      } else {
+        bigint **array = *((bigint ***) pdata);
+        for (m = 0; m < cols; m++)
+          array[nlocal][m] = (bigint) ubuf(values[ivalue++]).i;
+      }
+    }
+  }
+
+  // error checks applicable to all styles
+
+  if (tag[nlocal] <= 0)
+    error->one(FLERR,"Invalid atom ID in Atoms section of data file");
+  if (type[nlocal] <= 0 || type[nlocal] > atom->ntypes)
+    error->one(FLERR,"Invalid atom type in Atoms section of data file");
+
+  // if needed, modify unpacked values or initialize other peratom values
+
+  data_atom_post(nlocal);
+
+  atom->nlocal++;
+}
+
 /* ----------------------------------------------------------------------
    pack atom info for data file including 3 image flags
 ------------------------------------------------------------------------- */
@@ -1968,6 +2044,59 @@ void AtomVec::data_vel(int ilocal, char **values)
   }
 }
 
+/* ----------------------------------------------------------------------
+   unpack one row from binary Velocities section of data file
+   row has same layout as pack_vel() without the atom ID
+------------------------------------------------------------------------- */
+
+void AtomVec::unpack_vel(int ilocal, double *values)
+{
+  int m,n,datatype,cols;
+  void *pdata;
+
+  double **v = atom->v;
+  v[ilocal][0] = values[0];
+  v[ilocal][1] = values[1];
+  v[ilocal][2] = values[2];
+
+  if (ndata_vel > 2) {
+    int ivalue = 3;
+    for (n = 2; n < ndata_vel; n++) {
+      pdata = mdata_vel.pdata[n];
+      datatype = mdata_vel.datatype[n];
+      cols = mdata_vel.cols[n];
+      if (datatype == Atom::DOUBLE) {
+        if (cols == 0) {
+          double *vec = *((double **) pdata);
+          vec[ilocal] = values[ivalue++];
+        } else {
+          double **array = *((double ***) pdata);
+          for (m = 0; m < cols; m++)
+            array[ilocal][m] = values[ivalue++];
+        }
+      } else if (datatype == Atom::INT) {
+        if (cols == 0) {
+          int *vec = *((int **) pdata);
+          vec[ilocal] = (int) ubuf(values[ivalue++]).i;
+        } else {
+          int **array = *((int ***) pdata);
+          for (m = 0; m < cols; m++)
+            array[ilocal][m] = (int) ubuf(values[ivalue++]).i;
+        }
+      } else if (datatype == Atom::BIGINT) {
+        if (cols == 0) {
+          bigint *vec = *((bigint **) pdata);
+          vec[ilocal] = (bigint) ubuf(values[ivalue++]).i;
+        } else {
+          bigint **array = *((bigint ***) pdata);
+          for (m = 0; m < cols; m++)
+            array[ilocal][m] = (bigint) ubuf(values[ivalue++]).i;
+        }
+      }
+    }
+  }
+}
+
 /* ----------------------------------------------------------------------
    pack velocity info for data file
 ------------------------------------------------------------------------- */
@@ -127,6 +127,7 @@ class AtomVec : protected Pointers {
   virtual void data_atom_post(int) {}
   virtual void data_atom_bonus(int, char **) {}
   virtual void data_body(int, int, int, int *, double *) {}
+  virtual void unpack_data(double *, imageint, double *);
 
   virtual void pack_data(double **);
   virtual void write_data(FILE *, int, double **);
@@ -134,6 +135,7 @@ class AtomVec : protected Pointers {
   virtual void pack_data_post(int) {}
 
   virtual void data_vel(int, char **);
+  virtual void unpack_vel(int, double *);
   virtual void pack_vel(double **);
   virtual void write_vel(FILE *, int, double **);
 
@@ -0,0 +1,133 @@
+/* ----------------------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://lammps.sandia.gov/, Sandia National Laboratories
+   Steve Plimpton, sjplimp@sandia.gov
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#include "checkpoint.h"
+
+#include "comm.h"
+#include "domain.h"
+#include "error.h"
+#include "fix_checkpoint.h"
+#include "modify.h"
+#include "update.h"
+
+#include <cstring>
+
+using namespace LAMMPS_NS;
+
+/* ---------------------------------------------------------------------- */
+
+Checkpoint::Checkpoint(LAMMPS *lmp) : Pointers(lmp) {}
+
+/* ----------------------------------------------------------------------
+   called as checkpoint command in input script
+------------------------------------------------------------------------- */
+
+void Checkpoint::command(int narg, char **arg)
+{
+  if (narg < 2) error->all(FLERR,"Illegal checkpoint command");
+
+  int buddyflag = 0;
+  int stepflag = 1;
+
+  int iarg = 2;
+  while (iarg < narg) {
+    if (strcmp(arg[iarg],"buddy") == 0 && strcmp(arg[0],"delete") != 0) {
+      if (iarg+2 > narg) error->all(FLERR,"Illegal checkpoint command");
+      if (strcmp(arg[iarg+1],"yes") == 0) buddyflag = 1;
+      else if (strcmp(arg[iarg+1],"no") == 0) buddyflag = 0;
+      else error->all(FLERR,"Illegal checkpoint command");
+      iarg += 2;
+    } else if (strcmp(arg[iarg],"timestep") == 0 &&
+               strcmp(arg[0],"restore") == 0) {
+      if (iarg+2 > narg) error->all(FLERR,"Illegal checkpoint command");
+      if (strcmp(arg[iarg+1],"yes") == 0) stepflag = 1;
+      else if (strcmp(arg[iarg+1],"no") == 0) stepflag = 0;
+      else error->all(FLERR,"Illegal checkpoint command");
+      iarg += 2;
+    } else error->all(FLERR,"Illegal checkpoint command");
+  }
+
+  if (strcmp(arg[0],"save") == 0) save(arg[1],buddyflag);
+  else if (strcmp(arg[0],"restore") == 0) restore(arg[1],buddyflag,stepflag);
+  else if (strcmp(arg[0],"delete") == 0) remove(arg[1]);
+  else error->all(FLERR,"Illegal checkpoint command");
+}
+
+/* ----------------------------------------------------------------------
+   store current state in checkpoint name, create it if needed
+------------------------------------------------------------------------- */
+
+void Checkpoint::save(const std::string &name, int buddyflag)
+{
+  if (domain->box_exist == 0)
+    error->all(FLERR,"Checkpoint command before simulation box is defined");
+
+  double time1 = MPI_Wtime();
+
+  FixCheckpoint *fix = find(name);
+  if (fix == nullptr) {
+    modify->add_fix(fmt::format("_checkpoint_{} all CHECKPOINT {}",name,name));
+    fix = find(name);
+  }
+  fix->save(buddyflag);
+
+  if (comm->me == 0)
+    utils::logmesg(lmp,fmt::format("Saved checkpoint {} at step {}: "
+                                   "CPU = {:.6f} seconds\n",name,
+                                   update->ntimestep,MPI_Wtime()-time1));
+}
+
+/* ----------------------------------------------------------------------
+   reset system to the state stored in checkpoint name
+------------------------------------------------------------------------- */
+
+void Checkpoint::restore(const std::string &name, int buddyflag, int stepflag)
+{
+  if (domain->box_exist == 0)
+    error->all(FLERR,"Checkpoint command before simulation box is defined");
+
+  double time1 = MPI_Wtime();
+
+  FixCheckpoint *fix = find(name);
+  if (fix == nullptr)
+    error->all(FLERR,fmt::format("Checkpoint {} does not exist",name));
+  fix->restore(buddyflag,stepflag);
+
+  if (comm->me == 0)
+    utils::logmesg(lmp,fmt::format("Restored checkpoint {} at step {}: "
+                                   "CPU = {:.6f} seconds\n",name,
+                                   update->ntimestep,MPI_Wtime()-time1));
+}
+
+/* ----------------------------------------------------------------------
+   delete checkpoint name and free its memory
+------------------------------------------------------------------------- */
+
+void Checkpoint::remove(const std::string &name)
+{
+  if (find(name) == nullptr)
+    error->all(FLERR,fmt::format("Checkpoint {} does not exist",name));
+  modify->delete_fix("_checkpoint_" + name);
+}
+
+/* ----------------------------------------------------------------------
+   return fix holding checkpoint name or nullptr if it does not exist
+------------------------------------------------------------------------- */
+
+FixCheckpoint *Checkpoint::find(const std::string &name)
+{
+  int ifix = modify->find_fix("_checkpoint_" + name);
+  if (ifix < 0 || strcmp(modify->fix[ifix]->style,"CHECKPOINT") != 0)
+    return nullptr;
+  return (FixCheckpoint *) modify->fix[ifix];
+}
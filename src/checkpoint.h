@@ -0,0 +1,61 @@
+/* -*- c++ -*- ----------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://lammps.sandia.gov/, Sandia National Laboratories
+   Steve Plimpton, sjplimp@sandia.gov
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#ifdef COMMAND_CLASS
+
+CommandStyle(checkpoint,Checkpoint)
+
+#else
+
+#ifndef LMP_CHECKPOINT_H
+#define LMP_CHECKPOINT_H
+
+#include "pointers.h"
+
+namespace LAMMPS_NS {
+
+class Checkpoint : protected Pointers {
+ public:
+  Checkpoint(class LAMMPS *);
+  void command(int, char **);
+  void save(const std::string &, int);
+  void restore(const std::string &, int, int);
+  void remove(const std::string &);
+
+ private:
+  class FixCheckpoint *find(const std::string &);
+};
+
+}
+
+#endif
+#endif
+
+/* ERROR/WARNING messages:
+
+E: Checkpoint command before simulation box is defined
+
+The checkpoint command cannot be used before a read_data,
+read_restart, or create_box command.
+
+E: Illegal ... command
+
+Self-explanatory.  Check the input script syntax and compare to the
+documentation for the command.  You can use -echo screen as a
+command-line option when running LAMMPS to see the offending line.
+
+E: Checkpoint %s does not exist
+
+The checkpoint must be saved before it can be restored or deleted.
+
+*/
@@ -29,6 +29,7 @@
 #include "neigh_request.h"
 #include "neighbor.h"
 #include "pair.h"
+#include "union_find.h"
 #include "update.h"
 
 #include <cstring>
@@ -56,6 +57,7 @@ ComputeAggregateAtom::ComputeAggregateAtom(LAMMPS *lmp, int narg, char **arg) :
   comm_reverse = 1;
 
   nmax = 0;
+  uf = new UnionFind(lmp);
 }
 
 /* ---------------------------------------------------------------------- */
@@ -63,6 +65,7 @@ ComputeAggregateAtom::ComputeAggregateAtom(LAMMPS *lmp, int narg, char **arg) :
 ComputeAggregateAtom::~ComputeAggregateAtom()
 {
   memory->destroy(aggregateID);
+  delete uf;
 }
 
 /* ---------------------------------------------------------------------- */
@@ -134,11 +137,10 @@ void ComputeAggregateAtom::compute_peratom()
     comm->forward_comm_compute(this);
   }
 
-  // each atom starts in its own aggregate,
+  // each atom starts in its own aggregate
 
   int nlocal = atom->nlocal;
   int inum = list->inum;
-  tagint *tag = atom->tag;
   int *mask = atom->mask;
   int *num_bond = atom->num_bond;
   int **bond_type = atom->bond_type;
@@ -148,85 +150,55 @@ void ComputeAggregateAtom::compute_peratom()
   int **firstneigh = list->firstneigh;
   double **x = atom->x;
 
-  for (i = 0; i < nlocal + atom->nghost; i++)
-    if (mask[i] & groupbit) aggregateID[i] = tag[i];
-    else aggregateID[i] = 0;
+  uf->reset(nlocal + atom->nghost);
 
-  // loop until no more changes on any proc:
-  // acquire aggregateIDs of ghost atoms
   // loop over my atoms, and check atoms bound to it
-  // if both atoms are in aggregate, assign lowest aggregateID to both
-  // then loop over my atoms, checking distance to neighbors
-  // if both atoms are in cluster, assign lowest clusterID to both
-  // iterate until no changes in my atoms
-  // then check if any proc made changes
-
-  commflag = 1;
-
-  int change,done,anychange;
-
-  while (1) {
-    comm->forward_comm_compute(this);
+  // if both atoms are in group, join their aggregates
+  // with newton_bond, the proc of the other atom may store the bond,
+  //   which is joined there and merged across procs below
+
+  for (i = 0; i < nlocal; i++) {
+    if (!(mask[i] & groupbit)) continue;
+
+    for (j = 0; j < num_bond[i]; j++) {
+      if (bond_type[i][j] == 0) continue;
+      k = atom->map(bond_atom[i][j]);
+      if (k < 0) continue;
+      if (!(mask[k] & groupbit)) continue;
+      uf->join(i,k);
+    }
+  }
 
-    // reverse communication when bonds are not stored on every processor
-
-    if (force->newton_bond)
-      comm->reverse_comm_compute(this);
-
-    change = 0;
-    while (1) {
-      done = 1;
-      for (i = 0; i < nlocal; i++) {
-        if (!(mask[i] & groupbit)) continue;
-
-        for (j = 0; j < num_bond[i]; j++) {
-          if (bond_type[i][j] == 0) continue;
-          k = atom->map(bond_atom[i][j]);
-          if (k < 0) continue;
-          if (!(mask[k] & groupbit)) continue;
-          if (aggregateID[i] == aggregateID[k]) continue;
-
-          aggregateID[i] = aggregateID[k] = MIN(aggregateID[i],aggregateID[k]);
-          done = 0;
-        }
-      }
-
-      for (int ii = 0; ii < inum; ii++) {
-        i = ilist[ii];
-        if (!(mask[i] & groupbit)) continue;
-
-        const double xtmp = x[i][0];
-        const double ytmp = x[i][1];
-        const double ztmp = x[i][2];
-        int *jlist = firstneigh[i];
-        const int jnum = numneigh[i];
-
-        for (int jj = 0; jj < jnum; jj++) {
-          j = jlist[jj];
-          j &= NEIGHMASK;
-          if (!(mask[j] & groupbit)) continue;
-          if (aggregateID[i] == aggregateID[j]) continue;
-
-          const double delx = xtmp - x[j][0];
-          const double dely = ytmp - x[j][1];
-          const double delz = ztmp - x[j][2];
-          const double rsq = delx*delx + dely*dely + delz*delz;
-          if (rsq < cutsq) {
-            aggregateID[i] = aggregateID[j]
-              = MIN(aggregateID[i],aggregateID[j]);
-            done = 0;
-          }
-        }
-      }
-      if (!done) change = 1;
-      if (done) break;
+  // then loop over my atoms, checking distance to neighbors
+  // if both atoms are in group, join their aggregates
+
+  for (int ii = 0; ii < inum; ii++) {
+    i = ilist[ii];
+    if (!(mask[i] & groupbit)) continue;
+
+    const double xtmp = x[i][0];
+    const double ytmp = x[i][1];
+    const double ztmp = x[i][2];
+    int *jlist = firstneigh[i];
+    const int jnum = numneigh[i];
+
+    for (int jj = 0; jj < jnum; jj++) {
+      j = jlist[jj];
+      j &= NEIGHMASK;
+      if (!(mask[j] & groupbit)) continue;
+
+      const double delx = xtmp - x[j][0];
+      const double dely = ytmp - x[j][1];
+      const double delz = ztmp - x[j][2];
+      const double rsq = delx*delx + dely*dely + delz*delz;
+      if (rsq < cutsq) uf->join(i,j);
     }
+  }
 
-    // stop if all procs are done
+  // merge aggregates across procs, aggregateID = lowest atom ID in aggregate
 
-    MPI_Allreduce(&change,&anychange,1,MPI_INT,MPI_MAX,world);
-    if (!anychange) break;
-  }
+  commflag = 1;
+  uf->merge(this,groupbit,aggregateID);
 }
 
 /* ---------------------------------------------------------------------- */
@@ -262,13 +234,7 @@ void ComputeAggregateAtom::unpack_forward_comm(int n, int first, double *buf)
   m = 0;
   last = first + n;
   if (commflag)
-    for (i = first; i < last; i++) {
-      double x = buf[m++];
-
-      // only overwrite ghost IDs with values lower than current ones
-
-      aggregateID[i] = MIN(x,aggregateID[i]);
-    }
+    for (i = first; i < last; i++) aggregateID[i] = buf[m++];
   else {
     int *mask = atom->mask;
     for (i = first; i < last; i++) mask[i] = (int) ubuf(buf[m++]).i;
@@ -313,5 +279,6 @@ void ComputeAggregateAtom::unpack_reverse_comm(int n, int *list, double *buf)
 double ComputeAggregateAtom::memory_usage()
 {
   double bytes = (double)nmax * sizeof(double);
+  bytes += uf->memory_usage();
   return bytes;
 }
@@ -41,6 +41,7 @@ class ComputeAggregateAtom : public Compute {
   int nmax,commflag;
   double cutsq;
   class NeighList *list;
+  class UnionFind *uf;
   double *aggregateID;
 };
 
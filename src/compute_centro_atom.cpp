@@ -23,6 +23,7 @@
 #include "neighbor.h"
 #include "neigh_list.h"
 #include "neigh_request.h"
+#include "neigh_shell.h"
 #include "force.h"
 #include "pair.h"
 #include "comm.h"
@@ -36,7 +37,7 @@ using namespace LAMMPS_NS;
 
 ComputeCentroAtom::ComputeCentroAtom(LAMMPS *lmp, int narg, char **arg) :
   Compute(lmp, narg, arg),
-  distsq(nullptr), nearest(nullptr), centro(nullptr)
+  list(nullptr), shell(nullptr), centro(nullptr)
 {
   if (narg < 4 || narg > 6)
     error->all(FLERR,"Illegal compute centro/atom command");
@@ -71,7 +72,6 @@ ComputeCentroAtom::ComputeCentroAtom(LAMMPS *lmp, int narg, char **arg) :
   else size_peratom_cols = 10;
 
   nmax = 0;
-  maxneigh = 0;
 }
 
 /* ---------------------------------------------------------------------- */
@@ -79,8 +79,6 @@ ComputeCentroAtom::ComputeCentroAtom(LAMMPS *lmp, int narg, char **arg) :
 ComputeCentroAtom::~ComputeCentroAtom()
 {
   memory->destroy(centro);
-  memory->destroy(distsq);
-  memory->destroy(nearest);
   if (axes_flag) memory->destroy(array_atom);
 }
 
@@ -112,15 +110,21 @@ void ComputeCentroAtom::init()
 void ComputeCentroAtom::init_list(int /*id*/, NeighList *ptr)
 {
   list = ptr;
+
+  // nnn nearest neighbors are taken from the shells shared with other
+  // computes that use an identical neighbor list
+
+  shell = list->get_shell();
+  shell->request(nnn);
 }
 
 /* ---------------------------------------------------------------------- */
 
 void ComputeCentroAtom::compute_peratom()
 {
-  int i,j,k,ii,jj,kk,n,inum,jnum;
-  double xtmp,ytmp,ztmp,delx,dely,delz,rsq,value;
-  int *ilist,*jlist,*numneigh,**firstneigh;
+  int i,j,k,ii,jj,kk,n,inum;
+  double xtmp,ytmp,ztmp,delx,dely,delz,value;
+  int *ilist,*nearest;
 
   invoked_peratom = update->ntimestep;
 
@@ -144,13 +148,15 @@ void ComputeCentroAtom::compute_peratom()
   }
 
   // invoke full neighbor list (will copy or build if necessary)
+  // then select sorted nearest neighbors of each atom
 
   neighbor->build_one(list);
+  shell->build();
 
   inum = list->inum;
   ilist = list->ilist;
-  numneigh = list->numneigh;
-  firstneigh = list->firstneigh;
+  int *numshell = shell->numshell;
+  double **rsqshell = shell->rsqshell;
 
   // npairs = number of unique pairs
 
@@ -171,37 +177,12 @@ void ComputeCentroAtom::compute_peratom()
       xtmp = x[i][0];
       ytmp = x[i][1];
       ztmp = x[i][2];
-      jlist = firstneigh[i];
-      jnum = numneigh[i];
+      nearest = shell->shell[i];
 
-      // insure distsq and nearest arrays are long enough
-
-      if (jnum > maxneigh) {
-        memory->destroy(distsq);
-        memory->destroy(nearest);
-        maxneigh = jnum;
-        memory->create(distsq,maxneigh,"centro/atom:distsq");
-        memory->create(nearest,maxneigh,"centro/atom:nearest");
-      }
-
-      // loop over list of all neighbors within force cutoff
-      // distsq[] = distance sq to each
-      // nearest[] = atom indices of neighbors
+      // n = # of nnn nearest neighbors within force cutoff
 
       n = 0;
-      for (jj = 0; jj < jnum; jj++) {
-        j = jlist[jj];
-        j &= NEIGHMASK;
-
-        delx = xtmp - x[j][0];
-        dely = ytmp - x[j][1];
-        delz = ztmp - x[j][2];
-        rsq = delx*delx + dely*dely + delz*delz;
-        if (rsq < cutsq) {
-          distsq[n] = rsq;
-          nearest[n++] = j;
-        }
-      }
+      while (n < numshell[i] && n < nnn && rsqshell[i][n] < cutsq) n++;
 
       // check whether to include local crystal symmetry axes
 
@@ -214,10 +195,6 @@ void ComputeCentroAtom::compute_peratom()
           continue;
         }
 
-        // store nnn nearest neighs in 1st nnn locations of distsq and nearest
-
-        select2(nnn,n,distsq,nearest);
-
         // R = Ri + Rj for each of npairs i,j pairs among nnn neighbors
         // pairs = squared length of each R
 
@@ -256,10 +233,6 @@ void ComputeCentroAtom::compute_peratom()
           continue;
         }
 
-        // store nnn nearest neighs in 1st nnn locations of distsq and nearest
-
-        select2(nnn,n,distsq,nearest);
-
         n = 0;
         rsq1 = rsq2 = cutsq;
         for (j = 0; j < nnn; j++) {
@@ -324,13 +297,11 @@ void ComputeCentroAtom::compute_peratom()
 
 
 /* ----------------------------------------------------------------------
-   2 select routines from Numerical Recipes (slightly modified)
+   select routine from Numerical Recipes (slightly modified)
    find k smallest values in array of length n
-   2nd routine sorts auxiliary array at same time
 ------------------------------------------------------------------------- */
 
 #define SWAP(a,b)   tmp = a; a = b; b = tmp;
-#define ISWAP(a,b) itmp = a; a = b; b = itmp;
 
 void ComputeCentroAtom::select(int k, int n, double *arr)
 {
@@ -375,61 +346,6 @@ void ComputeCentroAtom::select(int k, int n, double *arr)
   }
 }
 
-/* ---------------------------------------------------------------------- */
-
-void ComputeCentroAtom::select2(int k, int n, double *arr, int *iarr)
-{
-  int i,ir,j,l,mid,ia,itmp;
-  double a,tmp;
-
-  arr--;
-  iarr--;
-  l = 1;
-  ir = n;
-  for (;;) {
-    if (ir <= l+1) {
-      if (ir == l+1 && arr[ir] < arr[l]) {
-        SWAP(arr[l],arr[ir])
-        ISWAP(iarr[l],iarr[ir])
-      }
-      return;
-    } else {
-      mid=(l+ir) >> 1;
-      SWAP(arr[mid],arr[l+1])
-      ISWAP(iarr[mid],iarr[l+1])
-      if (arr[l] > arr[ir]) {
-        SWAP(arr[l],arr[ir])
-        ISWAP(iarr[l],iarr[ir])
-      }
-      if (arr[l+1] > arr[ir]) {
-        SWAP(arr[l+1],arr[ir])
-        ISWAP(iarr[l+1],iarr[ir])
-      }
-      if (arr[l] > arr[l+1]) {
-        SWAP(arr[l],arr[l+1])
-        ISWAP(iarr[l],iarr[l+1])
-      }
-      i = l+1;
-      j = ir;
-      a = arr[l+1];
-      ia = iarr[l+1];
-      for (;;) {
-        do i++; while (arr[i] < a);
-        do j--; while (arr[j] > a);
-        if (j < i) break;
-        SWAP(arr[i],arr[j])
-        ISWAP(iarr[i],iarr[j])
-      }
-      arr[l+1] = arr[j];
-      arr[j] = a;
-      iarr[l+1] = iarr[j];
-      iarr[j] = ia;
-      if (j >= k) ir = j-1;
-      if (j <= k) l = i;
-    }
-  }
-}
-
 /* ----------------------------------------------------------------------
    memory usage of local atom-based array
 ------------------------------------------------------------------------- */
@@ -34,15 +34,13 @@ class ComputeCentroAtom : public Compute {
   double memory_usage();
 
  private:
-  int nmax,maxneigh,nnn;
-  double *distsq;
-  int *nearest;
+  int nmax,nnn;
   class NeighList *list;
+  class NeighShell *shell;
   double *centro;
   int axes_flag;
 
   void select(int, int, double *);
-  void select2(int, int, double *, int *);
 };
 
 }
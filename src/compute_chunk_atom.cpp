@@ -28,6 +28,7 @@
 #include "math_const.h"
 #include "memory.h"
 #include "modify.h"
+#include "neighbor.h"
 #include "region.h"
 #include "update.h"
 #include "variable.h"
@@ -47,6 +48,7 @@ enum{ONCE,NFREQ,EVERY};              // used in several files
 enum{LIMITMAX,LIMITEXACT};
 
 #define IDMAX 1024*1024
+#define BIG 1.0e20
 
 /* ---------------------------------------------------------------------- */
 
@@ -55,7 +57,8 @@ ComputeChunkAtom::ComputeChunkAtom(LAMMPS *lmp, int narg, char **arg) :
   chunk_volume_vec(nullptr), coord(nullptr), ichunk(nullptr), chunkID(nullptr),
   cfvid(nullptr), idregion(nullptr), region(nullptr), cchunk(nullptr), fchunk(nullptr),
   varatom(nullptr), id_fix(nullptr), fixstore(nullptr), lockfix(nullptr), chunk(nullptr),
-  exclude(nullptr), hash(nullptr)
+  exclude(nullptr), hash(nullptr), binmap(nullptr), bincache(nullptr),
+  xcache(nullptr), dcache(nullptr)
 {
   if (narg < 4) error->all(FLERR,"Illegal compute chunk/atom command");
 
@@ -178,6 +181,7 @@ ComputeChunkAtom::ComputeChunkAtom(LAMMPS *lmp, int narg, char **arg) :
   maxflag[2] = UPPER;
   scaleflag = LATTICE;
   pbcflag = 0;
+  incremental = 0;
 
   while (iarg < narg) {
     if (strcmp(arg[iarg],"region") == 0) {
@@ -262,6 +266,12 @@ ComputeChunkAtom::ComputeChunkAtom(LAMMPS *lmp, int narg, char **arg) :
       else if (strcmp(arg[iarg+1],"yes") == 0) pbcflag = 1;
       else error->all(FLERR,"Illegal compute chunk/atom command");
       iarg += 2;
+    } else if (strcmp(arg[iarg],"incremental") == 0) {
+      if (iarg+2 > narg) error->all(FLERR,"Illegal compute chunk/atom command");
+      if (strcmp(arg[iarg+1],"no") == 0) incremental = 0;
+      else if (strcmp(arg[iarg+1],"yes") == 0) incremental = 1;
+      else error->all(FLERR,"Illegal compute chunk/atom command");
+      iarg += 2;
     } else error->all(FLERR,"Illegal compute chunk/atom command");
   }
 
@@ -292,6 +302,10 @@ ComputeChunkAtom::ComputeChunkAtom(LAMMPS *lmp, int narg, char **arg) :
   if (which == ArgInfo::MOLECULE && !atom->molecule_flag)
     error->all(FLERR,"Compute chunk/atom molecule for non-molecular system");
 
+  if (incremental && which != ArgInfo::BIN1D && which != ArgInfo::BIN2D &&
+      which != ArgInfo::BIN3D)
+    error->all(FLERR,"Compute chunk/atom incremental requires "
+               "a bin/1d, bin/2d, or bin/3d style");
   if (!binflag && discard == MIXED)
     error->all(FLERR,"Compute chunk/atom without bins "
                "cannot use discard mixed");
@@ -465,6 +479,9 @@ ComputeChunkAtom::ComputeChunkAtom(LAMMPS *lmp, int narg, char **arg) :
   lockcount = 0;
   lockfix = nullptr;
 
+  nbinall = 0;
+  cachevalid = 0;
+
   if (which == ArgInfo::MOLECULE) molcheck = 1;
   else molcheck = 0;
 }
@@ -488,6 +505,11 @@ ComputeChunkAtom::~ComputeChunkAtom()
   delete [] idregion;
   delete [] cfvid;
   delete hash;
+  memory->destroy(binmap);
+
+  memory->destroy(bincache);
+  memory->destroy(xcache);
+  memory->destroy(dcache);
 
   memory->destroy(varatom);
 }
@@ -675,6 +697,46 @@ void ComputeChunkAtom::unlock(Fix *fixptr)
   lockfix = nullptr;
 }
 
+/* ----------------------------------------------------------------------
+   set owner of each chunk to the proc whose sub-domain contains
+     the center of the xyz bin, for use by sparse reductions of chunk data
+   for bin/1d and bin/2d the box center is used for the other dims
+   return 0 if chunks are not uncompressed xyz bins, else 1
+------------------------------------------------------------------------- */
+
+int ComputeChunkAtom::chunk_owners(int *owner)
+{
+  if (which != ArgInfo::BIN1D && which != ArgInfo::BIN2D &&
+      which != ArgInfo::BIN3D) return 0;
+  if (compress) return 0;
+
+  // bin coords are lamda coords if scaleflag = REDUCED
+  // coord2proc() requires lamda coords for triclinic, else box coords
+
+  int triclinic = domain->triclinic;
+  double *boxlo = domain->boxlo;
+  double *prd = domain->prd;
+
+  int m,n,idim,igx,igy,igz;
+  double x[3];
+
+  for (m = 0; m < nchunk; m++) {
+    for (idim = 0; idim < 3; idim++) {
+      if (triclinic) x[idim] = 0.5;
+      else x[idim] = boxlo[idim] + 0.5*prd[idim];
+    }
+    for (n = 0; n < ndim; n++) {
+      idim = dim[n];
+      if (scaleflag == REDUCED && !triclinic)
+        x[idim] = boxlo[idim] + coord[m][n]*prd[idim];
+      else x[idim] = coord[m][n];
+    }
+    owner[m] = comm->coord2proc(x,igx,igy,igz);
+  }
+
+  return 1;
+}
+
 /* ----------------------------------------------------------------------
    assign chunk IDs from 1 to Nchunk to every atom, or 0 if not in chunk
 ------------------------------------------------------------------------- */
@@ -722,8 +784,8 @@ void ComputeChunkAtom::compute_ichunk()
     if (binflag) {
       for (i = 0; i < nlocal; i++) {
         if (exclude[i]) continue;
-        if (hash->find(ichunk[i]) == hash->end()) exclude[i] = 1;
-        else ichunk[i] = hash->find(ichunk[i])->second;
+        if (binmap[ichunk[i]] == 0) exclude[i] = 1;
+        else ichunk[i] = binmap[ichunk[i]];
       }
     } else if (discard == NODISCARD) {
       for (i = 0; i < nlocal; i++) {
@@ -891,6 +953,15 @@ void ComputeChunkAtom::assign_chunk_ids()
     nmaxint = atom->nmax;
     memory->create(ichunk,nmaxint,"chunk/atom:ichunk");
     memory->create(exclude,nmaxint,"chunk/atom:exclude");
+    if (incremental) {
+      memory->destroy(bincache);
+      memory->destroy(xcache);
+      memory->destroy(dcache);
+      memory->create(bincache,nmaxint,"chunk/atom:bincache");
+      memory->create(xcache,nmaxint,3,"chunk/atom:xcache");
+      memory->create(dcache,nmaxint,"chunk/atom:dcache");
+      cachevalid = 0;
+    }
   }
 
   // update region if necessary
@@ -921,7 +992,8 @@ void ComputeChunkAtom::assign_chunk_ids()
   // binning styles apply discard rule, others do not yet
 
   if (binflag) {
-    if (which == ArgInfo::BIN1D) atom2bin1d();
+    if (incremental) atom2bin_incremental();
+    else if (which == ArgInfo::BIN1D) atom2bin1d();
     else if (which == ArgInfo::BIN2D) atom2bin2d();
     else if (which == ArgInfo::BIN3D) atom2bin3d();
     else if (which == ArgInfo::BINSPHERE) atom2binsphere();
@@ -1013,6 +1085,36 @@ void ComputeChunkAtom::assign_chunk_ids()
 
 void ComputeChunkAtom::compress_chunk_ids()
 {
+  // for binning styles, original chunk IDs are bins from 1 to Nbins
+  // flag populated bins and sum flags across all procs
+  // binmap = new compressed chunk ID of each original bin
+
+  if (binflag) {
+    nbinall = nchunk;
+    memory->destroy(binmap);
+    memory->create(binmap,nbinall+1,"chunk/atom:binmap");
+    int *flag;
+    memory->create(flag,nbinall+1,"chunk/atom:flag");
+    for (int m = 0; m <= nbinall; m++) flag[m] = 0;
+
+    int nlocal = atom->nlocal;
+    for (int i = 0; i < nlocal; i++)
+      if (!exclude[i]) flag[ichunk[i]] = 1;
+
+    MPI_Allreduce(flag,binmap,nbinall+1,MPI_INT,MPI_MAX,world);
+    memory->destroy(flag);
+
+    nchunk = 0;
+    for (int m = 1; m <= nbinall; m++)
+      if (binmap[m]) binmap[m] = ++nchunk;
+
+    memory->destroy(chunkID);
+    memory->create(chunkID,nchunk,"chunk/atom:chunkID");
+    for (int m = 1; m <= nbinall; m++)
+      if (binmap[m]) chunkID[binmap[m]-1] = m;
+    return;
+  }
+
   hash->clear();
 
   // put my IDs into hash
@@ -1771,6 +1873,137 @@ void ComputeChunkAtom::atom2bin3d()
   if (scaleflag == REDUCED) domain->lamda2x(nlocal);
 }
 
+/* ----------------------------------------------------------------------
+   assign each atom to a 1d, 2d, or 3d spatial bin
+   reuse the bin of an atom if it has moved less than its distance
+     to the nearest bin boundary since it was last binned
+   cache is only valid between reneighborings, since atoms are reordered,
+     and for unchanged bins in a static box
+------------------------------------------------------------------------- */
+
+void ComputeChunkAtom::atom2bin_incremental()
+{
+  int i,m,ibin;
+  double dx,dy,dz,dist;
+  double lamda[3];
+
+  double **x = atom->x;
+  int nlocal = atom->nlocal;
+
+  int valid = cachevalid;
+  if (neighbor->ncalls != cache_ncalls) valid = 0;
+  if (domain->box_change) valid = 0;
+  for (m = 0; m < ndim; m++)
+    if (offset[m] != cache_offset[m] || nlayers[m] != cache_nlayers[m])
+      valid = 0;
+
+  for (i = 0; i < nlocal; i++) {
+    if (exclude[i]) {
+      dcache[i] = -1.0;
+      continue;
+    }
+
+    if (valid && dcache[i] >= 0.0) {
+      dx = x[i][0] - xcache[i][0];
+      dy = x[i][1] - xcache[i][1];
+      dz = x[i][2] - xcache[i][2];
+      if (dx*dx + dy*dy + dz*dz < dcache[i]*dcache[i]) {
+        if (bincache[i]) ichunk[i] = bincache[i];
+        else exclude[i] = 1;
+        continue;
+      }
+    }
+
+    if (scaleflag == REDUCED) {
+      domain->x2lamda(x[i],lamda);
+      ibin = xyzbin(lamda,dist);
+    } else ibin = xyzbin(x[i],dist);
+
+    bincache[i] = ibin;
+    xcache[i][0] = x[i][0];
+    xcache[i][1] = x[i][1];
+    xcache[i][2] = x[i][2];
+    dcache[i] = dist;
+
+    if (ibin) ichunk[i] = ibin;
+    else exclude[i] = 1;
+  }
+
+  cachevalid = 1;
+  cache_ncalls = neighbor->ncalls;
+  for (m = 0; m < ndim; m++) {
+    cache_offset[m] = offset[m];
+    cache_nlayers[m] = nlayers[m];
+  }
+}
+
+/* ----------------------------------------------------------------------
+   return 1d, 2d, or 3d bin of one atom
+   xbin = coords of atom, lamda coords if units = reduced
+   return 0 if atom is discarded
+   dist = distance atom can move without changing the result
+     distance to nearest boundary of the bin or of the periodic box
+     for units = reduced, converted from lamda to box units
+------------------------------------------------------------------------- */
+
+int ComputeChunkAtom::xyzbin(double *xbin, double &dist)
+{
+  double *boxlo,*boxhi,*prd;
+  double scale[3];
+
+  if (scaleflag == REDUCED) {
+    boxlo = domain->boxlo_lamda;
+    boxhi = domain->boxhi_lamda;
+    prd = domain->prd_lamda;
+    double *h_inv = domain->h_inv;
+    scale[0] = 1.0/sqrt(h_inv[0]*h_inv[0] + h_inv[5]*h_inv[5] +
+                        h_inv[4]*h_inv[4]);
+    scale[1] = 1.0/sqrt(h_inv[1]*h_inv[1] + h_inv[3]*h_inv[3]);
+    scale[2] = 1.0/fabs(h_inv[2]);
+  } else {
+    boxlo = domain->boxlo;
+    boxhi = domain->boxhi;
+    prd = domain->prd;
+    scale[0] = scale[1] = scale[2] = 1.0;
+  }
+  int *periodicity = domain->periodicity;
+
+  int ibin = 0;
+  dist = BIG;
+
+  for (int m = 0; m < ndim; m++) {
+    int idim = dim[m];
+    double xremap = xbin[idim];
+    if (periodicity[idim]) {
+      if (xremap < boxlo[idim]) xremap += prd[idim];
+      if (xremap >= boxhi[idim]) xremap -= prd[idim];
+      dist = MIN(dist,fabs(xbin[idim]-boxlo[idim])*scale[idim]);
+      dist = MIN(dist,fabs(boxhi[idim]-xbin[idim])*scale[idim]);
+    }
+
+    double s = (xremap - offset[m]) * invdelta[m];
+    int i1bin = static_cast<int> (s);
+    if (xremap < offset[m]) i1bin--;
+    dist = MIN(dist,(s-i1bin)*delta[m]*scale[idim]);
+    dist = MIN(dist,(i1bin+1-s)*delta[m]*scale[idim]);
+
+    int nlayerm1 = nlayers[m] - 1;
+    if (discard == MIXED) {
+      if (!minflag[idim]) i1bin = MAX(i1bin,0);
+      else if (i1bin < 0) return 0;
+      if (!maxflag[idim]) i1bin = MIN(i1bin,nlayerm1);
+      else if (i1bin > nlayerm1) return 0;
+    } else if (discard == NODISCARD) {
+      i1bin = MAX(i1bin,0);
+      i1bin = MIN(i1bin,nlayerm1);
+    } else if (i1bin < 0 || i1bin > nlayerm1) return 0;
+
+    ibin = ibin*nlayers[m] + i1bin;
+  }
+
+  return ibin+1;
+}
+
 /* ----------------------------------------------------------------------
    assign each atom to a spherical bin
 ------------------------------------------------------------------------- */
@@ -1994,5 +2227,10 @@ double ComputeChunkAtom::memory_usage()
   bytes += (double)nmax * sizeof(double);                  // chunk
   bytes += (double)ncoord*nchunk * sizeof(double);         // coord
   if (compress) bytes += (double)nchunk * sizeof(int);     // chunkID
+  if (compress && binflag)
+    bytes += (double)(nbinall+1) * sizeof(int);            // binmap
+  if (incremental)
+    bytes += (double)MAX(nmaxint,0) *
+      (sizeof(int) + 4*sizeof(double));                    // bin,x,dcache
   return bytes;
 }
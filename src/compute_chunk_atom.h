@@ -47,6 +47,7 @@ class ComputeChunkAtom : public Compute {
   void unlock(class Fix *);
   int setup_chunks();
   void compute_ichunk();
+  int chunk_owners(int *);
 
  private:
   int which,binflag;
@@ -108,6 +109,21 @@ class ComputeChunkAtom : public Compute {
   int *exclude;              // 1 if atom is not assigned to any chunk
   std::map<tagint,int> *hash;   // store original chunks IDs before compression
 
+  int nbinall;               // # of bins before compression
+  int *binmap;               // compressed chunk ID of each bin, 0 if empty
+
+  // cache of xyz bins between reneighborings for incremental = yes
+
+  int incremental;
+  int *bincache;             // bin of each atom when last binned, 0 if none
+  double **xcache;           // coords of each atom when last binned
+  double *dcache;            // distance atom can move without changing bin
+                             //   < 0.0 if cache is not set for the atom
+  int cachevalid;            // 1 if cache is set for current bins
+  bigint cache_ncalls;       // # of neighbor list builds when cache was set
+  double cache_offset[3];    // bins when cache was set
+  int cache_nlayers[3];
+
   // callback function for ring communication
 
   static void idring(int, char *, void *);
@@ -122,6 +138,8 @@ class ComputeChunkAtom : public Compute {
   void atom2bin1d();
   void atom2bin2d();
   void atom2bin3d();
+  void atom2bin_incremental();
+  int xyzbin(double *, double &);
   void atom2binsphere();
   void atom2bincylinder();
   void readdim(int, char **, int, int);
@@ -226,6 +244,10 @@ E: Compute chunk/atom ids once but nchunk is not once
 You cannot assign chunks IDs to atom permanently if the number of
 chunks may change.
 
+E: Compute chunk/atom incremental requires a bin/1d, bin/2d, or bin/3d style
+
+Only the assignment of atoms to these bins can be cached.
+
 E: Two fix commands using same compute chunk/atom command in incompatible ways
 
 UNDOCUMENTED
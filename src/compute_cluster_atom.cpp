@@ -24,6 +24,7 @@
 #include "neigh_request.h"
 #include "neighbor.h"
 #include "pair.h"
+#include "union_find.h"
 #include "update.h"
 
 #include <cmath>
@@ -47,8 +48,10 @@ ComputeClusterAtom::ComputeClusterAtom(LAMMPS *lmp, int narg, char **arg) :
   peratom_flag = 1;
   size_peratom_cols = 0;
   comm_forward = 3;
+  comm_reverse = 1;
 
   nmax = 0;
+  uf = new UnionFind(lmp);
 }
 
 /* ---------------------------------------------------------------------- */
@@ -56,6 +59,7 @@ ComputeClusterAtom::ComputeClusterAtom(LAMMPS *lmp, int narg, char **arg) :
 ComputeClusterAtom::~ComputeClusterAtom()
 {
   memory->destroy(clusterID);
+  delete uf;
 }
 
 /* ---------------------------------------------------------------------- */
@@ -140,70 +144,42 @@ void ComputeClusterAtom::compute_peratom()
     comm->forward_comm_compute(this);
   }
 
-  // every atom starts in its own cluster, with clusterID = atomID
+  // every atom starts in its own cluster
+  // loop over my atoms, checking distance to neighbors
+  // if both atoms are in group, join their clusters
 
-  tagint *tag = atom->tag;
   int *mask = atom->mask;
+  double **x = atom->x;
+
+  uf->reset(atom->nlocal + atom->nghost);
 
   for (ii = 0; ii < inum; ii++) {
     i = ilist[ii];
-    if (mask[i] & groupbit) clusterID[i] = tag[i];
-    else clusterID[i] = 0;
+    if (!(mask[i] & groupbit)) continue;
+
+    xtmp = x[i][0];
+    ytmp = x[i][1];
+    ztmp = x[i][2];
+    jlist = firstneigh[i];
+    jnum = numneigh[i];
+
+    for (jj = 0; jj < jnum; jj++) {
+      j = jlist[jj];
+      j &= NEIGHMASK;
+      if (!(mask[j] & groupbit)) continue;
+
+      delx = xtmp - x[j][0];
+      dely = ytmp - x[j][1];
+      delz = ztmp - x[j][2];
+      rsq = delx*delx + dely*dely + delz*delz;
+      if (rsq < cutsq) uf->join(i,j);
+    }
   }
 
-  // loop until no more changes on any proc:
-  // acquire clusterIDs of ghost atoms
-  // loop over my atoms, checking distance to neighbors
-  // if both atoms are in cluster, assign lowest clusterID to both
-  // iterate until no changes in my atoms
-  // then check if any proc made changes
+  // merge clusters across procs, clusterID = lowest atom ID in cluster
 
   commflag = CLUSTER;
-  double **x = atom->x;
-
-  int change,done,anychange;
-
-  while (1) {
-    comm->forward_comm_compute(this);
-
-    change = 0;
-    while (1) {
-      done = 1;
-      for (ii = 0; ii < inum; ii++) {
-        i = ilist[ii];
-        if (!(mask[i] & groupbit)) continue;
-
-        xtmp = x[i][0];
-        ytmp = x[i][1];
-        ztmp = x[i][2];
-        jlist = firstneigh[i];
-        jnum = numneigh[i];
-
-        for (jj = 0; jj < jnum; jj++) {
-          j = jlist[jj];
-          j &= NEIGHMASK;
-          if (!(mask[j] & groupbit)) continue;
-          if (clusterID[i] == clusterID[j]) continue;
-
-          delx = xtmp - x[j][0];
-          dely = ytmp - x[j][1];
-          delz = ztmp - x[j][2];
-          rsq = delx*delx + dely*dely + delz*delz;
-          if (rsq < cutsq) {
-            clusterID[i] = clusterID[j] = MIN(clusterID[i],clusterID[j]);
-            done = 0;
-          }
-        }
-      }
-      if (!done) change = 1;
-      if (done) break;
-    }
-
-    // stop if all procs are done
-
-    MPI_Allreduce(&change,&anychange,1,MPI_INT,MPI_MAX,world);
-    if (!anychange) break;
-  }
+  uf->merge(this,groupbit,clusterID);
 }
 
 /* ---------------------------------------------------------------------- */
@@ -261,6 +237,37 @@ void ComputeClusterAtom::unpack_forward_comm(int n, int first, double *buf)
   }
 }
 
+/* ---------------------------------------------------------------------- */
+
+int ComputeClusterAtom::pack_reverse_comm(int n, int first, double *buf)
+{
+  int i,m,last;
+
+  m = 0;
+  last = first + n;
+  for (i = first; i < last; i++) {
+    buf[m++] = clusterID[i];
+  }
+  return m;
+}
+
+/* ---------------------------------------------------------------------- */
+
+void ComputeClusterAtom::unpack_reverse_comm(int n, int *list, double *buf)
+{
+  int i,j,m;
+
+  m = 0;
+  for (i = 0; i < n; i++) {
+    j = list[i];
+    double x = buf[m++];
+
+    // only overwrite local IDs with values lower than current ones
+
+    clusterID[j] = MIN(x,clusterID[j]);
+  }
+}
+
 /* ----------------------------------------------------------------------
    memory usage of local atom-based array
 ------------------------------------------------------------------------- */
@@ -268,5 +275,6 @@ void ComputeClusterAtom::unpack_forward_comm(int n, int first, double *buf)
 double ComputeClusterAtom::memory_usage()
 {
   double bytes = (double)nmax * sizeof(double);
+  bytes += uf->memory_usage();
   return bytes;
 }
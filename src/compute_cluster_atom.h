@@ -33,12 +33,15 @@ class ComputeClusterAtom : public Compute {
   void compute_peratom();
   int pack_forward_comm(int, int *, double *, int, int *);
   void unpack_forward_comm(int, int, double *);
+  int pack_reverse_comm(int, int, double *);
+  void unpack_reverse_comm(int, int *, double *);
   double memory_usage();
 
  private:
   int nmax,commflag;
   double cutsq;
   class NeighList *list;
+  class UnionFind *uf;
   double *clusterID;
 };
 
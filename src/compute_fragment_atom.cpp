@@ -24,14 +24,13 @@
 #include "group.h"
 #include "memory.h"
 #include "modify.h"
+#include "union_find.h"
 #include "update.h"
 
 #include <cstring>
 
 using namespace LAMMPS_NS;
 
-#define BIG 1.0e20
-
 /* ---------------------------------------------------------------------- */
 
 ComputeFragmentAtom::ComputeFragmentAtom(LAMMPS *lmp, int narg, char **arg) :
@@ -44,6 +43,7 @@ ComputeFragmentAtom::ComputeFragmentAtom(LAMMPS *lmp, int narg, char **arg) :
   peratom_flag = 1;
   size_peratom_cols = 0;
   comm_forward = 1;
+  comm_reverse = 1;
 
   // process optional args
 
@@ -61,19 +61,15 @@ ComputeFragmentAtom::ComputeFragmentAtom(LAMMPS *lmp, int narg, char **arg) :
   }
 
   nmax = 0;
-  stack = nullptr;
-  clist = nullptr;
-  markflag = nullptr;
+  uf = new UnionFind(lmp);
 }
 
 /* ---------------------------------------------------------------------- */
 
 ComputeFragmentAtom::~ComputeFragmentAtom()
 {
-  memory->destroy(stack);
-  memory->destroy(clist);
-  memory->destroy(markflag);
   memory->destroy(fragmentID);
+  delete uf;
 }
 
 /* ---------------------------------------------------------------------- */
@@ -96,24 +92,15 @@ void ComputeFragmentAtom::init()
 
 void ComputeFragmentAtom::compute_peratom()
 {
-  int i,j,k,m,n;
-  int nstack,ncluster,done,alldone;
-  double newID,cID;
-  tagint *list;
+  int i,k,m;
 
   invoked_peratom = update->ntimestep;
 
-  // grow work and fragmentID vectors if necessary
+  // grow fragmentID vector if necessary
 
   if (atom->nmax > nmax) {
-    memory->destroy(stack);
-    memory->destroy(clist);
-    memory->destroy(markflag);
     memory->destroy(fragmentID);
     nmax = atom->nmax;
-    memory->create(stack,nmax,"fragment/atom:stack");
-    memory->create(clist,nmax,"fragment/atom:clist");
-    memory->create(markflag,nmax,"fragment/atom:markflag");
     memory->create(fragmentID,nmax,"fragment/atom:fragmentID");
     vector_atom = fragmentID;
   }
@@ -125,111 +112,38 @@ void ComputeFragmentAtom::compute_peratom()
     comm->forward_comm_compute(this);
   }
 
-  // owned + ghost atoms start with fragmentID = atomID
-  // atoms not in group have fragmentID = 0
+  // each atom starts in its own fragment
+  // loop over my atoms and their bond partners
+  // if both atoms are in group, join their fragments
 
-  tagint *tag = atom->tag;
   int *mask = atom->mask;
   tagint **special = atom->special;
   int **nspecial = atom->nspecial;
   int nlocal = atom->nlocal;
-  int nall = nlocal + atom->nghost;
 
-  for (i = 0; i < nall; i++) {
-    if (mask[i] & groupbit) fragmentID[i] = tag[i];
-    else fragmentID[i] = 0;
+  uf->reset(nlocal + atom->nghost);
+
+  for (i = 0; i < nlocal; i++) {
+    if (!(mask[i] & groupbit)) continue;
+    for (m = 0; m < nspecial[i][0]; m++) {
+      k = atom->map(special[i][m]);
+      if (k < 0) continue;
+      if (!(mask[k] & groupbit)) continue;
+      uf->join(i,k);
+    }
   }
 
-  // loop until no ghost atom fragment ID is changed
-  // acquire fragmentIDs of ghost atoms
-  // loop over clusters of atoms, which include ghost atoms
-  // set fragmentIDs for each cluster to min framentID in the clusters
-  // if singleflag = 0 atoms without bonds are assigned fragmentID = 0
-  // iterate until no changes to ghost atom fragmentIDs
+  // merge fragments across procs, fragmentID = lowest atom ID in fragment
 
   commflag = 1;
+  uf->merge(this,groupbit,fragmentID);
 
-  int iteration = 0;
-
-  while (1) {
-    iteration++;
+  // if singleflag = 0 atoms without bond partners have fragmentID = 0
 
+  if (!singleflag) {
+    for (i = 0; i < nlocal; i++)
+      if (nspecial[i][0] == 0) fragmentID[i] = 0.0;
     comm->forward_comm_compute(this);
-    done = 1;
-
-    // set markflag = 0 for all owned atoms, for new iteration
-
-    for (i = 0; i < nlocal; i++) markflag[i] = 0;
-
-    // loop over all owned atoms
-    // each unmarked atom starts a cluster search
-
-    for (i = 0; i < nlocal; i++) {
-
-      // skip atom I if not in group or already marked
-      // if singleflag = 0 and atom has no bond partners, fragID = 0 and done
-
-      if (!(mask[i] & groupbit)) continue;
-      if (markflag[i]) continue;
-      if (!singleflag && (nspecial[i][0] == 0)) {
-        fragmentID[i] = 0.0;
-        continue;
-      }
-
-      // find one cluster of bond-connected atoms
-      // ncluster = # of owned and ghost atoms in cluster
-      // clist = vector of local indices of the ncluster atoms
-      // stack is used to walk the bond topology
-
-      ncluster = nstack = 0;
-      stack[nstack++] = i;
-
-      while (nstack) {
-        j = stack[--nstack];
-        clist[ncluster++] = j;
-        markflag[j] = 1;
-
-        n = nspecial[j][0];
-        list = special[j];
-        for (m = 0; m < n; m++) {
-          k = atom->map(list[m]);
-
-          // skip bond neighbor K if not in group or already marked
-
-          if (k < 0) continue;
-          if (!(mask[k] & groupbit)) continue;
-          if (k < nlocal && markflag[k]) continue;
-
-          // owned bond neighbors are added to stack for further walking
-          // ghost bond neighbors are added directly w/out use of stack
-
-          if (k < nlocal) stack[nstack++] = k;
-          else clist[ncluster++] = k;
-        }
-      }
-
-      // newID = minimum fragment ID in cluster list, including ghost atoms
-
-      newID = BIG;
-      for (m = 0; m < ncluster; m++) {
-        cID = fragmentID[clist[m]];
-        newID = MIN(newID,cID);
-      }
-
-      // set fragmentID = newID for all atoms in cluster, including ghost atoms
-      // not done with iterations if change the fragmentID of a ghost atom
-
-      for (m = 0; m < ncluster; m++) {
-        j = clist[m];
-        if (j >= nlocal && fragmentID[j] != newID) done = 0;
-        fragmentID[j] = newID;
-      }
-    }
-
-    // stop if all procs are done
-
-    MPI_Allreduce(&done,&alldone,1,MPI_INT,MPI_MIN,world);
-    if (alldone) break;
   }
 }
 
@@ -266,19 +180,44 @@ void ComputeFragmentAtom::unpack_forward_comm(int n, int first, double *buf)
   m = 0;
   last = first + n;
   if (commflag)
-    for (i = first; i < last; i++) {
-      double x = buf[m++];
-
-      // only overwrite ghost IDs with values lower than current ones
-
-      fragmentID[i] = MIN(x,fragmentID[i]);
-    }
+    for (i = first; i < last; i++) fragmentID[i] = buf[m++];
   else {
     int *mask = atom->mask;
     for (i = first; i < last; i++) mask[i] = (int) ubuf(buf[m++]).i;
   }
 }
 
+/* ---------------------------------------------------------------------- */
+
+int ComputeFragmentAtom::pack_reverse_comm(int n, int first, double *buf)
+{
+  int i,m,last;
+
+  m = 0;
+  last = first + n;
+  for (i = first; i < last; i++) {
+    buf[m++] = fragmentID[i];
+  }
+  return m;
+}
+
+/* ---------------------------------------------------------------------- */
+
+void ComputeFragmentAtom::unpack_reverse_comm(int n, int *list, double *buf)
+{
+  int i,j,m;
+
+  m = 0;
+  for (i = 0; i < n; i++) {
+    j = list[i];
+    double x = buf[m++];
+
+    // only overwrite local IDs with values lower than current ones
+
+    fragmentID[j] = MIN(x,fragmentID[j]);
+  }
+}
+
 /* ----------------------------------------------------------------------
    memory usage of local atom-based arrays
 ------------------------------------------------------------------------- */
@@ -286,6 +225,6 @@ void ComputeFragmentAtom::unpack_forward_comm(int n, int first, double *buf)
 double ComputeFragmentAtom::memory_usage()
 {
   double bytes = (double)nmax * sizeof(double);
-  bytes += (double)3*nmax * sizeof(int);
+  bytes += uf->memory_usage();
   return bytes;
 }
@@ -53,7 +53,9 @@ using namespace MathSpecial;
 ComputeOrientOrderAtom::ComputeOrientOrderAtom(LAMMPS *lmp, int narg, char **arg) :
   Compute(lmp, narg, arg),
   qlist(nullptr), distsq(nullptr), nearest(nullptr), rlist(nullptr),
-  qnarray(nullptr), qnm_r(nullptr), qnm_i(nullptr), cglist(nullptr)
+  qnarray(nullptr), qnm_r(nullptr), qnm_i(nullptr), ylm_r(nullptr),
+  ylm_i(nullptr), ymm(nullptr), alm(nullptr), blm(nullptr),
+  qlmarray(nullptr), cglist(nullptr)
 {
   if (narg < 3 ) error->all(FLERR,"Illegal compute orientorder/atom command");
 
@@ -63,6 +65,7 @@ ComputeOrientOrderAtom::ComputeOrientOrderAtom(LAMMPS *lmp, int narg, char **arg
   cutsq = 0.0;
   wlflag = 0;
   wlhatflag = 0;
+  avgflag = 0;
   qlcompflag = 0;
   chunksize = 16384;
 
@@ -125,6 +128,13 @@ ComputeOrientOrderAtom::ComputeOrientOrderAtom(LAMMPS *lmp, int narg, char **arg
       else if (strcmp(arg[iarg+1],"no") == 0) wlhatflag = 0;
       else error->all(FLERR,"Illegal compute orientorder/atom command");
       iarg += 2;
+    } else if (strcmp(arg[iarg],"average") == 0) {
+      if (iarg+2 > narg)
+        error->all(FLERR,"Illegal compute orientorder/atom command");
+      if (strcmp(arg[iarg+1],"yes") == 0) avgflag = 1;
+      else if (strcmp(arg[iarg+1],"no") == 0) avgflag = 0;
+      else error->all(FLERR,"Illegal compute orientorder/atom command");
+      iarg += 2;
     } else if (strcmp(arg[iarg],"components") == 0) {
       qlcompflag = 1;
       if (iarg+2 > narg)
@@ -161,12 +171,21 @@ ComputeOrientOrderAtom::ComputeOrientOrderAtom(LAMMPS *lmp, int narg, char **arg
   if (wlflag) ncol += nqlist;
   if (wlhatflag) ncol += nqlist;
   if (qlcompflag) ncol += 2*(2*qlcomp+1);
+  if (avgflag) ncol += nqlist;
 
   peratom_flag = 1;
   size_peratom_cols = ncol;
 
+  // Y_lm with m >= 0 of each atom are communicated for averaged Q_l
+
+  ncomp = 0;
+  for (int il = 0; il < nqlist; il++) ncomp += 2*(qlist[il]+1);
+  if (avgflag) comm_forward = ncomp;
+
   nmax = 0;
   maxneigh = 0;
+
+  init_harmonics();
 }
 
 /* ---------------------------------------------------------------------- */
@@ -182,6 +201,12 @@ ComputeOrientOrderAtom::~ComputeOrientOrderAtom()
   memory->destroy(qlist);
   memory->destroy(qnm_r);
   memory->destroy(qnm_i);
+  memory->destroy(ylm_r);
+  memory->destroy(ylm_i);
+  memory->destroy(ymm);
+  memory->destroy(alm);
+  memory->destroy(blm);
+  memory->destroy(qlmarray);
   memory->destroy(cglist);
 }
 
@@ -229,9 +254,8 @@ void ComputeOrientOrderAtom::init_list(int /*id*/, NeighList *ptr)
 
 void ComputeOrientOrderAtom::compute_peratom()
 {
-  int i,j,ii,jj,inum,jnum;
-  double xtmp,ytmp,ztmp,delx,dely,delz,rsq;
-  int *ilist,*jlist,*numneigh,**firstneigh;
+  int i,ii,inum;
+  int *ilist;
 
   invoked_peratom = update->ntimestep;
 
@@ -242,6 +266,10 @@ void ComputeOrientOrderAtom::compute_peratom()
     nmax = atom->nmax;
     memory->create(qnarray,nmax,ncol,"orientorder/atom:qnarray");
     array_atom = qnarray;
+    if (avgflag) {
+      memory->destroy(qlmarray);
+      memory->create(qlmarray,nmax,ncomp,"orientorder/atom:qlmarray");
+    }
   }
 
   // invoke full neighbor list (will copy or build if necessary)
@@ -250,13 +278,12 @@ void ComputeOrientOrderAtom::compute_peratom()
 
   inum = list->inum;
   ilist = list->ilist;
-  numneigh = list->numneigh;
-  firstneigh = list->firstneigh;
 
   // compute order parameter for each atom in group
   // use full neighbor list to count atoms less than cutoff
+  // for averaged Q_l, also store Y_lm of atoms not in group,
+  //   since they may be neighbors of atoms in group
 
-  double **x = atom->x;
   int *mask = atom->mask;
   memset(&qnarray[0][0],0,sizeof(double)*nmax*ncol);
 
@@ -264,65 +291,130 @@ void ComputeOrientOrderAtom::compute_peratom()
     i = ilist[ii];
     double* qn = qnarray[i];
     if (mask[i] & groupbit) {
-      xtmp = x[i][0];
-      ytmp = x[i][1];
-      ztmp = x[i][2];
-      jlist = firstneigh[i];
-      jnum = numneigh[i];
-
-      // insure distsq and nearest arrays are long enough
-
-      if (jnum > maxneigh) {
-        memory->destroy(distsq);
-        memory->destroy(rlist);
-        memory->destroy(nearest);
-        maxneigh = jnum;
-        memory->create(distsq,maxneigh,"orientorder/atom:distsq");
-        memory->create(rlist,maxneigh,3,"orientorder/atom:rlist");
-        memory->create(nearest,maxneigh,"orientorder/atom:nearest");
-      }
-
-      // loop over list of all neighbors within force cutoff
-      // distsq[] = distance sq to each
-      // rlist[] = distance vector to each
-      // nearest[] = atom indices of neighbors
-
-      int ncount = 0;
-      for (jj = 0; jj < jnum; jj++) {
-        j = jlist[jj];
-        j &= NEIGHMASK;
-
-        delx = xtmp - x[j][0];
-        dely = ytmp - x[j][1];
-        delz = ztmp - x[j][2];
-        rsq = delx*delx + dely*dely + delz*delz;
-        if (rsq < cutsq) {
-          distsq[ncount] = rsq;
-          rlist[ncount][0] = delx;
-          rlist[ncount][1] = dely;
-          rlist[ncount][2] = delz;
-          nearest[ncount++] = j;
+      int ncount = select_neighbors(i);
+      if (ncount) calc_boop(rlist, ncount, qn, qlist, nqlist);
+      else if (avgflag) calc_ylm(rlist, 0);
+    } else if (avgflag) {
+      calc_ylm(rlist, select_neighbors(i));
+    } else continue;
+
+    // store Y_lm with m >= 0 of all degrees for averaged Q_l
+
+    if (avgflag) {
+      double *qlm = qlmarray[i];
+      int k = 0;
+      for (int il = 0; il < nqlist; il++) {
+        int l = qlist[il];
+        for (int m = 0; m <= l; m++) {
+          qlm[k++] = qnm_r[il][m+l];
+          qlm[k++] = qnm_i[il][m+l];
         }
       }
+    }
+  }
 
-      // if not nnn neighbors, order parameter = 0;
+  // averaged Q_l requires Y_lm of ghost atoms
 
-      if ((ncount == 0) || (ncount < nnn)) {
-        for (int jj = 0; jj < ncol; jj++)
-          qn[jj] = 0.0;
-        continue;
-      }
+  if (avgflag) {
+    comm->forward_comm_compute(this);
+    for (ii = 0; ii < inum; ii++) {
+      i = ilist[ii];
+      if (!(mask[i] & groupbit)) continue;
+      int ncount = select_neighbors(i);
+      if (ncount) calc_average(i, ncount, &qnarray[i][ncol-nqlist]);
+    }
+  }
+}
 
-      // if nnn > 0, use only nearest nnn neighbors
+/* ----------------------------------------------------------------------
+   find neighbors of atom I within cutoff
+   if nnn > 0, use only nearest nnn neighbors
+   store them in nearest[], with distance vectors in rlist[]
+   return # of neighbors, 0 if not nnn neighbors
+------------------------------------------------------------------------- */
 
-      if (nnn > 0) {
-        select3(nnn,ncount,distsq,nearest,rlist);
-        ncount = nnn;
-      }
+int ComputeOrientOrderAtom::select_neighbors(int i)
+{
+  int j,jj,jnum;
+  double delx,dely,delz,rsq;
+
+  double **x = atom->x;
+  const double xtmp = x[i][0];
+  const double ytmp = x[i][1];
+  const double ztmp = x[i][2];
+  int *jlist = list->firstneigh[i];
+  jnum = list->numneigh[i];
+
+  // insure distsq and nearest arrays are long enough
+
+  if (jnum > maxneigh) {
+    memory->destroy(distsq);
+    memory->destroy(rlist);
+    memory->destroy(nearest);
+    maxneigh = jnum;
+    memory->create(distsq,maxneigh,"orientorder/atom:distsq");
+    memory->create(rlist,maxneigh,3,"orientorder/atom:rlist");
+    memory->create(nearest,maxneigh,"orientorder/atom:nearest");
+  }
 
-      calc_boop(rlist, ncount, qn, qlist, nqlist);
+  // loop over list of all neighbors within force cutoff
+  // distsq[] = distance sq to each
+  // rlist[] = distance vector to each
+  // nearest[] = atom indices of neighbors
+
+  int ncount = 0;
+  for (jj = 0; jj < jnum; jj++) {
+    j = jlist[jj];
+    j &= NEIGHMASK;
+
+    delx = xtmp - x[j][0];
+    dely = ytmp - x[j][1];
+    delz = ztmp - x[j][2];
+    rsq = delx*delx + dely*dely + delz*delz;
+    if (rsq < cutsq) {
+      distsq[ncount] = rsq;
+      rlist[ncount][0] = delx;
+      rlist[ncount][1] = dely;
+      rlist[ncount][2] = delz;
+      nearest[ncount++] = j;
     }
   }
+
+  // if not nnn neighbors, order parameter = 0;
+
+  if ((ncount == 0) || (ncount < nnn)) return 0;
+
+  // if nnn > 0, use only nearest nnn neighbors
+
+  if (nnn > 0) {
+    select3(nnn,ncount,distsq,nearest,rlist);
+    ncount = nnn;
+  }
+
+  return ncount;
+}
+
+/* ---------------------------------------------------------------------- */
+
+int ComputeOrientOrderAtom::pack_forward_comm(int n, int *list, double *buf,
+                                              int /*pbc_flag*/, int * /*pbc*/)
+{
+  int i,k,m = 0;
+  for (i = 0; i < n; ++i)
+    for (k = 0; k < ncomp; ++k)
+      buf[m++] = qlmarray[list[i]][k];
+  return m;
+}
+
+/* ---------------------------------------------------------------------- */
+
+void ComputeOrientOrderAtom::unpack_forward_comm(int n, int first, double *buf)
+{
+  int i,k,m = 0;
+  int last = first + n;
+  for (i = first; i < last; ++i)
+    for (k = 0; k < ncomp; ++k)
+      qlmarray[i][k] = buf[m++];
 }
 
 /* ----------------------------------------------------------------------
@@ -334,6 +426,8 @@ double ComputeOrientOrderAtom::memory_usage()
   double bytes = (double)ncol*nmax * sizeof(double);
   bytes += (double)(qmax*(2*qmax+1)+maxneigh*4) * sizeof(double);
   bytes += (double)(nqlist+maxneigh) * sizeof(int);
+  bytes += (double)4*(qmax+1)*(qmax+1) * sizeof(double);   // ylm,alm,blm
+  if (avgflag) bytes += (double)ncomp*nmax * sizeof(double);
   return bytes;
 }
 
@@ -438,77 +532,7 @@ void ComputeOrientOrderAtom::calc_boop(double **rlist,
                                        int ncount, double qn[],
                                        int qlist[], int nqlist) {
 
-  for (int il = 0; il < nqlist; il++) {
-    int l = qlist[il];
-    for (int m = 0; m < 2*l+1; m++) {
-      qnm_r[il][m] = 0.0;
-      qnm_i[il][m] = 0.0;
-    }
-  }
-
-  for (int ineigh = 0; ineigh < ncount; ineigh++) {
-    const double * const r = rlist[ineigh];
-    double rmag = dist(r);
-    if (rmag <= MY_EPSILON) {
-      return;
-    }
-
-    double costheta = r[2] / rmag;
-    double expphi_r = r[0];
-    double expphi_i = r[1];
-    double rxymag = sqrt(expphi_r*expphi_r+expphi_i*expphi_i);
-    if (rxymag <= MY_EPSILON) {
-      expphi_r = 1.0;
-      expphi_i = 0.0;
-    } else {
-      double rxymaginv = 1.0/rxymag;
-      expphi_r *= rxymaginv;
-      expphi_i *= rxymaginv;
-    }
-
-    for (int il = 0; il < nqlist; il++) {
-      int l = qlist[il];
-
-      // calculate spherical harmonics
-      // Ylm, -l <= m <= l
-      // sign convention: sign(Yll(0,0)) = (-1)^l
-
-      qnm_r[il][l] += polar_prefactor(l, 0, costheta);
-      double expphim_r = expphi_r;
-      double expphim_i = expphi_i;
-      for (int m = 1; m <= +l; m++) {
-
-        double prefactor = polar_prefactor(l, m, costheta);
-        double ylm_r = prefactor * expphim_r;
-        double ylm_i = prefactor * expphim_i;
-        qnm_r[il][m+l] += ylm_r;
-        qnm_i[il][m+l] += ylm_i;
-        if (m & 1) {
-          qnm_r[il][-m+l] -= ylm_r;
-          qnm_i[il][-m+l] += ylm_i;
-        } else {
-          qnm_r[il][-m+l] += ylm_r;
-          qnm_i[il][-m+l] -= ylm_i;
-        }
-        double tmp_r = expphim_r*expphi_r - expphim_i*expphi_i;
-        double tmp_i = expphim_r*expphi_i + expphim_i*expphi_r;
-        expphim_r = tmp_r;
-        expphim_i = tmp_i;
-      }
-
-    }
-  }
-
-  // convert sums to averages
-
-  double facn = 1.0 / ncount;
-  for (int il = 0; il < nqlist; il++) {
-    int l = qlist[il];
-    for (int m = 0; m < 2*l+1; m++) {
-      qnm_r[il][m] *= facn;
-      qnm_i[il][m] *= facn;
-    }
-  }
+  if (!calc_ylm(rlist, ncount)) return;
 
   // calculate Q_l
   // NOTE: optional W_l_hat and components of Q_qlcomp use these stored Q_l values
@@ -601,51 +625,149 @@ double ComputeOrientOrderAtom::dist(const double r[])
 }
 
 /* ----------------------------------------------------------------------
-   polar prefactor for spherical harmonic Y_l^m, where
-   Y_l^m (theta, phi) = prefactor(l, m, cos(theta)) * exp(i*m*phi)
+   calculate averages of the spherical harmonics Y_lm over the neighbors
+   Y_lm = ymm[m] * Q_lm(cos(theta)) * ((x + i y)/r)^m, m >= 0, with
+     Q_lm = P_lm/sin^m(theta) obtained by a recursion in l for each m,
+     so only polynomials of the bond unit vector are needed
+   Y_l,-m = (-1)^m Y*_lm
+   return 0 if the averages are zero, e.g. for a neighbor at zero distance
 ------------------------------------------------------------------------- */
 
-double ComputeOrientOrderAtom::polar_prefactor(int l, int m, double costheta)
+int ComputeOrientOrderAtom::calc_ylm(double **rlist, int ncount)
 {
-  const int mabs = abs(m);
+  int l,m;
+
+  for (int il = 0; il < nqlist; il++) {
+    l = qlist[il];
+    for (m = 0; m < 2*l+1; m++) {
+      qnm_r[il][m] = 0.0;
+      qnm_i[il][m] = 0.0;
+    }
+  }
+  if (ncount == 0) return 0;
 
-  double prefactor = 1.0;
-  for (int i=l-mabs+1; i < l+mabs+1; ++i)
-    prefactor *= static_cast<double>(i);
+  for (l = 0; l <= qmax; l++)
+    for (m = 0; m <= l; m++) {
+      ylm_r[l][m] = 0.0;
+      ylm_i[l][m] = 0.0;
+    }
 
-  prefactor = sqrt(static_cast<double>(2*l+1)/(MY_4PI*prefactor))
-    * associated_legendre(l,mabs,costheta);
+  for (int ineigh = 0; ineigh < ncount; ineigh++) {
+    const double * const r = rlist[ineigh];
+    double rmag = dist(r);
+    if (rmag <= MY_EPSILON) return 0;
+
+    const double rinv = 1.0/rmag;
+    const double ux = r[0]*rinv;
+    const double uy = r[1]*rinv;
+    const double uz = r[2]*rinv;
+
+    // zm = (ux + i uy)^m = sin^m(theta) exp(i m phi)
+
+    double zm_r = 1.0;
+    double zm_i = 0.0;
+    for (m = 0; m <= qmax; m++) {
+      double plm2 = 0.0;
+      double plm1 = ymm[m];
+      ylm_r[m][m] += plm1*zm_r;
+      ylm_i[m][m] += plm1*zm_i;
+      for (l = m+1; l <= qmax; l++) {
+        const double plm = alm[l][m]*(uz*plm1 - blm[l][m]*plm2);
+        ylm_r[l][m] += plm*zm_r;
+        ylm_i[l][m] += plm*zm_i;
+        plm2 = plm1;
+        plm1 = plm;
+      }
+      const double tmp_r = zm_r*ux - zm_i*uy;
+      zm_i = zm_r*uy + zm_i*ux;
+      zm_r = tmp_r;
+    }
+  }
 
-  if ((m < 0) && (m % 2)) prefactor = -prefactor;
+  // convert sums to averages, including m < 0
+
+  double facn = 1.0 / ncount;
+  for (int il = 0; il < nqlist; il++) {
+    l = qlist[il];
+    qnm_r[il][l] = ylm_r[l][0]*facn;
+    qnm_i[il][l] = ylm_i[l][0]*facn;
+    for (m = 1; m <= l; m++) {
+      const double ylmavg_r = ylm_r[l][m]*facn;
+      const double ylmavg_i = ylm_i[l][m]*facn;
+      qnm_r[il][m+l] = ylmavg_r;
+      qnm_i[il][m+l] = ylmavg_i;
+      if (m & 1) {
+        qnm_r[il][-m+l] = -ylmavg_r;
+        qnm_i[il][-m+l] = ylmavg_i;
+      } else {
+        qnm_r[il][-m+l] = ylmavg_r;
+        qnm_i[il][-m+l] = -ylmavg_i;
+      }
+    }
+  }
 
-  return prefactor;
+  return 1;
 }
 
 /* ----------------------------------------------------------------------
-   associated legendre polynomial
-   sign convention: P(l,l) = (2l-1)!!(-sqrt(1-x^2))^l
+   calculate averaged Q_l of atom I from the Y_lm averages of I
+     and its ncount neighbors, see Lechner and Dellago
 ------------------------------------------------------------------------- */
 
-double ComputeOrientOrderAtom::associated_legendre(int l, int m, double x)
+void ComputeOrientOrderAtom::calc_average(int i, int ncount, double qavg[])
 {
-  if (l < m) return 0.0;
-
-  double p(1.0), pm1(0.0), pm2(0.0);
+  int k,m,jj;
 
-  if (m != 0) {
-    const double msqx = -sqrt(1.0-x*x);
-    for (int i=1; i < m+1; ++i)
-      p *= static_cast<double>(2*i-1) * msqx;
+  int kfirst = 0;
+  double facn = 1.0 / (ncount+1);
+  for (int il = 0; il < nqlist; il++) {
+    int l = qlist[il];
+    int klast = kfirst + 2*(l+1);
+    double qm_sum = 0.0;
+    for (k = kfirst, m = 0; k < klast; k += 2, m++) {
+      double qlm_r = qlmarray[i][k];
+      double qlm_i = qlmarray[i][k+1];
+      for (jj = 0; jj < ncount; jj++) {
+        qlm_r += qlmarray[nearest[jj]][k];
+        qlm_i += qlmarray[nearest[jj]][k+1];
+      }
+      double qlmsq = qlm_r*qlm_r + qlm_i*qlm_i;
+      if (m == 0) qm_sum += qlmsq;
+      else qm_sum += 2.0*qlmsq;
+    }
+    qavg[il] = sqrt(MY_4PI/(2*l+1)*qm_sum) * facn;
+    kfirst = klast;
   }
+}
 
-  for (int i=m+1; i < l+1; ++i) {
-    pm2 = pm1;
-    pm1 = p;
-    p = (static_cast<double>(2*i-1)*x*pm1
-         - static_cast<double>(i+m-1)*pm2) / static_cast<double>(i-m);
-  }
+/* ----------------------------------------------------------------------
+   coefficients of the recursion for the normalized associated
+   Legendre polynomials divided by sin^m(theta)
+   Y_mm / sin^m(theta) = -sqrt((2m+1)/2m) Y_m-1,m-1 / sin^(m-1)(theta)
+   Q_lm = alm * (cos(theta) Q_l-1,m - blm Q_l-2,m)
+   sign convention: sign(Yll(0,0)) = (-1)^l
+------------------------------------------------------------------------- */
 
-  return p;
+void ComputeOrientOrderAtom::init_harmonics()
+{
+  memory->create(ylm_r,qmax+1,qmax+1,"orientorder/atom:ylm_r");
+  memory->create(ylm_i,qmax+1,qmax+1,"orientorder/atom:ylm_i");
+  memory->create(ymm,qmax+1,"orientorder/atom:ymm");
+  memory->create(alm,qmax+1,qmax+1,"orientorder/atom:alm");
+  memory->create(blm,qmax+1,qmax+1,"orientorder/atom:blm");
+
+  ymm[0] = sqrt(1.0/MY_4PI);
+  for (int m = 1; m <= qmax; m++)
+    ymm[m] = -sqrt((2.0*m+1.0)/(2.0*m)) * ymm[m-1];
+
+  for (int l = 1; l <= qmax; l++)
+    for (int m = 0; m < l; m++) {
+      double lsq = l*l;
+      double lm1sq = (l-1)*(l-1);
+      double msq = m*m;
+      alm[l][m] = sqrt((4.0*lsq-1.0)/(lsq-msq));
+      blm[l][m] = sqrt((lm1sq-msq)/(4.0*lm1sq-1.0));
+    }
 }
 
 /* ----------------------------------------------------------------------
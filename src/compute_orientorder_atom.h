@@ -31,9 +31,11 @@ class ComputeOrientOrderAtom : public Compute {
   virtual void init();
   void init_list(int, class NeighList *);
   virtual void compute_peratom();
+  int pack_forward_comm(int, int *, double *, int, int *);
+  void unpack_forward_comm(int, int, double *);
   double memory_usage();
   double cutsq;
-  int iqlcomp, qlcomp, qlcompflag, wlflag, wlhatflag;
+  int iqlcomp, qlcomp, qlcompflag, wlflag, wlhatflag, avgflag;
   int *qlist;
   int nqlist;
 
@@ -48,13 +50,22 @@ class ComputeOrientOrderAtom : public Compute {
   double **qnm_r;
   double **qnm_i;
 
+  double **ylm_r;                      // sums of Y_lm for 0 <= m <= l <= qmax
+  double **ylm_i;
+  double *ymm;                         // Y_mm / sin^m(theta) for m <= qmax
+  double **alm,**blm;                  // coeffs of recursion in l for Y_lm
+  int ncomp;                           // # of stored Y_lm, m >= 0, per atom
+  double **qlmarray;                   // Y_lm of owned and ghost atoms
+
+  int select_neighbors(int);
   void select3(int, int, double *, int *, double **);
   void calc_boop(double **rlist, int numNeighbors,
                  double qn[], int nlist[], int nnlist);
+  int calc_ylm(double **rlist, int numNeighbors);
+  void calc_average(int, int, double qn[]);
   double dist(const double r[]);
 
-  double polar_prefactor(int, int, double);
-  double associated_legendre(int, int, double);
+  void init_harmonics();
 
   virtual void init_clebsch_gordan();
   double *cglist;                      // Clebsch-Gordan coeffs
@@ -32,11 +32,17 @@
 #include "memory.h"
 #include "error.h"
 #include "comm.h"
+#include "irregular.h"
 
 
 using namespace LAMMPS_NS;
 using namespace MathConst;
 
+enum{ALL,INTER,INTRA};
+
+#define BIG 1.0e20
+#define MAXIMAGE 64
+
 /* ---------------------------------------------------------------------- */
 
 ComputeRDF::ComputeRDF(LAMMPS *lmp, int narg, char **arg) :
@@ -57,10 +63,13 @@ ComputeRDF::ComputeRDF(LAMMPS *lmp, int narg, char **arg) :
   // nargpair = # of pairwise args, starting at iarg = 4
 
   cutflag = 0;
+  binflag = 0;
+  molflag = ALL;
 
   int iarg;
   for (iarg = 4; iarg < narg; iarg++)
-    if (strcmp(arg[iarg],"cutoff") == 0) break;
+    if (strcmp(arg[iarg],"cutoff") == 0 || strcmp(arg[iarg],"binned") == 0 ||
+        strcmp(arg[iarg],"molecule") == 0) break;
 
   int nargpair = iarg - 4;
 
@@ -71,11 +80,27 @@ ComputeRDF::ComputeRDF(LAMMPS *lmp, int narg, char **arg) :
       if (cutoff_user <= 0.0) cutflag = 0;
       else cutflag = 1;
       iarg += 2;
+    } else if (strcmp(arg[iarg],"binned") == 0) {
+      if (iarg+2 > narg) error->all(FLERR,"Illegal compute rdf command");
+      if (strcmp(arg[iarg+1],"yes") == 0) binflag = 1;
+      else if (strcmp(arg[iarg+1],"no") == 0) binflag = 0;
+      else error->all(FLERR,"Illegal compute rdf command");
+      iarg += 2;
+    } else if (strcmp(arg[iarg],"molecule") == 0) {
+      if (iarg+2 > narg) error->all(FLERR,"Illegal compute rdf command");
+      if (strcmp(arg[iarg+1],"all") == 0) molflag = ALL;
+      else if (strcmp(arg[iarg+1],"inter") == 0) molflag = INTER;
+      else if (strcmp(arg[iarg+1],"intra") == 0) molflag = INTRA;
+      else error->all(FLERR,"Illegal compute rdf command");
+      iarg += 2;
     } else error->all(FLERR,"Illegal compute rdf command");
   }
 
   // pairwise args
 
+  if (molflag != ALL && !atom->molecule_flag)
+    error->all(FLERR,"Compute rdf molecule requires atoms have molecule IDs");
+
   if (nargpair == 0) npairs = 1;
   else {
     if (nargpair % 2) error->all(FLERR,"Illegal compute rdf command");
@@ -160,7 +185,13 @@ void ComputeRDF::init()
     error->all(FLERR,"Compute rdf requires a pair style be defined "
                "or cutoff specified");
 
-  if (cutflag) {
+  if (binflag && comm->layout == Comm::LAYOUT_TILED)
+    error->all(FLERR,"Compute rdf binned requires a brick decomposition");
+
+  if (binflag) {
+    if (cutflag) delr = cutoff_user / nbin;
+    else delr = force->pair->cutforce / nbin;
+  } else if (cutflag) {
     double skin = neighbor->skin;
     mycutneigh = cutoff_user + skin;
 
@@ -195,6 +226,10 @@ void ComputeRDF::init()
   if (dynamic_user) dynamic = 1;
   init_norm();
 
+  // binned mode finds its own pairs, no neighbor list or ghost atoms needed
+
+  if (binflag) return;
+
   // need an occasional half neighbor list
   // if user specified, request a cutoff = cutoff_user + skin
   // skin is included b/c Neighbor uses this value similar
@@ -266,10 +301,7 @@ void ComputeRDF::init_norm()
 
 void ComputeRDF::compute_array()
 {
-  int i,j,m,ii,jj,inum,jnum,itype,jtype,ipair,jpair,ibin,ihisto;
-  double xtmp,ytmp,ztmp,delx,dely,delz,r;
-  int *ilist,*jlist,*numneigh,**firstneigh;
-  double factor_lj,factor_coul;
+  int i,j,m,ibin;
 
   if (natoms_old != atom->natoms) {
     dynamic = 1;
@@ -284,6 +316,81 @@ void ComputeRDF::compute_array()
 
   invoked_array = update->ntimestep;
 
+  // zero the histogram counts
+
+  for (i = 0; i < npairs; i++)
+    for (j = 0; j < nbin; j++)
+      hist[i][j] = 0;
+
+  if (binflag) tally_binned();
+  else tally_list();
+
+  // sum histograms across procs
+
+  MPI_Allreduce(hist[0],histall[0],npairs*nbin,MPI_DOUBLE,MPI_SUM,world);
+
+  // convert counts to g(r) and coord(r) and copy into output array
+  // vfrac = fraction of volume in shell m
+  // npairs = number of pairs, corrected for duplicates
+  // duplicates = pairs in which both atoms are the same
+
+  double constant,vfrac,gr,ncoord,rlower,rupper,normfac;
+
+  if (domain->dimension == 3) {
+    constant = 4.0*MY_PI / (3.0*domain->xprd*domain->yprd*domain->zprd);
+
+    for (m = 0; m < npairs; m++) {
+      normfac = (icount[m] > 0) ? static_cast<double>(jcount[m])
+                - static_cast<double>(duplicates[m])/icount[m] : 0.0;
+      ncoord = 0.0;
+      for (ibin = 0; ibin < nbin; ibin++) {
+        rlower = ibin*delr;
+        rupper = (ibin+1)*delr;
+        vfrac = constant * (rupper*rupper*rupper - rlower*rlower*rlower);
+        if (vfrac * normfac != 0.0)
+          gr = histall[m][ibin] / (vfrac * normfac * icount[m]);
+        else gr = 0.0;
+        if (icount[m] != 0)
+          ncoord += gr * vfrac * normfac;
+        array[ibin][1+2*m] = gr;
+        array[ibin][2+2*m] = ncoord;
+      }
+    }
+
+  } else {
+    constant = MY_PI / (domain->xprd*domain->yprd);
+
+    for (m = 0; m < npairs; m++) {
+      ncoord = 0.0;
+      normfac = (icount[m] > 0) ? static_cast<double>(jcount[m])
+                - static_cast<double>(duplicates[m])/icount[m] : 0.0;
+      for (ibin = 0; ibin < nbin; ibin++) {
+        rlower = ibin*delr;
+        rupper = (ibin+1)*delr;
+        vfrac = constant * (rupper*rupper - rlower*rlower);
+        if (vfrac * normfac != 0.0)
+          gr = histall[m][ibin] / (vfrac * normfac * icount[m]);
+        else gr = 0.0;
+        if (icount[m] != 0)
+          ncoord += gr * vfrac * normfac;
+        array[ibin][1+2*m] = gr;
+        array[ibin][2+2*m] = ncoord;
+      }
+    }
+  }
+}
+
+/* ----------------------------------------------------------------------
+   tally pairs of the occasional half neighbor list
+------------------------------------------------------------------------- */
+
+void ComputeRDF::tally_list()
+{
+  int i,j,m,ii,jj,inum,jnum,itype,jtype,ipair,jpair,ibin,ihisto;
+  double xtmp,ytmp,ztmp,delx,dely,delz,r;
+  int *ilist,*jlist,*numneigh,**firstneigh;
+  double factor_lj,factor_coul;
+
   // invoke half neighbor list (will copy or build if necessary)
 
   neighbor->build_one(list);
@@ -293,12 +400,6 @@ void ComputeRDF::compute_array()
   numneigh = list->numneigh;
   firstneigh = list->firstneigh;
 
-  // zero the histogram counts
-
-  for (i = 0; i < npairs; i++)
-    for (j = 0; j < nbin; j++)
-      hist[i][j] = 0;
-
   // tally the RDF
   // both atom i and j must be in fix group
   // itype,jtype must have been specified by user
@@ -308,6 +409,7 @@ void ComputeRDF::compute_array()
   double **x = atom->x;
   int *type = atom->type;
   int *mask = atom->mask;
+  tagint *molecule = atom->molecule;
   int nlocal = atom->nlocal;
 
   double *special_coul = force->special_coul;
@@ -337,6 +439,8 @@ void ComputeRDF::compute_array()
       if (factor_lj == 0.0 && factor_coul == 0.0) continue;
 
       if (!(mask[j] & groupbit)) continue;
+      if (molflag == INTER && molecule[i] == molecule[j]) continue;
+      if (molflag == INTRA && molecule[i] != molecule[j]) continue;
       jtype = type[j];
       ipair = nrdfpair[itype][jtype];
       jpair = nrdfpair[jtype][itype];
@@ -361,58 +465,261 @@ void ComputeRDF::compute_array()
       }
     }
   }
+}
 
-  // sum histograms across procs
+/* ----------------------------------------------------------------------
+   tally pairs without neighbor list or ghost atoms
+   each owned J atom and its periodic images are sent to all procs
+     whose sub-domain extended by the cutoff contains them,
+     only on the steps this compute is invoked
+   received atoms are binned into cells of at least the cutoff size
+   each pair is tallied once by the owner of I and once by the owner of J
+------------------------------------------------------------------------- */
 
-  MPI_Allreduce(hist[0],histall[0],npairs*nbin,MPI_DOUBLE,MPI_SUM,world);
+void ComputeRDF::tally_binned()
+{
+  int i,j,k,m,n,ihisto,ibin,itype,jtype;
+  double delx,dely,delz,rsq;
 
-  // convert counts to g(r) and coord(r) and copy into output array
-  // vfrac = fraction of volume in shell m
-  // npairs = number of pairs, corrected for duplicates
-  // duplicates = pairs in which both atoms are the same
+  double **x = atom->x;
+  int *type = atom->type;
+  int *mask = atom->mask;
+  tagint *tag = atom->tag;
+  tagint *molecule = atom->molecule;
+  int nlocal = atom->nlocal;
+  int ntypes = atom->ntypes;
+  int triclinic = domain->triclinic;
+  int dimension = domain->dimension;
+  int *periodicity = domain->periodicity;
+  double *h = domain->h;
 
-  double constant,vfrac,gr,ncoord,rlower,rupper,normfac;
+  // types that occur as I or J of a histogram
 
-  if (domain->dimension == 3) {
-    constant = 4.0*MY_PI / (3.0*domain->xprd*domain->yprd*domain->zprd);
+  int *iflag = new int[ntypes+1];
+  int *jflag = new int[ntypes+1];
+  for (i = 1; i <= ntypes; i++) iflag[i] = jflag[i] = 0;
+  for (i = 1; i <= ntypes; i++)
+    for (j = 1; j <= ntypes; j++)
+      if (nrdfpair[i][j]) iflag[i] = jflag[j] = 1;
+
+  // cutoff in fractional coords in each dim, as for ghost atoms in Comm
+  // extended by skin, since between reneighborings owned atoms can be
+  //   outside their sub-domain and the box by up to half the skin
+
+  double cut = nbin*delr;
+  double cutcomm = cut + neighbor->skin;
+  double cutlamda[3];
+  if (triclinic == 0) {
+    cutlamda[0] = cutcomm/domain->xprd;
+    cutlamda[1] = cutcomm/domain->yprd;
+    cutlamda[2] = cutcomm/domain->zprd;
+  } else {
+    double *h_inv = domain->h_inv;
+    cutlamda[0] = cutcomm*sqrt(h_inv[0]*h_inv[0] + h_inv[5]*h_inv[5] +
+                               h_inv[4]*h_inv[4]);
+    cutlamda[1] = cutcomm*sqrt(h_inv[1]*h_inv[1] + h_inv[3]*h_inv[3]);
+    cutlamda[2] = cutcomm*h_inv[2];
+  }
+  if (dimension == 2) cutlamda[2] = 0.0;
+
+  double *split[3];
+  split[0] = comm->xsplit;
+  split[1] = comm->ysplit;
+  split[2] = comm->zsplit;
+  int *procgrid = comm->procgrid;
+
+  // images and destination procs of each J atom
+  // the 1st and last proc in a non-periodic dim also get atoms outside box
+
+  int nsend = 0;
+  int maxsend = nlocal;
+  int *proclist = (int *) memory->smalloc(maxsend*sizeof(int),"rdf:proclist");
+  GhostAtom *sendbuf = (GhostAtom *)
+    memory->smalloc(maxsend*sizeof(GhostAtom),"rdf:sendbuf");
+
+  double lamda[3],s;
+  int shiftlo[3],shifthi[3],nimage[3];
+  int shift[3][MAXIMAGE],plo[3][MAXIMAGE],phi[3][MAXIMAGE];
+  int ix,iy,iz,jx,jy,jz;
+
+  for (i = 0; i < nlocal; i++) {
+    if (!(mask[i] & groupbit) || !jflag[type[i]]) continue;
+
+    if (triclinic) domain->x2lamda(x[i],lamda);
+    else {
+      lamda[0] = (x[i][0] - domain->boxlo[0])/domain->xprd;
+      lamda[1] = (x[i][1] - domain->boxlo[1])/domain->yprd;
+      lamda[2] = (x[i][2] - domain->boxlo[2])/domain->zprd;
+    }
 
-    for (m = 0; m < npairs; m++) {
-      normfac = (icount[m] > 0) ? static_cast<double>(jcount[m])
-                - static_cast<double>(duplicates[m])/icount[m] : 0.0;
-      ncoord = 0.0;
-      for (ibin = 0; ibin < nbin; ibin++) {
-        rlower = ibin*delr;
-        rupper = (ibin+1)*delr;
-        vfrac = constant * (rupper*rupper*rupper - rlower*rlower*rlower);
-        if (vfrac * normfac != 0.0)
-          gr = histall[m][ibin] / (vfrac * normfac * icount[m]);
-        else gr = 0.0;
-        if (icount[m] != 0)
-          ncoord += gr * vfrac * normfac;
-        array[ibin][1+2*m] = gr;
-        array[ibin][2+2*m] = ncoord;
+    // image shifts and range of procs in each dim for each shift
+
+    for (k = 0; k < 3; k++) {
+      if (k == 2 && dimension == 2) {
+        shiftlo[k] = shifthi[k] = 0;
+      } else if (periodicity[k]) {
+        shiftlo[k] = static_cast<int>(floor(-cutlamda[k] - lamda[k]));
+        shifthi[k] = static_cast<int>(floor(1.0 + cutlamda[k] - lamda[k]));
+      } else shiftlo[k] = shifthi[k] = 0;
+      if (shifthi[k] - shiftlo[k] >= MAXIMAGE)
+        error->one(FLERR,"Compute rdf binned cutoff is too large for box");
+
+      nimage[k] = 0;
+      for (n = shiftlo[k]; n <= shifthi[k]; n++) {
+        s = lamda[k] + n;
+        if (periodicity[k] && (s < -cutlamda[k] || s >= 1.0 + cutlamda[k]))
+          continue;
+        int lo = -1, hi = -1;
+        for (m = 0; m < procgrid[k]; m++) {
+          double sublo = split[k][m] - cutlamda[k];
+          double subhi = split[k][m+1] + cutlamda[k];
+          if (!periodicity[k] && m == 0) sublo = -BIG;
+          if (!periodicity[k] && m == procgrid[k]-1) subhi = BIG;
+          if (k == 2 && dimension == 2) {
+            sublo = -BIG;
+            subhi = BIG;
+          }
+          if (s >= sublo && s < subhi) {
+            if (lo < 0) lo = m;
+            hi = m;
+          }
+        }
+        if (lo < 0) continue;
+        shift[k][nimage[k]] = n;
+        plo[k][nimage[k]] = lo;
+        phi[k][nimage[k]] = hi;
+        nimage[k]++;
       }
     }
 
-  } else {
-    constant = MY_PI / (domain->xprd*domain->yprd);
+    for (ix = 0; ix < nimage[0]; ix++)
+      for (iy = 0; iy < nimage[1]; iy++)
+        for (iz = 0; iz < nimage[2]; iz++) {
+          GhostAtom one;
+          one.x[0] = x[i][0] + shift[0][ix]*h[0] + shift[1][iy]*h[5] +
+            shift[2][iz]*h[4];
+          one.x[1] = x[i][1] + shift[1][iy]*h[1] + shift[2][iz]*h[3];
+          one.x[2] = x[i][2] + shift[2][iz]*h[2];
+          one.tag = tag[i];
+          one.mol = molecule ? molecule[i] : 0;
+          one.type = type[i];
+
+          for (jx = plo[0][ix]; jx <= phi[0][ix]; jx++)
+            for (jy = plo[1][iy]; jy <= phi[1][iy]; jy++)
+              for (jz = plo[2][iz]; jz <= phi[2][iz]; jz++) {
+                if (nsend == maxsend) {
+                  maxsend = 2*maxsend + 1;
+                  proclist = (int *)
+                    memory->srealloc(proclist,maxsend*sizeof(int),"rdf:proclist");
+                  sendbuf = (GhostAtom *)
+                    memory->srealloc(sendbuf,maxsend*sizeof(GhostAtom),
+                                     "rdf:sendbuf");
+                }
+                proclist[nsend] = comm->grid2proc[jx][jy][jz];
+                sendbuf[nsend++] = one;
+              }
+        }
+  }
 
-    for (m = 0; m < npairs; m++) {
-      ncoord = 0.0;
-      normfac = (icount[m] > 0) ? static_cast<double>(jcount[m])
-                - static_cast<double>(duplicates[m])/icount[m] : 0.0;
-      for (ibin = 0; ibin < nbin; ibin++) {
-        rlower = ibin*delr;
-        rupper = (ibin+1)*delr;
-        vfrac = constant * (rupper*rupper - rlower*rlower);
-        if (vfrac * normfac != 0.0)
-          gr = histall[m][ibin] / (vfrac * normfac * icount[m]);
-        else gr = 0.0;
-        if (icount[m] != 0)
-          ncoord += gr * vfrac * normfac;
-        array[ibin][1+2*m] = gr;
-        array[ibin][2+2*m] = ncoord;
-      }
+  Irregular *irregular = new Irregular(lmp);
+  int nrecv = irregular->create_data(nsend,proclist);
+  GhostAtom *recvbuf = (GhostAtom *)
+    memory->smalloc(MAX(nrecv,1)*sizeof(GhostAtom),"rdf:recvbuf");
+  irregular->exchange_data((char *) sendbuf,sizeof(GhostAtom),(char *) recvbuf);
+  irregular->destroy_data();
+  delete irregular;
+  memory->sfree(proclist);
+  memory->sfree(sendbuf);
+
+  // bin received atoms into cells of at least the cutoff size
+  //   over their bounding box, with not many more cells than atoms
+
+  double lo[3],hi[3],cellinv[3];
+  int nc[3];
+  lo[0] = lo[1] = lo[2] = BIG;
+  hi[0] = hi[1] = hi[2] = -BIG;
+  for (j = 0; j < nrecv; j++)
+    for (k = 0; k < 3; k++) {
+      lo[k] = MIN(lo[k],recvbuf[j].x[k]);
+      hi[k] = MAX(hi[k],recvbuf[j].x[k]);
+    }
+
+  for (k = 0; k < 3; k++) {
+    nc[k] = 1;
+    if (nrecv && hi[k] > lo[k])
+      nc[k] = MAX(1,static_cast<int>(MIN((hi[k]-lo[k])/cut,1000.0)));
+  }
+  bigint ncell = (bigint) nc[0]*nc[1]*nc[2];
+  while (ncell > 8*(bigint)nrecv + 1) {
+    k = 0;
+    if (nc[1] > nc[k]) k = 1;
+    if (nc[2] > nc[k]) k = 2;
+    nc[k] = (nc[k]+1)/2;
+    ncell = (bigint) nc[0]*nc[1]*nc[2];
+  }
+  for (k = 0; k < 3; k++)
+    cellinv[k] = (nrecv && hi[k] > lo[k]) ? nc[k]/(hi[k]-lo[k]) : 0.0;
+
+  int *head = new int[ncell];
+  int *next = new int[MAX(nrecv,1)];
+  for (n = 0; n < ncell; n++) head[n] = -1;
+
+  int c[3];
+  for (j = 0; j < nrecv; j++) {
+    for (k = 0; k < 3; k++) {
+      c[k] = static_cast<int>((recvbuf[j].x[k]-lo[k])*cellinv[k]);
+      c[k] = MAX(0,MIN(c[k],nc[k]-1));
+    }
+    n = (c[2]*nc[1] + c[1])*nc[0] + c[0];
+    next[j] = head[n];
+    head[n] = j;
+  }
+
+  // tally pairs of each owned I atom with received atoms in adjacent cells
+  // exclude I itself, which has the same tag at distance 0
+
+  double cutsq = cut*cut;
+  int ipair;
+
+  for (i = 0; i < nlocal; i++) {
+    if (!(mask[i] & groupbit) || !iflag[type[i]]) continue;
+    itype = type[i];
+
+    for (k = 0; k < 3; k++) {
+      c[k] = static_cast<int>((x[i][k]-lo[k])*cellinv[k]);
+      c[k] = MAX(0,MIN(c[k],nc[k]-1));
     }
+
+    for (iz = MAX(0,c[2]-1); iz <= MIN(nc[2]-1,c[2]+1); iz++)
+      for (iy = MAX(0,c[1]-1); iy <= MIN(nc[1]-1,c[1]+1); iy++)
+        for (ix = MAX(0,c[0]-1); ix <= MIN(nc[0]-1,c[0]+1); ix++)
+          for (j = head[(iz*nc[1] + iy)*nc[0] + ix]; j >= 0; j = next[j]) {
+            GhostAtom &other = recvbuf[j];
+            jtype = other.type;
+            ipair = nrdfpair[itype][jtype];
+            if (!ipair) continue;
+            if (molflag == INTER && molecule[i] == other.mol) continue;
+            if (molflag == INTRA && molecule[i] != other.mol) continue;
+
+            delx = x[i][0] - other.x[0];
+            dely = x[i][1] - other.x[1];
+            delz = x[i][2] - other.x[2];
+            rsq = delx*delx + dely*dely + delz*delz;
+            if (rsq >= cutsq) continue;
+            if (rsq == 0.0 && other.tag == tag[i]) continue;
+            ibin = static_cast<int> (sqrt(rsq)*delrinv);
+            if (ibin >= nbin) continue;
+
+            for (ihisto = 0; ihisto < ipair; ihisto++) {
+              m = rdfpair[ihisto][itype][jtype];
+              hist[m][ibin] += 1.0;
+            }
+          }
   }
+
+  delete [] head;
+  delete [] next;
+  memory->sfree(recvbuf);
+  delete [] iflag;
+  delete [] jflag;
 }
@@ -35,6 +35,8 @@ class ComputeRDF : public Compute {
  private:
   int nbin;              // # of rdf bins
   int cutflag;           // user cutoff flag
+  int binflag;           // 1 if pairs are found by own binning, not a list
+  int molflag;           // ALL, INTER, or INTRA molecular pairs
   int npairs;            // # of rdf pairs
   double delr,delrinv;   // bin width and its inverse
   double cutoff_user;    // user-specified cutoff
@@ -51,6 +53,15 @@ class ComputeRDF : public Compute {
 
   class NeighList *list; // half neighbor list
   void init_norm();
+  void tally_list();
+  void tally_binned();
+
+  struct GhostAtom {     // copy of an atom or its image sent by binned mode
+    double x[3];
+    tagint tag,mol;
+    int type;
+  };
+
   bigint natoms_old;
 };
 
@@ -79,6 +90,19 @@ W: Compute rdf cutoff less than neighbor cutoff - forcing a needless neighbor li
 
 UNDOCUMENTED
 
+E: Compute rdf molecule requires atoms have molecule IDs
+
+Only atom styles with molecule IDs can select intra- or
+inter-molecular pairs.
+
+E: Compute rdf binned cutoff is too large for box
+
+The cutoff spans too many periodic images of the simulation box.
+
+E: Compute rdf binned requires a brick decomposition
+
+The binned mode of compute rdf cannot be used with "comm_style tiled".
+
 U: Compute rdf requires a pair style be defined
 
 Self-explanatory.
@@ -20,6 +20,7 @@
 #include "error.h"
 #include "fix.h"
 #include "input.h"
+#include "irregular.h"
 #include "memory.h"
 #include "modify.h"
 #include "update.h"
@@ -30,6 +31,7 @@
 using namespace LAMMPS_NS;
 
 enum{SUM,MINN,MAXX};
+enum{DENSE,SPARSE,SPATIAL};
 
 
 #define BIG 1.0e20
@@ -39,7 +41,10 @@ enum{SUM,MINN,MAXX};
 ComputeReduceChunk::ComputeReduceChunk(LAMMPS *lmp, int narg, char **arg) :
   Compute(lmp, narg, arg),
   which(nullptr), argindex(nullptr), value2index(nullptr), idchunk(nullptr), ids(nullptr),
-  vlocal(nullptr), vglobal(nullptr), alocal(nullptr), aglobal(nullptr), varatom(nullptr)
+  vlocal(nullptr), vglobal(nullptr), alocal(nullptr), aglobal(nullptr), varatom(nullptr),
+  chunkflag(nullptr), chunklist(nullptr), proclist(nullptr), sendbuf(nullptr),
+  recvbuf(nullptr), chunkproc(nullptr), chunkorder(nullptr), gatherbuf(nullptr),
+  recvcounts(nullptr), displs(nullptr)
 {
   if (narg < 6) error->all(FLERR,"Illegal compute reduce/chunk command");
 
@@ -83,6 +88,8 @@ ComputeReduceChunk::ComputeReduceChunk(LAMMPS *lmp, int narg, char **arg) :
   for (iarg = 0; iarg < nargnew; iarg++) {
     ArgInfo argi(arg[iarg]);
 
+    if (argi.get_type() == ArgInfo::NONE) break;
+
     which[nvalues] = argi.get_type();
     argindex[nvalues] = argi.get_index1();
     ids[nvalues] = argi.copy_name();
@@ -94,6 +101,24 @@ ComputeReduceChunk::ComputeReduceChunk(LAMMPS *lmp, int narg, char **arg) :
     nvalues++;
   }
 
+  if (nvalues == 0) error->all(FLERR,"Illegal compute reduce/chunk command");
+
+  // optional args
+
+  sparseflag = DENSE;
+
+  while (iarg < nargnew) {
+    if (strcmp(arg[iarg],"sparse") == 0) {
+      if (iarg+2 > nargnew)
+        error->all(FLERR,"Illegal compute reduce/chunk command");
+      if (strcmp(arg[iarg+1],"yes") == 0) sparseflag = SPARSE;
+      else if (strcmp(arg[iarg+1],"spatial") == 0) sparseflag = SPATIAL;
+      else if (strcmp(arg[iarg+1],"no") == 0) sparseflag = DENSE;
+      else error->all(FLERR,"Illegal compute reduce/chunk command");
+      iarg += 2;
+    } else error->all(FLERR,"Illegal compute reduce/chunk command");
+  }
+
   // if wildcard expansion occurred, free earg memory from expand_args()
 
   if (expand) {
@@ -176,6 +201,14 @@ ComputeReduceChunk::ComputeReduceChunk(LAMMPS *lmp, int narg, char **arg) :
 
   maxatom = 0;
   varatom = nullptr;
+
+  MPI_Comm_rank(world,&me);
+  MPI_Comm_size(world,&nprocs);
+  maxsend = maxrecv = 0;
+  if (sparseflag) {
+    recvcounts = new int[nprocs];
+    displs = new int[nprocs];
+  }
 }
 
 /* ---------------------------------------------------------------------- */
@@ -196,6 +229,17 @@ ComputeReduceChunk::~ComputeReduceChunk()
   memory->destroy(aglobal);
 
   memory->destroy(varatom);
+
+  memory->destroy(chunkflag);
+  memory->destroy(chunklist);
+  memory->destroy(proclist);
+  memory->destroy(sendbuf);
+  memory->destroy(recvbuf);
+  memory->destroy(chunkproc);
+  memory->destroy(chunkorder);
+  memory->destroy(gatherbuf);
+  delete [] recvcounts;
+  delete [] displs;
 }
 
 /* ---------------------------------------------------------------------- */
@@ -265,6 +309,7 @@ void ComputeReduceChunk::compute_vector()
     memory->create(vlocal,maxchunk,"reduce/chunk:vlocal");
     memory->create(vglobal,maxchunk,"reduce/chunk:vglobal");
     vector = vglobal;
+    if (sparseflag) allocate_sparse();
   }
 
   // perform local reduction of single peratom value
@@ -273,7 +318,8 @@ void ComputeReduceChunk::compute_vector()
 
   // reduce the per-chunk values across all procs
 
-  if (mode == SUM)
+  if (sparseflag) reduce_sparse(vlocal,vglobal,1);
+  else if (mode == SUM)
     MPI_Allreduce(vlocal,vglobal,nchunk,MPI_DOUBLE,MPI_SUM,world);
   else if (mode == MINN)
     MPI_Allreduce(vlocal,vglobal,nchunk,MPI_DOUBLE,MPI_MIN,world);
@@ -305,6 +351,7 @@ void ComputeReduceChunk::compute_array()
     memory->create(alocal,maxchunk,nvalues,"reduce/chunk:alocal");
     memory->create(aglobal,maxchunk,nvalues,"reduce/chunk:aglobal");
     array = aglobal;
+    if (sparseflag) allocate_sparse();
   }
 
   // perform local reduction of all peratom values
@@ -313,7 +360,8 @@ void ComputeReduceChunk::compute_array()
 
   // reduce the per-chunk values across all procs
 
-  if (mode == SUM)
+  if (sparseflag) reduce_sparse(&alocal[0][0],&aglobal[0][0],nvalues);
+  else if (mode == SUM)
     MPI_Allreduce(&alocal[0][0],&aglobal[0][0],nchunk*nvalues,
                   MPI_DOUBLE,MPI_SUM,world);
   else if (mode == MINN)
@@ -330,7 +378,7 @@ void ComputeReduceChunk::compute_one(int m, double *vchunk, int nstride)
 {
   // initialize per-chunk values in accumulation vector
 
-  for (int i = 0; i < nchunk; i += nstride) vchunk[i] = initvalue;
+  for (int i = 0; i < nchunk; i++) vchunk[i*nstride] = initvalue;
 
   // loop over my atoms
   // use peratom input and chunk ID of each atom to update vector
@@ -422,6 +470,152 @@ void ComputeReduceChunk::compute_one(int m, double *vchunk, int nstride)
   }
 }
 
+/* ----------------------------------------------------------------------
+   reallocate per-chunk arrays for sparse reduction
+------------------------------------------------------------------------- */
+
+void ComputeReduceChunk::allocate_sparse()
+{
+  memory->destroy(chunkflag);
+  memory->destroy(chunklist);
+  memory->create(chunkflag,maxchunk,"reduce/chunk:chunkflag");
+  memory->create(chunklist,maxchunk,"reduce/chunk:chunklist");
+  for (int m = 0; m < maxchunk; m++) chunkflag[m] = 0;
+
+  if (sparseflag == SPATIAL) {
+    memory->destroy(chunkproc);
+    memory->destroy(chunkorder);
+    memory->destroy(gatherbuf);
+    memory->create(chunkproc,maxchunk,"reduce/chunk:chunkproc");
+    memory->create(chunkorder,maxchunk,"reduce/chunk:chunkorder");
+    memory->create(gatherbuf,maxchunk*nvalues,"reduce/chunk:gatherbuf");
+  }
+}
+
+/* ----------------------------------------------------------------------
+   reduce per-chunk values with NCOL columns from local to global
+   only chunks with my atoms in them are sent to the proc that owns them
+   each proc owns a contiguous range of chunks, or for sparse = spatial
+     the bins whose center is in its sub-domain, which are then
+     gathered to all procs
+------------------------------------------------------------------------- */
+
+void ComputeReduceChunk::reduce_sparse(double *local, double *global, int ncol)
+{
+  int i,j,m,index;
+  double *buf;
+
+  // list chunks with my atoms in them
+
+  int *mask = atom->mask;
+  int nlocal = atom->nlocal;
+  int n = 0;
+
+  for (i = 0; i < nlocal; i++) {
+    if (!(mask[i] & groupbit)) continue;
+    index = ichunk[i]-1;
+    if (index < 0 || chunkflag[index]) continue;
+    chunkflag[index] = 1;
+    chunklist[n++] = index;
+  }
+
+  // send local values of each listed chunk to its owner
+
+  int nper = ncol + 1;
+  if (n > maxsend) {
+    maxsend = n;
+    memory->destroy(proclist);
+    memory->destroy(sendbuf);
+    memory->create(proclist,maxsend,"reduce/chunk:proclist");
+    memory->create(sendbuf,maxsend*nper,"reduce/chunk:sendbuf");
+  }
+
+  if (sparseflag == SPATIAL && !cchunk->chunk_owners(chunkproc))
+    error->all(FLERR,"Compute reduce/chunk sparse spatial requires "
+               "compute chunk/atom with uncompressed bin/1d, bin/2d, or bin/3d");
+
+  for (i = 0; i < n; i++) {
+    m = chunklist[i];
+    chunkflag[m] = 0;
+    if (sparseflag == SPATIAL) proclist[i] = chunkproc[m];
+    else proclist[i] = static_cast<int> (((bigint) (m+1)*nprocs - 1) / nchunk);
+    buf = &sendbuf[i*nper];
+    buf[0] = m;
+    for (j = 0; j < ncol; j++) buf[j+1] = local[m*ncol+j];
+  }
+
+  Irregular *irregular = new Irregular(lmp);
+  int nrecv = irregular->create_data(n,proclist,1);
+  if (nrecv > maxrecv) {
+    maxrecv = nrecv;
+    memory->destroy(recvbuf);
+    memory->create(recvbuf,maxrecv*nper,"reduce/chunk:recvbuf");
+  }
+  irregular->exchange_data((char *) sendbuf,nper*sizeof(double),
+                           (char *) recvbuf);
+  irregular->destroy_data();
+  delete irregular;
+
+  // combine received values into owned chunks
+
+  int p;
+
+  if (sparseflag == SPATIAL) {
+    for (m = 0; m < nchunk; m++)
+      if (chunkproc[m] == me)
+        for (j = 0; j < ncol; j++) global[m*ncol+j] = initvalue;
+  } else {
+    int clo = static_cast<int> ((bigint) me*nchunk/nprocs);
+    int chi = static_cast<int> ((bigint) (me+1)*nchunk/nprocs);
+    for (i = clo*ncol; i < chi*ncol; i++) global[i] = initvalue;
+  }
+
+  for (i = 0; i < nrecv; i++) {
+    buf = &recvbuf[i*nper];
+    m = static_cast<int> (buf[0]);
+    for (j = 0; j < ncol; j++) combine(global[m*ncol+j],buf[j+1]);
+  }
+
+  // gather owned chunks to all procs
+  // spatially owned chunks are packed in order of their owning proc
+
+  if (sparseflag == SPATIAL) {
+    for (p = 0; p < nprocs; p++) recvcounts[p] = 0;
+    for (m = 0; m < nchunk; m++) recvcounts[chunkproc[m]]++;
+    displs[0] = 0;
+    for (p = 1; p < nprocs; p++) displs[p] = displs[p-1] + recvcounts[p-1];
+    for (m = 0; m < nchunk; m++) chunkorder[displs[chunkproc[m]]++] = m;
+    for (p = 0; p < nprocs; p++) displs[p] -= recvcounts[p];
+
+    int klo = displs[me];
+    int khi = klo + recvcounts[me];
+    for (int k = klo; k < khi; k++)
+      for (j = 0; j < ncol; j++)
+        gatherbuf[k*ncol+j] = global[chunkorder[k]*ncol+j];
+
+    for (p = 0; p < nprocs; p++) {
+      displs[p] *= ncol;
+      recvcounts[p] *= ncol;
+    }
+    MPI_Allgatherv(MPI_IN_PLACE,0,MPI_DOUBLE,gatherbuf,recvcounts,displs,
+                   MPI_DOUBLE,world);
+
+    for (int k = 0; k < nchunk; k++)
+      for (j = 0; j < ncol; j++)
+        global[chunkorder[k]*ncol+j] = gatherbuf[k*ncol+j];
+    return;
+  }
+
+  for (p = 0; p < nprocs; p++) {
+    displs[p] = static_cast<int> ((bigint) p*nchunk/nprocs);
+    recvcounts[p] = static_cast<int> ((bigint) (p+1)*nchunk/nprocs) - displs[p];
+    displs[p] *= ncol;
+    recvcounts[p] *= ncol;
+  }
+  MPI_Allgatherv(MPI_IN_PLACE,0,MPI_DOUBLE,global,recvcounts,displs,
+                 MPI_DOUBLE,world);
+}
+
 /* ----------------------------------------------------------------------
    combine two values according to reduction mode
 ------------------------------------------------------------------------- */
@@ -501,5 +695,14 @@ double ComputeReduceChunk::memory_usage()
   double bytes = (bigint) maxatom * sizeof(double);
   if (nvalues == 1) bytes += (double) maxchunk * 2 * sizeof(double);
   else bytes += (double) maxchunk * nvalues * 2 * sizeof(double);
+  if (sparseflag) {
+    bytes += (double) maxchunk * 2 * sizeof(int);
+    bytes += (double) maxsend * sizeof(int);
+    bytes += (double) (maxsend+maxrecv) * (nvalues+1) * sizeof(double);
+  }
+  if (sparseflag == SPATIAL) {
+    bytes += (double) maxchunk * 2 * sizeof(int);
+    bytes += (double) maxchunk * nvalues * sizeof(double);
+  }
   return bytes;
 }
@@ -56,8 +56,26 @@ class ComputeReduceChunk : public Compute {
   class ComputeChunkAtom *cchunk;
   int *ichunk;
 
+  // sparse reduction: each proc owns a contiguous range of chunks
+  //   or the spatial bins in its sub-domain
+  // and receives data only for chunks with atoms in them
+
+  int sparseflag;
+  int me,nprocs;
+  int *chunkflag;           // 1 if chunk is in chunklist
+  int *chunklist;           // list of chunks with my atoms in them
+  int *proclist;            // owning proc of each chunk in chunklist
+  int maxsend,maxrecv;
+  double *sendbuf,*recvbuf;
+  int *chunkproc;           // owning proc of each chunk for sparse spatial
+  int *chunkorder;          // all chunks ordered by owning proc
+  double *gatherbuf;        // packed owned chunks for sparse spatial
+  int *recvcounts,*displs;  // for gathering owned chunks to all procs
+
   void init_chunk();
+  void allocate_sparse();
   void compute_one(int, double *, int);
+  void reduce_sparse(double *, double *, int);
   void combine(double &, double);
 };
 
@@ -74,4 +92,9 @@ Self-explanatory.  Check the input script syntax and compare to the
 documentation for the command.  You can use -echo screen as a
 command-line option when running LAMMPS to see the offending line.
 
+E: Compute reduce/chunk sparse spatial requires compute chunk/atom with uncompressed bin/1d, bin/2d, or bin/3d
+
+Chunks can only be assigned to the processors by their location, if
+they are spatial bins in x, y, or z that are not compressed.
+
 */
@@ -26,6 +26,9 @@
 #include "error.h"
 
 #include <cstring>
+#include <system_error>
+#include <thread>
+#include <vector>
 
 using namespace LAMMPS_NS;
 
@@ -39,6 +42,26 @@ Dump *Dump::dumpptr;
 
 enum{ASCEND,DESCEND};
 
+namespace LAMMPS_NS {
+
+// copy of one gathered snapshot and the thread writing it to the file
+
+struct DumpAsync {
+  std::thread thread;
+  char *buf;                    // per-proc chunks back to back
+  bigint maxbuf;                // allocated size of buf in bytes
+  bigint nbytes;                // bytes in use
+  std::vector<int> nlines;      // 1st arg of write_data() for each chunk
+  std::vector<bigint> offset;   // offset of each chunk in buf
+  int errorflag;                // 1 if writing failed
+  DeferredError error;          // error of writing, raised by sync()
+  std::vector<DeferredError> warnings;
+
+  DumpAsync() : buf(nullptr), maxbuf(0), nbytes(0), errorflag(0) {}
+};
+
+}
+
 /* ---------------------------------------------------------------------- */
 
 Dump::Dump(LAMMPS *lmp, int /*narg*/, char **arg) : Pointers(lmp)
@@ -83,6 +106,9 @@ Dump::Dump(LAMMPS *lmp, int /*narg*/, char **arg) : Pointers(lmp)
   append_flag = 0;
   buffer_allow = 0;
   buffer_flag = 0;
+  async_allow = 0;
+  async_flag = 0;
+  async = nullptr;
   padflag = 0;
   pbcflag = 0;
   time_flag = 0;
@@ -160,6 +186,12 @@ Dump::Dump(LAMMPS *lmp, int /*narg*/, char **arg) : Pointers(lmp)
 
 Dump::~Dump()
 {
+  sync(0);
+  if (async) {
+    memory->sfree(async->buf);
+    delete async;
+  }
+
   delete [] id;
   delete [] style;
   delete [] filename;
@@ -218,6 +250,7 @@ Dump::~Dump()
 
 void Dump::init()
 {
+  sync();
   init_style();
 
   if (!sort_flag) {
@@ -340,6 +373,10 @@ void Dump::write()
 
   if (delay_flag && update->ntimestep < delaystep) return;
 
+  // previous snapshot must be completely written before the file is reused
+
+  sync();
+
   // if file per timestep, open new file
 
   if (multifile) openfile();
@@ -444,8 +481,9 @@ void Dump::write()
   // if buffering, convert doubles into strings
   // insure sbuf is sized for communicating
   // cannot buffer if output is to binary file
+  // if async, the I/O thread converts the gathered doubles instead
 
-  if (buffer_flag && !binary) {
+  if (buffer_flag && !binary && !async_flag) {
     nsme = convert_string(nme,buf);
     int nsmin,nsmax;
     MPI_Allreduce(&nsme,&nsmin,1,MPI_INT,MPI_MIN,world);
@@ -469,20 +507,45 @@ void Dump::write()
 
   // comm and output buf of doubles
 
-  if (buffer_flag == 0 || binary) {
+  // if async, receive each proc's data into the snapshot copy
+  //   and hand the complete snapshot to the I/O thread
+
+  if (buffer_flag == 0 || binary || async_flag) {
     if (filewriter) {
       for (int iproc = 0; iproc < nclusterprocs; iproc++) {
+        double *rbuf = buf;
+        if (async_flag)
+          rbuf = (double *)
+            async_reserve((bigint) maxbuf*size_one*sizeof(double));
         if (iproc) {
-          MPI_Irecv(buf,maxbuf*size_one,MPI_DOUBLE,me+iproc,0,world,&request);
+          MPI_Irecv(rbuf,maxbuf*size_one,MPI_DOUBLE,me+iproc,0,world,&request);
           MPI_Send(&tmp,0,MPI_INT,me+iproc,0,world);
           MPI_Wait(&request,&status);
           MPI_Get_count(&status,MPI_DOUBLE,&nlines);
           nlines /= size_one;
-        } else nlines = nme;
+        } else {
+          nlines = nme;
+          if (async_flag && nme) memcpy(rbuf,buf,nme*size_one*sizeof(double));
+        }
 
-        write_data(nlines,buf);
+        if (async_flag)
+          async_commit(nlines,(bigint) nlines*size_one*sizeof(double));
+        else write_data(nlines,rbuf);
       }
-      if (flush_flag && fp) fflush(fp);
+      if (async_flag) {
+        try {
+          async->thread = std::thread(&Dump::write_snapshot,this);
+        } catch (std::system_error &) {
+
+          // without thread support the snapshot is written right away
+
+          error->warning(FLERR,"Cannot start thread for asynchronous dump "
+                         "output, writing synchronously");
+          async_flag = 0;
+          write_snapshot();
+          sync();
+        }
+      } else close_snapshot();
 
     } else {
       MPI_Recv(&tmp,0,MPI_INT,fileproc,0,world,MPI_STATUS_IGNORE);
@@ -503,7 +566,7 @@ void Dump::write()
 
         write_data(nchars,(double *) sbuf);
       }
-      if (flush_flag && fp) fflush(fp);
+      close_snapshot();
 
     } else {
       MPI_Recv(&tmp,0,MPI_INT,fileproc,0,world,MPI_STATUS_IGNORE);
@@ -524,16 +587,123 @@ void Dump::write()
 
   if (refreshflag) modify->compute[irefresh]->refresh();
 
-  // if file per timestep, close file if I am filewriter
+  // a dump not owned by Output, e.g. from write_dump, is deleted
+  // right after this snapshot, so it cannot be left in flight
+
+  if (async_flag) {
+    int idump;
+    for (idump = 0; idump < output->ndump; idump++)
+      if (output->dump[idump] == this) break;
+    if (idump == output->ndump) sync();
+  }
+}
+
+/* ----------------------------------------------------------------------
+   called by filewriter after all data of a snapshot is written
+   flush file, or close it if file per timestep
+   derived classes that do not write via fp override this function
+------------------------------------------------------------------------- */
 
+void Dump::close_snapshot()
+{
   if (multifile) {
     if (compressed) {
-      if (filewriter && fp != nullptr) pclose(fp);
+      if (fp != nullptr) pclose(fp);
     } else {
-      if (filewriter && fp != nullptr) fclose(fp);
+      if (fp != nullptr) fclose(fp);
     }
     fp = nullptr;
+  } else if (flush_flag && fp) fflush(fp);
+}
+
+/* ----------------------------------------------------------------------
+   wait until the I/O thread has written the previous snapshot
+   must be called before anything else uses the file or the dump settings
+   flag = 1 to raise errors and warnings of the I/O thread,
+     0 from destructors, which only report errors as a warning
+------------------------------------------------------------------------- */
+
+void Dump::sync(int flag)
+{
+  if (!async) return;
+  if (async->thread.joinable()) async->thread.join();
+
+  for (auto &w : async->warnings) error->warning(w.file,w.line,w.message);
+  async->warnings.clear();
+
+  if (async->errorflag) {
+    async->errorflag = 0;
+    DeferredError &e = async->error;
+    if (flag) error->one(e.file,e.line,e.message);
+    error->warning(e.file,e.line,e.message);
+  }
+}
+
+/* ----------------------------------------------------------------------
+   return pointer to room for nbytes at the end of the snapshot copy
+   first chunk of a snapshot starts a new copy
+------------------------------------------------------------------------- */
+
+char *Dump::async_reserve(bigint nbytes)
+{
+  if (async == nullptr) async = new DumpAsync;
+  if (async->nlines.empty()) async->nbytes = 0;
+
+  if (async->nbytes + nbytes > async->maxbuf) {
+    async->maxbuf = async->nbytes + nbytes;
+    async->buf = (char *)
+      memory->srealloc(async->buf,async->maxbuf,"dump:async");
+  }
+  return async->buf + async->nbytes;
+}
+
+/* ----------------------------------------------------------------------
+   append chunk of nbytes with n lines or chars to the snapshot copy
+------------------------------------------------------------------------- */
+
+void Dump::async_commit(int n, bigint nbytes)
+{
+  async->nlines.push_back(n);
+  async->offset.push_back(async->nbytes);
+  async->nbytes += nbytes;
+}
+
+/* ----------------------------------------------------------------------
+   run by I/O thread: format and write all chunks of the snapshot copy
+   if buffering, convert each chunk into one string and write it
+   errors and warnings are kept for the main thread to raise in sync()
+------------------------------------------------------------------------- */
+
+void Dump::write_snapshot()
+{
+  Error::defer(1);
+
+  try {
+    const int nchunk = async->nlines.size();
+    for (int i = 0; i < nchunk; i++) {
+      double *mybuf = (double *) (async->buf + async->offset[i]);
+      if (buffer_flag && !binary) {
+        int nchars = convert_string(async->nlines[i],mybuf);
+        if (nchars < 0)
+          error->one(FLERR,"Too much buffered per-proc info for dump");
+        write_data(nchars,(double *) sbuf);
+      } else write_data(async->nlines[i],mybuf);
+    }
+
+    if (fp && ferror(fp))
+      error->one(FLERR,"Error writing dump file: " + utils::getsyserror());
+    close_snapshot();
+
+  } catch (DeferredError &e) {
+    async->errorflag = 1;
+    async->error = e;
   }
+
+  async->warnings = Error::deferred_warnings();
+  Error::defer(0);
+
+  async->nlines.clear();
+  async->offset.clear();
 }
 
 /* ----------------------------------------------------------------------
@@ -919,6 +1089,8 @@ void Dump::modify_params(int narg, char **arg)
 {
   if (narg == 0) error->all(FLERR,"Illegal dump_modify command");
 
+  sync();
+
   int iarg = 0;
   while (iarg < narg) {
     if (strcmp(arg[iarg],"append") == 0) {
@@ -928,6 +1100,15 @@ void Dump::modify_params(int narg, char **arg)
       else error->all(FLERR,"Illegal dump_modify command");
       iarg += 2;
 
+    } else if (strcmp(arg[iarg],"async") == 0) {
+      if (iarg+2 > narg) error->all(FLERR,"Illegal dump_modify command");
+      if (strcmp(arg[iarg+1],"yes") == 0) async_flag = 1;
+      else if (strcmp(arg[iarg+1],"no") == 0) async_flag = 0;
+      else error->all(FLERR,"Illegal dump_modify command");
+      if (async_flag && async_allow == 0)
+        error->all(FLERR,"Dump_modify async yes not allowed for this style");
+      iarg += 2;
+
     } else if (strcmp(arg[iarg],"buffer") == 0) {
       if (iarg+2 > narg) error->all(FLERR,"Illegal dump_modify command");
       if (strcmp(arg[iarg+1],"yes") == 0) buffer_flag = 1;
@@ -1176,6 +1357,7 @@ double Dump::memory_usage()
 {
   double bytes = memory->usage(buf,size_one*maxbuf);
   bytes += memory->usage(sbuf,maxsbuf);
+  if (async) bytes += (double)async->maxbuf;
   if (sort_flag) {
     if (sortcol == 0) bytes += memory->usage(ids,maxids);
     bytes += memory->usage(bufsort,size_one*maxsort);
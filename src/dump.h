@@ -48,6 +48,7 @@ class Dump : protected Pointers {
 
   void modify_params(int, char **);
   virtual double memory_usage();
+  void sync(int flag = 1);
 
  protected:
   int me,nprocs;             // proc info
@@ -69,6 +70,8 @@ class Dump : protected Pointers {
   int append_flag;           // 1 if open file in append mode, 0 if not
   int buffer_allow;          // 1 if style allows for buffer_flag, 0 if not
   int buffer_flag;           // 1 if buffer output as one big string, 0 if not
+  int async_allow;           // 1 if style allows for async_flag, 0 if not
+  int async_flag;            // 1 if file is written by a background thread
   int padflag;               // timestep padding in filename
   int pbcflag;               // 1 if remap dumped atoms via PBC, 0 if not
   int singlefile_opened;     // 1 = one big file, already opened, else 0
@@ -137,6 +140,8 @@ class Dump : protected Pointers {
 
   class Irregular *irregular;
 
+  struct DumpAsync *async;   // snapshot copy and I/O thread for async output
+
   virtual void init_style() = 0;
   virtual void openfile();
   virtual int modify_param(int, char **) {return 0;}
@@ -145,10 +150,16 @@ class Dump : protected Pointers {
   virtual void pack(tagint *) = 0;
   virtual int convert_string(int, double *) {return 0;}
   virtual void write_data(int, double *) = 0;
+  virtual void close_snapshot();
   void pbc_allocate();
   double compute_time();
 
   void sort();
+
+  char *async_reserve(bigint);
+  void async_commit(int, bigint);
+  void write_snapshot();
+
 #if defined(LMP_QSORT)
   static int idcompare(const void *, const void *);
   static int bufcompare(const void *, const void *);
@@ -221,6 +232,17 @@ E: Dump_modify buffer yes not allowed for this style
 
 Self-explanatory.
 
+E: Dump_modify async yes not allowed for this style
+
+Only dump styles atom, custom, cfg, local, and xyz and their
+compressed variants can write their files from a background thread.
+
+W: Cannot start thread for asynchronous dump output, writing synchronously
+
+The C++ runtime could not create a thread, e.g. because LAMMPS was
+built without the -pthread compiler and linker flag.  Async output is
+turned off for this dump.
+
 E: Cannot use dump_modify fileper without % in dump file name
 
 Self-explanatory.
@@ -55,7 +55,7 @@ DumpCustom::DumpCustom(LAMMPS *lmp, int narg, char **arg) :
   Dump(lmp, narg, arg),
   idregion(nullptr), thresh_array(nullptr), thresh_op(nullptr), thresh_value(nullptr),
   thresh_last(nullptr), thresh_fix(nullptr), thresh_fixID(nullptr), thresh_first(nullptr),
-  earg(nullptr), vtype(nullptr), vformat(nullptr), columns(nullptr), choose(nullptr),
+  earg(nullptr), vtype(nullptr), vformat(nullptr), fformat(nullptr), columns(nullptr), choose(nullptr),
   dchoose(nullptr), clist(nullptr), field2index(nullptr), argindex(nullptr), id_compute(nullptr),
   compute(nullptr), id_fix(nullptr), fix(nullptr), id_variable(nullptr), variable(nullptr),
   vbuf(nullptr), id_custom(nullptr), flag_custom(nullptr), typenames(nullptr),
@@ -85,6 +85,7 @@ DumpCustom::DumpCustom(LAMMPS *lmp, int narg, char **arg) :
   memory->create(argindex,nfield,"dump:argindex");
 
   buffer_allow = 1;
+  async_allow = 1;
   buffer_flag = 1;
   iregion = -1;
   idregion = nullptr;
@@ -158,6 +159,7 @@ DumpCustom::DumpCustom(LAMMPS *lmp, int narg, char **arg) :
   // setup format strings
 
   vformat = new char*[nfield];
+  fformat = new char*[nfield];
 
   format_default = new char[4*nfield+1];
   format_default[0] = '\0';
@@ -168,6 +170,7 @@ DumpCustom::DumpCustom(LAMMPS *lmp, int narg, char **arg) :
     else if (vtype[i] == Dump::STRING) strcat(format_default,"%s ");
     else if (vtype[i] == Dump::BIGINT) strcat(format_default,BIGINT_FORMAT " ");
     vformat[i] = nullptr;
+    fformat[i] = nullptr;
   }
 
   format_column_user = new char*[nfield];
@@ -248,6 +251,11 @@ DumpCustom::~DumpCustom()
     delete [] vformat;
   }
 
+  if (fformat) {
+    for (int i = 0; i < nfield; i++) delete [] fformat[i];
+    delete [] fformat;
+  }
+
   if (format_column_user) {
     for (int i = 0; i < nfield; i++) delete [] format_column_user[i];
     delete [] format_column_user;
@@ -303,6 +311,31 @@ void DumpCustom::init_style()
     if (i+1 < nfield) vformat[i] = strcat(vformat[i]," ");
   }
 
+  // translate each format string once for the {fmt} library,
+  // which formats much faster than sprintf()
+  // keep using sprintf() for formats that cannot be translated exactly
+
+  for (int i = 0; i < nfield; i++) {
+    delete [] fformat[i];
+    fformat[i] = nullptr;
+
+    std::string convs;
+    if (vtype[i] == Dump::DOUBLE) convs = "eEfFgG";
+    else if (vtype[i] == Dump::STRING) convs = "s";
+    else convs = "di";
+    std::string str = utils::printf2fmt(vformat[i],convs);
+    if (str.empty()) continue;
+
+    try {
+      if (vtype[i] == Dump::DOUBLE) fmt::format(str,0.0);
+      else if (vtype[i] == Dump::STRING) fmt::format(str,"C");
+      else fmt::format(str,(bigint) 0);
+    } catch (fmt::format_error &) {
+      continue;
+    }
+    fformat[i] = utils::strdup(str);
+  }
+
   // setup boundary string
 
   domain->boundary_string(boundstr);
@@ -1184,24 +1217,45 @@ int DumpCustom::convert_string(int n, double *mybuf)
       memory->grow(sbuf,maxsbuf,"dump:sbuf");
     }
 
-    for (j = 0; j < nfield; j++) {
-      if (vtype[j] == Dump::INT)
-        offset += sprintf(&sbuf[offset],vformat[j],static_cast<int> (mybuf[m]));
-      else if (vtype[j] == Dump::DOUBLE)
-        offset += sprintf(&sbuf[offset],vformat[j],mybuf[m]);
-      else if (vtype[j] == Dump::STRING)
-        offset += sprintf(&sbuf[offset],vformat[j],typenames[(int) mybuf[m]]);
-      else if (vtype[j] == Dump::BIGINT)
-        offset += sprintf(&sbuf[offset],vformat[j],
-                          static_cast<bigint> (mybuf[m]));
-      m++;
-    }
-    offset += sprintf(&sbuf[offset],"\n");
+    for (j = 0; j < nfield; j++)
+      offset += format_field(&sbuf[offset],j,mybuf[m++]);
+    sbuf[offset++] = '\n';
   }
 
   return offset;
 }
 
+/* ----------------------------------------------------------------------
+   write value of field j into str, return # of chars written
+   use translated format with {fmt} library if available
+------------------------------------------------------------------------- */
+
+int DumpCustom::format_field(char *str, int j, double value)
+{
+  const char *ff = fformat[j];
+
+  if (ff) {
+    char *end;
+    if (vtype[j] == Dump::INT)
+      end = fmt::format_to(str,ff,static_cast<int> (value));
+    else if (vtype[j] == Dump::DOUBLE)
+      end = fmt::format_to(str,ff,value);
+    else if (vtype[j] == Dump::STRING)
+      end = fmt::format_to(str,ff,typenames[(int) value]);
+    else
+      end = fmt::format_to(str,ff,static_cast<bigint> (value));
+    return end - str;
+  }
+
+  if (vtype[j] == Dump::INT)
+    return sprintf(str,vformat[j],static_cast<int> (value));
+  else if (vtype[j] == Dump::DOUBLE)
+    return sprintf(str,vformat[j],value);
+  else if (vtype[j] == Dump::STRING)
+    return sprintf(str,vformat[j],typenames[(int) value]);
+  return sprintf(str,vformat[j],static_cast<bigint> (value));
+}
+
 /* ---------------------------------------------------------------------- */
 
 void DumpCustom::write_data(int n, double *mybuf)
@@ -1231,19 +1285,43 @@ void DumpCustom::write_lines(int n, double *mybuf)
 {
   int i,j;
 
+  // format lines into a local buffer and write it in large blocks
+  // fields that need sprintf() are printed directly after a flush
+
+  fmt::memory_buffer line;
+
   int m = 0;
   for (i = 0; i < n; i++) {
     for (j = 0; j < nfield; j++) {
-      if (vtype[j] == Dump::INT) fprintf(fp,vformat[j],static_cast<int> (mybuf[m]));
-      else if (vtype[j] == Dump::DOUBLE) fprintf(fp,vformat[j],mybuf[m]);
-      else if (vtype[j] == Dump::STRING)
-        fprintf(fp,vformat[j],typenames[(int) mybuf[m]]);
-      else if (vtype[j] == Dump::BIGINT)
-        fprintf(fp,vformat[j],static_cast<bigint> (mybuf[m]));
+      if (fformat[j]) {
+        if (vtype[j] == Dump::INT)
+          fmt::format_to(line,fformat[j],static_cast<int> (mybuf[m]));
+        else if (vtype[j] == Dump::DOUBLE)
+          fmt::format_to(line,fformat[j],mybuf[m]);
+        else if (vtype[j] == Dump::STRING)
+          fmt::format_to(line,fformat[j],typenames[(int) mybuf[m]]);
+        else if (vtype[j] == Dump::BIGINT)
+          fmt::format_to(line,fformat[j],static_cast<bigint> (mybuf[m]));
+      } else {
+        fwrite(line.data(),sizeof(char),line.size(),fp);
+        line.clear();
+        if (vtype[j] == Dump::INT)
+          fprintf(fp,vformat[j],static_cast<int> (mybuf[m]));
+        else if (vtype[j] == Dump::DOUBLE) fprintf(fp,vformat[j],mybuf[m]);
+        else if (vtype[j] == Dump::STRING)
+          fprintf(fp,vformat[j],typenames[(int) mybuf[m]]);
+        else if (vtype[j] == Dump::BIGINT)
+          fprintf(fp,vformat[j],static_cast<bigint> (mybuf[m]));
+      }
       m++;
     }
-    fprintf(fp,"\n");
+    line.push_back('\n');
+    if (line.size() > DELTA) {
+      fwrite(line.data(),sizeof(char),line.size(),fp);
+      line.clear();
+    }
   }
+  fwrite(line.data(),sizeof(char),line.size(),fp);
 }
 
 /* ---------------------------------------------------------------------- */
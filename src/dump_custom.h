@@ -58,6 +58,8 @@ class DumpCustom : public Dump {
 
   int *vtype;                // type of each vector (INT, DOUBLE)
   char **vformat;            // format string for each vector element
+  char **fformat;            // vformat translated for {fmt} library,
+                             // nullptr if it must be used with sprintf()
 
   char *columns;             // column labels
 
@@ -136,6 +138,7 @@ class DumpCustom : public Dump {
   void write_binary(int, double *);
   void write_string(int, double *);
   void write_lines(int, double *);
+  int format_field(char *, int, double);
 
   // customize by adding a method prototype
 
@@ -63,6 +63,7 @@ DumpImage::DumpImage(LAMMPS *lmp, int narg, char **arg) :
 
   binary = 1;
   multifile_override = 0;
+  async_allow = 0;
 
   // set filetype based on filename suffix
 
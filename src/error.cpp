@@ -24,6 +24,11 @@
 
 using namespace LAMMPS_NS;
 
+// errors and warnings of helper threads, see defer()
+
+static thread_local int deferflag = 0;
+static thread_local std::vector<DeferredError> deferred;
+
 // helper function to truncate a string to a segment starting with "src/";
 
 static std::string truncpath(const std::string &path)
@@ -127,6 +132,8 @@ void Error::universe_warn(const std::string &file, int line, const std::string &
 
 void Error::all(const std::string &file, int line, const std::string &str)
 {
+  if (deferflag) throw DeferredError(file,line,str);
+
   MPI_Barrier(world);
 
   int me;
@@ -176,6 +183,8 @@ void Error::all(const std::string &file, int line, const std::string &str)
 
 void Error::one(const std::string &file, int line, const std::string &str)
 {
+  if (deferflag) throw DeferredError(file,line,str);
+
   int me;
   std::string lastcmd = "(unknown)";
   MPI_Comm_rank(world,&me);
@@ -212,6 +221,11 @@ void Error::one(const std::string &file, int line, const std::string &str)
 
 void Error::warning(const std::string &file, int line, const std::string &str, int logflag)
 {
+  if (deferflag) {
+    deferred.emplace_back(file,line,str);
+    return;
+  }
+
   std::string mesg = fmt::format("WARNING: {} ({}:{})\n",
                                  str,truncpath(file),line);
   if (screen) fputs(mesg.c_str(),screen);
@@ -251,6 +265,29 @@ void Error::done(int status)
   exit(status);
 }
 
+/* ----------------------------------------------------------------------
+   flag = 1 to defer errors and warnings of the calling thread, 0 to stop
+   called by helper threads at start and end of their work
+------------------------------------------------------------------------- */
+
+void Error::defer(int flag)
+{
+  deferflag = flag;
+  deferred.clear();
+}
+
+/* ----------------------------------------------------------------------
+   return and clear warnings stored since defer() or previous call
+   called by helper thread which stored them
+------------------------------------------------------------------------- */
+
+std::vector<DeferredError> Error::deferred_warnings()
+{
+  std::vector<DeferredError> warnings;
+  warnings.swap(deferred);
+  return warnings;
+}
+
 #ifdef LAMMPS_EXCEPTIONS
 /* ----------------------------------------------------------------------
    return the last error message reported by LAMMPS (only used if
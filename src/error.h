@@ -16,12 +16,28 @@
 
 #include "pointers.h"
 
+#include <exception>
+#include <vector>
+
 #ifdef LAMMPS_EXCEPTIONS
 #include "exceptions.h"
 #endif
 
 namespace LAMMPS_NS {
 
+// error or warning raised by a helper thread, see Error::defer()
+
+class DeferredError : public std::exception {
+ public:
+  std::string file,message;
+  int line;
+
+  DeferredError() : line(0) {}
+  DeferredError(const std::string &f, int l, const std::string &msg) :
+    file(f), message(msg), line(l) {}
+  const char *what() const noexcept override { return message.c_str(); }
+};
+
 class Error : protected Pointers {
  public:
   Error(class LAMMPS *);
@@ -36,6 +52,14 @@ class Error : protected Pointers {
   void message(const std::string &, int, const std::string &, int = 1);
   [[ noreturn ]] void done(int = 0); // 1 would be fully backwards compatible
 
+  // helper threads must not write output or make MPI calls
+  // after defer(1) errors of the calling thread are thrown as DeferredError
+  //   and its warnings are stored, the thread must pass both to the
+  //   main thread which raises them via one() and warning()
+
+  static void defer(int);
+  static std::vector<DeferredError> deferred_warnings();
+
 #ifdef LAMMPS_EXCEPTIONS
   std::string get_last_error() const;
   ErrorType get_last_error_type() const;
@@ -17,6 +17,7 @@
 #include "atom.h"
 #include "atom_vec.h"
 #include "comm.h"
+#include "dump.h"
 #include "error.h"
 #include "force.h"
 #include "kspace.h"
@@ -26,6 +27,7 @@
 #include "neigh_list.h"
 #include "neigh_request.h"
 #include "neighbor.h"           // IWYU pragma: keep
+#include "output.h"
 #include "timer.h"              // IWYU pragma: keep
 #include "universe.h"
 #include "update.h"
@@ -73,6 +75,10 @@ void Finish::end(int flag)
 
   const int nthreads = comm->nthreads;
 
+  // dump files written by I/O threads are complete at end of run
+
+  for (i = 0; i < output->ndump; i++) output->dump[i]->sync();
+
   // recompute natoms in case atoms have been lost
 
   bigint nblocal = atom->nlocal;
@@ -21,6 +21,7 @@
 #include "error.h"
 #include "force.h"
 #include "input.h"
+#include "irregular.h"
 #include "memory.h"
 #include "modify.h"
 #include "update.h"
@@ -36,6 +37,7 @@ enum{SCALAR,VECTOR};
 enum{SAMPLE,ALL};
 enum{NOSCALE,ATOM};
 enum{ONE,RUNNING,WINDOW};
+enum{DENSE,SPARSE,SPATIAL};
 
 
 /* ---------------------------------------------------------------------- */
@@ -48,11 +50,15 @@ FixAveChunk::FixAveChunk(LAMMPS *lmp, int narg, char **arg) :
   count_one(nullptr), count_many(nullptr), count_sum(nullptr),
   values_one(nullptr), values_many(nullptr), values_sum(nullptr),
   count_total(nullptr), count_list(nullptr),
-  values_total(nullptr), values_list(nullptr)
+  values_total(nullptr), values_list(nullptr), chunklist(nullptr),
+  proclist(nullptr), sendbuf(nullptr), recvbuf(nullptr),
+  chunkproc(nullptr), chunkorder(nullptr), ownedcount(nullptr),
+  ownedfirst(nullptr), gatherbuf(nullptr), recvcounts(nullptr), displs(nullptr)
 {
   if (narg < 7) error->all(FLERR,"Illegal fix ave/chunk command");
 
   MPI_Comm_rank(world,&me);
+  MPI_Comm_size(world,&nprocs);
 
   nevery = utils::inumeric(FLERR,arg[3],false,lmp);
   nrepeat = utils::inumeric(FLERR,arg[4],false,lmp);
@@ -151,6 +157,7 @@ FixAveChunk::FixAveChunk(LAMMPS *lmp, int narg, char **arg) :
   adof = domain->dimension;
   cdof = 0.0;
   overwrite = 0;
+  sparseflag = DENSE;
   format_user = nullptr;
   format = (char *) " %g";
   char *title1 = nullptr;
@@ -216,6 +223,13 @@ FixAveChunk::FixAveChunk(LAMMPS *lmp, int narg, char **arg) :
     } else if (strcmp(arg[iarg],"overwrite") == 0) {
       overwrite = 1;
       iarg += 1;
+    } else if (strcmp(arg[iarg],"sparse") == 0) {
+      if (iarg+2 > narg) error->all(FLERR,"Illegal fix ave/chunk command");
+      if (strcmp(arg[iarg+1],"yes") == 0) sparseflag = SPARSE;
+      else if (strcmp(arg[iarg+1],"spatial") == 0) sparseflag = SPATIAL;
+      else if (strcmp(arg[iarg+1],"no") == 0) sparseflag = DENSE;
+      else error->all(FLERR,"Illegal fix ave/chunk command");
+      iarg += 2;
     } else if (strcmp(arg[iarg],"format") == 0) {
       if (iarg+2 > narg) error->all(FLERR,"Illegal fix ave/chunk command");
       delete [] format_user;
@@ -399,6 +413,14 @@ FixAveChunk::FixAveChunk(LAMMPS *lmp, int narg, char **arg) :
   values_one = values_many = values_sum = values_total = nullptr;
   values_list = nullptr;
 
+  maxsend = maxrecv = 0;
+  if (sparseflag) {
+    ownedcount = new int[nprocs];
+    ownedfirst = new int[nprocs];
+    recvcounts = new int[nprocs];
+    displs = new int[nprocs];
+  }
+
   maxchunk = 0;
   nchunk = 1;
   allocate();
@@ -436,6 +458,17 @@ FixAveChunk::~FixAveChunk()
   memory->destroy(values_sum);
   memory->destroy(values_total);
   memory->destroy(values_list);
+  memory->destroy(chunklist);
+  memory->destroy(proclist);
+  memory->destroy(sendbuf);
+  memory->destroy(recvbuf);
+  memory->destroy(chunkproc);
+  memory->destroy(chunkorder);
+  memory->destroy(gatherbuf);
+  delete [] ownedcount;
+  delete [] ownedfirst;
+  delete [] recvcounts;
+  delete [] displs;
 
   // decrement lock counter in compute chunk/atom, it if still exists
 
@@ -549,7 +582,7 @@ void FixAveChunk::setup(int /*vflag*/)
 
 void FixAveChunk::end_of_step()
 {
-  int i,j,m,n,index;
+  int i,j,k,m,n,index;
 
   // skip if not step which requires doing something
   // error check if timestep was reset in an invalid manner
@@ -582,6 +615,7 @@ void FixAveChunk::end_of_step()
       modify->addstep_compute(ntimestep+nfreq);
     }
     allocate();
+    if (sparseflag) setup_owners();
     if (nrepeat > 1 && ave == ONE)
       cchunk->lock(this,ntimestep,ntimestep+((bigint)nrepeat-1)*nevery);
     else if ((ave == RUNNING || ave == WINDOW) && !lockforever) {
@@ -601,10 +635,13 @@ void FixAveChunk::end_of_step()
   }
 
   // zero out arrays for one sample
+  // for sparse reduction they are zeroed after each sample for used chunks
 
-  for (m = 0; m < nchunk; m++) {
-    count_one[m] = 0.0;
-    for (i = 0; i < nvalues; i++) values_one[m][i] = 0.0;
+  if (!sparseflag) {
+    for (m = 0; m < nchunk; m++) {
+      count_one[m] = 0.0;
+      for (i = 0; i < nvalues; i++) values_one[m][i] = 0.0;
+    }
   }
 
   // compute chunk/atom assigns atoms to chunk IDs
@@ -625,12 +662,24 @@ void FixAveChunk::end_of_step()
   // sum within each chunk, only include atoms in fix group
   // compute/fix/variable may invoke computes so wrap with clear/add
 
+  // for sparse reduction, also list the chunks my atoms are in
+
   int *mask = atom->mask;
   int nlocal = atom->nlocal;
-
-  for (i = 0; i < nlocal; i++)
-    if (mask[i] & groupbit && ichunk[i] > 0)
-      count_one[ichunk[i]-1]++;
+  int nused = 0;
+
+  if (sparseflag) {
+    for (i = 0; i < nlocal; i++)
+      if (mask[i] & groupbit && ichunk[i] > 0) {
+        index = ichunk[i]-1;
+        if (count_one[index] == 0.0) chunklist[nused++] = index;
+        count_one[index]++;
+      }
+  } else {
+    for (i = 0; i < nlocal; i++)
+      if (mask[i] & groupbit && ichunk[i] > 0)
+        count_one[ichunk[i]-1]++;
+  }
 
   modify->clearstep_compute();
 
@@ -784,12 +833,36 @@ void FixAveChunk::end_of_step()
   //   exception is scaleflag = NOSCALE (norm = NONE):
   //     no normalize by atom count
   //     check last so other options can take precedence
+  // for sparse reduction, only chunks with atoms are processed
+  //   if normflag = ALL, values,count are summed across procs at Nfreq
+  //   if normflag = SAMPLE, owning procs sum value,count of their chunks
+  //     and normalize them, no MPI_Allreduce over all chunks is needed
 
   double mvv2e = force->mvv2e;
   double mv2d = force->mv2d;
   double boltz = force->boltz;
 
-  if (normflag == ALL) {
+  if (cchunk->chunk_volume_vec) {
+    volflag = VECTOR;
+    chunk_volume_vec = cchunk->chunk_volume_vec;
+  } else {
+    volflag = SCALAR;
+    chunk_volume_scalar = cchunk->chunk_volume_scalar;
+  }
+
+  if (sparseflag) {
+    if (normflag == SAMPLE) nused = reduce_sparse(nused,count_one,values_one);
+    for (i = 0; i < nused; i++) {
+      m = chunklist[i];
+      if (normflag == ALL) {
+        count_many[m] += count_one[m];
+        for (j = 0; j < nvalues; j++)
+          values_many[m][j] += values_one[m][j];
+      } else normalize_sample(m,count_one[m]);
+      count_one[m] = 0.0;
+      for (j = 0; j < nvalues; j++) values_one[m][j] = 0.0;
+    }
+  } else if (normflag == ALL) {
     for (m = 0; m < nchunk; m++) {
       count_many[m] += count_one[m];
       for (j = 0; j < nvalues; j++)
@@ -797,37 +870,7 @@ void FixAveChunk::end_of_step()
     }
   } else if (normflag == SAMPLE) {
     MPI_Allreduce(count_one,count_many,nchunk,MPI_DOUBLE,MPI_SUM,world);
-
-    if (cchunk->chunk_volume_vec) {
-      volflag = VECTOR;
-      chunk_volume_vec = cchunk->chunk_volume_vec;
-    } else {
-      volflag = SCALAR;
-      chunk_volume_scalar = cchunk->chunk_volume_scalar;
-    }
-
-    for (m = 0; m < nchunk; m++) {
-      if (count_many[m] > 0.0)
-        for (j = 0; j < nvalues; j++) {
-          if (which[j] == ArgInfo::TEMPERATURE) {
-            values_many[m][j] += mvv2e*values_one[m][j] /
-              ((cdof + adof*count_many[m]) * boltz);
-          } else if (which[j] == ArgInfo::DENSITY_NUMBER) {
-            if (volflag == SCALAR) values_one[m][j] /= chunk_volume_scalar;
-            else values_one[m][j] /= chunk_volume_vec[m];
-            values_many[m][j] += values_one[m][j];
-          } else if (which[j] == ArgInfo::DENSITY_MASS) {
-            if (volflag == SCALAR) values_one[m][j] /= chunk_volume_scalar;
-            else values_one[m][j] /= chunk_volume_vec[m];
-            values_many[m][j] += mv2d*values_one[m][j];
-          } else if (scaleflag == NOSCALE) {
-            values_many[m][j] += values_one[m][j];
-          } else {
-            values_many[m][j] += values_one[m][j]/count_many[m];
-          }
-        }
-      count_sum[m] += count_many[m];
-    }
+    for (m = 0; m < nchunk; m++) normalize_sample(m,count_many[m]);
   }
 
   // done if irepeat < nrepeat
@@ -860,13 +903,33 @@ void FixAveChunk::end_of_step()
   //     normalize by repeat, not by total count
   //     check last so other options can take precedence
   // if normflag = SAMPLE, final is sum of ave / repeat
+  // for sparse reduction, each proc normalizes the chunks it owns
+  //   which are then gathered to all procs
 
   double repeat = nrepeat;
+  int klo = 0;
+  int khi = nchunk;
+  if (sparseflag) {
+    klo = ownedfirst[me];
+    khi = klo + ownedcount[me];
+  }
 
   if (normflag == ALL) {
-    MPI_Allreduce(count_many,count_sum,nchunk,MPI_DOUBLE,MPI_SUM,world);
-    MPI_Allreduce(&values_many[0][0],&values_sum[0][0],nchunk*nvalues,
-                  MPI_DOUBLE,MPI_SUM,world);
+    if (sparseflag) {
+      n = 0;
+      for (m = 0; m < nchunk; m++)
+        if (count_many[m] > 0.0) chunklist[n++] = m;
+      reduce_sparse(n,count_many,values_many);
+      for (k = klo; k < khi; k++) {
+        m = chunkorder[k];
+        count_sum[m] = count_many[m];
+        for (j = 0; j < nvalues; j++) values_sum[m][j] = values_many[m][j];
+      }
+    } else {
+      MPI_Allreduce(count_many,count_sum,nchunk,MPI_DOUBLE,MPI_SUM,world);
+      MPI_Allreduce(&values_many[0][0],&values_sum[0][0],nchunk*nvalues,
+                    MPI_DOUBLE,MPI_SUM,world);
+    }
 
     if (cchunk->chunk_volume_vec) {
       volflag = VECTOR;
@@ -876,7 +939,8 @@ void FixAveChunk::end_of_step()
       chunk_volume_scalar = cchunk->chunk_volume_scalar;
     }
 
-    for (m = 0; m < nchunk; m++) {
+    for (k = klo; k < khi; k++) {
+      m = sparseflag ? chunkorder[k] : k;
       if (count_sum[m] > 0.0)
         for (j = 0; j < nvalues; j++) {
           if (which[j] == ArgInfo::TEMPERATURE) {
@@ -898,14 +962,23 @@ void FixAveChunk::end_of_step()
       count_sum[m] /= repeat;
     }
   } else if (normflag == SAMPLE) {
-    MPI_Allreduce(&values_many[0][0],&values_sum[0][0],nchunk*nvalues,
-                  MPI_DOUBLE,MPI_SUM,world);
-    for (m = 0; m < nchunk; m++) {
+    if (sparseflag) {
+      for (k = klo; k < khi; k++) {
+        m = chunkorder[k];
+        for (j = 0; j < nvalues; j++) values_sum[m][j] = values_many[m][j];
+      }
+    } else
+      MPI_Allreduce(&values_many[0][0],&values_sum[0][0],nchunk*nvalues,
+                    MPI_DOUBLE,MPI_SUM,world);
+    for (k = klo; k < khi; k++) {
+      m = sparseflag ? chunkorder[k] : k;
       for (j = 0; j < nvalues; j++) values_sum[m][j] /= repeat;
       count_sum[m] /= repeat;
     }
   }
 
+  if (sparseflag) gather_sparse();
+
   // if ave = ONE, only single Nfreq timestep value is needed
   // if ave = RUNNING, combine with all previous Nfreq timestep values
   // if ave = WINDOW, comine with nwindow most recent Nfreq timestep values
@@ -1066,6 +1139,14 @@ void FixAveChunk::allocate()
     memory->grow(values_many,nchunk,nvalues,"ave/chunk:values_many");
     memory->grow(values_sum,nchunk,nvalues,"ave/chunk:values_sum");
     memory->grow(values_total,nchunk,nvalues,"ave/chunk:values_total");
+    if (sparseflag) {
+      memory->grow(chunklist,nchunk,"ave/chunk:chunklist");
+      memory->grow(chunkorder,nchunk,"ave/chunk:chunkorder");
+    }
+    if (sparseflag == SPATIAL) {
+      memory->grow(chunkproc,nchunk,"ave/chunk:chunkproc");
+      memory->grow(gatherbuf,nchunk*(nvalues+1),"ave/chunk:gatherbuf");
+    }
 
     // only allocate count and values list for ave = WINDOW
 
@@ -1082,9 +1163,206 @@ void FixAveChunk::allocate()
       for (i = 0; i < nvalues; i++) values_total[m][i] = 0.0;
       count_total[m] = 0.0;
     }
+
+    // sparse reduction only re-zeroes count/values one of used chunks
+
+    if (sparseflag) {
+      for (m = 0; m < nchunk; m++) {
+        for (i = 0; i < nvalues; i++) values_one[m][i] = 0.0;
+        count_one[m] = 0.0;
+      }
+    }
   }
 }
 
+/* ----------------------------------------------------------------------
+   assign each chunk to the proc that owns it for sparse reduction
+   for sparse = yes, each proc owns a contiguous range of chunk IDs
+   for sparse = spatial, each proc owns the bins whose center is
+     in its sub-domain, kept for the Nfreq epoch that starts now
+   chunkorder = all chunks ordered by owning proc,
+     chunks owned by proc P start at ownedfirst[P]
+------------------------------------------------------------------------- */
+
+void FixAveChunk::setup_owners()
+{
+  int m,p;
+
+  if (sparseflag == SPARSE) {
+    for (p = 0; p < nprocs; p++) {
+      ownedfirst[p] = static_cast<int> ((bigint) p*nchunk/nprocs);
+      ownedcount[p] = static_cast<int> ((bigint) (p+1)*nchunk/nprocs) -
+        ownedfirst[p];
+    }
+    for (m = 0; m < nchunk; m++) chunkorder[m] = m;
+    return;
+  }
+
+  if (!cchunk->chunk_owners(chunkproc))
+    error->all(FLERR,"Fix ave/chunk sparse spatial requires "
+               "compute chunk/atom with uncompressed bin/1d, bin/2d, or bin/3d");
+
+  for (p = 0; p < nprocs; p++) ownedcount[p] = 0;
+  for (m = 0; m < nchunk; m++) ownedcount[chunkproc[m]]++;
+  ownedfirst[0] = 0;
+  for (p = 1; p < nprocs; p++)
+    ownedfirst[p] = ownedfirst[p-1] + ownedcount[p-1];
+
+  // displs is used as insertion index of each proc
+
+  for (p = 0; p < nprocs; p++) displs[p] = ownedfirst[p];
+  for (m = 0; m < nchunk; m++) chunkorder[displs[chunkproc[m]]++] = m;
+}
+
+/* ----------------------------------------------------------------------
+   normalize values of chunk M for one sample by its total count
+   and add them to the values accumulated across samples
+------------------------------------------------------------------------- */
+
+void FixAveChunk::normalize_sample(int m, double count)
+{
+  double mvv2e = force->mvv2e;
+  double mv2d = force->mv2d;
+  double boltz = force->boltz;
+
+  if (count > 0.0)
+    for (int j = 0; j < nvalues; j++) {
+      if (which[j] == ArgInfo::TEMPERATURE) {
+        values_many[m][j] += mvv2e*values_one[m][j] /
+          ((cdof + adof*count) * boltz);
+      } else if (which[j] == ArgInfo::DENSITY_NUMBER) {
+        if (volflag == SCALAR) values_one[m][j] /= chunk_volume_scalar;
+        else values_one[m][j] /= chunk_volume_vec[m];
+        values_many[m][j] += values_one[m][j];
+      } else if (which[j] == ArgInfo::DENSITY_MASS) {
+        if (volflag == SCALAR) values_one[m][j] /= chunk_volume_scalar;
+        else values_one[m][j] /= chunk_volume_vec[m];
+        values_many[m][j] += mv2d*values_one[m][j];
+      } else if (scaleflag == NOSCALE) {
+        values_many[m][j] += values_one[m][j];
+      } else {
+        values_many[m][j] += values_one[m][j]/count;
+      }
+    }
+  count_sum[m] += count;
+}
+
+/* ----------------------------------------------------------------------
+   sum count and values of the N chunks in chunklist across procs
+   each chunk is sent to the proc that owns it and zeroed locally
+   return # of owned chunks with received data, they are stored in chunklist
+------------------------------------------------------------------------- */
+
+int FixAveChunk::reduce_sparse(int n, double *count, double **values)
+{
+  int i,j,m;
+  double *buf;
+
+  int nper = nvalues + 2;
+  if (n > maxsend) {
+    maxsend = n;
+    memory->destroy(proclist);
+    memory->destroy(sendbuf);
+    memory->create(proclist,maxsend,"ave/chunk:proclist");
+    memory->create(sendbuf,maxsend*nper,"ave/chunk:sendbuf");
+  }
+
+  // owner of chunk M is the proc whose range of chunk IDs includes it
+  //   or for sparse = spatial the proc assigned by setup_owners()
+
+  for (i = 0; i < n; i++) {
+    m = chunklist[i];
+    if (sparseflag == SPATIAL) proclist[i] = chunkproc[m];
+    else proclist[i] = static_cast<int> (((bigint) (m+1)*nprocs - 1) / nchunk);
+    buf = &sendbuf[i*nper];
+    buf[0] = m;
+    buf[1] = count[m];
+    count[m] = 0.0;
+    for (j = 0; j < nvalues; j++) {
+      buf[j+2] = values[m][j];
+      values[m][j] = 0.0;
+    }
+  }
+
+  Irregular *irregular = new Irregular(lmp);
+  int nrecv = irregular->create_data(n,proclist,1);
+  if (nrecv > maxrecv) {
+    maxrecv = nrecv;
+    memory->destroy(recvbuf);
+    memory->create(recvbuf,maxrecv*nper,"ave/chunk:recvbuf");
+  }
+  irregular->exchange_data((char *) sendbuf,nper*sizeof(double),
+                           (char *) recvbuf);
+  irregular->destroy_data();
+  delete irregular;
+
+  // every received chunk has a non-zero count
+
+  int nowned = 0;
+  for (i = 0; i < nrecv; i++) {
+    buf = &recvbuf[i*nper];
+    m = static_cast<int> (buf[0]);
+    if (count[m] == 0.0) chunklist[nowned++] = m;
+    count[m] += buf[1];
+    for (j = 0; j < nvalues; j++) values[m][j] += buf[j+2];
+  }
+
+  return nowned;
+}
+
+/* ----------------------------------------------------------------------
+   gather count_sum and values_sum of owned chunks to all procs
+   chunk ID ranges are gathered in place,
+     spatially owned chunks are packed in chunkorder sequence
+------------------------------------------------------------------------- */
+
+void FixAveChunk::gather_sparse()
+{
+  int j,k,m,p;
+  double *buf;
+
+  if (sparseflag == SPATIAL) {
+    int nper = nvalues + 1;
+    int klo = ownedfirst[me];
+    int khi = klo + ownedcount[me];
+    for (k = klo; k < khi; k++) {
+      m = chunkorder[k];
+      buf = &gatherbuf[k*nper];
+      buf[0] = count_sum[m];
+      for (j = 0; j < nvalues; j++) buf[j+1] = values_sum[m][j];
+    }
+
+    for (p = 0; p < nprocs; p++) {
+      displs[p] = ownedfirst[p]*nper;
+      recvcounts[p] = ownedcount[p]*nper;
+    }
+    MPI_Allgatherv(MPI_IN_PLACE,0,MPI_DOUBLE,gatherbuf,recvcounts,displs,
+                   MPI_DOUBLE,world);
+
+    for (k = 0; k < nchunk; k++) {
+      m = chunkorder[k];
+      buf = &gatherbuf[k*nper];
+      count_sum[m] = buf[0];
+      for (j = 0; j < nvalues; j++) values_sum[m][j] = buf[j+1];
+    }
+    return;
+  }
+
+  for (p = 0; p < nprocs; p++) {
+    displs[p] = ownedfirst[p];
+    recvcounts[p] = ownedcount[p];
+  }
+  MPI_Allgatherv(MPI_IN_PLACE,0,MPI_DOUBLE,count_sum,recvcounts,displs,
+                 MPI_DOUBLE,world);
+
+  for (p = 0; p < nprocs; p++) {
+    displs[p] *= nvalues;
+    recvcounts[p] *= nvalues;
+  }
+  MPI_Allgatherv(MPI_IN_PLACE,0,MPI_DOUBLE,&values_sum[0][0],
+                 recvcounts,displs,MPI_DOUBLE,world);
+}
+
 /* ----------------------------------------------------------------------
    return I,J array value
    if I exceeds current nchunks, return 0.0 instead of generating an error
@@ -1136,5 +1414,14 @@ double FixAveChunk::memory_usage()
   bytes += (double)nvalues*maxchunk * sizeof(double);     // values one,many,sum,total
   bytes += (double)nwindow*maxchunk * sizeof(double);          // count_list
   bytes += (double)nwindow*maxchunk*nvalues * sizeof(double);  // values_list
+  if (sparseflag) {
+    bytes += (double)2*maxchunk * sizeof(int);                   // chunklist,order
+    bytes += (double)maxsend * sizeof(int);                      // proclist
+    bytes += (double)(maxsend+maxrecv)*(nvalues+2) * sizeof(double); // bufs
+  }
+  if (sparseflag == SPATIAL) {
+    bytes += (double)maxchunk * sizeof(int);                     // chunkproc
+    bytes += (double)maxchunk*(nvalues+1) * sizeof(double);      // gatherbuf
+  }
   return bytes;
 }
@@ -36,7 +36,7 @@ class FixAveChunk : public Fix {
   double memory_usage();
 
  private:
-  int me,nvalues;
+  int me,nprocs,nvalues;
   int nrepeat,nfreq,irepeat;
   int normflag,scaleflag,overwrite,biasflag,colextra;
   bigint nvalid,nvalid_last;
@@ -74,7 +74,27 @@ class FixAveChunk : public Fix {
   double *count_total,**count_list;
   double **values_total,***values_list;
 
+  // sparse reduction: each proc owns a contiguous range of chunks
+  //   or the spatial bins in its sub-domain
+  // and receives data only for chunks with atoms in them
+
+  int sparseflag;
+  int *chunklist;           // list of chunks with data to reduce
+  int *proclist;            // owning proc of each chunk in chunklist
+  int maxsend,maxrecv;
+  double *sendbuf,*recvbuf;
+  int *chunkproc;           // owning proc of each chunk for sparse spatial
+  int *chunkorder;          // all chunks ordered by owning proc
+  int *ownedcount;          // # of chunks owned by each proc
+  int *ownedfirst;          // index of first chunk of each proc in chunkorder
+  double *gatherbuf;        // packed owned chunks for sparse spatial
+  int *recvcounts,*displs;  // for gathering owned chunks to all procs
+
   void allocate();
+  void setup_owners();
+  void normalize_sample(int, double);
+  int reduce_sparse(int, double *, double **);
+  void gather_sparse();
   bigint nextvalid();
 };
 
@@ -186,4 +206,9 @@ E: Error writing averaged chunk data
 
 Something in the output to the file triggered an error.
 
+E: Fix ave/chunk sparse spatial requires compute chunk/atom with uncompressed bin/1d, bin/2d, or bin/3d
+
+Chunks can only be assigned to the processors by their location, if
+they are spatial bins in x, y, or z that are not compressed.
+
 */
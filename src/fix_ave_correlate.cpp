@@ -42,7 +42,9 @@ enum{AUTO,UPPER,LOWER,AUTOUPPER,AUTOLOWER,FULL};
 FixAveCorrelate::FixAveCorrelate(LAMMPS * lmp, int narg, char **arg):
   Fix (lmp, narg, arg),
   nvalues(0), which(nullptr), argindex(nullptr), value2index(nullptr), ids(nullptr), fp(nullptr),
-  count(nullptr), values(nullptr), corr(nullptr), save_count(nullptr), save_corr(nullptr)
+  lag(nullptr), count(nullptr), values(nullptr), corr(nullptr), save_count(nullptr),
+  save_corr(nullptr), nfill(nullptr), naccum(nullptr), insert(nullptr), shift(nullptr),
+  accum(nullptr)
 {
   if (narg < 7) error->all(FLERR,"Illegal fix ave/correlate command");
 
@@ -93,6 +95,9 @@ FixAveCorrelate::FixAveCorrelate(LAMMPS * lmp, int narg, char **arg):
   ave = ONE;
   startstep = 0;
   prefactor = 1.0;
+  multitau = 0;
+  nlevel = 1;
+  nbin = 2;
   fp = nullptr;
   overwrite = 0;
   char *title1 = nullptr;
@@ -124,6 +129,12 @@ FixAveCorrelate::FixAveCorrelate(LAMMPS * lmp, int narg, char **arg):
       if (iarg+2 > narg) error->all(FLERR,"Illegal fix ave/correlate command");
       prefactor = utils::numeric(FLERR,arg[iarg+1],false,lmp);
       iarg += 2;
+    } else if (strcmp(arg[iarg],"multitau") == 0) {
+      if (iarg+3 > narg) error->all(FLERR,"Illegal fix ave/correlate command");
+      multitau = 1;
+      nlevel = utils::inumeric(FLERR,arg[iarg+1],false,lmp);
+      nbin = utils::inumeric(FLERR,arg[iarg+2],false,lmp);
+      iarg += 3;
     } else if (strcmp(arg[iarg],"file") == 0) {
       if (iarg+2 > narg) error->all(FLERR,"Illegal fix ave/correlate command");
       if (me == 0) {
@@ -171,6 +182,8 @@ FixAveCorrelate::FixAveCorrelate(LAMMPS * lmp, int narg, char **arg):
     error->all(FLERR,"Illegal fix ave/correlate command");
   if (ave != RUNNING && overwrite)
     error->all(FLERR,"Illegal fix ave/correlate command");
+  if (multitau && (nlevel <= 0 || nbin <= 1 || nrepeat % nbin))
+    error->all(FLERR,"Illegal fix ave/correlate command");
 
   for (int i = 0; i < nvalues; i++) {
     if (which[i] == ArgInfo::COMPUTE) {
@@ -222,6 +235,12 @@ FixAveCorrelate::FixAveCorrelate(LAMMPS * lmp, int narg, char **arg):
   if (type == AUTOUPPER || type == AUTOLOWER) npair = nvalues*(nvalues+1)/2;
   if (type == FULL) npair = nvalues*nvalues;
 
+  // nrow = # of time deltas
+  // multiple-tau levels above 0 only add the deltas not covered below
+
+  nrow = nrepeat;
+  if (multitau) nrow += (nlevel-1)*(nrepeat - nrepeat/nbin);
+
   // print file comment lines
 
   if (fp && me == 0) {
@@ -280,23 +299,47 @@ FixAveCorrelate::FixAveCorrelate(LAMMPS * lmp, int narg, char **arg):
   // set count and corr to zero since they accumulate
   // also set save versions to zero in case accessed via compute_array()
 
-  memory->create(values,nrepeat,nvalues,"ave/correlate:values");
-  memory->create(count,nrepeat,"ave/correlate:count");
-  memory->create(save_count,nrepeat,"ave/correlate:save_count");
-  memory->create(corr,nrepeat,npair,"ave/correlate:corr");
-  memory->create(save_corr,nrepeat,npair,"ave/correlate:save_corr");
+  // multiple-tau correlator stores its samples in the shift registers,
+  //   values only holds the latest one
+
+  if (multitau) memory->create(values,1,nvalues,"ave/correlate:values");
+  else memory->create(values,nrepeat,nvalues,"ave/correlate:values");
+  memory->create(lag,nrow,"ave/correlate:lag");
+  memory->create(count,nrow,"ave/correlate:count");
+  memory->create(save_count,nrow,"ave/correlate:save_count");
+  memory->create(corr,nrow,npair,"ave/correlate:corr");
+  memory->create(save_corr,nrow,npair,"ave/correlate:save_corr");
 
   int i,j;
-  for (i = 0; i < nrepeat; i++) {
+  for (i = 0; i < nrow; i++) {
     save_count[i] = count[i] = 0;
     for (j = 0; j < npair; j++)
       save_corr[i][j] = corr[i][j] = 0.0;
   }
 
+  // time delta of level K row J is J*Nbin^K samples
+
+  for (i = 0; i < nrepeat; i++) lag[i] = (bigint) i*nevery;
+  if (multitau) {
+    int jmin = nrepeat/nbin;
+    bigint stride = nevery;
+    for (int k = 1, m = nrepeat; k < nlevel; k++) {
+      stride *= nbin;
+      for (j = jmin; j < nrepeat; j++) lag[m++] = j*stride;
+    }
+
+    memory->create(nfill,nlevel,"ave/correlate:nfill");
+    memory->create(naccum,nlevel,"ave/correlate:naccum");
+    memory->create(insert,nlevel,"ave/correlate:insert");
+    memory->create(shift,nlevel,nrepeat,nvalues,"ave/correlate:shift");
+    memory->create(accum,nlevel,nvalues,"ave/correlate:accum");
+    reset_levels();
+  }
+
   // this fix produces a global array
 
   array_flag = 1;
-  size_array_rows = nrepeat;
+  size_array_rows = nrow;
   size_array_cols = npair+2;
   extarray = 0;
 
@@ -324,10 +367,16 @@ FixAveCorrelate::~FixAveCorrelate()
   delete [] ids;
 
   memory->destroy(values);
+  memory->destroy(lag);
   memory->destroy(count);
   memory->destroy(save_count);
   memory->destroy(corr);
   memory->destroy(save_corr);
+  memory->destroy(nfill);
+  memory->destroy(naccum);
+  memory->destroy(insert);
+  memory->destroy(shift);
+  memory->destroy(accum);
 
   if (fp && me == 0) fclose(fp);
 }
@@ -374,6 +423,7 @@ void FixAveCorrelate::init()
     lastindex = -1;
     firstindex = 0;
     nsample = 0;
+    if (multitau) reset_levels();
     nvalid = nextvalid();
     modify->addstep_compute_all(nvalid);
   }
@@ -412,7 +462,7 @@ void FixAveCorrelate::end_of_step()
   // lastindex = index in values ring of latest time sample
 
   lastindex++;
-  if (lastindex == nrepeat) lastindex = 0;
+  if (lastindex == nrepeat || multitau) lastindex = 0;
 
   for (i = 0; i < nvalues; i++) {
     m = value2index[i];
@@ -480,7 +530,7 @@ void FixAveCorrelate::end_of_step()
 
   // save results in save_count and save_corr
 
-  for (i = 0; i < nrepeat; i++) {
+  for (i = 0; i < nrow; i++) {
     save_count[i] = count[i];
     if (count[i])
       for (j = 0; j < npair; j++)
@@ -495,9 +545,9 @@ void FixAveCorrelate::end_of_step()
   if (fp && me == 0) {
     clearerr(fp);
     if (overwrite) fseek(fp,filepos,SEEK_SET);
-    fprintf(fp,BIGINT_FORMAT " %d\n",ntimestep,nrepeat);
-    for (i = 0; i < nrepeat; i++) {
-      fprintf(fp,"%d %d %d",i+1,i*nevery,count[i]);
+    fprintf(fp,BIGINT_FORMAT " %d\n",ntimestep,nrow);
+    for (i = 0; i < nrow; i++) {
+      fprintf(fp,"%d " BIGINT_FORMAT " %d",i+1,lag[i],count[i]);
       if (count[i])
         for (j = 0; j < npair; j++)
           fprintf(fp," %g",prefactor*corr[i][j]/count[i]);
@@ -522,12 +572,13 @@ void FixAveCorrelate::end_of_step()
   // recalculate Cij(0)
 
   if (ave == ONE) {
-    for (i = 0; i < nrepeat; i++) {
+    for (i = 0; i < nrow; i++) {
       count[i] = 0;
       for (j = 0; j < npair; j++)
         corr[i][j] = 0.0;
     }
     nsample = 1;
+    if (multitau) reset_levels();
     accumulate();
   }
 }
@@ -538,70 +589,117 @@ void FixAveCorrelate::end_of_step()
 
 void FixAveCorrelate::accumulate()
 {
-  int i,j,k,m,n,ipair;
+  int k,m;
+
+  if (multitau) {
+    add_sample(0,values[0]);
+    return;
+  }
 
   for (k = 0; k < nsample; k++) count[k]++;
 
+  m = lastindex;
+  for (k = 0; k < nsample; k++) {
+    correlate(values[m],values[lastindex],corr[k]);
+    m--;
+    if (m < 0) m = nrepeat-1;
+  }
+}
+
+/* ----------------------------------------------------------------------
+   add products of earlier sample A and later sample B to correlation C
+------------------------------------------------------------------------- */
+
+void FixAveCorrelate::correlate(double *a, double *b, double *c)
+{
+  int i,j;
+  int ipair = 0;
+
   if (type == AUTO) {
-    m = n = lastindex;
-    for (k = 0; k < nsample; k++) {
-      ipair = 0;
-      for (i = 0; i < nvalues; i++) {
-        corr[k][ipair++] += values[m][i]*values[n][i];
-      }
-      m--;
-      if (m < 0) m = nrepeat-1;
-    }
+    for (i = 0; i < nvalues; i++)
+      c[ipair++] += a[i]*b[i];
   } else if (type == UPPER) {
-    m = n = lastindex;
-    for (k = 0; k < nsample; k++) {
-      ipair = 0;
-      for (i = 0; i < nvalues; i++)
-        for (j = i+1; j < nvalues; j++)
-          corr[k][ipair++] += values[m][i]*values[n][j];
-      m--;
-      if (m < 0) m = nrepeat-1;
-    }
+    for (i = 0; i < nvalues; i++)
+      for (j = i+1; j < nvalues; j++)
+        c[ipair++] += a[i]*b[j];
   } else if (type == LOWER) {
-    m = n = lastindex;
-    for (k = 0; k < nsample; k++) {
-      ipair = 0;
-      for (i = 0; i < nvalues; i++)
-        for (j = 0; j < i; j++)
-          corr[k][ipair++] += values[m][i]*values[n][j];
-      m--;
-      if (m < 0) m = nrepeat-1;
-    }
+    for (i = 0; i < nvalues; i++)
+      for (j = 0; j < i; j++)
+        c[ipair++] += a[i]*b[j];
   } else if (type == AUTOUPPER) {
-    m = n = lastindex;
-    for (k = 0; k < nsample; k++) {
-      ipair = 0;
-      for (i = 0; i < nvalues; i++)
-        for (j = i; j < nvalues; j++)
-          corr[k][ipair++] += values[m][i]*values[n][j];
-      m--;
-      if (m < 0) m = nrepeat-1;
-    }
+    for (i = 0; i < nvalues; i++)
+      for (j = i; j < nvalues; j++)
+        c[ipair++] += a[i]*b[j];
   } else if (type == AUTOLOWER) {
-    m = n = lastindex;
-    for (k = 0; k < nsample; k++) {
-      ipair = 0;
-      for (i = 0; i < nvalues; i++)
-        for (j = 0; j <= i; j++)
-          corr[k][ipair++] += values[m][i]*values[n][j];
-      m--;
-      if (m < 0) m = nrepeat-1;
-    }
+    for (i = 0; i < nvalues; i++)
+      for (j = 0; j <= i; j++)
+        c[ipair++] += a[i]*b[j];
   } else if (type == FULL) {
-    m = n = lastindex;
-    for (k = 0; k < nsample; k++) {
-      ipair = 0;
-      for (i = 0; i < nvalues; i++)
-        for (j = 0; j < nvalues; j++)
-          corr[k][ipair++] += values[m][i]*values[n][j];
-      m--;
-      if (m < 0) m = nrepeat-1;
-    }
+    for (i = 0; i < nvalues; i++)
+      for (j = 0; j < nvalues; j++)
+        c[ipair++] += a[i]*b[j];
+  }
+}
+
+/* ----------------------------------------------------------------------
+   add sample W to level K of multiple-tau correlator
+   every Nbin samples their average is passed on to level K+1
+   level 0 correlates lags 0 to nrepeat-1,
+     higher levels only lags nrepeat/Nbin to nrepeat-1
+------------------------------------------------------------------------- */
+
+void FixAveCorrelate::add_sample(int k, double *w)
+{
+  int i,j,m;
+
+  if (k == nlevel) return;
+
+  double *latest = shift[k][insert[k]];
+  for (i = 0; i < nvalues; i++) {
+    latest[i] = w[i];
+    accum[k][i] += w[i];
+  }
+  if (nfill[k] < nrepeat) nfill[k]++;
+
+  naccum[k]++;
+  if (naccum[k] == nbin) {
+    for (i = 0; i < nvalues; i++) accum[k][i] /= nbin;
+    add_sample(k+1,accum[k]);
+    for (i = 0; i < nvalues; i++) accum[k][i] = 0.0;
+    naccum[k] = 0;
+  }
+
+  // row = 1st row of level K minus its smallest lag
+
+  int jmin = 0;
+  int row = 0;
+  if (k) {
+    jmin = nrepeat/nbin;
+    row = nrepeat + (k-1)*(nrepeat-jmin) - jmin;
+  }
+
+  m = insert[k] - jmin;
+  if (m < 0) m += nrepeat;
+  for (j = jmin; j < nfill[k]; j++) {
+    count[row+j]++;
+    correlate(shift[k][m],latest,corr[row+j]);
+    m--;
+    if (m < 0) m = nrepeat-1;
+  }
+
+  insert[k]++;
+  if (insert[k] == nrepeat) insert[k] = 0;
+}
+
+/* ----------------------------------------------------------------------
+   clear samples of all levels of multiple-tau correlator
+------------------------------------------------------------------------- */
+
+void FixAveCorrelate::reset_levels()
+{
+  for (int k = 0; k < nlevel; k++) {
+    nfill[k] = naccum[k] = insert[k] = 0;
+    for (int i = 0; i < nvalues; i++) accum[k][i] = 0.0;
   }
 }
 
@@ -611,7 +709,7 @@ void FixAveCorrelate::accumulate()
 
 double FixAveCorrelate::compute_array(int i, int j)
 {
-  if (j == 0) return 1.0*i*nevery;
+  if (j == 0) return 1.0*lag[i];
   else if (j == 1) return 1.0*save_count[i];
   else if (save_count[i]) return save_corr[i][j-2];
   return 0.0;
@@ -51,13 +51,29 @@ class FixAveCorrelate : public Fix {
   int nsample;         // number of time samples in values ring
 
   int npair;           // number of correlation pairs to calculate
+  int nrow;            // number of correlation time deltas
+  bigint *lag;         // time delta of each row
   int *count;
   double **values,**corr;
 
   int *save_count;     // saved values at Nfreq for output via compute_array()
   double **save_corr;
 
+  // multiple-tau correlator, nrepeat samples per level
+
+  int multitau;        // 1 if multiple-tau correlator is used
+  int nlevel;          // number of levels
+  int nbin;            // number of samples averaged into one of next level
+  int *nfill;          // number of samples in shift register of each level
+  int *naccum;         // number of samples in accumulator of each level
+  int *insert;         // index of next sample in shift register of each level
+  double ***shift;     // shift register of samples of each level
+  double **accum;      // sum of samples for next level
+
   void accumulate();
+  void correlate(double *, double *, double *);
+  void add_sample(int, double *);
+  void reset_levels();
   bigint nextvalid();
 };
 
@@ -0,0 +1,458 @@
+/* ----------------------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://lammps.sandia.gov/, Sandia National Laboratories
+   Steve Plimpton, sjplimp@sandia.gov
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#include "fix_checkpoint.h"
+
+#include "atom.h"
+#include "atom_vec.h"
+#include "comm.h"
+#include "domain.h"
+#include "error.h"
+#include "irregular.h"
+#include "memory.h"
+#include "modify.h"
+#include "special.h"
+#include "update.h"
+
+#include <cstdlib>
+#include <cstring>
+
+using namespace LAMMPS_NS;
+using namespace FixConst;
+
+/* ---------------------------------------------------------------------- */
+
+FixCheckpoint::FixCheckpoint(LAMMPS *lmp, int narg, char **arg) :
+  Fix(lmp, narg, arg),
+  global(nullptr), buf(nullptr), buddy(nullptr)
+{
+  if (narg != 4) error->all(FLERR,"Illegal fix CHECKPOINT command");
+
+  MPI_Comm_rank(world,&me);
+  MPI_Comm_size(world,&nprocs);
+  name = arg[3];
+
+  // buddy copies are sent asynchronously and may still be in flight
+  //   when other point-to-point messages are exchanged on world
+
+  MPI_Comm_dup(world,&buddycomm);
+
+  ntimestep = atimestep = 0;
+  atime = 0.0;
+  nglobal = 0;
+  nbuf = maxbuf = 0;
+  nbuddy = maxbuddy = 0;
+  hasbuddy = 0;
+  nrequest = 0;
+}
+
+/* ---------------------------------------------------------------------- */
+
+FixCheckpoint::~FixCheckpoint()
+{
+  wait_buddy();
+  MPI_Comm_free(&buddycomm);
+
+  delete [] global;
+  memory->destroy(buf);
+  memory->destroy(buddy);
+}
+
+/* ---------------------------------------------------------------------- */
+
+int FixCheckpoint::setmask()
+{
+  int mask = 0;
+  return mask;
+}
+
+/* ----------------------------------------------------------------------
+   store current state of the system in memory
+   if buddyflag set, also send a copy of my data to proc me+1
+------------------------------------------------------------------------- */
+
+void FixCheckpoint::save(int buddyflag)
+{
+  wait_buddy();
+
+  // global state
+
+  ntimestep = update->ntimestep;
+  atimestep = update->atimestep;
+  atime = update->atime;
+
+  natoms = atom->natoms;
+  nbonds = atom->nbonds;
+  nangles = atom->nangles;
+  ndihedrals = atom->ndihedrals;
+  nimpropers = atom->nimpropers;
+
+  for (int i = 0; i < 3; i++) {
+    boxlo[i] = domain->boxlo[i];
+    boxhi[i] = domain->boxhi[i];
+  }
+  xy = domain->xy;
+  xz = domain->xz;
+  yz = domain->yz;
+
+  atom_style = atom->atom_style;
+  peratom_fixes.clear();
+  for (int iextra = 0; iextra < atom->nextra_restart; iextra++)
+    peratom_fixes.push_back(modify->fix[atom->extra_restart[iextra]]->id);
+
+  save_global();
+
+  // per-atom state, including per-atom restart info of fixes
+
+  double *lo,*hi;
+  if (domain->triclinic == 0) {
+    lo = domain->sublo;
+    hi = domain->subhi;
+  } else {
+    lo = domain->sublo_lamda;
+    hi = domain->subhi_lamda;
+  }
+  for (int i = 0; i < 3; i++) {
+    sublo[i] = lo[i];
+    subhi[i] = hi[i];
+  }
+
+  AtomVec *avec = atom->avec;
+  int nlocal = atom->nlocal;
+
+  bigint n = 1 + (bigint) avec->size_restart();
+  if (n > MAXSMALLINT) error->one(FLERR,"Too much per-proc data for checkpoint");
+  if (n > maxbuf) {
+    maxbuf = n;
+    memory->destroy(buf);
+    memory->create(buf,maxbuf,"checkpoint:buf");
+  }
+
+  int m = 1;
+  buf[0] = ubuf(nlocal).d;
+  for (int i = 0; i < nlocal; i++) m += avec->pack_restart(i,&buf[m]);
+  nbuf = m;
+
+  // replicate my data on proc me+1 and receive the data of proc me-1
+  // the transfer completes in the background, wait_buddy() finishes it
+
+  hasbuddy = buddyflag;
+  if (!buddyflag) return;
+
+  int next = (me+1) % nprocs;
+  int prev = (me+nprocs-1) % nprocs;
+
+  MPI_Sendrecv(&nbuf,1,MPI_INT,next,0,&nbuddy,1,MPI_INT,prev,0,
+               buddycomm,MPI_STATUS_IGNORE);
+  if (nbuddy > maxbuddy) {
+    maxbuddy = nbuddy;
+    memory->destroy(buddy);
+    memory->create(buddy,maxbuddy,"checkpoint:buddy");
+  }
+
+  MPI_Irecv(buddy,nbuddy,MPI_DOUBLE,prev,0,buddycomm,&requests[0]);
+  MPI_Isend(buf,nbuf,MPI_DOUBLE,next,0,buddycomm,&requests[1]);
+  nrequest = 2;
+}
+
+/* ----------------------------------------------------------------------
+   reset system to the stored state
+   if buddyflag set, each proc restores the copy of proc me-1's data
+   if stepflag set, also reset the timestep
+------------------------------------------------------------------------- */
+
+void FixCheckpoint::restore(int buddyflag, int stepflag)
+{
+  wait_buddy();
+
+  if (buddyflag && !hasbuddy)
+    error->all(FLERR,fmt::format("Checkpoint {} was not saved with "
+                                 "a buddy copy",name));
+  if (atom_style != atom->atom_style)
+    error->all(FLERR,fmt::format("Checkpoint {} was saved with a "
+                                 "different atom style",name));
+
+  int flag = ((int) peratom_fixes.size() != atom->nextra_restart);
+  for (int iextra = 0; !flag && iextra < atom->nextra_restart; iextra++)
+    if (peratom_fixes[iextra] != modify->fix[atom->extra_restart[iextra]]->id)
+      flag = 1;
+  if (flag)
+    error->all(FLERR,fmt::format("Checkpoint {} was saved with different "
+                                 "per-atom restart fixes",name));
+
+  // global state
+
+  if (stepflag) {
+    if (update->ntimestep != ntimestep) update->reset_timestep(ntimestep);
+    update->atimestep = atimestep;
+    update->atime = atime;
+  }
+
+  atom->natoms = natoms;
+  atom->nbonds = nbonds;
+  atom->nangles = nangles;
+  atom->ndihedrals = ndihedrals;
+  atom->nimpropers = nimpropers;
+
+  for (int i = 0; i < 3; i++) {
+    domain->boxlo[i] = boxlo[i];
+    domain->boxhi[i] = boxhi[i];
+  }
+  domain->xy = xy;
+  domain->xz = xz;
+  domain->yz = yz;
+
+  domain->set_initial_box(0);
+  domain->set_global_box();
+  domain->set_local_box();
+
+  restore_global();
+
+  // per-atom state
+
+  clear_atoms();
+  if (buddyflag) unpack_atoms(buddy);
+  else unpack_atoms(buf);
+
+  // atoms must migrate if they were restored from the buddy copy
+  //   or if the sub-domains changed since the checkpoint was saved
+  // otherwise every proc gets back its atoms in the original order
+
+  double *lo,*hi;
+  if (domain->triclinic == 0) {
+    lo = domain->sublo;
+    hi = domain->subhi;
+  } else {
+    lo = domain->sublo_lamda;
+    hi = domain->subhi_lamda;
+  }
+
+  flag = buddyflag;
+  for (int i = 0; i < 3; i++)
+    if (lo[i] != sublo[i] || hi[i] != subhi[i]) flag = 1;
+
+  int flagall;
+  MPI_Allreduce(&flag,&flagall,1,MPI_INT,MPI_MAX,world);
+
+  if (flagall) {
+    if (atom->map_style != Atom::MAP_NONE) {
+      atom->map_init();
+      atom->map_set();
+    }
+    if (domain->triclinic) domain->x2lamda(atom->nlocal);
+    Irregular *irregular = new Irregular(lmp);
+    irregular->migrate_atoms(1);
+    delete irregular;
+    if (domain->triclinic) domain->lamda2x(atom->nlocal);
+  }
+
+  bigint nblocal = atom->nlocal;
+  bigint natoms_restored;
+  MPI_Allreduce(&nblocal,&natoms_restored,1,MPI_LMP_BIGINT,MPI_SUM,world);
+  if (natoms_restored != atom->natoms)
+    error->all(FLERR,"Did not assign all checkpoint atoms correctly");
+
+  if (atom->map_style != Atom::MAP_NONE) {
+    atom->map_init();
+    atom->map_set();
+  }
+
+  if (atom->molecular == Atom::MOLECULAR) {
+    Special special(lmp);
+    special.build();
+  }
+}
+
+/* ----------------------------------------------------------------------
+   complete pending transfer of buddy copy
+------------------------------------------------------------------------- */
+
+void FixCheckpoint::wait_buddy()
+{
+  if (nrequest == 0) return;
+  MPI_Waitall(nrequest,requests,MPI_STATUSES_IGNORE);
+  nrequest = 0;
+}
+
+/* ----------------------------------------------------------------------
+   collect global state of fixes in the same format as a restart file
+   fix write_restart() writes to a FILE, so proc 0 captures it in memory
+------------------------------------------------------------------------- */
+
+void FixCheckpoint::save_global()
+{
+  FILE *fp = nullptr;
+  char *ptr = nullptr;
+  size_t size = 0;
+
+  if (me == 0) {
+#if defined(_WIN32)
+    fp = tmpfile();
+#else
+    fp = open_memstream(&ptr,&size);
+#endif
+    if (fp == nullptr)
+      error->one(FLERR,"Could not capture fix state for checkpoint");
+  }
+
+  int n;
+  int count = 0;
+  for (int i = 0; i < modify->nfix; i++)
+    if (modify->fix[i]->restart_global) count++;
+  if (me == 0) fwrite(&count,sizeof(int),1,fp);
+
+  for (int i = 0; i < modify->nfix; i++)
+    if (modify->fix[i]->restart_global) {
+      if (me == 0) {
+        n = strlen(modify->fix[i]->id) + 1;
+        fwrite(&n,sizeof(int),1,fp);
+        fwrite(modify->fix[i]->id,sizeof(char),n,fp);
+        n = strlen(modify->fix[i]->style) + 1;
+        fwrite(&n,sizeof(int),1,fp);
+        fwrite(modify->fix[i]->style,sizeof(char),n,fp);
+      }
+      modify->fix[i]->write_restart(fp);
+    }
+
+  delete [] global;
+  global = nullptr;
+
+  if (me == 0) {
+#if defined(_WIN32)
+    nglobal = ftell(fp);
+    rewind(fp);
+    global = new char[nglobal];
+    utils::sfread(FLERR,global,sizeof(char),nglobal,fp,nullptr,error);
+    fclose(fp);
+#else
+    fclose(fp);
+    nglobal = size;
+    global = new char[nglobal];
+    memcpy(global,ptr,nglobal);
+    free(ptr);
+#endif
+  }
+
+  MPI_Bcast(&nglobal,1,MPI_INT,0,world);
+  if (me) global = new char[nglobal];
+  MPI_Bcast(global,nglobal,MPI_CHAR,0,world);
+}
+
+/* ----------------------------------------------------------------------
+   pass stored global state to fixes with matching ID and style
+------------------------------------------------------------------------- */
+
+void FixCheckpoint::restore_global()
+{
+  char *ptr = global;
+  int count,n;
+
+  memcpy(&count,ptr,sizeof(int));
+  ptr += sizeof(int);
+
+  for (int i = 0; i < count; i++) {
+    memcpy(&n,ptr,sizeof(int));
+    ptr += sizeof(int);
+    char *fixid = ptr;
+    ptr += n;
+    memcpy(&n,ptr,sizeof(int));
+    ptr += sizeof(int);
+    char *fixstyle = ptr;
+    ptr += n;
+    memcpy(&n,ptr,sizeof(int));
+    ptr += sizeof(int);
+
+    // copy state so fixes can access it with proper alignment
+
+    int ifix = modify->find_fix(fixid);
+    if (ifix >= 0 && strcmp(modify->fix[ifix]->style,fixstyle) == 0) {
+      char *state = new char[n];
+      memcpy(state,ptr,n);
+      modify->fix[ifix]->restart(state);
+      delete [] state;
+    }
+    ptr += n;
+  }
+}
+
+/* ----------------------------------------------------------------------
+   delete all owned and ghost atoms of this proc
+------------------------------------------------------------------------- */
+
+void FixCheckpoint::clear_atoms()
+{
+  AtomVec *avec = atom->avec;
+
+  if (atom->map_style != Atom::MAP_NONE) atom->map_clear();
+
+  // self-copy with delflag set releases the bonus data of an atom
+
+  if (avec->bonus_flag) {
+    avec->clear_bonus();
+    for (int i = atom->nlocal-1; i >= 0; i--) avec->copy(i,i,1);
+  }
+
+  atom->nlocal = 0;
+  atom->nghost = 0;
+}
+
+/* ----------------------------------------------------------------------
+   append atoms stored in data to my atoms
+   per-atom restart info of fixes goes through atom->extra as in read_restart
+------------------------------------------------------------------------- */
+
+void FixCheckpoint::unpack_atoms(double *data)
+{
+  AtomVec *avec = atom->avec;
+  int n = (int) ubuf(data[0]).i;
+
+  if (atom->nextra_store) {
+    memory->destroy(atom->extra);
+    atom->nextra_store = 0;
+  }
+
+  int nextra = 0;
+  for (int iextra = 0; iextra < atom->nextra_restart; iextra++)
+    nextra += modify->fix[atom->extra_restart[iextra]]->maxsize_restart();
+
+  if (n > atom->nmax) avec->grow(n);
+  if (nextra) {
+    atom->nextra_store = nextra;
+    memory->create(atom->extra,atom->nmax,nextra,"atom:extra");
+  }
+
+  int m = 1;
+  for (int i = 0; i < n; i++) m += avec->unpack_restart(&data[m]);
+
+  if (nextra) {
+    int nlocal = atom->nlocal;
+    for (int iextra = 0; iextra < atom->nextra_restart; iextra++) {
+      Fix *fix = modify->fix[atom->extra_restart[iextra]];
+      for (int i = 0; i < nlocal; i++) fix->unpack_restart(i,iextra);
+    }
+    memory->destroy(atom->extra);
+    atom->nextra_store = 0;
+  }
+}
+
+/* ----------------------------------------------------------------------
+   memory usage of stored state
+------------------------------------------------------------------------- */
+
+double FixCheckpoint::memory_usage()
+{
+  double bytes = (double) maxbuf * sizeof(double);
+  bytes += (double) maxbuddy * sizeof(double);
+  bytes += (double) nglobal;
+  return bytes;
+}
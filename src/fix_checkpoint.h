@@ -0,0 +1,111 @@
+/* -*- c++ -*- ----------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://lammps.sandia.gov/, Sandia National Laboratories
+   Steve Plimpton, sjplimp@sandia.gov
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#ifdef FIX_CLASS
+
+FixStyle(CHECKPOINT,FixCheckpoint)
+
+#else
+
+#ifndef LMP_FIX_CHECKPOINT_H
+#define LMP_FIX_CHECKPOINT_H
+
+#include "fix.h"
+
+#include <vector>
+
+namespace LAMMPS_NS {
+
+class FixCheckpoint : public Fix {
+ public:
+  FixCheckpoint(class LAMMPS *, int, char **);
+  ~FixCheckpoint();
+  int setmask();
+  double memory_usage();
+
+  void save(int);
+  void restore(int, int);
+
+ private:
+  int me,nprocs;
+  std::string name;          // name of checkpoint
+  MPI_Comm buddycomm;        // private communicator for buddy messages
+
+  // global state, identical on all procs
+
+  bigint ntimestep,atimestep;
+  double atime;
+  bigint natoms,nbonds,nangles,ndihedrals,nimpropers;
+  double boxlo[3],boxhi[3],xy,xz,yz;
+  std::string atom_style;
+  std::vector<std::string> peratom_fixes;   // IDs of fixes in atom->extra_restart
+
+  int nglobal;               // # of bytes of global fix state
+  char *global;              // global fix state in restart file format
+
+  // per-proc state
+
+  double sublo[3],subhi[3];  // my sub-domain when checkpoint was saved
+  int nbuf,maxbuf;
+  double *buf;               // # of my atoms followed by their restart data
+
+  int hasbuddy;              // 1 if buddy holds a copy of my data
+  int nbuddy,maxbuddy;
+  double *buddy;             // copy of the data of proc me-1
+  int nrequest;
+  MPI_Request requests[2];
+
+  void wait_buddy();
+  void save_global();
+  void restore_global();
+  void clear_atoms();
+  void unpack_atoms(double *);
+};
+
+}
+
+#endif
+#endif
+
+/* ERROR/WARNING messages:
+
+E: Too much per-proc data for checkpoint
+
+The restart data of the atoms owned by one processor exceeds the size
+that can be stored in a single buffer.  Use more processors.
+
+E: Checkpoint %s was not saved with a buddy copy
+
+The buddy keyword of the checkpoint restore command requires that the
+checkpoint was saved with "buddy yes".
+
+E: Checkpoint %s was saved with a different atom style
+
+The atom style was changed after the checkpoint was saved.
+
+E: Checkpoint %s was saved with different per-atom restart fixes
+
+Fixes which store per-atom information in restart files were added or
+removed after the checkpoint was saved.  Their state can only be
+restored if the same fixes are defined.
+
+E: Could not capture fix state for checkpoint
+
+The temporary memory stream used to collect the global state of fixes
+could not be created.
+
+E: Did not assign all checkpoint atoms correctly
+
+Atoms were lost when restoring the checkpoint.  This should not happen.
+
+*/
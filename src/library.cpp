@@ -20,6 +20,7 @@
 
 #include "atom.h"
 #include "atom_vec.h"
+#include "checkpoint.h"
 #include "comm.h"
 #include "compute.h"
 #include "domain.h"
@@ -722,6 +723,66 @@ void lammps_reset_box(void *handle, double *boxlo, double *boxhi,
 
 /* ---------------------------------------------------------------------- */
 
+/** Save the current state of the simulation in memory.
+
+\verbatim embed:rst
+
+This function does the same as the :doc:`checkpoint save <checkpoint>`
+command.  Per-atom data, box, timestep and the restart information of
+fixes are stored in a per-processor memory buffer under the given name,
+replacing a previous checkpoint with the same name.
+
+\endverbatim
+ *
+ * \param  handle  pointer to a previously created LAMMPS instance
+ * \param  name    name of the checkpoint
+ * \param  buddy   1 to also keep a copy of each processor's data
+ *                 on the next processor, 0 otherwise */
+
+void lammps_checkpoint_save(void *handle, const char *name, int buddy)
+{
+  LAMMPS *lmp = (LAMMPS *) handle;
+
+  BEGIN_CAPTURE
+  {
+    Checkpoint checkpoint(lmp);
+    checkpoint.save(name,buddy);
+  }
+  END_CAPTURE
+}
+
+/* ---------------------------------------------------------------------- */
+
+/** Reset the simulation to a state saved in memory.
+
+\verbatim embed:rst
+
+This function does the same as the :doc:`checkpoint restore
+<checkpoint>` command including the timestep.  When LAMMPS is compiled
+with exceptions, it can be used to resume from the last checkpoint
+after a command failed with a recoverable error.
+
+\endverbatim
+ *
+ * \param  handle  pointer to a previously created LAMMPS instance
+ * \param  name    name of the checkpoint
+ * \param  buddy   1 to restore from the copies held by the next
+ *                 processors, 0 to restore from the own data */
+
+void lammps_checkpoint_restore(void *handle, const char *name, int buddy)
+{
+  LAMMPS *lmp = (LAMMPS *) handle;
+
+  BEGIN_CAPTURE
+  {
+    Checkpoint checkpoint(lmp);
+    checkpoint.restore(name,buddy,1);
+  }
+  END_CAPTURE
+}
+
+/* ---------------------------------------------------------------------- */
+
 /** Get memory usage information
  *
 \verbatim embed:rst
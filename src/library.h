@@ -120,6 +120,8 @@ void lammps_extract_box(void *handle, double *boxlo, double *boxhi,
 void lammps_reset_box(void *handle, double *boxlo, double *boxhi,
                       double xy, double yz, double xz);
 
+void lammps_checkpoint_save(void *handle, const char *name, int buddy);
+void lammps_checkpoint_restore(void *handle, const char *name, int buddy);
 void lammps_memory_usage(void *handle, double *meminfo);
 int  lammps_get_mpi_comm(void *handle);
 
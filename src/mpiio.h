@@ -38,10 +38,12 @@ class RestartMPIIO {
 
   RestartMPIIO(class LAMMPS *) {mpiio_exists = 0;}
   ~RestartMPIIO() {}
+  void set_aggregators(int) {}
   void openForRead(const char *) {}
   void openForWrite(const char *) {}
-  void write(MPI_Offset,int,double *) {}
+  void write(MPI_Offset,int,double *,long) {}
   void read(MPI_Offset,long,double *) {}
+  void verify(MPI_Offset,long,MPI_Offset,long,double *,long) {}
   void close() {}
 };
 
@@ -17,6 +17,7 @@
 #include "comm.h"
 #include "neighbor.h"
 #include "neigh_request.h"
+#include "neigh_shell.h"
 #include "my_page.h"
 #include "memory.h"
 
@@ -59,6 +60,7 @@ NeighList::NeighList(LAMMPS *lmp) : Pointers(lmp)
   listfull = nullptr;
 
   fix_bond = nullptr;
+  shell = nullptr;
 
   ipage = nullptr;
 
@@ -119,6 +121,7 @@ NeighList::~NeighList()
 
   delete [] iskip;
   memory->destroy(ijskip);
+  delete shell;
 }
 
 /* ----------------------------------------------------------------------
@@ -193,6 +196,20 @@ void NeighList::setup_pages(int pgsize_caller, int oneatom_caller)
   }
 }
 
+/* ----------------------------------------------------------------------
+   return nearest-neighbor shells of the atoms in this list
+   a copy list uses the shells of the list it copies from,
+     so all computes with identical lists share one instance
+   created on first call, only meaningful for full lists
+------------------------------------------------------------------------- */
+
+NeighShell *NeighList::get_shell()
+{
+  if (copy && listcopy && !kk2cpu) return listcopy->get_shell();
+  if (!shell) shell = new NeighShell(lmp,this);
+  return shell;
+}
+
 /* ----------------------------------------------------------------------
    grow per-atom data to allow for nlocal/nall atoms
    triggered by neighbor list build
@@ -328,5 +345,7 @@ double NeighList::memory_usage()
     }
   }
 
+  if (shell) bytes += shell->memory_usage();
+
   return bytes;
 }
@@ -89,6 +89,8 @@ class NeighList : protected Pointers {
 
   class Fix *fix_bond;          // fix that stores bond info
 
+  class NeighShell *shell;      // sorted nearest neighbors, see get_shell()
+
   // Kokkos package
 
   int kokkos;                   // 1 if list stores Kokkos data
@@ -107,6 +109,7 @@ class NeighList : protected Pointers {
   void grow(int,int);                   // grow all data structs
   void print_attributes();              // debug routine
   int get_maxlocal() {return maxatom;}
+  class NeighShell *get_shell();        // shared nearest-neighbor shells
   double memory_usage();
 };
 
@@ -0,0 +1,147 @@
+/* ----------------------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://lammps.sandia.gov/, Sandia National Laboratories
+   Steve Plimpton, sjplimp@sandia.gov
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#include "neigh_shell.h"
+
+#include "atom.h"
+#include "memory.h"
+#include "neigh_list.h"
+#include "neighbor.h"
+#include "update.h"
+
+#include <algorithm>
+
+using namespace LAMMPS_NS;
+
+/* ---------------------------------------------------------------------- */
+
+NeighShell::NeighShell(LAMMPS *lmp, NeighList *ptr) : Pointers(lmp)
+{
+  list = ptr;
+  maxshell = 0;
+  nmax = ncol = 0;
+  last_step = last_ncalls = -1;
+
+  numshell = nullptr;
+  shell = nullptr;
+  rsqshell = nullptr;
+
+  candidates = nullptr;
+  maxneigh = 0;
+}
+
+/* ---------------------------------------------------------------------- */
+
+NeighShell::~NeighShell()
+{
+  memory->destroy(numshell);
+  memory->destroy(shell);
+  memory->destroy(rsqshell);
+  memory->sfree(candidates);
+}
+
+/* ----------------------------------------------------------------------
+   a compute requests the N nearest neighbors of each atom
+   called from init_list(), the shell stores the max of all requests
+------------------------------------------------------------------------- */
+
+void NeighShell::request(int n)
+{
+  if (n > maxshell) {
+    maxshell = n;
+    last_step = -1;
+  }
+}
+
+/* ----------------------------------------------------------------------
+   select and sort the maxshell nearest neighbors of each I atom
+   neighbor list must be current, i.e. built with build_one() before
+   only done once per timestep and reneighboring, since atoms cannot
+     move in between, later calls return immediately
+------------------------------------------------------------------------- */
+
+void NeighShell::build()
+{
+  if (last_step == update->ntimestep && last_ncalls == neighbor->ncalls)
+    return;
+  last_step = update->ntimestep;
+  last_ncalls = neighbor->ncalls;
+
+  if (atom->nmax > nmax || maxshell > ncol) {
+    memory->destroy(numshell);
+    memory->destroy(shell);
+    memory->destroy(rsqshell);
+    nmax = MAX(nmax,atom->nmax);
+    ncol = maxshell;
+    memory->create(numshell,nmax,"neigh_shell:numshell");
+    memory->create(shell,nmax,ncol,"neigh_shell:shell");
+    memory->create(rsqshell,nmax,ncol,"neigh_shell:rsqshell");
+  }
+
+  double **x = atom->x;
+  int inum = list->inum;
+  int *ilist = list->ilist;
+  int *numneigh = list->numneigh;
+  int **firstneigh = list->firstneigh;
+
+  for (int ii = 0; ii < inum; ii++) {
+    int i = ilist[ii];
+    const double xtmp = x[i][0];
+    const double ytmp = x[i][1];
+    const double ztmp = x[i][2];
+    int *jlist = firstneigh[i];
+    int jnum = numneigh[i];
+
+    if (jnum > maxneigh) {
+      maxneigh = jnum;
+      memory->sfree(candidates);
+      candidates = (ShellNeigh *)
+        memory->smalloc(maxneigh*sizeof(ShellNeigh),"neigh_shell:candidates");
+    }
+
+    for (int jj = 0; jj < jnum; jj++) {
+      int j = jlist[jj] & NEIGHMASK;
+      double delx = xtmp - x[j][0];
+      double dely = ytmp - x[j][1];
+      double delz = ztmp - x[j][2];
+      candidates[jj].rsq = delx*delx + dely*dely + delz*delz;
+      candidates[jj].j = j;
+    }
+
+    // only the nearest maxshell neighbors are sorted
+    // ties in distance are ordered by index so the order is reproducible
+
+    int n = MIN(jnum,maxshell);
+    std::partial_sort(candidates,candidates+n,candidates+jnum,
+                      [](const ShellNeigh &a, const ShellNeigh &b) {
+                        return (a.rsq < b.rsq) || (a.rsq == b.rsq && a.j < b.j);
+                      });
+
+    numshell[i] = n;
+    for (int k = 0; k < n; k++) {
+      shell[i][k] = candidates[k].j;
+      rsqshell[i][k] = candidates[k].rsq;
+    }
+  }
+}
+
+/* ---------------------------------------------------------------------- */
+
+double NeighShell::memory_usage()
+{
+  double bytes = memory->usage(numshell,nmax);
+  bytes += memory->usage(shell,nmax,ncol);
+  bytes += memory->usage(rsqshell,nmax,ncol);
+  bytes += (double)maxneigh * sizeof(ShellNeigh);
+  return bytes;
+}
@@ -0,0 +1,56 @@
+/* -*- c++ -*- ----------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://lammps.sandia.gov/, Sandia National Laboratories
+   Steve Plimpton, sjplimp@sandia.gov
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#ifndef LMP_NEIGH_SHELL_H
+#define LMP_NEIGH_SHELL_H
+
+#include "pointers.h"
+
+namespace LAMMPS_NS {
+
+// nearest neighbors of each owned atom of a full neighbor list,
+//   sorted by distance, shared by all computes that use the list
+//   or a copy of it, so they are selected once per timestep
+
+class NeighShell : protected Pointers {
+ public:
+  int *numshell;             // # of nearest neighbors stored for each I atom
+  int **shell;               // local indices of nearest neighbors of I atom
+  double **rsqshell;         // distance sq to each nearest neighbor
+
+  NeighShell(class LAMMPS *, class NeighList *);
+  ~NeighShell();
+  void request(int);
+  void build();
+  int get_maxshell() const { return maxshell; }
+  double memory_usage();
+
+ private:
+  class NeighList *list;
+  int maxshell;              // max # of nearest neighbors requested
+  int nmax;                  // # of rows in per-atom arrays
+  int ncol;                  // # of columns in per-atom arrays
+  bigint last_step;          // timestep of last build
+  bigint last_ncalls;        // # of reneighborings at last build
+
+  struct ShellNeigh {
+    double rsq;
+    int j;
+  };
+  ShellNeigh *candidates;    // all neighbors of one I atom
+  int maxneigh;
+};
+
+}
+
+#endif
@@ -1217,13 +1217,19 @@ void Neighbor::morph_copy()
 
       if (jrq->copy && jrq->copylist == i) continue;
 
-      // other list (jrq) to copy from must be perpetual
+      // other list (jrq) to copy from must be perpetual,
+      //   or occasional if the list that becomes a copy list (irq) is too
+      //   and both are requested by computes,
+      //   so identical occasional lists of several computes are built once
+      // fixes can build occasional lists before reneighboring on a step,
+      //   a copy of such a list would not be rebuilt after reneighboring
       // list that becomes a copy list (irq) can be perpetual or occasional
-      // if both lists are perpetual, require j < i
+      // if both lists are perpetual or both are occasional, require j < i
       //   to prevent circular dependence with 3 or more copies of a list
 
-      if (jrq->occasional) continue;
-      if (!irq->occasional && j > i) continue;
+      if (jrq->occasional && !irq->occasional) continue;
+      if (jrq->occasional && !(irq->compute && jrq->compute)) continue;
+      if (irq->occasional == jrq->occasional && j > i) continue;
 
       // both lists must be half, or both full
 
@@ -48,8 +48,13 @@ using namespace LAMMPS_NS;
 #define MAXLINE 256
 #define LB_FACTOR 1.1
 #define CHUNK 1024
+#define PCHUNK 16384       // # of lines read per proc in parallel mode
+#define SCANBLOCK 1048576  // block size for counting lines
+#define RVOUS 1            // 0 for irregular, 1 for all2all
 #define DELTA 4            // must be 2 or larger
 #define MAXBODY 32         // max # of lines in one body
+#define BINARY_VERSION 1         // also in WriteData
+#define BINARY_MAGIC 0x4c4d5044  // also in WriteData
 
                            // customize for new sections
 #define NSECTIONS 25       // change when add to header::section_keywords
@@ -77,6 +82,18 @@ ReadData::ReadData(LAMMPS *lmp) : Pointers(lmp)
   arg = nullptr;
   fp = nullptr;
 
+  nreader = 0;
+  myreader = -1;
+  filename = nullptr;
+  fpsection = nullptr;
+  pbuffer = rbuffer = nullptr;
+  maxrbuf = 0;
+  binary = 0;
+  dbuffer = nullptr;
+  maxdbuf = 0;
+  nowner = 0;
+  owner = nullptr;
+
   // customize for new sections
   // pointers to atom styles that store bonus info
 
@@ -99,6 +116,10 @@ ReadData::~ReadData()
   delete [] style;
   delete [] buffer;
   memory->sfree(arg);
+  memory->destroy(pbuffer);
+  memory->destroy(rbuffer);
+  memory->destroy(dbuffer);
+  memory->destroy(owner);
 
   for (int i = 0; i < nfix; i++) {
     delete [] fix_header[i];
@@ -130,6 +151,7 @@ void ReadData::command(int narg, char **arg)
     extra_dihedral_types = extra_improper_types = 0;
 
   groupbit = 0;
+  nreader = 0;
 
   nfix = 0;
   fix_index = nullptr;
@@ -288,10 +310,38 @@ void ReadData::command(int narg, char **arg)
       strcpy(fix_section[nfix],arg[iarg+3]);
       nfix++;
       iarg += 4;
+    } else if (strcmp(arg[iarg],"parallel") == 0) {
+      if (iarg+2 > narg) error->all(FLERR,"Illegal read_data command");
+      nreader = utils::inumeric(FLERR,arg[iarg+1],false,lmp);
+      if (nreader < 0) error->all(FLERR,"Illegal read_data command");
+      iarg += 2;
 
     } else error->all(FLERR,"Illegal read_data command");
   }
 
+  // setup procs which read sections in parallel
+  // readers are spread evenly across procs
+
+  if (nreader && utils::strmatch(arg[0],"\\.gz$")) {
+    if (me == 0)
+      error->warning(FLERR,"Cannot read compressed data file in parallel");
+    nreader = 0;
+  }
+  if (nreader && atom->avec->bonus_flag) {
+    if (me == 0)
+      error->warning(FLERR,"Cannot read data file in parallel with bonus data");
+    nreader = 0;
+  }
+
+  if (nreader) {
+    nreader = MIN(nreader,comm->nprocs);
+    for (int i = 0; i < nreader; i++)
+      if (i*comm->nprocs/nreader == me) myreader = i;
+    filename = arg[0];
+    if (myreader >= 0)
+      memory->create(pbuffer,PCHUNK*MAXLINE,"read_data:pbuffer");
+  }
+
   // error checks
 
   if ((domain->dimension == 2) && (domain->zperiodic == 0))
@@ -515,11 +565,13 @@ void ReadData::command(int narg, char **arg)
             error->warning(FLERR,"Atom style in data file differs "
                            "from currently defined atom style");
           atoms();
-        } else skip_lines(natoms);
+        } else if (binary) skip_binary();
+        else skip_lines(natoms);
       } else if (strcmp(keyword,"Velocities") == 0) {
         if (atomflag == 0)
           error->all(FLERR,"Must read Atoms before Velocities");
         if (firstpass) velocities();
+        else if (binary) skip_binary();
         else skip_lines(natoms);
 
       } else if (strcmp(keyword,"Bonds") == 0) {
@@ -929,6 +981,7 @@ void ReadData::header(int firstpass)
     atom->ndihedraltypes = extra_dihedral_types;
     atom->nimpropertypes = extra_improper_types;
   }
+  binary = 0;
 
   // customize for new sections
 
@@ -993,7 +1046,18 @@ void ReadData::header(int firstpass)
     int extra_flag_value = 0;
     int rv;
 
-    if (utils::strmatch(line,"^\\s*\\d+\\s+atoms\\s")) {
+    if (utils::strmatch(line,"^\\s*\\d+\\s+binary\\s+format\\s")) {
+      rv = sscanf(line,"%d",&binary);
+      if (rv != 1)
+        error->all(FLERR,"Could not parse 'binary format' line "
+                   "in data file header");
+      if (binary != BINARY_VERSION)
+        error->all(FLERR,fmt::format("Unsupported binary format {} "
+                                     "in data file",binary));
+      if (lmp->kokkos)
+        error->all(FLERR,"Cannot read binary data file with KOKKOS package");
+
+    } else if (utils::strmatch(line,"^\\s*\\d+\\s+atoms\\s")) {
       rv = sscanf(line,BIGINT_FORMAT,&natoms);
       if (rv != 1)
         error->all(FLERR,"Could not parse 'atoms' line in data file header");
@@ -1215,14 +1279,77 @@ void ReadData::atoms()
 
   if (me == 0) utils::logmesg(lmp,"  reading atoms ...\n");
 
-  bigint nread = 0;
+  // parallel: each reader keeps all atoms it reads,
+  //   then new atoms migrate to owning procs, existing atoms stay
+
+  if (nreader) {
+    int imageflags = 0;
+    if (binary) {
+      binary_open(natoms,atom->avec->size_data_atom+3);
+      while (binary_chunk(nchunk))
+        if (nchunk)
+          imageflags |= atom->data_atoms_binary(nchunk,dbuffer,id_offset,
+                                                mol_offset,toffset,
+                                                shiftflag,shift,1);
+    } else {
+      section_open(natoms);
+      while (section_chunk(nchunk))
+        if (nchunk)
+          imageflags |= atom->data_atoms(nchunk,pbuffer,id_offset,mol_offset,
+                                         toffset,shiftflag,shift,1);
+    }
+    section_close();
 
-  while (nread < natoms) {
-    nchunk = MIN(natoms-nread,CHUNK);
-    eof = comm->read_lines_from_file(fp,nchunk,MAXLINE,buffer);
-    if (eof) error->all(FLERR,"Unexpected end of data file");
-    atom->data_atoms(nchunk,buffer,id_offset,mol_offset,toffset,shiftflag,shift);
-    nread += nchunk;
+    // image flags reset by any reader
+
+    int allflags;
+    MPI_Allreduce(&imageflags,&allflags,1,MPI_INT,MPI_BOR,world);
+    atom->data_image_warnings(allflags);
+
+    double **x = atom->x;
+    int nlocal = atom->nlocal;
+    int *procassign;
+    memory->create(procassign,nlocal,"read_data:procassign");
+
+    int igx,igy,igz;
+    double lamda[3];
+    comm->coord2proc_setup();
+    for (int i = 0; i < nlocal; i++) {
+      if (i < nlocal_previous) procassign[i] = me;
+      else if (domain->triclinic) {
+        domain->x2lamda(x[i],lamda);
+        procassign[i] = comm->coord2proc(lamda,igx,igy,igz);
+      } else procassign[i] = comm->coord2proc(x[i],igx,igy,igz);
+    }
+
+    // migrate_atoms() clears and resets the map, so it must exist
+
+    if (atom->map_style != Atom::MAP_NONE) {
+      atom->map_init();
+      atom->map_set();
+    }
+
+    Irregular *irregular = new Irregular(lmp);
+    irregular->migrate_atoms(1,1,procassign);
+    delete irregular;
+    memory->destroy(procassign);
+
+  } else if (binary) {
+    binary_open(natoms,atom->avec->size_data_atom+3);
+    while (binary_chunk(nchunk))
+      atom->data_atoms_binary(nchunk,dbuffer,id_offset,mol_offset,toffset,
+                              shiftflag,shift);
+
+  } else {
+    bigint nread = 0;
+
+    while (nread < natoms) {
+      nchunk = MIN(natoms-nread,CHUNK);
+      eof = comm->read_lines_from_file(fp,nchunk,MAXLINE,buffer);
+      if (eof) error->all(FLERR,"Unexpected end of data file");
+      atom->data_atoms(nchunk,buffer,id_offset,mol_offset,toffset,shiftflag,shift);
+      nread += nchunk;
+    }
   }
 
   // check that all atoms were assigned correctly
@@ -1271,14 +1398,53 @@ void ReadData::velocities()
     atom->map_set();
   }
 
-  bigint nread = 0;
+  // binary: each row is routed to the owner of its atom if parallel
 
-  while (nread < natoms) {
-    nchunk = MIN(natoms-nread,CHUNK);
-    eof = comm->read_lines_from_file(fp,nchunk,MAXLINE,buffer);
-    if (eof) error->all(FLERR,"Unexpected end of data file");
-    atom->data_vels(nchunk,buffer,id_offset);
-    nread += nchunk;
+  if (binary) {
+    binary_open(natoms,atom->avec->size_data_vel);
+    while (binary_chunk(nchunk)) {
+      if (nreader) {
+        int nrecv = route_rows(nchunk,dbuffer,atom->avec->size_data_vel,0,1);
+        if (nrecv) atom->data_vels_binary(nrecv,(double *) rbuffer,id_offset);
+      } else atom->data_vels_binary(nchunk,dbuffer,id_offset);
+    }
+    section_close();
+
+  // parallel: check format on readers, since data_vels() errors are global
+  //   then route each line to the owner of its atom
+
+  } else if (nreader) {
+    section_open(natoms);
+    while (section_chunk(nchunk)) {
+      int flag = 0;
+      char *ptr = pbuffer;
+      for (int i = 0; i < nchunk; i++) {
+        char *next = strchr(ptr,'\n');
+        *next = '\0';
+        if ((int) utils::trim_and_count_words(ptr) != atom->avec->size_data_vel)
+          flag = 1;
+        *next = '\n';
+        ptr = next + 1;
+      }
+      int flagall;
+      MPI_Allreduce(&flag,&flagall,1,MPI_INT,MPI_MAX,world);
+      if (flagall) error->all(FLERR,"Incorrect velocity format in data file");
+
+      int nrecv = route_lines(nchunk,pbuffer,0,1);
+      if (nrecv) atom->data_vels(nrecv,rbuffer,id_offset);
+    }
+    section_close();
+
+  } else {
+    bigint nread = 0;
+
+    while (nread < natoms) {
+      nchunk = MIN(natoms-nread,CHUNK);
+      eof = comm->read_lines_from_file(fp,nchunk,MAXLINE,buffer);
+      if (eof) error->all(FLERR,"Unexpected end of data file");
+      atom->data_vels(nchunk,buffer,id_offset);
+      nread += nchunk;
+    }
   }
 
   if (mapflag) {
@@ -1312,15 +1478,38 @@ void ReadData::bonds(int firstpass)
   }
 
   // read and process bonds
+  // parallel: route each line or binary row to the owners of its atoms
+
+  if (binary) {
+    binary_open(nbonds,3);
+    while (binary_chunk(nchunk)) {
+      if (nreader) {
+        int nrecv = route_rows(nchunk,dbuffer,3,1,2);
+        if (nrecv)
+          atom->data_bonds_binary(nrecv,(double *) rbuffer,count,id_offset,
+                                  boffset);
+      } else atom->data_bonds_binary(nchunk,dbuffer,count,id_offset,boffset);
+    }
+    section_close();
 
-  bigint nread = 0;
+  } else if (nreader) {
+    section_open(nbonds);
+    while (section_chunk(nchunk)) {
+      int nrecv = route_lines(nchunk,pbuffer,2,2);
+      if (nrecv) atom->data_bonds(nrecv,rbuffer,count,id_offset,boffset);
+    }
+    section_close();
 
-  while (nread < nbonds) {
-    nchunk = MIN(nbonds-nread,CHUNK);
-    eof = comm->read_lines_from_file(fp,nchunk,MAXLINE,buffer);
-    if (eof) error->all(FLERR,"Unexpected end of data file");
-    atom->data_bonds(nchunk,buffer,count,id_offset,boffset);
-    nread += nchunk;
+  } else {
+    bigint nread = 0;
+
+    while (nread < nbonds) {
+      nchunk = MIN(nbonds-nread,CHUNK);
+      eof = comm->read_lines_from_file(fp,nchunk,MAXLINE,buffer);
+      if (eof) error->all(FLERR,"Unexpected end of data file");
+      atom->data_bonds(nchunk,buffer,count,id_offset,boffset);
+      nread += nchunk;
+    }
   }
 
   // if firstpass: tally max bond/atom and return
@@ -1386,15 +1575,38 @@ void ReadData::angles(int firstpass)
   }
 
   // read and process angles
+  // parallel: route each line or binary row to the owners of its atoms
+
+  if (binary) {
+    binary_open(nangles,4);
+    while (binary_chunk(nchunk)) {
+      if (nreader) {
+        int nrecv = route_rows(nchunk,dbuffer,4,1,3);
+        if (nrecv)
+          atom->data_angles_binary(nrecv,(double *) rbuffer,count,id_offset,
+                                   aoffset);
+      } else atom->data_angles_binary(nchunk,dbuffer,count,id_offset,aoffset);
+    }
+    section_close();
 
-  bigint nread = 0;
+  } else if (nreader) {
+    section_open(nangles);
+    while (section_chunk(nchunk)) {
+      int nrecv = route_lines(nchunk,pbuffer,2,3);
+      if (nrecv) atom->data_angles(nrecv,rbuffer,count,id_offset,aoffset);
+    }
+    section_close();
 
-  while (nread < nangles) {
-    nchunk = MIN(nangles-nread,CHUNK);
-    eof = comm->read_lines_from_file(fp,nchunk,MAXLINE,buffer);
-    if (eof) error->all(FLERR,"Unexpected end of data file");
-    atom->data_angles(nchunk,buffer,count,id_offset,aoffset);
-    nread += nchunk;
+  } else {
+    bigint nread = 0;
+
+    while (nread < nangles) {
+      nchunk = MIN(nangles-nread,CHUNK);
+      eof = comm->read_lines_from_file(fp,nchunk,MAXLINE,buffer);
+      if (eof) error->all(FLERR,"Unexpected end of data file");
+      atom->data_angles(nchunk,buffer,count,id_offset,aoffset);
+      nread += nchunk;
+    }
   }
 
   // if firstpass: tally max angle/atom and return
@@ -1460,15 +1672,38 @@ void ReadData::dihedrals(int firstpass)
   }
 
   // read and process dihedrals
+  // parallel: route each line or binary row to the owners of its atoms
+
+  if (binary) {
+    binary_open(ndihedrals,5);
+    while (binary_chunk(nchunk)) {
+      if (nreader) {
+        int nrecv = route_rows(nchunk,dbuffer,5,1,4);
+        if (nrecv)
+          atom->data_dihedrals_binary(nrecv,(double *) rbuffer,count,id_offset,
+                                      doffset);
+      } else atom->data_dihedrals_binary(nchunk,dbuffer,count,id_offset,doffset);
+    }
+    section_close();
 
-  bigint nread = 0;
+  } else if (nreader) {
+    section_open(ndihedrals);
+    while (section_chunk(nchunk)) {
+      int nrecv = route_lines(nchunk,pbuffer,2,4);
+      if (nrecv) atom->data_dihedrals(nrecv,rbuffer,count,id_offset,doffset);
+    }
+    section_close();
 
-  while (nread < ndihedrals) {
-    nchunk = MIN(ndihedrals-nread,CHUNK);
-    eof = comm->read_lines_from_file(fp,nchunk,MAXLINE,buffer);
-    if (eof) error->all(FLERR,"Unexpected end of data file");
-    atom->data_dihedrals(nchunk,buffer,count,id_offset,doffset);
-    nread += nchunk;
+  } else {
+    bigint nread = 0;
+
+    while (nread < ndihedrals) {
+      nchunk = MIN(ndihedrals-nread,CHUNK);
+      eof = comm->read_lines_from_file(fp,nchunk,MAXLINE,buffer);
+      if (eof) error->all(FLERR,"Unexpected end of data file");
+      atom->data_dihedrals(nchunk,buffer,count,id_offset,doffset);
+      nread += nchunk;
+    }
   }
 
   // if firstpass: tally max dihedral/atom and return
@@ -1534,15 +1769,38 @@ void ReadData::impropers(int firstpass)
   }
 
   // read and process impropers
+  // parallel: route each line or binary row to the owners of its atoms
+
+  if (binary) {
+    binary_open(nimpropers,5);
+    while (binary_chunk(nchunk)) {
+      if (nreader) {
+        int nrecv = route_rows(nchunk,dbuffer,5,1,4);
+        if (nrecv)
+          atom->data_impropers_binary(nrecv,(double *) rbuffer,count,id_offset,
+                                      ioffset);
+      } else atom->data_impropers_binary(nchunk,dbuffer,count,id_offset,ioffset);
+    }
+    section_close();
 
-  bigint nread = 0;
+  } else if (nreader) {
+    section_open(nimpropers);
+    while (section_chunk(nchunk)) {
+      int nrecv = route_lines(nchunk,pbuffer,2,4);
+      if (nrecv) atom->data_impropers(nrecv,rbuffer,count,id_offset,ioffset);
+    }
+    section_close();
 
-  while (nread < nimpropers) {
-    nchunk = MIN(nimpropers-nread,CHUNK);
-    eof = comm->read_lines_from_file(fp,nchunk,MAXLINE,buffer);
-    if (eof) error->all(FLERR,"Unexpected end of data file");
-    atom->data_impropers(nchunk,buffer,count,id_offset,ioffset);
-    nread += nchunk;
+  } else {
+    bigint nread = 0;
+
+    while (nread < nimpropers) {
+      nchunk = MIN(nimpropers-nread,CHUNK);
+      eof = comm->read_lines_from_file(fp,nchunk,MAXLINE,buffer);
+      if (eof) error->all(FLERR,"Unexpected end of data file");
+      atom->data_impropers(nchunk,buffer,count,id_offset,ioffset);
+      nread += nchunk;
+    }
   }
 
   // if firstpass: tally max improper/atom and return
@@ -2047,11 +2305,565 @@ void ReadData::skip_lines(bigint n)
 {
   if (me) return;
   if (n <= 0) return;
+  if (nreader) {
+    if (find_section_end(n) < 0)
+      error->one(FLERR,"Unexpected end of data file");
+    return;
+  }
   char *eof = nullptr;
   for (bigint i = 0; i < n; i++) eof = fgets(line,MAXLINE,fp);
   if (eof == nullptr) error->one(FLERR,"Unexpected end of data file");
 }
 
+/* ----------------------------------------------------------------------
+   proc 0 finds end of next N lines by counting newlines in large blocks
+   leaves file positioned at that end
+   last line of file counts even if not terminated by a newline
+   return file offset of end, -1 if hit EOF first
+------------------------------------------------------------------------- */
+
+bigint ReadData::find_section_end(bigint n)
+{
+  bigint pos = ftell(fp);
+  if (n <= 0) return pos;
+
+  char *block = new char[SCANBLOCK];
+  bigint count = 0;
+  int partial = 0;
+  size_t nbytes;
+
+  while ((nbytes = fread(block,1,SCANBLOCK,fp)) > 0) {
+    char *ptr = block;
+    char *end = block + nbytes;
+    while ((ptr = (char *) memchr(ptr,'\n',end-ptr))) {
+      ptr++;
+      if (++count == n) {
+        pos += ptr - block;
+        delete [] block;
+        fseek(fp,pos,SEEK_SET);
+        return pos;
+      }
+    }
+    pos += nbytes;
+    partial = (block[nbytes-1] != '\n');
+  }
+
+  delete [] block;
+  if (partial && count == n-1) return pos;
+  return -1;
+}
+
+/* ----------------------------------------------------------------------
+   setup parallel read of section with N lines
+   proc 0 finds byte range of section and skips it in its file
+   range is split evenly among readers, each opens file on its own
+   a line is read by the reader whose range contains its first byte
+------------------------------------------------------------------------- */
+
+void ReadData::section_open(bigint n)
+{
+  bigint bounds[2];
+  if (me == 0) {
+    bounds[0] = ftell(fp);
+    bounds[1] = find_section_end(n);
+  }
+  MPI_Bcast(bounds,2,MPI_LMP_BIGINT,0,world);
+  if (bounds[1] < 0) error->all(FLERR,"Unexpected end of data file");
+
+  if (myreader < 0) return;
+
+  bigint range = bounds[1] - bounds[0];
+  sectionpos = bounds[0] + range*myreader/nreader;
+  sectionend = bounds[0] + range*(myreader+1)/nreader;
+
+  fpsection = fopen(filename,"r");
+  if (fpsection == nullptr)
+    error->one(FLERR,fmt::format("Cannot open file {}: {}",
+                                 filename,utils::getsyserror()));
+
+  // skip partial line which belongs to previous reader
+
+  if (sectionpos > bounds[0]) {
+    fseek(fpsection,sectionpos-1,SEEK_SET);
+    sectionpos--;
+    int c;
+    do {
+      c = fgetc(fpsection);
+      sectionpos++;
+    } while (c != '\n' && c != EOF);
+  } else fseek(fpsection,sectionpos,SEEK_SET);
+}
+
+/* ----------------------------------------------------------------------
+   each reader reads up to PCHUNK more lines of its range into pbuffer
+   nchunk = # of lines read by this proc, 0 if not a reader or range is done
+   each line is terminated by newline, even if last line in file is not
+   return max nchunk of all procs, 0 when section is complete
+------------------------------------------------------------------------- */
+
+int ReadData::section_chunk(int &nchunk)
+{
+  nchunk = 0;
+
+  if (fpsection) {
+    int m = 0;
+    while (nchunk < PCHUNK && sectionpos < sectionend) {
+      if (!fgets(&pbuffer[m],MAXLINE,fpsection)) {
+        sectionpos = sectionend;
+        break;
+      }
+      int n = strlen(&pbuffer[m]);
+      sectionpos += n;
+      m += n;
+      nchunk++;
+    }
+    if (m && pbuffer[m-1] != '\n') pbuffer[m++] = '\n';
+    pbuffer[m] = '\0';
+  }
+
+  int nmax;
+  MPI_Allreduce(&nchunk,&nmax,1,MPI_INT,MPI_MAX,world);
+  return nmax;
+}
+
+/* ---------------------------------------------------------------------- */
+
+void ReadData::section_close()
+{
+  if (fpsection) fclose(fpsection);
+  fpsection = nullptr;
+}
+
+/* ----------------------------------------------------------------------
+   proc 0 reads descriptor of binary section with N rows of NCOL values
+   descriptor = # of rows, # of values per row, magic number
+   must match WriteData::binary_descriptor()
+   serial: proc 0 reads rows from its file, bcasts them in chunks
+   parallel: proc 0 skips rows in its file,
+     rows are split evenly among readers, each opens file on its own
+------------------------------------------------------------------------- */
+
+void ReadData::binary_open(bigint n, int ncol)
+{
+  bigint nrow = 0;
+  int desc[2] = {0,0};
+  bigint bounds[2] = {0,0};
+  int flag = 0;
+
+  if (me == 0) {
+    if ((fread(&nrow,sizeof(bigint),1,fp) != 1) ||
+        (fread(desc,sizeof(int),2,fp) != 2)) flag = 1;
+    else if (desc[1] != BINARY_MAGIC) flag = 2;
+    else if (nrow != n || desc[0] != ncol) flag = 3;
+    else if (nreader) {
+      bounds[0] = ftell(fp);
+      bounds[1] = bounds[0] + n*ncol*sizeof(double);
+      fseek(fp,bounds[1],SEEK_SET);
+    }
+  }
+
+  MPI_Bcast(&flag,1,MPI_INT,0,world);
+  if (flag == 1) error->all(FLERR,"Unexpected end of data file");
+  if (flag == 2)
+    error->all(FLERR,fmt::format("Invalid binary {} section in data file",
+                                 keyword));
+  if (flag == 3)
+    error->all(FLERR,fmt::format("Incorrect format of binary {} section "
+                                 "in data file",keyword));
+
+  ncolumn = ncol;
+  int nmax = nreader ? PCHUNK : CHUNK;
+  if (nmax*ncol > maxdbuf) {
+    maxdbuf = nmax*ncol;
+    memory->destroy(dbuffer);
+    memory->create(dbuffer,maxdbuf,"read_data:dbuffer");
+  }
+
+  if (nreader == 0) {
+    sectionpos = 0;
+    sectionend = n;
+    return;
+  }
+
+  MPI_Bcast(bounds,2,MPI_LMP_BIGINT,0,world);
+  if (myreader < 0) return;
+
+  sectionpos = n*myreader/nreader;
+  sectionend = n*(myreader+1)/nreader;
+
+  fpsection = fopen(filename,"rb");
+  if (fpsection == nullptr)
+    error->one(FLERR,fmt::format("Cannot open file {}: {}",
+                                 filename,utils::getsyserror()));
+  fseek(fpsection,bounds[0]+sectionpos*ncol*sizeof(double),SEEK_SET);
+}
+
+/* ----------------------------------------------------------------------
+   read up to CHUNK (serial) or PCHUNK (parallel) more rows into dbuffer
+   serial: proc 0 reads rows, all procs get same nchunk rows
+   parallel: nchunk = # of rows read by this proc, 0 if not a reader
+   return max nchunk of all procs, 0 when section is complete
+------------------------------------------------------------------------- */
+
+int ReadData::binary_chunk(int &nchunk)
+{
+  size_t nvalues;
+
+  if (nreader == 0) {
+    nchunk = MIN(sectionend-sectionpos,CHUNK);
+    if (nchunk == 0) return 0;
+    nvalues = (size_t) nchunk*ncolumn;
+    int eof = 0;
+    if (me == 0 && fread(dbuffer,sizeof(double),nvalues,fp) != nvalues)
+      eof = 1;
+    MPI_Bcast(&eof,1,MPI_INT,0,world);
+    if (eof) error->all(FLERR,"Unexpected end of data file");
+    MPI_Bcast(dbuffer,nchunk*ncolumn,MPI_DOUBLE,0,world);
+    sectionpos += nchunk;
+    return nchunk;
+  }
+
+  nchunk = 0;
+  if (fpsection) {
+    nchunk = MIN(sectionend-sectionpos,PCHUNK);
+    nvalues = (size_t) nchunk*ncolumn;
+    if (nchunk && fread(dbuffer,sizeof(double),nvalues,fpsection) != nvalues)
+      error->one(FLERR,"Unexpected end of data file");
+    sectionpos += nchunk;
+  }
+
+  int nmax;
+  MPI_Allreduce(&nchunk,&nmax,1,MPI_INT,MPI_MAX,world);
+  return nmax;
+}
+
+/* ----------------------------------------------------------------------
+   proc 0 skips binary section, size is taken from its descriptor
+------------------------------------------------------------------------- */
+
+void ReadData::skip_binary()
+{
+  if (me) return;
+
+  bigint nrow;
+  int desc[2];
+  if ((fread(&nrow,sizeof(bigint),1,fp) != 1) ||
+      (fread(desc,sizeof(int),2,fp) != 2) || desc[1] != BINARY_MAGIC)
+    error->one(FLERR,"Unexpected end of data file");
+
+  // cannot seek in pipe from gzip, so read and discard
+
+  bigint nbytes = nrow*desc[0]*sizeof(double);
+  if (compressed) {
+    while (nbytes > 0) {
+      size_t n = MIN(nbytes,CHUNK*MAXLINE);
+      if (fread(buffer,1,n,fp) != n)
+        error->one(FLERR,"Unexpected end of data file");
+      nbytes -= n;
+    }
+  } else fseek(fp,nbytes,SEEK_CUR);
+}
+
+/* ----------------------------------------------------------------------
+   store owning proc of each atom ID in rendezvous decomposition
+   each proc is assigned every Pth atom ID, same as Special
+------------------------------------------------------------------------- */
+
+void ReadData::atom_owners()
+{
+  int nprocs = comm->nprocs;
+  tagint *tag = atom->tag;
+  int nlocal = atom->nlocal;
+
+  tagint maxtag = 0;
+  for (int i = 0; i < nlocal; i++) maxtag = MAX(maxtag,tag[i]);
+  MPI_Allreduce(&maxtag,&ownermax,1,MPI_LMP_TAGINT,MPI_MAX,world);
+
+  nowner = static_cast<int> (ownermax/nprocs) + 1;
+  memory->create(owner,nowner,"read_data:owner");
+  for (int i = 0; i < nowner; i++) owner[i] = -1;
+
+  int *proclist;
+  memory->create(proclist,nlocal,"read_data:proclist");
+  IDRvous *idbuf = (IDRvous *)
+    memory->smalloc((bigint) nlocal*sizeof(IDRvous),"read_data:idbuf");
+
+  for (int i = 0; i < nlocal; i++) {
+    proclist[i] = tag[i] % nprocs;
+    idbuf[i].me = me;
+    idbuf[i].atomID = tag[i];
+  }
+
+  char *buf;
+  comm->rendezvous(RVOUS,nlocal,(char *) idbuf,sizeof(IDRvous),0,proclist,
+                   rendezvous_owners,0,buf,0,(void *) this);
+
+  memory->destroy(proclist);
+  memory->sfree(idbuf);
+}
+
+/* ----------------------------------------------------------------------
+   callback from comm->rendezvous() in atom_owners()
+   store owning proc of each received atom ID
+------------------------------------------------------------------------- */
+
+int ReadData::rendezvous_owners(int n, char *inbuf,
+                                int &flag, int *& /*proclist*/,
+                                char *& /*outbuf*/, void *ptr)
+{
+  ReadData *rptr = (ReadData *) ptr;
+  int nprocs = rptr->comm->nprocs;
+  int *owner = rptr->owner;
+
+  IDRvous *in = (IDRvous *) inbuf;
+  for (int i = 0; i < n; i++)
+    owner[in[i].atomID / nprocs] = in[i].me;
+
+  // flag = 0: no second comm needed in rendezvous
+
+  flag = 0;
+  return 0;
+}
+
+/* ----------------------------------------------------------------------
+   route N lines in buf to the owning procs of the atoms they reference
+   atom IDs are NID words after the first NSKIP words of a line
+   a line is kept on this proc if it cannot be parsed or has an invalid ID,
+     so that the Atom::data_*() method raises the error
+   lines routed to this proc are stored in rbuffer
+   return # of lines in rbuffer
+------------------------------------------------------------------------- */
+
+int ReadData::route_lines(int n, char *buf, int nskip, int nid)
+{
+  int i,j,m;
+  char copy[MAXLINE+1];
+  char *word;
+
+  // find start of each line, parse atom IDs
+  // atom ID = 0 flags a line that cannot be parsed
+
+  int *start;
+  tagint *ids;
+  memory->create(start,n+1,"read_data:start");
+  memory->create(ids,nid*n+1,"read_data:ids");
+
+  m = 0;
+  for (i = 0; i < n; i++) {
+    start[i] = m;
+    int len = strchr(&buf[m],'\n') - &buf[m] + 1;
+    strncpy(copy,&buf[m],len);
+    copy[len] = '\0';
+    m += len;
+
+    word = strtok(copy," \t\n\r\f");
+    for (j = 1; word && j < nskip; j++) word = strtok(nullptr," \t\n\r\f");
+    for (j = 0; j < nid; j++) {
+      if (word && (nskip || j)) word = strtok(nullptr," \t\n\r\f");
+      if (word == nullptr) ids[nid*i] = 0;
+      else ids[nid*i+j] = ATOTAGINT(word) + id_offset;
+    }
+  }
+  start[n] = m;
+
+  int nrecv = route(n,nid,ids,buf,start);
+
+  memory->destroy(start);
+  memory->destroy(ids);
+
+  int nline = 0;
+  for (m = 0; m < nrecv; m++)
+    if (rbuffer[m] == '\n') nline++;
+  return nline;
+}
+
+/* ----------------------------------------------------------------------
+   route N rows of NCOL values in buf to the owning procs of their atoms
+   atom IDs are stored as ubuf in NID columns starting at column ICOL
+   rows routed to this proc are stored in rbuffer
+   return # of rows in rbuffer
+------------------------------------------------------------------------- */
+
+int ReadData::route_rows(int n, double *buf, int ncol, int icol, int nid)
+{
+  int *start;
+  tagint *ids;
+  memory->create(start,n+1,"read_data:start");
+  memory->create(ids,nid*n+1,"read_data:ids");
+
+  int rowbytes = ncol*sizeof(double);
+  for (int i = 0; i < n; i++) {
+    start[i] = i*rowbytes;
+    for (int j = 0; j < nid; j++)
+      ids[nid*i+j] = (tagint) ubuf(buf[ncol*i+icol+j]).i + id_offset;
+  }
+  start[n] = n*rowbytes;
+
+  int nrecv = route(n,nid,ids,(char *) buf,start);
+
+  memory->destroy(start);
+  memory->destroy(ids);
+
+  return nrecv/rowbytes;
+}
+
+/* ----------------------------------------------------------------------
+   route N items in buf to the owning procs of the atoms they reference
+   item I = bytes start[I] to start[I+1] of buf, with NID atom IDs in ids
+   owners are looked up in rendezvous decomposition
+   an item is kept on this proc if one of its atom IDs is invalid
+   items routed to this proc are stored in rbuffer
+   return # of bytes in rbuffer
+------------------------------------------------------------------------- */
+
+int ReadData::route(int n, int nid, tagint *ids, char *buf, int *start)
+{
+  int i,j,k,m;
+  int nprocs = comm->nprocs;
+
+  if (owner == nullptr) atom_owners();
+
+  // one datum for each atom ID: datum = atomID, reader, item index
+
+  int *ndest,*dest;
+  memory->create(ndest,n+1,"read_data:ndest");
+  memory->create(dest,4*n+1,"read_data:dest");
+
+  int *proclist;
+  memory->create(proclist,nid*n+1,"read_data:proclist");
+  LineRvous *inbuf = (LineRvous *)
+    memory->smalloc((bigint) (nid*n+1)*sizeof(LineRvous),"read_data:inbuf");
+
+  int nsend = 0;
+  for (i = 0; i < n; i++) {
+    int valid = 1;
+    for (j = 0; valid && j < nid; j++) {
+      tagint atomID = ids[nid*i+j];
+      if (atomID <= 0 || atomID > ownermax) valid = 0;
+      else {
+        proclist[nsend+j] = atomID % nprocs;
+        inbuf[nsend+j].atomID = atomID;
+        inbuf[nsend+j].reader = me;
+        inbuf[nsend+j].iline = i;
+      }
+    }
+
+    if (valid) {
+      nsend += nid;
+      ndest[i] = 0;
+    } else {
+      ndest[i] = 1;
+      dest[4*i] = me;
+    }
+  }
+
+  // perform rendezvous operation, returned datums have owner of atom ID
+
+  char *outbuf;
+  int nreturn = comm->rendezvous(RVOUS,nsend,(char *) inbuf,sizeof(LineRvous),
+                                 0,proclist,rendezvous_lines,0,outbuf,
+                                 sizeof(LineRvous),(void *) this);
+  LineRvous *out = (LineRvous *) outbuf;
+
+  memory->destroy(proclist);
+  memory->sfree(inbuf);
+
+  // unique list of destination procs for each item
+  // atom IDs not owned by any proc are skipped, same as in serial read
+
+  for (m = 0; m < nreturn; m++) {
+    if (out[m].owner < 0) continue;
+    i = out[m].iline;
+    for (k = 0; k < ndest[i]; k++)
+      if (dest[4*i+k] == out[m].owner) break;
+    if (k == ndest[i]) dest[4*i+ndest[i]++] = out[m].owner;
+  }
+
+  memory->sfree(outbuf);
+
+  // send items to their destination procs
+
+  int *sendcounts,*sdispls,*recvcounts,*rdispls;
+  memory->create(sendcounts,nprocs,"read_data:sendcounts");
+  memory->create(sdispls,nprocs,"read_data:sdispls");
+  memory->create(recvcounts,nprocs,"read_data:recvcounts");
+  memory->create(rdispls,nprocs,"read_data:rdispls");
+
+  for (k = 0; k < nprocs; k++) sendcounts[k] = 0;
+  for (i = 0; i < n; i++)
+    for (k = 0; k < ndest[i]; k++)
+      sendcounts[dest[4*i+k]] += start[i+1] - start[i];
+
+  sdispls[0] = 0;
+  for (k = 1; k < nprocs; k++) sdispls[k] = sdispls[k-1] + sendcounts[k-1];
+  int nbytes = sdispls[nprocs-1] + sendcounts[nprocs-1];
+
+  char *sbuf;
+  memory->create(sbuf,nbytes+1,"read_data:sbuf");
+  for (k = 0; k < nprocs; k++) sendcounts[k] = 0;
+  for (i = 0; i < n; i++)
+    for (k = 0; k < ndest[i]; k++) {
+      int iproc = dest[4*i+k];
+      memcpy(&sbuf[sdispls[iproc]+sendcounts[iproc]],&buf[start[i]],
+             start[i+1]-start[i]);
+      sendcounts[iproc] += start[i+1] - start[i];
+    }
+
+  memory->destroy(ndest);
+  memory->destroy(dest);
+
+  MPI_Alltoall(sendcounts,1,MPI_INT,recvcounts,1,MPI_INT,world);
+  rdispls[0] = 0;
+  for (k = 1; k < nprocs; k++) rdispls[k] = rdispls[k-1] + recvcounts[k-1];
+  int nrecv = rdispls[nprocs-1] + recvcounts[nprocs-1];
+
+  if (nrecv+1 > maxrbuf) {
+    maxrbuf = nrecv+1;
+    memory->destroy(rbuffer);
+    memory->create(rbuffer,maxrbuf,"read_data:rbuffer");
+  }
+  MPI_Alltoallv(sbuf,sendcounts,sdispls,MPI_CHAR,
+                rbuffer,recvcounts,rdispls,MPI_CHAR,world);
+  rbuffer[nrecv] = '\0';
+
+  memory->destroy(sbuf);
+  memory->destroy(sendcounts);
+  memory->destroy(sdispls);
+  memory->destroy(recvcounts);
+  memory->destroy(rdispls);
+
+  return nrecv;
+}
+
+/* ----------------------------------------------------------------------
+   callback from comm->rendezvous() in route()
+   set owner of each atom ID and send datum back to its reader
+------------------------------------------------------------------------- */
+
+int ReadData::rendezvous_lines(int n, char *inbuf,
+                               int &flag, int *&proclist, char *&outbuf,
+                               void *ptr)
+{
+  ReadData *rptr = (ReadData *) ptr;
+  int nprocs = rptr->comm->nprocs;
+  int *owner = rptr->owner;
+
+  LineRvous *in = (LineRvous *) inbuf;
+  rptr->memory->create(proclist,n,"read_data:proclist");
+
+  for (int i = 0; i < n; i++) {
+    in[i].owner = owner[in[i].atomID / nprocs];
+    proclist[i] = in[i].reader;
+  }
+
+  outbuf = inbuf;
+
+  // flag = 1: outbuf = inbuf
+
+  flag = 1;
+  return n;
+}
+
 /* ----------------------------------------------------------------------
    parse a line of coeffs into words, storing them in narg,arg
    trim anything from '#' onward
@@ -76,6 +76,38 @@ class ReadData : protected Pointers {
   char **fix_header;
   char **fix_section;
 
+  // parallel reading of sections
+
+  int nreader;                   // # of procs reading sections, 0 = serial
+  int myreader;                  // my index as reader, -1 if not a reader
+  char *filename;                // data file, opened by each reader
+  FILE *fpsection;               // reader's file pointer into current section
+  bigint sectionpos,sectionend;  // position and end of reader's byte range
+  char *pbuffer;                 // lines read by this proc
+  char *rbuffer;                 // lines or rows routed to this proc
+  int maxrbuf;
+
+  // binary sections, reader's range is in rows instead of bytes
+
+  int binary;                    // binary format version, 0 = text file
+  int ncolumn;                   // # of values per row in current section
+  double *dbuffer;               // rows read by this proc
+  int maxdbuf;
+
+  tagint ownermax;               // max atom ID when owners were stored
+  int nowner;
+  int *owner;                    // owning proc of atom IDs assigned to me
+
+  struct IDRvous {
+    int me;
+    tagint atomID;
+  };
+
+  struct LineRvous {
+    tagint atomID;
+    int reader,iline,owner;
+  };
+
   // methods
 
   void open(char *);
@@ -84,6 +116,19 @@ class ReadData : protected Pointers {
   void header(int);
   void parse_keyword(int);
   void skip_lines(bigint);
+  bigint find_section_end(bigint);
+  void section_open(bigint);
+  int section_chunk(int &);
+  void section_close();
+  void binary_open(bigint, int);
+  int binary_chunk(int &);
+  void skip_binary();
+  void atom_owners();
+  int route_lines(int, char *, int, int);
+  int route_rows(int, double *, int, int, int);
+  int route(int, int, tagint *, char *, int *);
+  static int rendezvous_owners(int, char *, int &, int *&, char *&, void *);
+  static int rendezvous_lines(int, char *, int &, int *&, char *&, void *);
   void parse_coeffs(char *, const char *, int, int, int);
   int style_match(const char *, const char *);
 
@@ -123,6 +168,40 @@ Self-explanatory.  Check the input script syntax and compare to the
 documentation for the command.  You can use -echo screen as a
 command-line option when running LAMMPS to see the offending line.
 
+W: Cannot read compressed data file in parallel
+
+Sections of a gzipped data file can only be read by one processor.
+The parallel keyword is ignored.
+
+W: Cannot read data file in parallel with bonus data
+
+Atom styles which store bonus data, e.g. ellipsoid or body, are read
+by one processor.  The parallel keyword is ignored.
+
+E: Could not parse 'binary format' line in data file header
+
+The header line which marks a binary data file is corrupted.
+
+E: Unsupported binary format %d in data file
+
+The binary data file was written by a different version of LAMMPS
+which uses a format that this version cannot read.
+
+E: Cannot read binary data file with KOKKOS package
+
+The KOKKOS versions of the atom styles can only read data files
+in text format.  Write the data file without the binary keyword.
+
+E: Invalid binary %s section in data file
+
+The descriptor at the start of a binary section is corrupted, or the
+file was written on a machine with different byte order.
+
+E: Incorrect format of binary %s section in data file
+
+The number of rows or the number of values per row of a binary section
+does not match the header of the data file or the current atom style.
+
 E: Read data add atomID offset is too big
 
 UNDOCUMENTED
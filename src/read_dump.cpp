@@ -32,7 +32,13 @@
 #include "style_reader.h"       // IWYU pragma: keep
 #include "update.h"
 
+#include <atomic>
+#include <condition_variable>
 #include <cstring>
+#include <mutex>
+#include <system_error>
+#include <thread>
+#include <vector>
 
 using namespace LAMMPS_NS;
 
@@ -44,6 +50,38 @@ enum{ID,TYPE,X,Y,Z,VX,VY,VZ,Q,IX,IY,IZ,FX,FY,FZ};
 enum{UNSET,NOSCALE_NOWRAP,NOSCALE_WRAP,SCALE_NOWRAP,SCALE_WRAP};
 enum{NOADD,YESADD,KEEPADD};
 
+namespace LAMMPS_NS {
+
+// one snapshot read ahead by a frame reader thread
+
+struct DumpFrame {
+  bigint ntimestep;             // -1 after the last selected snapshot
+  bigint natoms;
+  double box[3][3];
+  int boxinfo,triclinic_snap;
+  int fieldflag,xflag,yflag,zflag;
+  int maxatoms;
+  double **fields;
+  int errorflag;                // 1 if reading failed
+  DeferredError error;          // error of reading, raised when frame is used
+  std::vector<DeferredError> warnings;
+};
+
+// ring buffer of snapshots filled by a frame reader thread
+
+struct DumpPrefetch {
+  std::thread thread;
+  std::mutex mutex;
+  std::condition_variable cond;
+  std::vector<DumpFrame> frames;
+  int head,count;               // oldest filled snapshot and # of filled ones
+  std::atomic<int> quit;        // 1 if thread must stop
+  bigint first,last;
+  int nevery,nskip;
+};
+
+}
+
 /* ---------------------------------------------------------------------- */
 
 ReadDump::ReadDump(LAMMPS *lmp) : Pointers(lmp)
@@ -74,12 +112,24 @@ ReadDump::ReadDump(LAMMPS *lmp) : Pointers(lmp)
   clustercomm = MPI_COMM_NULL;
   filereader = 0;
   parallel = 0;
+
+  nprefetch = 0;
+  nframereader = 0;
+  myframereader = -1;
+  iframe = 0;
+  prefetch = nullptr;
 }
 
 /* ---------------------------------------------------------------------- */
 
 ReadDump::~ReadDump()
 {
+  if (prefetch) {
+    prefetch_stop();
+    for (auto &frame : prefetch->frames) memory->destroy(frame.fields);
+    delete prefetch;
+  }
+
   for (int i = 0; i < nfile; i++) delete [] files[i];
   delete [] files;
   for (int i = 0; i < nfield; i++) delete [] fieldlabel[i];
@@ -260,13 +310,332 @@ void ReadDump::setup_reader(int narg, char **arg)
       filereader = 1;
   }
 
+  if (nprefetch && parallel)
+    error->all(FLERR,"Rerun prefetch cannot be used with parallel dump readers");
+
   // pass any arguments to readers
 
-  if (narg > 0 && filereader)
+  if (narg > 0 && (filereader || myframereader >= 0))
     for (int i = 0; i < nreader; i++)
       readers[i]->settings(narg,arg);
 }
 
+/* ----------------------------------------------------------------------
+   enable reading of snapshots ahead of their use by background threads
+   Nbuf = # of snapshots each frame reader buffers
+   Nframereader = # of procs reading and parsing different snapshots,
+     snapshot I of the selected sequence is read by frame reader I % Nframereader
+   Nlast,Nevery,Nskip = selection criteria, same as for next()
+   must be called after store_files() and before setup_reader()
+------------------------------------------------------------------------- */
+
+void ReadDump::setup_prefetch(int nbuf, int nframe, bigint nlast,
+                              int nevery, int nskip)
+{
+  if (multiproc)
+    error->all(FLERR,"Rerun prefetch requires dump files written by one processor");
+
+  nprefetch = nbuf;
+  nframereader = MIN(nframe,nprocs);
+  myframereader = -1;
+  for (int i = 0; i < nframereader; i++)
+    if (frame_root(i) == me) myframereader = i;
+
+  prefetch = new DumpPrefetch;
+  prefetch->head = prefetch->count = 0;
+  prefetch->quit = 0;
+  prefetch->last = nlast;
+  prefetch->nevery = nevery;
+  prefetch->nskip = nskip;
+
+  if (myframereader >= 0) {
+    prefetch->frames.resize(nprefetch);
+    for (auto &frame : prefetch->frames) {
+      frame.maxatoms = 0;
+      frame.fields = nullptr;
+      frame.errorflag = 0;
+    }
+  }
+}
+
+/* ----------------------------------------------------------------------
+   return proc that reads snapshot Index of the selected sequence
+------------------------------------------------------------------------- */
+
+int ReadDump::frame_root(bigint index)
+{
+  return static_cast<int> ((bigint) (index % nframereader) * nprocs/nframereader);
+}
+
+/* ----------------------------------------------------------------------
+   launch frame reader thread on frame reader procs
+   Nrequest = first selected timestep, as for seek() with exact = 0
+------------------------------------------------------------------------- */
+
+void ReadDump::prefetch_start(bigint nrequest)
+{
+  iframe = 0;
+  if (myframereader < 0) return;
+
+  prefetch->first = nrequest;
+  try {
+    prefetch->thread = std::thread(&ReadDump::prefetch_loop,this);
+  } catch (std::system_error &e) {
+    error->one(FLERR,fmt::format("Cannot start thread for rerun prefetch: {}",
+                                 e.what()));
+  }
+}
+
+/* ----------------------------------------------------------------------
+   stop and join frame reader thread
+------------------------------------------------------------------------- */
+
+void ReadDump::prefetch_stop()
+{
+  if (!prefetch->thread.joinable()) return;
+
+  {
+    std::lock_guard<std::mutex> lock(prefetch->mutex);
+    prefetch->quit = 1;
+  }
+  prefetch->cond.notify_all();
+  prefetch->thread.join();
+}
+
+/* ----------------------------------------------------------------------
+   body of frame reader thread
+   every frame reader scans the same selected sequence of snapshots,
+     parses the ones it owns into its ring buffer and skips the others
+   only file I/O and parsing is done here, all communication stays
+     with the calling thread
+   errors and warnings are stored in the next frame of this reader,
+     the calling thread raises them when it uses that frame
+------------------------------------------------------------------------- */
+
+void ReadDump::prefetch_loop()
+{
+  Reader *reader = readers[0];
+  int ifile = 0;
+  int fieldinfo = 1;
+  bigint ntimestep = -1;
+  int slot = -1;
+
+  Error::defer(1);
+
+  try {
+    reader->open_file(files[0]);
+
+    for (bigint index = 0; !prefetch->quit; index++) {
+      slot = -1;
+      ntimestep = prefetch_scan(ifile,ntimestep,index == 0);
+
+      if (index % nframereader != myframereader) {
+        if (ntimestep < 0) break;
+        reader->skip();
+        continue;
+      }
+
+      slot = prefetch_slot();
+      if (slot < 0) break;
+      prefetch_frame(prefetch->frames[slot],ntimestep,fieldinfo);
+      prefetch_commit();
+      slot = -1;
+
+      if (ntimestep < 0) break;
+    }
+
+    if (ifile < nfile) reader->close_file();
+
+  } catch (DeferredError &e) {
+
+    // pass error to calling thread in next frame of this reader
+
+    if (slot < 0) slot = prefetch_slot();
+    if (slot >= 0) {
+      DumpFrame &frame = prefetch->frames[slot];
+      frame.errorflag = 1;
+      frame.error = e;
+      frame.warnings = Error::deferred_warnings();
+      prefetch_commit();
+    }
+  }
+
+  Error::defer(0);
+}
+
+/* ----------------------------------------------------------------------
+   wait for a free slot in the ring buffer of a frame reader thread
+   return its index or -1 if thread must stop
+------------------------------------------------------------------------- */
+
+int ReadDump::prefetch_slot()
+{
+  std::unique_lock<std::mutex> lock(prefetch->mutex);
+  prefetch->cond.wait(lock,[this]
+                      { return prefetch->quit || prefetch->count < nprefetch; });
+  if (prefetch->quit) return -1;
+  return (prefetch->head + prefetch->count) % nprefetch;
+}
+
+/* ----------------------------------------------------------------------
+   mark next slot of the ring buffer as filled
+------------------------------------------------------------------------- */
+
+void ReadDump::prefetch_commit()
+{
+  {
+    std::lock_guard<std::mutex> lock(prefetch->mutex);
+    prefetch->count++;
+  }
+  prefetch->cond.notify_all();
+}
+
+/* ----------------------------------------------------------------------
+   read header and atoms of snapshot Ntimestep into frame
+   Ntimestep = -1 marks end of selected snapshots
+------------------------------------------------------------------------- */
+
+void ReadDump::prefetch_frame(DumpFrame &frame, bigint ntimestep,
+                              int &fieldinfo)
+{
+  Reader *reader = readers[0];
+  frame.ntimestep = ntimestep;
+
+  if (ntimestep >= 0) {
+    frame.natoms =
+      reader->read_header(frame.box,frame.boxinfo,frame.triclinic_snap,
+                          fieldinfo,nfield,fieldtype,fieldlabel,
+                          scaleflag,wrapflag,frame.fieldflag,
+                          frame.xflag,frame.yflag,frame.zflag);
+    fieldinfo = 0;
+
+    if (frame.natoms > MAXSMALLINT)
+      error->one(FLERR,"Read dump snapshot is too large for a proc");
+    int natoms = static_cast<int> (frame.natoms);
+    if (natoms > frame.maxatoms || frame.maxatoms == 0) {
+      memory->destroy(frame.fields);
+      frame.maxatoms = MAX(natoms,1);     // avoid null pointer
+      memory->create(frame.fields,frame.maxatoms,nfield,"read_dump:frame");
+    }
+
+    int ntotal = 0;
+    while (ntotal < natoms) {
+      int nread = MIN(CHUNK,natoms-ntotal);
+      reader->read_atoms(nread,nfield,&frame.fields[ntotal]);
+      ntotal += nread;
+    }
+  }
+
+  frame.warnings = Error::deferred_warnings();
+}
+
+/* ----------------------------------------------------------------------
+   find next selected snapshot for a frame reader thread
+   same criteria as seek() with exact = 0 for the first snapshot
+     and as next() for all following ones
+   Ncurrent = timestep of previous selected snapshot
+   return its timestep or -1 if files are exhausted
+------------------------------------------------------------------------- */
+
+bigint ReadDump::prefetch_scan(int &ifile, bigint ncurrent, int firstflag)
+{
+  Reader *reader = readers[0];
+  bigint ntimestep;
+  int iskip = 0;
+
+  while (ifile < nfile) {
+    if (reader->read_time(ntimestep)) {
+      reader->close_file();
+      if (++ifile < nfile) reader->open_file(files[ifile]);
+      continue;
+    }
+
+    if (firstflag) {
+      if (ntimestep >= prefetch->first) return ntimestep;
+      reader->skip();
+      continue;
+    }
+
+    if (ntimestep > prefetch->last) return -1;
+    if (ntimestep <= ncurrent) {
+      reader->skip();
+      continue;
+    }
+    if (iskip == prefetch->nskip) iskip = 0;
+    iskip++;
+    if (prefetch->nevery && ntimestep % prefetch->nevery) reader->skip();
+    else if (iskip < prefetch->nskip) reader->skip();
+    else return ntimestep;
+  }
+
+  return -1;
+}
+
+/* ----------------------------------------------------------------------
+   wait for current prefetched snapshot and broadcast its timestep
+   return -1 and stop frame reader threads after last snapshot
+------------------------------------------------------------------------- */
+
+bigint ReadDump::prefetch_timestep()
+{
+  int root = frame_root(iframe);
+  bigint ntimestep;
+
+  if (me == root) {
+    {
+      std::unique_lock<std::mutex> lock(prefetch->mutex);
+      prefetch->cond.wait(lock,[this] { return prefetch->count > 0; });
+    }
+
+    // raise errors and warnings of frame reader thread for this frame
+
+    DumpFrame &frame = prefetch->frames[prefetch->head];
+    for (auto &w : frame.warnings) error->warning(w.file,w.line,w.message);
+    frame.warnings.clear();
+    if (frame.errorflag)
+      error->one(frame.error.file,frame.error.line,frame.error.message);
+    ntimestep = frame.ntimestep;
+  }
+
+  MPI_Bcast(&ntimestep,1,MPI_LMP_BIGINT,root,world);
+  if (ntimestep < 0) prefetch_stop();
+  return ntimestep;
+}
+
+/* ----------------------------------------------------------------------
+   distribute atoms of current prefetched snapshot evenly across procs
+------------------------------------------------------------------------- */
+
+void ReadDump::prefetch_atoms()
+{
+  bigint nsnap = nsnapatoms[0];
+  int root = frame_root(iframe);
+
+  bigint ofirst = (bigint) me * nsnap/nprocs;
+  bigint olast = (bigint) (me+1) * nsnap/nprocs;
+  if (olast-ofirst > MAXSMALLINT)
+    error->one(FLERR,"Read dump snapshot is too large for a proc");
+  nnew = static_cast<int> (olast - ofirst);
+  if (nnew > maxnew || maxnew == 0) {
+    memory->destroy(fields);
+    maxnew = MAX(nnew,1);     // avoid null pointer
+    memory->create(fields,maxnew,nfield,"read_dump:fields");
+  }
+
+  if (me == root) {
+    double **snap = prefetch->frames[prefetch->head].fields;
+    for (int iproc = 0; iproc < nprocs; iproc++) {
+      bigint lo = (bigint) iproc * nsnap/nprocs;
+      bigint hi = (bigint) (iproc+1) * nsnap/nprocs;
+      if (iproc == me)
+        memcpy(&fields[0][0],&snap[lo][0],(hi-lo)*nfield*sizeof(double));
+      else
+        MPI_Send(&snap[lo][0],(hi-lo)*nfield,MPI_DOUBLE,iproc,0,world);
+    }
+  } else MPI_Recv(&fields[0][0],nnew*nfield,MPI_DOUBLE,root,0,
+                  world,MPI_STATUS_IGNORE);
+}
+
 /* ----------------------------------------------------------------------
    seek Nrequest timestep in one or more dump files
    if exact = 1, must find exactly Nrequest
@@ -279,6 +648,18 @@ bigint ReadDump::seek(bigint nrequest, int exact)
   int ifile,eofflag;
   bigint ntimestep;
 
+  // frame reader threads find the timestep and all following ones
+
+  if (nprefetch) {
+    prefetch_start(nrequest);
+    ntimestep = prefetch_timestep();
+    if (exact && ntimestep != nrequest) {
+      prefetch_stop();
+      ntimestep = -1;
+    }
+    return ntimestep;
+  }
+
   // proc 0 finds the timestep in its first reader
 
   if (me == 0 || parallel) {
@@ -368,6 +749,22 @@ bigint ReadDump::next(bigint ncurrent, bigint nlast, int nevery, int nskip)
   int ifile,eofflag;
   bigint ntimestep;
 
+  // release current prefetched snapshot and wait for next one
+  // selection criteria were already passed to setup_prefetch()
+
+  if (nprefetch) {
+    if (me == frame_root(iframe)) {
+      {
+        std::lock_guard<std::mutex> lock(prefetch->mutex);
+        prefetch->head = (prefetch->head + 1) % nprefetch;
+        prefetch->count--;
+      }
+      prefetch->cond.notify_all();
+    }
+    iframe++;
+    return prefetch_timestep();
+  }
+
   // proc 0 finds the timestep in its first reader
 
   if (me == 0 || parallel) {
@@ -456,6 +853,20 @@ bigint ReadDump::next(bigint ncurrent, bigint nlast, int nevery, int nskip)
   return ntimestep;
 }
 
+/* ----------------------------------------------------------------------
+   skip current snapshot found by seek() or next() without reading it
+   prefetched snapshots are released by next()
+------------------------------------------------------------------------- */
+
+void ReadDump::skip()
+{
+  if (nprefetch) return;
+
+  if (filereader)
+    for (int i = 0; i < nreader; i++)
+      readers[i]->skip();
+}
+
 /* ----------------------------------------------------------------------
    read and broadcast and store snapshot header info
    set nsnapatoms = # of atoms in snapshot
@@ -465,8 +876,25 @@ void ReadDump::header(int fieldinfo)
 {
   int boxinfo, triclinic_snap;
   int fieldflag,xflag,yflag,zflag;
-
-  if (filereader) {
+  int root = 0;
+
+  // with prefetching, header info was already read by a frame reader thread
+  // field info of its first snapshot is used for every snapshot
+
+  if (nprefetch) {
+    root = frame_root(iframe);
+    if (me == root) {
+      DumpFrame &frame = prefetch->frames[prefetch->head];
+      nsnapatoms[0] = frame.natoms;
+      memcpy(&box[0][0],&frame.box[0][0],9*sizeof(double));
+      boxinfo = frame.boxinfo;
+      triclinic_snap = frame.triclinic_snap;
+      fieldflag = frame.fieldflag;
+      xflag = frame.xflag;
+      yflag = frame.yflag;
+      zflag = frame.zflag;
+    }
+  } else if (filereader) {
     for (int i = 0; i < nreader; i++)
       nsnapatoms[i] = readers[i]->read_header(box,boxinfo,triclinic_snap,fieldinfo,
                                               nfield,fieldtype,fieldlabel,
@@ -475,10 +903,10 @@ void ReadDump::header(int fieldinfo)
   }
 
   if (!parallel) {
-    MPI_Bcast(nsnapatoms,nreader,MPI_LMP_BIGINT,0,clustercomm);
-    MPI_Bcast(&boxinfo,1,MPI_INT,0,clustercomm);
-    MPI_Bcast(&triclinic_snap,1,MPI_INT,0,clustercomm);
-    MPI_Bcast(&box[0][0],9,MPI_DOUBLE,0,clustercomm);
+    MPI_Bcast(nsnapatoms,nreader,MPI_LMP_BIGINT,root,clustercomm);
+    MPI_Bcast(&boxinfo,1,MPI_INT,root,clustercomm);
+    MPI_Bcast(&triclinic_snap,1,MPI_INT,root,clustercomm);
+    MPI_Bcast(&box[0][0],9,MPI_DOUBLE,root,clustercomm);
   }
 
   // local copy of snapshot box parameters
@@ -516,10 +944,10 @@ void ReadDump::header(int fieldinfo)
 
   if (!fieldinfo) return;
 
-  MPI_Bcast(&fieldflag,1,MPI_INT,0,clustercomm);
-  MPI_Bcast(&xflag,1,MPI_INT,0,clustercomm);
-  MPI_Bcast(&yflag,1,MPI_INT,0,clustercomm);
-  MPI_Bcast(&zflag,1,MPI_INT,0,clustercomm);
+  MPI_Bcast(&fieldflag,1,MPI_INT,root,clustercomm);
+  MPI_Bcast(&xflag,1,MPI_INT,root,clustercomm);
+  MPI_Bcast(&yflag,1,MPI_INT,root,clustercomm);
+  MPI_Bcast(&zflag,1,MPI_INT,root,clustercomm);
 
   // error check on current vs new box and fields
   // boxinfo == 0 means no box info in file
@@ -698,6 +1126,11 @@ void ReadDump::read_atoms()
   MPI_Request request;
   MPI_Status status;
 
+  if (nprefetch) {
+    prefetch_atoms();
+    return;
+  }
+
   // one reader per cluster of procs
   // each reading proc reads one file and splits data across cluster
   // cluster can be all procs or a subset
@@ -33,9 +33,11 @@ class ReadDump : protected Pointers {
   void command(int, char **);
 
   void store_files(int, char **);
+  void setup_prefetch(int, int, bigint, int, int);
   void setup_reader(int, char **);
   bigint seek(bigint, int);
   void header(int);
+  void skip();
   bigint next(bigint, bigint, int, int);
   void atoms();
   int fields_and_keywords(int, char **);
@@ -97,6 +99,25 @@ private:
                             // nreader-length list of readers if proc reads
                             //   from multiple parallel dump files
 
+  // prefetching of snapshots by background threads, used by rerun
+
+  int nprefetch;            // # of buffered snapshots per frame reader, 0 = off
+  int nframereader;         // # of procs reading different snapshots
+  int myframereader;        // index of my frame reader, -1 if not one
+  bigint iframe;            // index of current snapshot in selected sequence
+  struct DumpPrefetch *prefetch;
+
+  int frame_root(bigint);
+  bigint prefetch_timestep();
+  void prefetch_start(bigint);
+  void prefetch_stop();
+  void prefetch_loop();
+  int prefetch_slot();
+  void prefetch_commit();
+  void prefetch_frame(struct DumpFrame &, bigint, int &);
+  bigint prefetch_scan(int &, bigint, int);
+  void prefetch_atoms();
+
   void read_atoms();
   void process_atoms();
   void migrate_old_atoms();
@@ -185,6 +206,22 @@ E: Cannot add atoms if dump file does not store atom type
 
 UNDOCUMENTED
 
+E: Rerun prefetch requires dump files written by one processor
+
+The prefetch keyword of the rerun command cannot be used with
+multi-file dumps, i.e. dump file names with a "%" character.
+
+E: Rerun prefetch cannot be used with parallel dump readers
+
+The prefetch keyword of the rerun command is not compatible with
+reader styles where all processors read, e.g. format adios.
+
+E: Cannot start thread for rerun prefetch: %s
+
+The C++ runtime could not create a thread, e.g. because LAMMPS was
+built without the -pthread compiler and linker flag.  Use the rerun
+command without the prefetch keyword.
+
 U: No box information in dump. You have to use 'box no'
 
 Self-explanatory.
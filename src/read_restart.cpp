@@ -183,6 +183,9 @@ void ReadRestart::command(int narg, char **arg)
     mpiio->openForRead(file);
     memory->create(buf,assignedChunkSize,"read_restart:buf");
     mpiio->read((headerOffset+assignedChunkOffset),assignedChunkSize,buf);
+    if (checksum_segment)
+      mpiio->verify(headerOffset,mpiio_total,assignedChunkOffset,
+                    assignedChunkSize,buf,checksum_segment);
     mpiio->close();
 
     // can calculate number of atoms from assignedChunkSize
@@ -1009,6 +1012,9 @@ void ReadRestart::force_fields()
 
 void ReadRestart::file_layout()
 {
+  mpiio_total = 0;
+  checksum_segment = 0;
+
   int flag = read_int();
   while (flag >= 0) {
 
@@ -1049,6 +1055,8 @@ void ReadRestart::file_layout()
                          "write_restart:nproc_chunk_number");
 
           utils::sfread(FLERR,all_written_send_sizes,sizeof(int),nprocs_file,fp,nullptr,error);
+          for (int i = 0; i < nprocs_file; ++i)
+            mpiio_total += all_written_send_sizes[i];
 
           if ((nprocs != nprocs_file) && !(atom->nextra_store)) {
             // nprocs differ, but atom sizes are fixed length, yeah!
@@ -1119,7 +1127,15 @@ void ReadRestart::file_layout()
 
         memory->destroy(nproc_chunk_sizes);
         memory->destroy(nproc_chunk_offsets);
+        MPI_Bcast(&mpiio_total,1,MPI_LMP_BIGINT,0,world);
       }
+
+    } else if (flag == CHECKSUM) {
+      checksum_segment = read_bigint();
+
+    } else if (flag == AGGREGATORS) {
+      int naggregators = read_int();
+      mpiio->set_aggregators(MIN(naggregators,nprocs));
     }
 
     flag = read_int();
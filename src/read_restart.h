@@ -45,6 +45,8 @@ class ReadRestart : protected Pointers {
   class RestartMPIIO *mpiio;   // MPIIO for restart file input
   bigint assignedChunkSize;
   MPI_Offset assignedChunkOffset,headerOffset;
+  bigint mpiio_total;          // # of doubles of per-atom data in file
+  bigint checksum_segment;     // # of doubles per checksum, 0 if none
 
   void file_search(char *, char *);
   void header();
@@ -173,6 +173,24 @@ bigint ReaderNative::read_header(double box[3][3], int &boxinfo, int &triclinic,
     return 1;
   }
 
+  match_fields(labels,nfield,fieldtype,fieldlabel,scaleflag,wrapflag,
+               fieldflag,xflag,yflag,zflag);
+
+  return natoms;
+}
+
+/* ----------------------------------------------------------------------
+   match Nfield fields to per-atom column labels
+   allocate and set fieldindex = which column each field maps to
+   set fieldflag = -1 if any fields not found
+   also used by readers for other formats with named columns
+------------------------------------------------------------------------- */
+
+void ReaderNative::match_fields(const std::map<std::string, int> &labels,
+                                int nfield, int *fieldtype, char **fieldlabel,
+                                int scaleflag, int wrapflag, int &fieldflag,
+                                int &xflag, int &yflag, int &zflag)
+{
   // match each field with a column of per-atom data
   // if fieldlabel set, match with explicit column
   // else infer one or more column matches from fieldtype
@@ -297,8 +315,6 @@ bigint ReaderNative::read_header(double box[3][3], int &boxinfo, int &triclinic,
   fieldflag = 0;
   for (int i = 0; i < nfield; i++)
     if (fieldindex[i] < 0) fieldflag = -1;
-
-  return natoms;
 }
 
 /* ----------------------------------------------------------------------
@@ -39,13 +39,17 @@ class ReaderNative : public Reader {
                      int, int, int &, int &, int &, int &);
   void read_atoms(int, int, double **);
 
-private:
-  char *line;              // line read from dump file
-
+protected:
   int nwords;              // # of per-atom columns in dump file
-  int *fieldindex;         //
+  int *fieldindex;         // which column each requested field maps to
 
   int find_label(const std::string &label, const std::map<std::string, int> & labels);
+  void match_fields(const std::map<std::string, int> &, int, int *, char **,
+                    int, int, int &, int &, int &, int &);
+
+private:
+  char *line;              // line read from dump file
+
   void read_lines(int);
 };
 
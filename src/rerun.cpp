@@ -14,22 +14,26 @@
 #include "rerun.h"
 
 #include "domain.h"
+#include "comm.h"
 #include "error.h"
 #include "finish.h"
 #include "integrate.h"
 #include "modify.h"
 #include "output.h"
 #include "read_dump.h"
+#include "thermo.h"
 #include "timer.h"
+#include "universe.h"
 #include "update.h"
 
+#include <algorithm>
 #include <cstring>
 
 using namespace LAMMPS_NS;
 
 /* ---------------------------------------------------------------------- */
 
-Rerun::Rerun(LAMMPS *lmp) : Pointers(lmp) {}
+Rerun::Rerun(LAMMPS *lmp) : Pointers(lmp), partflag(0) {}
 
 /* ---------------------------------------------------------------------- */
 
@@ -50,6 +54,9 @@ void Rerun::command(int narg, char **arg)
     if (strcmp(arg[iarg],"skip") == 0) break;
     if (strcmp(arg[iarg],"start") == 0) break;
     if (strcmp(arg[iarg],"stop") == 0) break;
+    if (strcmp(arg[iarg],"prefetch") == 0) break;
+    if (strcmp(arg[iarg],"readers") == 0) break;
+    if (strcmp(arg[iarg],"partition") == 0) break;
     if (strcmp(arg[iarg],"dump") == 0) break;
     iarg++;
   }
@@ -67,6 +74,9 @@ void Rerun::command(int narg, char **arg)
   int stopflag = 0;
   bigint start = -1;
   bigint stop = -1;
+  int nprefetch = 0;
+  int nframereader = 1;
+  int readersflag = 0;
 
   while (iarg < narg) {
     if (strcmp(arg[iarg],"first") == 0) {
@@ -101,6 +111,23 @@ void Rerun::command(int narg, char **arg)
       stop = utils::bnumeric(FLERR,arg[iarg+1],false,lmp);
       if (stop < 0) error->all(FLERR,"Illegal rerun command");
       iarg += 2;
+    } else if (strcmp(arg[iarg],"prefetch") == 0) {
+      if (iarg+2 > narg) error->all(FLERR,"Illegal rerun command");
+      nprefetch = utils::inumeric(FLERR,arg[iarg+1],false,lmp);
+      if (nprefetch < 0) error->all(FLERR,"Illegal rerun command");
+      iarg += 2;
+    } else if (strcmp(arg[iarg],"readers") == 0) {
+      if (iarg+2 > narg) error->all(FLERR,"Illegal rerun command");
+      nframereader = utils::inumeric(FLERR,arg[iarg+1],false,lmp);
+      if (nframereader <= 0) error->all(FLERR,"Illegal rerun command");
+      readersflag = 1;
+      iarg += 2;
+    } else if (strcmp(arg[iarg],"partition") == 0) {
+      if (iarg+2 > narg) error->all(FLERR,"Illegal rerun command");
+      if (strcmp(arg[iarg+1],"yes") == 0) partflag = 1;
+      else if (strcmp(arg[iarg+1],"no") == 0) partflag = 0;
+      else error->all(FLERR,"Illegal rerun command");
+      iarg += 2;
     } else if (strcmp(arg[iarg],"dump") == 0) {
       break;
     } else error->all(FLERR,"Illegal rerun command");
@@ -111,6 +138,9 @@ void Rerun::command(int narg, char **arg)
   if (first > last) error->all(FLERR,"Illegal rerun command");
   if (startflag && stopflag && start > stop)
     error->all(FLERR,"Illegal rerun command");
+  if (readersflag && nprefetch == 0)
+    error->all(FLERR,"Rerun readers keyword requires prefetch");
+  if (universe->nworlds == 1) partflag = 0;
 
   // pass list of filenames to ReadDump
   // along with post-"dump" args and post-"format" args
@@ -118,6 +148,7 @@ void Rerun::command(int narg, char **arg)
   ReadDump *rd = new ReadDump(lmp);
 
   rd->store_files(nfile,arg);
+  if (nprefetch) rd->setup_prefetch(nprefetch,nframereader,last,nevery,nskip);
   if (nremain)
     nremain = rd->fields_and_keywords(nremain,&arg[narg-nremain]);
   else nremain = rd->fields_and_keywords(0,nullptr);
@@ -127,6 +158,8 @@ void Rerun::command(int narg, char **arg)
   // perform the pseudo run
   // invoke lmp->init() only once
   // read all relevant snapshots
+  // with partflag, each partition processes every Nworlds-th snapshot
+  //   of the selected sequence, starting with snapshot Iworld
   // use setup_minimal() since atoms are already owned by correct procs
   // addstep_compute_all() insures energy/virial computed on every snapshot
 
@@ -149,7 +182,19 @@ void Rerun::command(int narg, char **arg)
   if (ntimestep < 0)
     error->all(FLERR,"Rerun dump file does not contain requested snapshot");
 
+  int nstride = partflag ? universe->nworlds : 1;
+  int nadvance = partflag ? universe->iworld : 0;
+
   while (1) {
+    for (int i = 0; i < nadvance && ntimestep >= 0; i++) {
+      rd->skip();
+      ntimestep = rd->next(ntimestep,last,nevery,nskip);
+      if (stopflag && ntimestep > stop)
+        error->all(FLERR,"Read rerun dump file timestep > specified stop");
+    }
+    if (ntimestep < 0) break;
+    nadvance = nstride - 1;
+
     ndump++;
     rd->header(firstflag);
     update->reset_timestep(ntimestep);
@@ -158,20 +203,39 @@ void Rerun::command(int narg, char **arg)
     modify->init();
     update->integrate->setup_minimal(1);
     modify->end_of_step();
-    if (firstflag) output->setup();
-    else if (output->next) output->write(ntimestep);
+    if (firstflag) {
+      output->setup();
+
+      // setup always outputs thermo, keep it where a single partition would
+
+      if (universe->iworld == 0 ||
+          (!output->var_thermo && output->thermo_every &&
+           ntimestep % output->thermo_every == 0))
+        record_thermo(ntimestep);
+    } else if (output->next) {
+      output->write(ntimestep);
+      record_thermo(ntimestep);
+    }
 
     firstflag = 0;
     ntimestep = rd->next(ntimestep,last,nevery,nskip);
     if (stopflag && ntimestep > stop)
       error->all(FLERR,"Read rerun dump file timestep > specified stop");
-    if (ntimestep < 0) break;
   }
 
   // insure thermo output on last dump timestep
+  // with partflag, only the partition that processed the last snapshot
 
-  output->next_thermo = update->ntimestep;
-  output->write(update->ntimestep);
+  bigint lastdump = ndump ? update->ntimestep : -1;
+  if (partflag) {
+    bigint mylast = lastdump;
+    MPI_Allreduce(&mylast,&lastdump,1,MPI_LMP_BIGINT,MPI_MAX,universe->uworld);
+  }
+  if (ndump && update->ntimestep == lastdump) {
+    output->next_thermo = update->ntimestep;
+    output->write(update->ntimestep);
+    record_thermo(update->ntimestep);
+  }
 
   timer->barrier_stop();
 
@@ -181,6 +245,8 @@ void Rerun::command(int narg, char **arg)
 
   update->nsteps = ndump;
 
+  if (partflag) merge_thermo();
+
   Finish finish(lmp);
   finish.end(1);
 
@@ -192,3 +258,97 @@ void Rerun::command(int narg, char **arg)
 
   delete rd;
 }
+
+/* ----------------------------------------------------------------------
+   store thermo output of snapshot at Ntimestep for merging across partitions
+------------------------------------------------------------------------- */
+
+void Rerun::record_thermo(bigint ntimestep)
+{
+  if (!partflag || comm->me != 0) return;
+  if (output->last_thermo != ntimestep) return;
+  if (!thermo_steps.empty() && thermo_steps.back() == ntimestep) return;
+
+  std::string line(output->thermo->line);
+  thermo_steps.push_back(ntimestep);
+  thermo_len.push_back(line.size());
+  thermo_text += line;
+}
+
+/* ----------------------------------------------------------------------
+   gather thermo output of all partitions on universe proc 0
+   and write it in timestep order to universe screen and logfile
+------------------------------------------------------------------------- */
+
+void Rerun::merge_thermo()
+{
+  int me = universe->me;
+  int nprocs = universe->nprocs;
+
+  int counts[2];
+  counts[0] = thermo_steps.size();
+  counts[1] = thermo_text.size();
+
+  std::vector<int> allcounts;
+  if (me == 0) allcounts.resize(2*nprocs);
+  MPI_Gather(counts,2,MPI_INT,allcounts.data(),2,MPI_INT,0,universe->uworld);
+
+  std::vector<int> nsteps,nchars,displs,cdispls;
+  int nall = 0, nallchar = 0;
+  if (me == 0) {
+    nsteps.resize(nprocs);
+    nchars.resize(nprocs);
+    displs.resize(nprocs);
+    cdispls.resize(nprocs);
+    for (int iproc = 0; iproc < nprocs; iproc++) {
+      nsteps[iproc] = allcounts[2*iproc];
+      nchars[iproc] = allcounts[2*iproc+1];
+      displs[iproc] = nall;
+      cdispls[iproc] = nallchar;
+      nall += nsteps[iproc];
+      nallchar += nchars[iproc];
+    }
+  }
+
+  std::vector<bigint> allsteps(MAX(nall,1));
+  std::vector<int> alllen(MAX(nall,1));
+  std::vector<char> alltext(MAX(nallchar,1));
+
+  MPI_Gatherv(thermo_steps.data(),counts[0],MPI_LMP_BIGINT,allsteps.data(),
+              nsteps.data(),displs.data(),MPI_LMP_BIGINT,0,universe->uworld);
+  MPI_Gatherv(thermo_len.data(),counts[0],MPI_INT,alllen.data(),
+              nsteps.data(),displs.data(),MPI_INT,0,universe->uworld);
+  MPI_Gatherv(&thermo_text[0],counts[1],MPI_CHAR,alltext.data(),
+              nchars.data(),cdispls.data(),MPI_CHAR,0,universe->uworld);
+
+  thermo_steps.clear();
+  thermo_len.clear();
+  thermo_text.clear();
+
+  if (me != 0) return;
+
+  // sort thermo output of all partitions by timestep
+
+  std::vector<int> offset(nall);
+  for (int i = 0, n = 0; i < nall; i++) {
+    offset[i] = n;
+    n += alllen[i];
+  }
+
+  std::vector<int> order(nall);
+  for (int i = 0; i < nall; i++) order[i] = i;
+  std::stable_sort(order.begin(),order.end(),
+                   [&allsteps](int i, int j) { return allsteps[i] < allsteps[j]; });
+
+  std::string mesg;
+  Thermo *thermo = output->thermo;
+  if (strcmp(thermo->style,"multi") != 0) {
+    for (int i = 0; i < thermo->nfield; i++)
+      mesg += thermo->keyword[i] + std::string(" ");
+    mesg += "\n";
+  }
+  for (int i : order) mesg.append(&alltext[offset[i]],alllen[i]);
+
+  if (universe->uscreen) fputs(mesg.c_str(),universe->uscreen);
+  if (universe->ulogfile) fputs(mesg.c_str(),universe->ulogfile);
+}
@@ -22,12 +22,23 @@ CommandStyle(rerun,Rerun)
 
 #include "pointers.h"
 
+#include <vector>
+
 namespace LAMMPS_NS {
 
 class Rerun : protected Pointers {
  public:
   Rerun(class LAMMPS *);
   void command(int, char **);
+
+ private:
+  int partflag;                     // 1 if snapshots are split across partitions
+  std::vector<bigint> thermo_steps; // timesteps of my thermo output
+  std::vector<int> thermo_len;      // length of each thermo output
+  std::string thermo_text;          // thermo output of all steps
+
+  void record_thermo(bigint);
+  void merge_thermo();
 };
 
 }
@@ -56,4 +67,9 @@ E: Read rerun dump file timestep > specified stop
 
 Self-explanatory.
 
+E: Rerun readers keyword requires prefetch
+
+The readers keyword sets the number of processors reading snapshots
+ahead of time, which is only done with a prefetch value > 0.
+
 */
@@ -22,6 +22,7 @@ class Thermo : protected Pointers {
   friend class MinCG;                  // accesses compute_pe
   friend class DumpNetCDF;             // accesses thermo properties
   friend class DumpNetCDFMPIIO;        // accesses thermo properties
+  friend class Rerun;                  // accesses thermo output line
 
  public:
   char *style;
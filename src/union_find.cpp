@@ -0,0 +1,414 @@
+/* ----------------------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://lammps.sandia.gov/, Sandia National Laboratories
+   Steve Plimpton, sjplimp@sandia.gov
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+/* ----------------------------------------------------------------------
+   distributed union-find of owned and ghost atoms into clusters
+   callers join pairs of atoms they find connected on this proc,
+   merge() assigns each atom the smallest atom ID in its global cluster:
+     forward comm of labels of local sets,
+     equivalences of labels of sets on different procs are merged
+       by the procs owning the labels, label % nprocs,
+       in rounds of irregular comm and pointer jumping,
+     reverse and forward comm to update sets not part of the equivalences
+------------------------------------------------------------------------- */
+
+#include "union_find.h"
+
+#include "atom.h"
+#include "comm.h"
+#include "compute.h"
+#include "irregular.h"
+#include "memory.h"
+
+#include <algorithm>
+
+using namespace LAMMPS_NS;
+
+/* ---------------------------------------------------------------------- */
+
+UnionFind::UnionFind(LAMMPS *lmp) : Pointers(lmp)
+{
+  nmax = nall = 0;
+  parent = nullptr;
+  size = nullptr;
+  label = nullptr;
+}
+
+/* ---------------------------------------------------------------------- */
+
+UnionFind::~UnionFind()
+{
+  memory->destroy(parent);
+  memory->destroy(size);
+  memory->destroy(label);
+}
+
+/* ----------------------------------------------------------------------
+   put each of N owned + ghost atoms into its own set
+------------------------------------------------------------------------- */
+
+void UnionFind::reset(int n)
+{
+  if (n > nmax) {
+    memory->destroy(parent);
+    memory->destroy(size);
+    memory->destroy(label);
+    nmax = atom->nmax;
+    memory->create(parent,nmax,"union_find:parent");
+    memory->create(size,nmax,"union_find:size");
+    memory->create(label,nmax,"union_find:label");
+  }
+
+  nall = n;
+  for (int i = 0; i < nall; i++) {
+    parent[i] = i;
+    size[i] = 1;
+  }
+}
+
+/* ----------------------------------------------------------------------
+   return root of set of atom I, halve path to root on the way
+------------------------------------------------------------------------- */
+
+int UnionFind::find(int i)
+{
+  while (parent[i] != i) {
+    parent[i] = parent[parent[i]];
+    i = parent[i];
+  }
+  return i;
+}
+
+/* ----------------------------------------------------------------------
+   join sets of atoms I and J, attach smaller set to larger one
+------------------------------------------------------------------------- */
+
+void UnionFind::join(int i, int j)
+{
+  i = find(i);
+  j = find(j);
+  if (i == j) return;
+
+  if (size[i] < size[j]) std::swap(i,j);
+  parent[j] = i;
+  size[i] += size[j];
+}
+
+/* ----------------------------------------------------------------------
+   set ID of all owned and ghost atoms in group to smallest atom ID in
+     their global cluster, ID of atoms not in group to 0
+   Compute must forward and reverse communicate ID when invoked,
+     reverse comm must keep the minimum of the ghost and owned value
+------------------------------------------------------------------------- */
+
+void UnionFind::merge(Compute *compute, int groupbit, double *id)
+{
+  local_labels(groupbit,id);
+  comm->forward_comm_compute(compute);
+  merge_labels(groupbit,id);
+  comm->reverse_comm_compute(compute);
+  final_labels(groupbit,id);
+  comm->forward_comm_compute(compute);
+}
+
+/* ----------------------------------------------------------------------
+   label of each local set = smallest atom ID in set
+   ghost atoms that are images of another local atom join its set
+------------------------------------------------------------------------- */
+
+void UnionFind::local_labels(int groupbit, double *id)
+{
+  int nlocal = atom->nlocal;
+  tagint *tag = atom->tag;
+  int *mask = atom->mask;
+
+  for (int i = nlocal; i < nall; i++) {
+    if (!(mask[i] & groupbit)) continue;
+    int k = atom->map(tag[i]);
+    if (k >= 0 && k != i && (mask[k] & groupbit)) join(i,k);
+  }
+
+  for (int i = 0; i < nall; i++) label[i] = tag[i];
+  for (int i = 0; i < nall; i++) {
+    int r = find(i);
+    label[r] = MIN(label[r],tag[i]);
+  }
+
+  for (int i = 0; i < nall; i++) {
+    if (mask[i] & groupbit) id[i] = label[find(i)];
+    else id[i] = 0.0;
+  }
+}
+
+/* ----------------------------------------------------------------------
+   ID of ghost atoms = label of the set of the owned atom on its proc
+   each ghost atom in a set with other atoms makes its local set and the
+     set of its owned atom equivalent
+   equivalences are merged into a forest of labels distributed over procs
+   set ID of atoms in merged sets to global label
+------------------------------------------------------------------------- */
+
+void UnionFind::merge_labels(int groupbit, double *id)
+{
+  int nlocal = atom->nlocal;
+  int *mask = atom->mask;
+
+  std::vector<Edge> edges;
+  std::vector<tagint> labels;
+  for (int i = nlocal; i < nall; i++) {
+    if (!(mask[i] & groupbit)) continue;
+    int r = find(i);
+    if (size[r] == 1) continue;
+    labels.push_back(label[r]);
+    tagint other = (tagint) id[i];
+    if (other > label[r]) edges.push_back({other,label[r]});
+    else if (other < label[r]) edges.push_back({label[r],other});
+  }
+
+  std::sort(labels.begin(),labels.end());
+  labels.erase(std::unique(labels.begin(),labels.end()),labels.end());
+
+  // merge equivalences into trees, then point each label to its root
+
+  link_labels(edges);
+  jump_labels();
+
+  // request global label of each local set from proc owning its label
+
+  int nlabel = labels.size();
+  LabelRvous *query = (LabelRvous *)
+    memory->smalloc((bigint) MAX(nlabel,1)*sizeof(LabelRvous),
+                    "union_find:query");
+  for (int i = 0; i < nlabel; i++) query[i].label = labels[i];
+  int nreturn = parent_labels(nlabel,query);
+
+  // replace labels of local sets with global label
+
+  std::unordered_map<tagint,tagint> root;
+  for (int i = 0; i < nreturn; i++) root[query[i].label] = query[i].root;
+  memory->sfree(query);
+  up.clear();
+
+  for (int i = 0; i < nall; i++) {
+    if (parent[i] != i) continue;
+    auto it = root.find(label[i]);
+    if (it != root.end()) label[i] = it->second;
+  }
+
+  // ghost atoms not connected to other local atoms keep label of owned atom
+
+  for (int i = 0; i < nall; i++) {
+    if (!(mask[i] & groupbit)) continue;
+    int r = find(i);
+    if (i < nlocal || size[r] > 1) id[i] = label[r];
+  }
+}
+
+/* ----------------------------------------------------------------------
+   ID of owned atoms = minimum of its global label on all procs
+   propagate smallest ID of atoms in each local set to all its atoms
+------------------------------------------------------------------------- */
+
+void UnionFind::final_labels(int groupbit, double *id)
+{
+  int nlocal = atom->nlocal;
+  int *mask = atom->mask;
+
+  for (int i = 0; i < nall; i++) {
+    if (!(mask[i] & groupbit)) continue;
+    int r = find(i);
+    if (i < nlocal || size[r] > 1) label[r] = MIN(label[r],(tagint) id[i]);
+  }
+
+  for (int i = 0; i < nall; i++)
+    if (mask[i] & groupbit) id[i] = label[find(i)];
+}
+
+/* ----------------------------------------------------------------------
+   merge equivalences of labels into forest of labels owned by each proc
+   in each round, every edge is sent to the proc owning its larger label,
+     which points that label to the smallest label of all its edges and
+     its current parent, and replaces the edges by edges from the other
+     labels to this new parent
+   largest label of all edges decreases in every round, so number of
+     rounds is bounded by length of longest chain of labels,
+     in practice only a few rounds are needed
+------------------------------------------------------------------------- */
+
+void UnionFind::link_labels(std::vector<Edge> &edges)
+{
+  int nprocs = comm->nprocs;
+  Irregular *irregular = new Irregular(lmp);
+  std::vector<Edge> recv;
+
+  while (1) {
+    bigint nedge = edges.size();
+    bigint nedgeall;
+    MPI_Allreduce(&nedge,&nedgeall,1,MPI_LMP_BIGINT,MPI_SUM,world);
+    if (nedgeall == 0) break;
+
+    int nsend = edges.size();
+    int *proclist;
+    memory->create(proclist,MAX(nsend,1),"union_find:proclist");
+    for (int i = 0; i < nsend; i++) proclist[i] = edges[i].hi % nprocs;
+    int nrecv = irregular->create_data(nsend,proclist);
+    recv.resize(MAX(nrecv,1));
+    irregular->exchange_data((char *) edges.data(),sizeof(Edge),
+                             (char *) recv.data());
+    irregular->destroy_data();
+    memory->destroy(proclist);
+
+    // edges with same larger label are consecutive, smallest label first
+
+    std::sort(recv.begin(),recv.begin()+nrecv,[](const Edge &a, const Edge &b)
+              { return a.hi < b.hi || (a.hi == b.hi && a.lo < b.lo); });
+
+    edges.clear();
+    int i = 0;
+    while (i < nrecv) {
+      tagint hi = recv[i].hi;
+      tagint root = recv[i].lo;
+      auto it = up.find(hi);
+      if (it != up.end()) {
+        if (it->second > root) edges.push_back({it->second,root});
+        else root = it->second;
+      }
+      up[hi] = root;
+
+      for (tagint prev = root; i < nrecv && recv[i].hi == hi; i++) {
+        if (recv[i].lo != prev) edges.push_back({recv[i].lo,root});
+        prev = recv[i].lo;
+      }
+    }
+  }
+
+  delete irregular;
+}
+
+/* ----------------------------------------------------------------------
+   point each owned label to root of its tree by pointer jumping
+   depth of trees halves in every round
+------------------------------------------------------------------------- */
+
+void UnionFind::jump_labels()
+{
+  std::vector<tagint> active;
+  for (auto &kv : up) active.push_back(kv.first);
+
+  while (1) {
+    bigint nactive = active.size();
+    bigint nactiveall;
+    MPI_Allreduce(&nactive,&nactiveall,1,MPI_LMP_BIGINT,MPI_SUM,world);
+    if (nactiveall == 0) break;
+
+    // request parent of parent of each active label
+
+    std::vector<tagint> parents;
+    for (auto x : active) parents.push_back(up[x]);
+    std::sort(parents.begin(),parents.end());
+    parents.erase(std::unique(parents.begin(),parents.end()),parents.end());
+
+    int nquery = parents.size();
+    LabelRvous *query = (LabelRvous *)
+      memory->smalloc((bigint) MAX(nquery,1)*sizeof(LabelRvous),
+                      "union_find:query");
+    for (int i = 0; i < nquery; i++) query[i].label = parents[i];
+    int nreturn = parent_labels(nquery,query);
+
+    std::unordered_map<tagint,tagint> grandparent;
+    for (int i = 0; i < nreturn; i++)
+      grandparent[query[i].label] = query[i].root;
+    memory->sfree(query);
+
+    // labels whose parent is a root are done
+
+    int n = 0;
+    for (auto x : active) {
+      tagint &p = up[x];
+      tagint pp = grandparent[p];
+      if (pp == p) continue;
+      p = pp;
+      active[n++] = x;
+    }
+    active.resize(n);
+  }
+}
+
+/* ----------------------------------------------------------------------
+   request parent of N labels from procs owning them
+   query = N LabelRvous datums with label set, realloced to returned datums
+   return # of returned datums with root = parent of label, label for roots
+------------------------------------------------------------------------- */
+
+int UnionFind::parent_labels(int n, LabelRvous *&query)
+{
+  int me = comm->me;
+  int nprocs = comm->nprocs;
+
+  int *proclist;
+  memory->create(proclist,MAX(n,1),"union_find:proclist");
+  for (int i = 0; i < n; i++) {
+    query[i].proc = me;
+    proclist[i] = query[i].label % nprocs;
+  }
+
+  char *buf;
+  int nreturn = comm->rendezvous(0,n,(char *) query,sizeof(LabelRvous),
+                                 0,proclist,find_parents,
+                                 0,buf,sizeof(LabelRvous),(void *) this);
+  memory->destroy(proclist);
+  memory->sfree(query);
+  query = (LabelRvous *) buf;
+  return nreturn;
+}
+
+/* ----------------------------------------------------------------------
+   process parent requests of labels assigned to me in rendezvous decomposition
+   inbuf = list of N LabelRvous datums
+   outbuf = same list with parent of each label, sent back to requesting proc
+------------------------------------------------------------------------- */
+
+int UnionFind::find_parents(int n, char *inbuf,
+                            int &flag, int *&proclist, char *&outbuf,
+                            void *ptr)
+{
+  UnionFind *uptr = (UnionFind *) ptr;
+  Memory *memory = uptr->memory;
+
+  LabelRvous *in = (LabelRvous *) inbuf;
+
+  memory->create(proclist,n,"union_find:proclist");
+  for (int i = 0; i < n; i++) {
+    proclist[i] = in[i].proc;
+    auto it = uptr->up.find(in[i].label);
+    in[i].root = (it != uptr->up.end()) ? it->second : in[i].label;
+  }
+
+  outbuf = inbuf;
+
+  // flag = 1: outbuf = inbuf
+
+  flag = 1;
+  return n;
+}
+
+/* ----------------------------------------------------------------------
+   memory usage of local atom-based arrays
+------------------------------------------------------------------------- */
+
+double UnionFind::memory_usage()
+{
+  double bytes = (double)2*nmax * sizeof(int);
+  bytes += (double)nmax * sizeof(tagint);
+  return bytes;
+}
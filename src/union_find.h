@@ -0,0 +1,68 @@
+/* -*- c++ -*- ----------------------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://lammps.sandia.gov/, Sandia National Laboratories
+   Steve Plimpton, sjplimp@sandia.gov
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#ifndef LMP_UNION_FIND_H
+#define LMP_UNION_FIND_H
+
+#include "pointers.h"
+
+#include <unordered_map>
+#include <vector>
+
+namespace LAMMPS_NS {
+
+class UnionFind : protected Pointers {
+ public:
+  struct Edge {
+    tagint hi,lo;          // two equivalent labels, hi > lo
+  };
+
+  struct LabelRvous {
+    tagint label,root;     // label and label of its parent or global set
+    int proc;              // proc which requested the parent
+  };
+
+  UnionFind(class LAMMPS *);
+  ~UnionFind();
+  void reset(int);
+  void join(int, int);
+  void merge(class Compute *, int, double *);
+  double memory_usage();
+
+ private:
+  int nmax,nall;
+  int *parent;             // parent of each owned and ghost atom in its set
+  int *size;               // # of atoms in a set, valid for roots
+  tagint *label;           // smallest atom ID in a set, valid for roots
+
+  // forest of equivalent labels owned by this proc, label % nprocs = me
+  // each label points to a smaller one, roots are not stored
+
+  std::unordered_map<tagint,tagint> up;
+
+  int find(int);
+  void local_labels(int, double *);
+  void merge_labels(int, double *);
+  void final_labels(int, double *);
+  void link_labels(std::vector<Edge> &);
+  void jump_labels();
+  int parent_labels(int, LabelRvous *&);
+
+  // callback function for rendezvous communication
+
+  static int find_parents(int, char *, int &, int *&, char *&, void *);
+};
+
+}
+
+#endif
@@ -585,6 +585,88 @@ std::string utils::trim_comment(const std::string &line)
   return std::string(line);
 }
 
+/* ----------------------------------------------------------------------
+   Translate printf() format with one conversion into {fmt} format
+   return empty string if not possible with identical output
+------------------------------------------------------------------------- */
+
+std::string utils::printf2fmt(const std::string &format,
+                              const std::string &convs)
+{
+  std::string out;
+  int nconv = 0;
+  std::size_t i = 0;
+  const std::size_t n = format.size();
+
+  while (i < n) {
+    char c = format[i++];
+    if ((c == '{') || (c == '}')) {
+      out += c;
+      out += c;
+      continue;
+    }
+    if (c != '%') {
+      out += c;
+      continue;
+    }
+    if ((i < n) && (format[i] == '%')) {
+      out += '%';
+      ++i;
+      continue;
+    }
+
+    bool left = false, plus = false, space = false, zero = false;
+    while ((i < n) && strchr("-+ 0#",format[i])) {
+      switch (format[i++]) {
+      case '-': left = true; break;
+      case '+': plus = true; break;
+      case ' ': space = true; break;
+      case '0': zero = true; break;
+      default: return "";
+      }
+    }
+
+    std::string width, prec;
+    bool hasprec = false;
+    while ((i < n) && isdigit(format[i])) width += format[i++];
+    if ((i < n) && (format[i] == '.')) {
+      hasprec = true;
+      ++i;
+      while ((i < n) && isdigit(format[i])) prec += format[i++];
+      if (prec.empty()) prec = "0";
+    }
+    while ((i < n) && strchr("hlLqjzt",format[i])) ++i;
+    if (i >= n) return "";
+
+    char conv = format[i++];
+    if (convs.find(conv) == std::string::npos) return "";
+    if (++nconv > 1) return "";
+
+    // integers have no precision in {fmt} and strings no sign or zero-padding
+    // {fmt} pads inf and nan with zeros and aligns them left by default,
+    //   so reject zero-padded floats and make right alignment explicit
+
+    bool isint = (conv == 'd') || (conv == 'i');
+    if (isint && hasprec) return "";
+    if ((conv == 's') && (plus || space || zero)) return "";
+    if (!isint && (conv != 's') && zero && !left) return "";
+
+    out += "{:";
+    if (left) out += '<';
+    else if (!width.empty() && !zero) out += '>';
+    if (plus) out += '+';
+    else if (space) out += ' ';
+    if (zero && !left) out += '0';
+    out += width;
+    if (hasprec) out += "." + prec;
+    out += isint ? 'd' : conv;
+    out += '}';
+  }
+
+  if (nconv != 1) return "";
+  return out;
+}
+
 /* ----------------------------------------------------------------------
    Replace UTF-8 encoded chars with known ASCII equivalents
 ------------------------------------------------------------------------- */
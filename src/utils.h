@@ -220,6 +220,21 @@ namespace LAMMPS_NS {
 
     std::string trim_comment(const std::string &line);
 
+    /** Translate a C-style printf() format into a {fmt} library format
+     *
+     * The format must contain exactly one conversion, which must be
+     * one of the characters in *convs*.  Length modifiers are dropped
+     * and literal braces are escaped.  Conversions that {fmt} would
+     * render differently from printf() (e.g. the '#' flag, '*' width,
+     * or a precision for integers) are rejected.
+     *
+     * \param format  printf() style format string, e.g. "%-10.4g "
+     * \param convs   accepted conversion characters, e.g. "eEfFgG"
+     * \return        equivalent {fmt} format, e.g. "{:<10.4g} ",
+     *                or an empty string if there is none */
+
+    std::string printf2fmt(const std::string &format, const std::string &convs);
+
     /** Check if a string will likely have UTF-8 encoded characters
      *
      * UTF-8 uses the 7-bit standard ASCII table for the first 127 characters and
@@ -36,6 +36,9 @@
 
 using namespace LAMMPS_NS;
 
+#define BINARY_VERSION 1         // also in ReadData
+#define BINARY_MAGIC 0x4c4d5044  // also in ReadData
+
 enum{II,IJ};
 enum{ELLIPSOID,LINE,TRIANGLE,BODY};   // also in AtomVecHybrid
 
@@ -71,6 +74,7 @@ void WriteData::command(int narg, char **arg)
   pairflag = II;
   coeffflag = 1;
   fixflag = 1;
+  binaryflag = 0;
   int noinit = 0;
 
   int iarg = 1;
@@ -90,6 +94,9 @@ void WriteData::command(int narg, char **arg)
     } else if (strcmp(arg[iarg],"nofix") == 0) {
       fixflag = 0;
       iarg++;
+    } else if (strcmp(arg[iarg],"binary") == 0) {
+      binaryflag = 1;
+      iarg++;
     } else error->all(FLERR,"Illegal write_data command");
   }
 
@@ -232,6 +239,7 @@ void WriteData::header()
              "timestep = {}\n\n",lmp->version,update->ntimestep);
 
   fmt::print(fp,"{} atoms\n{} atom types\n",atom->natoms,atom->ntypes);
+  if (binaryflag) fmt::print(fp,"{} binary format\n",BINARY_VERSION);
 
   // only write out number of types for atom style template
 
@@ -349,6 +357,9 @@ void WriteData::atoms()
   int sendrow = atom->nlocal;
   int maxrow;
   MPI_Allreduce(&sendrow,&maxrow,1,MPI_INT,MPI_MAX,world);
+  bigint nrow = sendrow;
+  bigint nrowall;
+  MPI_Allreduce(&nrow,&nrowall,1,MPI_LMP_BIGINT,MPI_SUM,world);
 
   double **buf;
   if (me == 0) memory->create(buf,MAX(1,maxrow),ncol,"write_data:buf");
@@ -369,6 +380,7 @@ void WriteData::atoms()
     MPI_Request request;
 
     fmt::print(fp,"\nAtoms # {}\n\n",atom->atom_style);
+    if (binaryflag) binary_descriptor(nrowall,ncol);
     for (int iproc = 0; iproc < nprocs; iproc++) {
       if (iproc) {
         MPI_Irecv(&buf[0][0],maxrow*ncol,MPI_DOUBLE,iproc,0,world,&request);
@@ -378,7 +390,9 @@ void WriteData::atoms()
         recvrow /= ncol;
       } else recvrow = sendrow;
 
-      atom->avec->write_data(fp,recvrow,buf);
+      if (binaryflag)
+        fwrite(&buf[0][0],sizeof(double),(size_t) recvrow*ncol,fp);
+      else atom->avec->write_data(fp,recvrow,buf);
     }
 
   } else {
@@ -402,6 +416,9 @@ void WriteData::velocities()
   int sendrow = atom->nlocal;
   int maxrow;
   MPI_Allreduce(&sendrow,&maxrow,1,MPI_INT,MPI_MAX,world);
+  bigint nrow = sendrow;
+  bigint nrowall;
+  MPI_Allreduce(&nrow,&nrowall,1,MPI_LMP_BIGINT,MPI_SUM,world);
 
   double **buf;
   if (me == 0) memory->create(buf,MAX(1,maxrow),ncol,"write_data:buf");
@@ -422,6 +439,7 @@ void WriteData::velocities()
     MPI_Request request;
 
     fputs("\nVelocities\n\n",fp);
+    if (binaryflag) binary_descriptor(nrowall,ncol);
     for (int iproc = 0; iproc < nprocs; iproc++) {
       if (iproc) {
         MPI_Irecv(&buf[0][0],maxrow*ncol,MPI_DOUBLE,iproc,0,world,&request);
@@ -431,7 +449,9 @@ void WriteData::velocities()
         recvrow /= ncol;
       } else recvrow = sendrow;
 
-      atom->avec->write_vel(fp,recvrow,buf);
+      if (binaryflag)
+        fwrite(&buf[0][0],sizeof(double),(size_t) recvrow*ncol,fp);
+      else atom->avec->write_vel(fp,recvrow,buf);
     }
 
   } else {
@@ -476,6 +496,7 @@ void WriteData::bonds()
     MPI_Request request;
 
     fputs("\nBonds\n\n",fp);
+    if (binaryflag) binary_descriptor(nbonds,ncol);
     for (int iproc = 0; iproc < nprocs; iproc++) {
       if (iproc) {
         MPI_Irecv(&buf[0][0],maxrow*ncol,MPI_LMP_TAGINT,iproc,0,world,&request);
@@ -485,7 +506,8 @@ void WriteData::bonds()
         recvrow /= ncol;
       } else recvrow = sendrow;
 
-      atom->avec->write_bond(fp,recvrow,buf,index);
+      if (binaryflag) binary_rows(recvrow,ncol,buf);
+      else atom->avec->write_bond(fp,recvrow,buf,index);
       index += recvrow;
     }
 
@@ -531,6 +553,7 @@ void WriteData::angles()
     MPI_Request request;
 
     fputs("\nAngles\n\n",fp);
+    if (binaryflag) binary_descriptor(nangles,ncol);
     for (int iproc = 0; iproc < nprocs; iproc++) {
       if (iproc) {
         MPI_Irecv(&buf[0][0],maxrow*ncol,MPI_LMP_TAGINT,iproc,0,world,&request);
@@ -540,7 +563,8 @@ void WriteData::angles()
         recvrow /= ncol;
       } else recvrow = sendrow;
 
-      atom->avec->write_angle(fp,recvrow,buf,index);
+      if (binaryflag) binary_rows(recvrow,ncol,buf);
+      else atom->avec->write_angle(fp,recvrow,buf,index);
       index += recvrow;
     }
 
@@ -586,6 +610,7 @@ void WriteData::dihedrals()
     MPI_Request request;
 
     fputs("\nDihedrals\n\n",fp);
+    if (binaryflag) binary_descriptor(ndihedrals,ncol);
     for (int iproc = 0; iproc < nprocs; iproc++) {
       if (iproc) {
         MPI_Irecv(&buf[0][0],maxrow*ncol,MPI_LMP_TAGINT,iproc,0,world,&request);
@@ -595,7 +620,8 @@ void WriteData::dihedrals()
         recvrow /= ncol;
       } else recvrow = sendrow;
 
-      atom->avec->write_dihedral(fp,recvrow,buf,index);
+      if (binaryflag) binary_rows(recvrow,ncol,buf);
+      else atom->avec->write_dihedral(fp,recvrow,buf,index);
       index += recvrow;
     }
 
@@ -641,6 +667,7 @@ void WriteData::impropers()
     MPI_Request request;
 
     fputs("\nImpropers\n\n",fp);
+    if (binaryflag) binary_descriptor(nimpropers,ncol);
     for (int iproc = 0; iproc < nprocs; iproc++) {
       if (iproc) {
         MPI_Irecv(&buf[0][0],maxrow*ncol,MPI_LMP_TAGINT,iproc,0,world,&request);
@@ -650,7 +677,8 @@ void WriteData::impropers()
         recvrow /= ncol;
       } else recvrow = sendrow;
 
-      atom->avec->write_improper(fp,recvrow,buf,index);
+      if (binaryflag) binary_rows(recvrow,ncol,buf);
+      else atom->avec->write_improper(fp,recvrow,buf,index);
       index += recvrow;
     }
 
@@ -772,3 +800,38 @@ void WriteData::fix(int ifix, int mth)
 
   memory->destroy(buf);
 }
+
+/* ----------------------------------------------------------------------
+   proc 0 writes descriptor of binary section of data file
+   descriptor = # of rows, # of values per row, magic number
+   must match ReadData::binary_open()
+------------------------------------------------------------------------- */
+
+void WriteData::binary_descriptor(bigint nrow, int ncol)
+{
+  int magic = BINARY_MAGIC;
+  fwrite(&nrow,sizeof(bigint),1,fp);
+  fwrite(&ncol,sizeof(int),1,fp);
+  fwrite(&magic,sizeof(int),1,fp);
+}
+
+/* ----------------------------------------------------------------------
+   proc 0 writes N rows of topology info to binary section of data file
+   each value is stored as ubuf, same as integers in Atoms section
+------------------------------------------------------------------------- */
+
+void WriteData::binary_rows(int n, int ncol, tagint **buf)
+{
+  if (n == 0) return;
+
+  double *rows;
+  memory->create(rows,n*ncol,"write_data:rows");
+
+  int m = 0;
+  for (int i = 0; i < n; i++)
+    for (int j = 0; j < ncol; j++)
+      rows[m++] = ubuf(buf[i][j]).d;
+
+  fwrite(rows,sizeof(double),(size_t) n*ncol,fp);
+  memory->destroy(rows);
+}
@@ -35,6 +35,7 @@ class WriteData : protected Pointers {
   int pairflag;
   int coeffflag;
   int fixflag;
+  int binaryflag;
   FILE *fp;
   bigint nbonds_local,nbonds;
   bigint nangles_local,nangles;
@@ -52,6 +53,8 @@ class WriteData : protected Pointers {
   void impropers();
   void bonus(int);
   void fix(int, int);
+  void binary_descriptor(bigint, int);
+  void binary_rows(int, int, tagint **);
 };
 
 }
@@ -41,6 +41,8 @@
 
 using namespace LAMMPS_NS;
 
+#define CHECKSUM_SEGMENT 1048576    // # of doubles per checksum block
+
 /* ---------------------------------------------------------------------- */
 
 WriteRestart::WriteRestart(LAMMPS *lmp) : Pointers(lmp)
@@ -48,6 +50,8 @@ WriteRestart::WriteRestart(LAMMPS *lmp) : Pointers(lmp)
   MPI_Comm_rank(world,&me);
   MPI_Comm_size(world,&nprocs);
   multiproc = 0;
+  checksum_flag = 1;
+  naggregators = 0;
   noinit = 0;
   fp = nullptr;
 }
@@ -193,6 +197,26 @@ void WriteRestart::multiproc_options(int multiproc_caller, int mpiioflag_caller,
       else filewriter = 0;
       iarg += 2;
 
+    } else if (strcmp(arg[iarg],"aggregators") == 0) {
+      if (iarg+2 > narg) error->all(FLERR,"Illegal write_restart command");
+      if (!mpiioflag)
+        error->all(FLERR,"Cannot use write_restart aggregators "
+                   "without MPI-IO restart file");
+      naggregators = utils::inumeric(FLERR,arg[iarg+1],false,lmp);
+      if (naggregators <= 0) error->all(FLERR,"Illegal write_restart command");
+      mpiio->set_aggregators(MIN(naggregators,nprocs));
+      iarg += 2;
+
+    } else if (strcmp(arg[iarg],"checksum") == 0) {
+      if (iarg+2 > narg) error->all(FLERR,"Illegal write_restart command");
+      if (!mpiioflag)
+        error->all(FLERR,"Cannot use write_restart checksum "
+                   "without MPI-IO restart file");
+      if (strcmp(arg[iarg+1],"yes") == 0) checksum_flag = 1;
+      else if (strcmp(arg[iarg+1],"no") == 0) checksum_flag = 0;
+      else error->all(FLERR,"Illegal write_restart command");
+      iarg += 2;
+
     } else if (strcmp(arg[iarg],"noinit") == 0) {
       noinit = 1;
       iarg++;
@@ -366,7 +390,8 @@ void WriteRestart::write(std::string file)
       fp = nullptr;
     }
     mpiio->openForWrite(file.c_str());
-    mpiio->write(headerOffset,send_size,buf);
+    mpiio->write(headerOffset,send_size,buf,
+                 checksum_flag ? CHECKSUM_SEGMENT : 0);
     mpiio->close();
   } else {
 
@@ -582,6 +607,14 @@ void WriteRestart::file_layout(int send_size)
     MPI_Gather(&send_size, 1, MPI_INT, all_send_sizes, 1, MPI_INT, 0,world);
     if (me == 0) fwrite(all_send_sizes,sizeof(int),nprocs,fp);
     memory->destroy(all_send_sizes);
+
+    // checksums of per-atom data are written at the end of the file
+
+    if (me == 0 && checksum_flag) write_bigint(CHECKSUM,CHECKSUM_SEGMENT);
+
+    // aggregator hint is reused when the file is read
+
+    if (me == 0 && naggregators) write_int(AGGREGATORS,naggregators);
   }
 
   // -1 flag signals end of file layout info
@@ -49,6 +49,8 @@ class WriteRestart : protected Pointers {
   int mpiioflag;               // 1 for MPIIO output, else 0
   class RestartMPIIO *mpiio;   // MPIIO for restart file output
   MPI_Offset headerOffset;
+  int checksum_flag;           // 1 to write checksums of per-atom data
+  int naggregators;            // # of MPI-IO aggregator procs, 0 = default
 
   void header();
   void type_arrays();
@@ -102,6 +104,16 @@ E: Cannot use write_restart nfile without % in restart file name
 
 Self-explanatory.
 
+E: Cannot use write_restart aggregators without MPI-IO restart file
+
+The aggregators keyword only applies to restart files with a ".mpiio"
+suffix.
+
+E: Cannot use write_restart checksum without MPI-IO restart file
+
+The checksum keyword only applies to restart files with a ".mpiio"
+suffix.
+
 E: Atom count is inconsistent, cannot write restart file
 
 Sum of atoms across processors does not equal initial total count.
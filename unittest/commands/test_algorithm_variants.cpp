@@ -0,0 +1,302 @@
+/* ----------------------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://lammps.sandia.gov/, Sandia National Laboratories
+   Steve Plimpton, sjplimp@sandia.gov
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+// unit tests checking that alternative algorithms of computes and fixes
+// give the same results as the default ones
+
+#include "atom.h"
+#include "compute.h"
+#include "fix.h"
+#include "force.h"
+#include "info.h"
+#include "input.h"
+#include "lammps.h"
+#include "modify.h"
+#include "pair.h"
+#include "utils.h"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+#include <cmath>
+#include <cstring>
+#include <map>
+#include <mpi.h>
+#include <string>
+#include <vector>
+
+// whether to print verbose output (i.e. not capturing LAMMPS screen output).
+bool verbose = false;
+
+using LAMMPS_NS::utils::split_words;
+
+namespace LAMMPS_NS {
+
+class AlgorithmVariantsTest : public ::testing::Test {
+public:
+    void command(const std::string &line) { lmp->input->one(line.c_str()); }
+
+protected:
+    LAMMPS *lmp;
+
+    void SetUp() override
+    {
+        lmp = nullptr;
+        create();
+    }
+
+    void TearDown() override
+    {
+        if (!verbose) ::testing::internal::CaptureStdout();
+        delete lmp;
+        if (!verbose) ::testing::internal::GetCapturedStdout();
+    }
+
+    // replace the current LAMMPS instance with a new one
+
+    void create()
+    {
+        const char *args[] = {"AlgorithmVariantsTest", "-log", "none", "-nocite", "-echo",
+                              "screen"};
+        char **argv        = (char **)args;
+        int argc           = sizeof(args) / sizeof(char *);
+        if (!verbose) ::testing::internal::CaptureStdout();
+        delete lmp;
+        lmp = new LAMMPS(argc, argv, MPI_COMM_WORLD);
+        if (!verbose) ::testing::internal::GetCapturedStdout();
+    }
+
+    // fcc crystal with randomly displaced atoms, so that no two neighbors
+    // of an atom are at the same distance
+
+    void distorted_fcc()
+    {
+        command("units lj");
+        command("atom_style atomic");
+        command("lattice fcc 0.8442");
+        command("region box block 0 4 0 4 0 4");
+        command("create_box 1 box");
+        command("create_atoms 1 box");
+        command("mass 1 1.0");
+        command("displace_atoms all random 0.05 0.05 0.05 87287");
+        command("pair_style lj/cut 2.5");
+        command("pair_coeff 1 1 1.0 1.0 2.5");
+    }
+
+    // invoke a per-atom compute and return column icol of its output
+    // by atom ID, icol = 0 for a per-atom vector
+
+    std::map<tagint, double> peratom(const std::string &id, int icol = 0)
+    {
+        Compute *compute = lmp->modify->compute[lmp->modify->find_compute(id)];
+        compute->compute_peratom();
+        std::map<tagint, double> values;
+        for (int i = 0; i < lmp->atom->nlocal; ++i) {
+            if (compute->size_peratom_cols == 0)
+                values[lmp->atom->tag[i]] = compute->vector_atom[i];
+            else
+                values[lmp->atom->tag[i]] = compute->array_atom[i][icol];
+        }
+        return values;
+    }
+
+    // per-atom forces by atom ID
+
+    std::map<tagint, std::vector<double>> forces()
+    {
+        std::map<tagint, std::vector<double>> values;
+        double **f = lmp->atom->f;
+        for (int i = 0; i < lmp->atom->nlocal; ++i)
+            values[lmp->atom->tag[i]] = {f[i][0], f[i][1], f[i][2]};
+        return values;
+    }
+};
+
+// computes that share a neighbor list also share the sorted nearest
+// neighbors, each of them requesting a different number of neighbors
+
+TEST_F(AlgorithmVariantsTest, shared_neigh_shells)
+{
+    if (!Info::has_package("USER-PTM")) GTEST_SKIP();
+
+    // reference: each centro/atom compute with its own neighbor list
+
+    std::map<tagint, double> ref8, ref12;
+    for (const auto &nnn : {"8", "12"}) {
+        create();
+        if (!verbose) ::testing::internal::CaptureStdout();
+        distorted_fcc();
+        command(std::string("compute c all centro/atom ") + nnn);
+        command("run 0 post no");
+        if (!verbose) ::testing::internal::GetCapturedStdout();
+        if (strcmp(nnn, "8") == 0)
+            ref8 = peratom("c");
+        else
+            ref12 = peratom("c");
+    }
+
+    // all computes share one list and its shells, except for ptm/atom
+    // with a group2-ID, which selects its neighbors without the shells
+
+    create();
+    if (!verbose) ::testing::internal::CaptureStdout();
+    distorted_fcc();
+    command("group g2 type 1");
+    command("compute c8 all centro/atom 8");
+    command("compute ptm all ptm/atom default 0.0");
+    command("compute c12 all centro/atom 12");
+    command("compute ptmref all ptm/atom default 0.0 g2");
+    command("run 0 post no");
+    if (!verbose) ::testing::internal::GetCapturedStdout();
+
+    auto c8  = peratom("c8");
+    auto c12 = peratom("c12");
+    ASSERT_EQ(c8.size(), ref8.size());
+    for (const auto &kv : ref8)
+        EXPECT_DOUBLE_EQ(c8[kv.first], kv.second) << "atom " << kv.first;
+    ASSERT_EQ(c12.size(), ref12.size());
+    for (const auto &kv : ref12)
+        EXPECT_DOUBLE_EQ(c12[kv.first], kv.second) << "atom " << kv.first;
+
+    // structure type and RMSD of ptm/atom
+
+    for (int icol = 0; icol < 2; ++icol) {
+        auto ptm    = peratom("ptm", icol);
+        auto ptmref = peratom("ptmref", icol);
+        ASSERT_EQ(ptm.size(), ptmref.size());
+        for (const auto &kv : ptmref)
+            EXPECT_DOUBLE_EQ(ptm[kv.first], kv.second) << "atom " << kv.first;
+    }
+}
+
+// pair style reax/c with exactly sized lists gives the same energies
+// and forces as with the estimated list sizes, also after reneighboring
+
+TEST_F(AlgorithmVariantsTest, reaxc_exactlists)
+{
+    if (!Info::has_package("USER-REAXC")) GTEST_SKIP();
+
+    std::map<std::string, double> energy[2];
+    std::map<tagint, std::vector<double>> init_f[2], run_f[2];
+    const char *exact[2] = {"no", "yes"};
+    for (int n = 0; n < 2; ++n) {
+        create();
+        if (!verbose) ::testing::internal::CaptureStdout();
+        command("atom_modify map array");
+        command("units real");
+        command("atom_style charge");
+        command("lattice diamond 3.77");
+        command("region box block 0 2 0 2 0 2");
+        command("create_box 2 box");
+        command("create_atoms 1 box");
+        command("displace_atoms all random 0.1 0.1 0.1 623426");
+        command("mass 1 12.0");
+        command("mass 2 13.0");
+        command("set type 1 type/fraction 2 0.5 998877");
+        command("set type 1 charge 0.01");
+        command("set type 2 charge -0.01");
+        command("velocity all create 100 4534624 loop geom");
+        command(std::string("pair_style reax/c NULL checkqeq yes exactlists ") + exact[n]);
+        command("pair_coeff * * ffield.reax.mattsson C O");
+        command("fix qeq all qeq/reax 1 0.0 8.0 1.0e-12 reax/c");
+        command("neighbor 1.0 bin");
+        command("neigh_modify every 1 delay 0 check no");
+        command("run 0 post no");
+        energy[n]["init_vdwl"] = lmp->force->pair->eng_vdwl;
+        energy[n]["init_coul"] = lmp->force->pair->eng_coul;
+        init_f[n]              = forces();
+
+        // time steps with reneighboring on every step
+
+        command("fix nve all nve");
+        command("run 10 post no");
+        energy[n]["run_vdwl"] = lmp->force->pair->eng_vdwl;
+        energy[n]["run_coul"] = lmp->force->pair->eng_coul;
+        run_f[n]              = forces();
+        if (!verbose) ::testing::internal::GetCapturedStdout();
+    }
+
+    for (const auto &kv : energy[0])
+        EXPECT_NEAR(energy[1][kv.first], kv.second, 1.0e-10 * fabs(kv.second)) << kv.first;
+    for (auto f : {init_f, run_f}) {
+        ASSERT_EQ(f[0].size(), f[1].size());
+        for (const auto &kv : f[0])
+            for (int i = 0; i < 3; ++i)
+                EXPECT_NEAR(f[1][kv.first][i], kv.second[i], 1.0e-10)
+                    << "atom " << kv.first << " component " << i;
+    }
+}
+
+// level 0 of the multiple-tau correlator of fix ave/correlate reproduces
+// the rows of the dense correlator, the higher levels add longer lags
+
+TEST_F(AlgorithmVariantsTest, ave_correlate_multitau)
+{
+    if (!verbose) ::testing::internal::CaptureStdout();
+    distorted_fcc();
+    command("velocity all create 3.0 87287 loop geom");
+    command("fix nve all nve");
+    command("variable pe equal pe");
+    command("variable press equal press");
+    command("variable ke equal ke");
+    command("fix dense all ave/correlate 2 8 80 v_pe v_press v_ke type auto/upper ave running");
+    command("fix multi all ave/correlate 2 8 80 v_pe v_press v_ke type auto/upper ave running "
+            "multitau 3 2");
+    command("run 400 post no");
+    if (!verbose) ::testing::internal::GetCapturedStdout();
+
+    Fix *dense = lmp->modify->fix[lmp->modify->find_fix("dense")];
+    Fix *multi = lmp->modify->fix[lmp->modify->find_fix("multi")];
+    ASSERT_EQ(dense->size_array_rows, 8);
+    ASSERT_EQ(multi->size_array_rows, 8 + 2 * (8 - 4));
+    ASSERT_EQ(multi->size_array_cols, dense->size_array_cols);
+
+    // lag, count, and correlations of all lags within the first level
+
+    for (int i = 0; i < dense->size_array_rows; ++i)
+        for (int j = 0; j < dense->size_array_cols; ++j)
+            EXPECT_DOUBLE_EQ(multi->compute_array(i, j), dense->compute_array(i, j))
+                << "row " << i << " column " << j;
+
+    // level K has lags J*Nbin^K*Nevery for J = Nrepeat/Nbin to Nrepeat-1
+
+    int row = 8;
+    for (int k = 1, spacing = 4; k < 3; ++k, spacing *= 2)
+        for (int j = 4; j < 8; ++j, ++row) {
+            EXPECT_DOUBLE_EQ(multi->compute_array(row, 0), j * spacing) << "row " << row;
+            EXPECT_GT(multi->compute_array(row, 1), 0.0) << "row " << row;
+        }
+}
+
+} // namespace LAMMPS_NS
+
+int main(int argc, char **argv)
+{
+    MPI_Init(&argc, &argv);
+    ::testing::InitGoogleMock(&argc, argv);
+
+    // handle arguments passed via environment variable
+    if (const char *var = getenv("TEST_ARGS")) {
+        std::vector<std::string> env = split_words(var);
+        for (auto arg : env) {
+            if (arg == "-v") {
+                verbose = true;
+            }
+        }
+    }
+
+    if ((argc > 1) && (strcmp(argv[1], "-v") == 0)) verbose = true;
+
+    int rv = RUN_ALL_TESTS();
+    MPI_Finalize();
+    return rv;
+}
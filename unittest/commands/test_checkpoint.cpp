@@ -0,0 +1,230 @@
+/* ----------------------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://lammps.sandia.gov/, Sandia National Laboratories
+   Steve Plimpton, sjplimp@sandia.gov
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#include "atom.h"
+#include "domain.h"
+#include "fmt/format.h"
+#include "info.h"
+#include "input.h"
+#include "lammps.h"
+#include "modify.h"
+#include "update.h"
+#include "utils.h"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+#include <cstdio>
+#include <mpi.h>
+#include <vector>
+
+// whether to print verbose output (i.e. not capturing LAMMPS screen output).
+bool verbose = false;
+
+#if defined(OMPI_MAJOR_VERSION)
+const bool have_openmpi = true;
+#else
+const bool have_openmpi = false;
+#endif
+
+using LAMMPS_NS::utils::split_words;
+
+namespace LAMMPS_NS {
+using ::testing::MatchesRegex;
+
+#define GETIDX(i) lmp->atom->map(i)
+
+#define TEST_FAILURE(errmsg, ...)                                 \
+    if (Info::has_exceptions()) {                                 \
+        ::testing::internal::CaptureStdout();                     \
+        ASSERT_ANY_THROW({__VA_ARGS__});                          \
+        auto mesg = ::testing::internal::GetCapturedStdout();     \
+        ASSERT_THAT(mesg, MatchesRegex(errmsg));                  \
+    } else {                                                      \
+        if (!have_openmpi) {                                      \
+            ::testing::internal::CaptureStdout();                 \
+            ASSERT_DEATH({__VA_ARGS__}, "");                      \
+            auto mesg = ::testing::internal::GetCapturedStdout(); \
+            ASSERT_THAT(mesg, MatchesRegex(errmsg));              \
+        }                                                         \
+    }
+
+#define STRINGIFY(val) XSTR(val)
+#define XSTR(val) #val
+
+class CheckpointTest : public ::testing::Test {
+protected:
+    LAMMPS *lmp;
+
+    void SetUp() override
+    {
+        const char *args[] = {"CheckpointTest", "-log", "none", "-nocite", "-echo", "screen"};
+        char **argv        = (char **)args;
+        int argc           = sizeof(args) / sizeof(char *);
+        if (!verbose) ::testing::internal::CaptureStdout();
+        lmp        = new LAMMPS(argc, argv, MPI_COMM_WORLD);
+        Info *info = new Info(lmp);
+        if (info->has_style("atom", "full")) {
+            lmp->input->one("variable input_dir index " STRINGIFY(TEST_INPUT_FOLDER));
+            lmp->input->one("include ${input_dir}/in.fourmol");
+            lmp->input->one("velocity all create 300.0 4928459 loop geom");
+            lmp->input->one("fix 1 all nve");
+        }
+        delete info;
+        if (!verbose) ::testing::internal::GetCapturedStdout();
+    }
+
+    void TearDown() override
+    {
+        if (!verbose) ::testing::internal::CaptureStdout();
+        delete lmp;
+        if (!verbose) ::testing::internal::GetCapturedStdout();
+    }
+
+    // positions and velocities ordered by atom ID
+
+    std::vector<double> state()
+    {
+        std::vector<double> data;
+        for (int i = 1; i <= lmp->atom->natoms; ++i) {
+            int j = GETIDX(i);
+            for (int k = 0; k < 3; ++k) {
+                data.push_back(lmp->atom->x[j][k]);
+                data.push_back(lmp->atom->v[j][k]);
+            }
+        }
+        return data;
+    }
+};
+
+TEST_F(CheckpointTest, SaveRestore)
+{
+    if (lmp->atom->natoms == 0) GTEST_SKIP();
+
+    if (!verbose) ::testing::internal::CaptureStdout();
+    lmp->input->one("run 10 post no");
+    lmp->input->one("checkpoint save first");
+    if (!verbose) ::testing::internal::GetCapturedStdout();
+    ASSERT_GE(lmp->modify->find_fix("_checkpoint_first"), 0);
+
+    auto before = state();
+    double boxhi = lmp->domain->boxhi[0];
+
+    if (!verbose) ::testing::internal::CaptureStdout();
+    lmp->input->one("run 10 post no");
+    lmp->input->one("change_box all x final -10.0 10.0 remap units box");
+    if (!verbose) ::testing::internal::GetCapturedStdout();
+    ASSERT_EQ(lmp->update->ntimestep, 20);
+    ASSERT_NE(before, state());
+
+    if (!verbose) ::testing::internal::CaptureStdout();
+    lmp->input->one("checkpoint restore first");
+    if (!verbose) ::testing::internal::GetCapturedStdout();
+    ASSERT_EQ(lmp->update->ntimestep, 10);
+    ASSERT_DOUBLE_EQ(lmp->domain->boxhi[0], boxhi);
+    ASSERT_EQ(lmp->atom->nbonds, 24);
+    ASSERT_EQ(before, state());
+
+    // continuing from a checkpoint reproduces the original trajectory
+
+    if (!verbose) ::testing::internal::CaptureStdout();
+    lmp->input->one("run 10 post no");
+    auto after = state();
+    lmp->input->one("checkpoint restore first timestep no");
+    lmp->input->one("run 10 post no");
+    if (!verbose) ::testing::internal::GetCapturedStdout();
+    ASSERT_EQ(lmp->update->ntimestep, 30);
+    ASSERT_EQ(after, state());
+
+    if (!verbose) ::testing::internal::CaptureStdout();
+    lmp->input->one("checkpoint delete first");
+    if (!verbose) ::testing::internal::GetCapturedStdout();
+    ASSERT_LT(lmp->modify->find_fix("_checkpoint_first"), 0);
+}
+
+TEST_F(CheckpointTest, Buddy)
+{
+    if (lmp->atom->natoms == 0) GTEST_SKIP();
+
+    if (!verbose) ::testing::internal::CaptureStdout();
+    lmp->input->one("checkpoint save one buddy yes");
+    lmp->input->one("checkpoint save two buddy no");
+    if (!verbose) ::testing::internal::GetCapturedStdout();
+
+    auto before = state();
+
+    if (!verbose) ::testing::internal::CaptureStdout();
+    lmp->input->one("run 10 post no");
+    lmp->input->one("checkpoint restore one buddy yes");
+    if (!verbose) ::testing::internal::GetCapturedStdout();
+    ASSERT_EQ(lmp->update->ntimestep, 0);
+    ASSERT_EQ(before, state());
+
+    TEST_FAILURE(".*ERROR: Checkpoint two was not saved with a buddy copy.*",
+                 lmp->input->one("checkpoint restore two buddy yes"););
+}
+
+TEST_F(CheckpointTest, Errors)
+{
+    if (lmp->atom->natoms == 0) GTEST_SKIP();
+
+    TEST_FAILURE(".*ERROR: Illegal checkpoint command.*", lmp->input->one("checkpoint save"););
+    TEST_FAILURE(".*ERROR: Illegal checkpoint command.*",
+                 lmp->input->one("checkpoint load one"););
+    TEST_FAILURE(".*ERROR: Illegal checkpoint command.*",
+                 lmp->input->one("checkpoint save one timestep no"););
+    TEST_FAILURE(".*ERROR: Checkpoint one does not exist.*",
+                 lmp->input->one("checkpoint restore one"););
+    TEST_FAILURE(".*ERROR: Checkpoint one does not exist.*",
+                 lmp->input->one("checkpoint delete one"););
+
+    if (!verbose) ::testing::internal::CaptureStdout();
+    lmp->input->one("checkpoint save one");
+    lmp->input->one("compute msd all msd");
+    if (!verbose) ::testing::internal::GetCapturedStdout();
+    TEST_FAILURE(".*ERROR: Checkpoint one was saved with different per-atom restart fixes.*",
+                 lmp->input->one("checkpoint restore one"););
+
+    if (!verbose) ::testing::internal::CaptureStdout();
+    lmp->input->one("clear");
+    if (!verbose) ::testing::internal::GetCapturedStdout();
+    TEST_FAILURE(".*ERROR: Checkpoint command before simulation box is defined.*",
+                 lmp->input->one("checkpoint save one"););
+}
+
+} // namespace LAMMPS_NS
+
+int main(int argc, char **argv)
+{
+    MPI_Init(&argc, &argv);
+    ::testing::InitGoogleMock(&argc, argv);
+
+    if (have_openmpi && !LAMMPS_NS::Info::has_exceptions())
+        std::cout << "Warning: using OpenMPI without exceptions. "
+                     "Death tests will be skipped\n";
+
+    // handle arguments passed via environment variable
+    if (const char *var = getenv("TEST_ARGS")) {
+        std::vector<std::string> env = split_words(var);
+        for (auto arg : env) {
+            if (arg == "-v") {
+                verbose = true;
+            }
+        }
+    }
+
+    if ((argc > 1) && (strcmp(argv[1], "-v") == 0)) verbose = true;
+
+    int rv = RUN_ALL_TESTS();
+    MPI_Finalize();
+    return rv;
+}
@@ -0,0 +1,415 @@
+/* ----------------------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://lammps.sandia.gov/, Sandia National Laboratories
+   Steve Plimpton, sjplimp@sandia.gov
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+// unit tests for commands whose per-atom data or I/O is distributed
+// over several MPI ranks, run with 4 MPI tasks
+
+#include "atom.h"
+#include "compute.h"
+#include "fix.h"
+#include "fmt/format.h"
+#include "info.h"
+#include "input.h"
+#include "lammps.h"
+#include "modify.h"
+#include "utils.h"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+#include "../testing/test_mpi_main.h"
+
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <mpi.h>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace LAMMPS_NS;
+
+class ParallelTest : public ::testing::Test {
+public:
+    void command(const std::string &line) { lmp->input->one(line.c_str()); }
+
+protected:
+    LAMMPS *lmp;
+    int me, nprocs;
+
+    void SetUp() override
+    {
+        MPI_Comm_rank(MPI_COMM_WORLD, &me);
+        MPI_Comm_size(MPI_COMM_WORLD, &nprocs);
+        const char *args[] = {"ParallelTest", "-log", "none", "-echo", "screen", "-nocite"};
+        char **argv        = (char **)args;
+        int argc           = sizeof(args) / sizeof(char *);
+        if (!verbose) ::testing::internal::CaptureStdout();
+        lmp = new LAMMPS(argc, argv, MPI_COMM_WORLD);
+        if (!verbose) ::testing::internal::GetCapturedStdout();
+    }
+
+    void TearDown() override
+    {
+        if (!verbose) ::testing::internal::CaptureStdout();
+        delete lmp;
+        lmp = nullptr;
+        if (!verbose) ::testing::internal::GetCapturedStdout();
+    }
+
+    // hot LJ fluid in which atoms cross sub-domain boundaries every few steps
+
+    void lj_fluid()
+    {
+        command("units lj");
+        command("atom_style atomic");
+        command("lattice fcc 0.8442");
+        command("region box block 0 4 0 4 0 4");
+        command("create_box 1 box");
+        command("create_atoms 1 box");
+        command("mass 1 1.0");
+        command("velocity all create 3.0 87287 loop geom");
+        command("pair_style lj/cut 2.5");
+        command("pair_coeff 1 1 1.0 1.0 2.5");
+        command("neighbor 0.3 bin");
+        command("neigh_modify every 1 delay 0 check yes");
+        command("fix 1 all nve");
+    }
+};
+
+// per-atom sample windows that are larger than the default exchange
+// buffer must migrate with their atoms
+
+TEST_F(ParallelTest, ave_correlate_atom_migrate)
+{
+    if (!Info::has_package("KSPACE")) GTEST_SKIP();
+    EXPECT_EQ(nprocs, 4);
+
+    const int nrepeat = 1500;
+    if (!verbose) ::testing::internal::CaptureStdout();
+    lj_fluid();
+    command("variable a atom id*(1.0+0.001*step)");
+    command(fmt::format("fix 2 all ave/correlate/atom 1 {0} {0} v_a", nrepeat));
+    command(fmt::format("run {}", nrepeat));
+    if (!verbose) ::testing::internal::GetCapturedStdout();
+
+    // A_i(t) = id*(1+0.001*t) sampled on steps 1 to nrepeat, so
+    // C(M) = <id^2> * 1/(N-M) sum_t (1+0.001*t)*(1+0.001*(t+M))
+
+    const int natoms = lmp->atom->natoms;
+    double idsq      = 0.0;
+    for (int i = 1; i <= natoms; ++i)
+        idsq += (double)i * i;
+    idsq /= natoms;
+
+    Fix *fix = lmp->modify->fix[lmp->modify->find_fix("2")];
+    for (int m = 0; m < nrepeat; m += 149) {
+        double sum = 0.0;
+        for (int t = 1; t + m <= nrepeat; ++t)
+            sum += (1.0 + 0.001 * t) * (1.0 + 0.001 * (t + m));
+        const double expected = idsq * sum / (nrepeat - m);
+        EXPECT_DOUBLE_EQ(fix->compute_array(m, 0), m);
+        EXPECT_NEAR(fix->compute_array(m, 1), expected, 1.0e-10 * expected);
+    }
+}
+
+// non-zero image flags for a non-periodic boundary that are only seen
+// by a reader other than proc 0 must be reported and reset
+
+TEST_F(ParallelTest, read_data_parallel_imageflags)
+{
+    EXPECT_EQ(nprocs, 4);
+
+    const int natoms = 40;
+    if (me == 0) {
+        FILE *fp = fopen("test_parallel_imageflags.data", "w");
+        fputs("LAMMPS data file for parallel read\n\n", fp);
+        fprintf(fp, "%d atoms\n1 atom types\n\n", natoms);
+        fputs("0.0 10.0 xlo xhi\n0.0 10.0 ylo yhi\n0.0 10.0 zlo zhi\n\n", fp);
+        fputs("Masses\n\n1 1.0\n\nAtoms # atomic\n\n", fp);
+        for (int i = 1; i <= natoms; ++i)
+            fprintf(fp, "%d 1 %g %g %g %d 0 0\n", i, 0.2 * i, 0.1 * i, 0.2 * i,
+                    (i > natoms - 4) ? 1 : 0);
+        fclose(fp);
+    }
+    MPI_Barrier(MPI_COMM_WORLD);
+
+    ::testing::internal::CaptureStdout();
+    command("boundary f p p");
+    command("read_data test_parallel_imageflags.data parallel 4");
+    auto output = ::testing::internal::GetCapturedStdout();
+    if (verbose) std::cout << output;
+    if (me == 0) {
+        ASSERT_THAT(output, ::testing::HasSubstr("Non-zero imageflag(s) in x direction"));
+        ASSERT_THAT(output, ::testing::Not(::testing::HasSubstr("in y direction")));
+        remove("test_parallel_imageflags.data");
+    }
+
+    ASSERT_EQ(lmp->atom->natoms, natoms);
+    int nonzero = 0;
+    for (int i = 0; i < lmp->atom->nlocal; ++i) {
+        imageint image = lmp->atom->image[i];
+        if ((image & IMGMASK) != IMGMAX) ++nonzero;
+        if ((image >> IMGBITS & IMGMASK) != IMGMAX) ++nonzero;
+        if ((image >> IMG2BITS) != IMGMAX) ++nonzero;
+    }
+    int allnonzero;
+    MPI_Allreduce(&nonzero, &allnonzero, 1, MPI_INT, MPI_SUM, MPI_COMM_WORLD);
+    ASSERT_EQ(allnonzero, 0);
+}
+
+// pairs of atoms that moved outside their sub-domain since the last
+// reneighboring must be tallied by binned RDFs as by neighbor list RDFs
+
+TEST_F(ParallelTest, rdf_binned_between_reneighboring)
+{
+    EXPECT_EQ(nprocs, 4);
+
+    const int nbin = 50;
+    if (!verbose) ::testing::internal::CaptureStdout();
+    lj_fluid();
+    command("neigh_modify every 20 delay 0 check no");
+    command(fmt::format("compute 1 all rdf {} binned yes", nbin));
+    command(fmt::format("compute 2 all rdf {}", nbin));
+    command("run 10");
+    if (!verbose) ::testing::internal::GetCapturedStdout();
+
+    Compute *binned = lmp->modify->compute[lmp->modify->find_compute("1")];
+    Compute *list   = lmp->modify->compute[lmp->modify->find_compute("2")];
+    binned->compute_array();
+    list->compute_array();
+    for (int i = 0; i < nbin; ++i) {
+        EXPECT_DOUBLE_EQ(binned->array[i][0], list->array[i][0]);
+        EXPECT_NEAR(binned->array[i][1], list->array[i][1], 1.0e-12);
+        EXPECT_NEAR(binned->array[i][2], list->array[i][2], 1.0e-10);
+    }
+}
+
+// clusters that span several procs and the periodic boundary must get
+// the smallest atom ID of the cluster on all procs
+
+TEST_F(ParallelTest, cluster_atom_across_procs)
+{
+    EXPECT_EQ(nprocs, 4);
+
+    if (!verbose) ::testing::internal::CaptureStdout();
+    command("units lj");
+    command("atom_style atomic");
+    command("processors * 1 1");
+    command("lattice sc 1.0");
+    command("region box block 0 40 0 1 0 1");
+    command("create_box 1 box");
+    command("create_atoms 1 box");
+    command("mass 1 1.0");
+    command("region gap1 block 9.5 11.5 INF INF INF INF");
+    command("region gap2 block 29.5 31.5 INF INF INF INF");
+    command("delete_atoms region gap1");
+    command("delete_atoms region gap2");
+    command("pair_style lj/cut 1.2");
+    command("pair_coeff 1 1 1.0 1.0");
+    command("compute 1 all cluster/atom 1.1");
+    command("run 0 post no");
+    if (!verbose) ::testing::internal::GetCapturedStdout();
+
+    // one chain from x = 12 to 29, one from x = 32 across the boundary to 9
+
+    Compute *cluster = lmp->modify->compute[lmp->modify->find_compute("1")];
+    cluster->compute_peratom();
+
+    auto atom  = lmp->atom;
+    tagint mintag[2] = {MAXTAGINT, MAXTAGINT};
+    for (int i = 0; i < atom->nlocal; ++i) {
+        int chain = (atom->x[i][0] > 11.0 && atom->x[i][0] < 30.0) ? 0 : 1;
+        mintag[chain] = MIN(mintag[chain], atom->tag[i]);
+    }
+    tagint allmin[2];
+    MPI_Allreduce(mintag, allmin, 2, MPI_LMP_TAGINT, MPI_MIN, MPI_COMM_WORLD);
+
+    for (int i = 0; i < atom->nlocal; ++i) {
+        int chain = (atom->x[i][0] > 11.0 && atom->x[i][0] < 30.0) ? 0 : 1;
+        ASSERT_EQ(cluster->vector_atom[i], allmin[chain]);
+    }
+}
+
+// snapshots read ahead by several frame reader threads must give the
+// same results as reading them on demand
+
+static std::vector<double> thermo_pe(const std::string &output)
+{
+    std::vector<double> pe;
+    std::istringstream lines(output);
+    std::string line;
+    while (std::getline(lines, line))
+        if (utils::strmatch(line, "^\\s+\\d+\\s+-\\d"))
+            pe.push_back(std::stod(utils::split_words(line)[1]));
+    return pe;
+}
+
+TEST_F(ParallelTest, rerun_prefetch)
+{
+    EXPECT_EQ(nprocs, 4);
+
+    if (!verbose) ::testing::internal::CaptureStdout();
+    lj_fluid();
+    command("dump 1 all custom 10 test_rerun_prefetch.dump id type x y z");
+    command("dump_modify 1 format float %20.15g");
+    command("run 100");
+    command("undump 1");
+    command("unfix 1");
+    command("thermo_style custom step pe");
+    command("thermo_modify format float %20.15g");
+    command("thermo 10");
+    if (!verbose) ::testing::internal::GetCapturedStdout();
+
+    ::testing::internal::CaptureStdout();
+    command("rerun test_rerun_prefetch.dump every 20 dump x y z");
+    auto ref = thermo_pe(::testing::internal::GetCapturedStdout());
+
+    for (const auto &args : {"prefetch 1", "prefetch 2 readers 3", "prefetch 3 readers 8"}) {
+        ::testing::internal::CaptureStdout();
+        command(fmt::format("rerun test_rerun_prefetch.dump every 20 {} dump x y z", args));
+        auto pe = thermo_pe(::testing::internal::GetCapturedStdout());
+        if (me != 0) continue;
+        ASSERT_EQ(ref.size(), 6);
+        ASSERT_EQ(pe.size(), ref.size()) << args;
+        for (std::size_t i = 0; i < ref.size(); ++i)
+            EXPECT_NEAR(pe[i], ref[i], 1.0e-12 * fabs(ref[i])) << args;
+    }
+
+    if (me == 0) remove("test_rerun_prefetch.dump");
+}
+
+// dump files written by I/O threads must be complete at the end of a run
+// and identical to synchronously written files
+
+static std::string file_contents(const std::string &name)
+{
+    std::ifstream in(name);
+    std::stringstream contents;
+    contents << in.rdbuf();
+    return contents.str();
+}
+
+TEST_F(ParallelTest, dump_async)
+{
+    EXPECT_EQ(nprocs, 4);
+
+    // dump style, its arguments, and the header of the last snapshot
+
+    const std::vector<std::vector<std::string>> styles = {
+        {"atom", "", "ITEM: TIMESTEP\n20\n"},
+        {"custom", "id type x y z vx vy vz", "ITEM: TIMESTEP\n20\n"},
+        {"xyz", "", "Timestep: 20\n"}};
+    const std::vector<std::string> options = {"buffer yes", "buffer no", "sort id"};
+
+    if (!verbose) ::testing::internal::CaptureStdout();
+    lj_fluid();
+    int ndump = 0;
+    for (const auto &style : styles) {
+        for (const auto &option : options) {
+            for (const auto &async : {"no", "yes"}) {
+                command(fmt::format("dump {0} all {1} 5 test_dump_async_{0}.txt {2}", ndump,
+                                    style[0], style[1]));
+                command(fmt::format("dump_modify {} {} async {}", ndump, option, async));
+                ++ndump;
+            }
+        }
+    }
+    command("run 20");
+    if (!verbose) ::testing::internal::GetCapturedStdout();
+
+    // files are compared before the dumps are deleted
+
+    if (me == 0) {
+        for (int i = 0; i < ndump; i += 2) {
+            auto sync  = file_contents(fmt::format("test_dump_async_{}.txt", i));
+            auto async = file_contents(fmt::format("test_dump_async_{}.txt", i + 1));
+            EXPECT_THAT(sync, ::testing::HasSubstr(styles[i / 2 / options.size()][2]));
+            EXPECT_EQ(sync, async) << "dump " << i + 1;
+        }
+    }
+
+    if (!verbose) ::testing::internal::CaptureStdout();
+    for (int i = 0; i < ndump; ++i)
+        command(fmt::format("undump {}", i));
+    if (!verbose) ::testing::internal::GetCapturedStdout();
+    if (me == 0)
+        for (int i = 0; i < ndump; ++i)
+            remove(fmt::format("test_dump_async_{}.txt", i).c_str());
+}
+
+// sparse reductions of fix ave/chunk and compute reduce/chunk, with chunk
+// ID ranges or spatial bins owned by each proc, match the dense reduction
+
+TEST_F(ParallelTest, ave_chunk_sparse)
+{
+    EXPECT_EQ(nprocs, 4);
+
+    const std::vector<std::string> modes = {"no", "yes", "spatial"};
+
+    if (!verbose) ::testing::internal::CaptureStdout();
+    lj_fluid();
+    command("compute bins all chunk/atom bin/3d x lower 0.5 y lower 0.5 z lower 0.5");
+    command("compute bins2 all chunk/atom bin/3d x lower 0.5 y lower 0.5 z lower 0.5");
+    command("compute slabs all chunk/atom bin/1d y lower 0.25");
+    command("compute vel all property/atom vx vy vz");
+    for (const auto &mode : modes) {
+        command(fmt::format("fix all_{0} all ave/chunk 2 5 10 bins vx density/mass temp "
+                            "norm all sparse {0}",
+                            mode));
+        command(fmt::format("fix sample_{0} all ave/chunk 2 5 10 bins2 vx density/number temp "
+                            "norm sample ave running sparse {0}",
+                            mode));
+        command(fmt::format("compute sum_{0} all reduce/chunk bins sum c_vel[1] c_vel[2] "
+                            "sparse {0}",
+                            mode));
+        command(fmt::format("compute max_{0} all reduce/chunk slabs max c_vel[3] sparse {0}",
+                            mode));
+    }
+    command("run 20");
+    if (!verbose) ::testing::internal::GetCapturedStdout();
+
+    auto *modify = lmp->modify;
+    for (const auto &prefix : {"all_", "sample_"}) {
+        Fix *dense = modify->fix[modify->find_fix(std::string(prefix) + "no")];
+        for (int k = 1; k < (int)modes.size(); ++k) {
+            Fix *fix = modify->fix[modify->find_fix(prefix + modes[k])];
+            ASSERT_EQ(fix->size_array_rows, dense->size_array_rows);
+            for (int i = 0; i < dense->size_array_rows; ++i)
+                for (int j = 0; j < dense->size_array_cols; ++j) {
+                    double ref = dense->compute_array(i, j);
+                    EXPECT_NEAR(fix->compute_array(i, j), ref, 1.0e-12 * (1.0 + fabs(ref)))
+                        << prefix << modes[k] << " row " << i << " col " << j;
+                }
+        }
+    }
+
+    Compute *sum[3], *max[3];
+    for (int k = 0; k < (int)modes.size(); ++k) {
+        sum[k] = modify->compute[modify->find_compute("sum_" + modes[k])];
+        sum[k]->compute_array();
+        max[k] = modify->compute[modify->find_compute("max_" + modes[k])];
+        max[k]->compute_vector();
+    }
+    for (int k = 1; k < (int)modes.size(); ++k) {
+        ASSERT_EQ(sum[k]->size_array_rows, sum[0]->size_array_rows);
+        for (int i = 0; i < sum[0]->size_array_rows; ++i)
+            for (int j = 0; j < sum[0]->size_array_cols; ++j)
+                EXPECT_NEAR(sum[k]->array[i][j], sum[0]->array[i][j], 1.0e-12)
+                    << "sum_" << modes[k] << " row " << i << " col " << j;
+        ASSERT_EQ(max[k]->size_vector, max[0]->size_vector);
+        for (int i = 0; i < max[0]->size_vector; ++i)
+            EXPECT_DOUBLE_EQ(max[k]->vector[i], max[0]->vector[i])
+                << "max_" << modes[k] << " row " << i;
+    }
+}
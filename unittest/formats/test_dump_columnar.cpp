@@ -0,0 +1,235 @@
+/* ----------------------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://lammps.sandia.gov/, Sandia National Laboratories
+   Steve Plimpton, sjplimp@sandia.gov
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#include "../testing/core.h"
+#include "../testing/systems/melt.h"
+#include "../testing/utils.h"
+#include "atom.h"
+#include "fmt/format.h"
+#include "utils.h"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+#include <cmath>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <vector>
+
+using ::testing::Eq;
+
+class DumpColumnarTest : public MeltTest {
+public:
+    void enable_triclinic()
+    {
+        if (!verbose) ::testing::internal::CaptureStdout();
+        command("change_box all triclinic");
+        if (!verbose) ::testing::internal::GetCapturedStdout();
+    }
+
+    void generate_text_and_columnar_dump(std::string text_file, std::string columnar_file,
+                                         std::string fields, std::string dump_modify_options,
+                                         int ntimesteps)
+    {
+        if (!verbose) ::testing::internal::CaptureStdout();
+        command(fmt::format("dump id0 all custom 5 {} {}", text_file, fields));
+        command(fmt::format("dump id1 all columnar 5 {} {}", columnar_file, fields));
+        command("dump_modify id0 sort id format float %20.15g");
+
+        if (!dump_modify_options.empty()) {
+            command(fmt::format("dump_modify id1 {}", dump_modify_options));
+        }
+
+        command(fmt::format("run {}", ntimesteps));
+        command("undump id0");
+        command("undump id1");
+        if (!verbose) ::testing::internal::GetCapturedStdout();
+    }
+
+    // read snapshot with given reader and write it back as text
+
+    void reread_dump(std::string dump_file, std::string format, int ntimestep,
+                     std::string out_file)
+    {
+        if (!verbose) ::testing::internal::CaptureStdout();
+        command(fmt::format("read_dump {} {} x y z vx vy vz box yes format {}", dump_file,
+                            ntimestep, format));
+        command(fmt::format("write_dump all custom {} id type x y z vx vy vz "
+                            "modify sort id format float %20.15g",
+                            out_file));
+        if (!verbose) ::testing::internal::GetCapturedStdout();
+    }
+
+    // positions and velocities of all atoms by atom ID
+
+    std::map<tagint, std::vector<double>> get_atoms()
+    {
+        std::map<tagint, std::vector<double>> atoms;
+        auto atom = lmp->atom;
+        for (int i = 0; i < atom->nlocal; i++)
+            atoms[atom->tag[i]] = {atom->x[i][0], atom->x[i][1], atom->x[i][2],
+                                   atom->v[i][0], atom->v[i][1], atom->v[i][2]};
+        return atoms;
+    }
+};
+
+TEST_F(DumpColumnarTest, reread_run10)
+{
+    auto text_file     = "dump_columnar_text_run10.melt";
+    auto columnar_file = "dump_columnar_run10.col";
+    auto text_out      = "dump_columnar_text_out_run10.melt";
+    auto columnar_out  = "dump_columnar_col_out_run10.melt";
+    auto fields        = "id type x y z vx vy vz";
+
+    generate_text_and_columnar_dump(text_file, columnar_file, fields, "", 10);
+
+    ASSERT_FILE_EXISTS(text_file);
+    ASSERT_FILE_EXISTS(columnar_file);
+
+    reread_dump(text_file, "native", 5, text_out);
+    reread_dump(columnar_file, "columnar", 5, columnar_out);
+    ASSERT_FILE_EQUAL(text_out, columnar_out);
+    delete_file(text_out);
+    delete_file(columnar_out);
+
+    reread_dump(text_file, "native", 10, text_out);
+    reread_dump(columnar_file, "columnar", 10, columnar_out);
+    ASSERT_FILE_EQUAL(text_out, columnar_out);
+
+    delete_file(text_file);
+    delete_file(columnar_file);
+    delete_file(text_out);
+    delete_file(columnar_out);
+}
+
+TEST_F(DumpColumnarTest, triclinic_no_codec_run10)
+{
+    auto text_file     = "dump_columnar_tri_text_run10.melt";
+    auto columnar_file = "dump_columnar_tri_run10.col";
+    auto text_out      = "dump_columnar_tri_text_out_run10.melt";
+    auto columnar_out  = "dump_columnar_tri_col_out_run10.melt";
+    auto fields        = "id type x y z vx vy vz";
+
+    enable_triclinic();
+    generate_text_and_columnar_dump(text_file, columnar_file, fields, "codec none", 10);
+
+    ASSERT_FILE_EXISTS(text_file);
+    ASSERT_FILE_EXISTS(columnar_file);
+
+    reread_dump(text_file, "native", 10, text_out);
+    reread_dump(columnar_file, "columnar", 10, columnar_out);
+    ASSERT_FILE_EQUAL(text_out, columnar_out);
+
+    delete_file(text_file);
+    delete_file(columnar_file);
+    delete_file(text_out);
+    delete_file(columnar_out);
+}
+
+TEST_F(DumpColumnarTest, missing_index_run10)
+{
+    auto text_file     = "dump_columnar_noidx_text_run10.melt";
+    auto columnar_file = "dump_columnar_noidx_run10.col";
+    auto text_out      = "dump_columnar_noidx_text_out_run10.melt";
+    auto columnar_out  = "dump_columnar_noidx_col_out_run10.melt";
+    auto fields        = "id type x y z vx vy vz";
+
+    generate_text_and_columnar_dump(text_file, columnar_file, fields, "", 10);
+
+    ASSERT_FILE_EXISTS(columnar_file);
+
+    // cut off the end of the index, so the reader has to scan the frames
+
+    std::string content;
+    {
+        std::ifstream in(columnar_file, std::ios::binary);
+        content.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    }
+    ASSERT_GT(content.size(), 8u);
+    {
+        std::ofstream out(columnar_file, std::ios::binary | std::ios::trunc);
+        out.write(content.data(), content.size() - 8);
+    }
+
+    reread_dump(text_file, "native", 10, text_out);
+    reread_dump(columnar_file, "columnar", 10, columnar_out);
+    ASSERT_FILE_EQUAL(text_out, columnar_out);
+
+    delete_file(text_file);
+    delete_file(columnar_file);
+    delete_file(text_out);
+    delete_file(columnar_out);
+}
+
+TEST_F(DumpColumnarTest, quantize_run10)
+{
+    auto text_file     = "dump_columnar_quant_text_run10.melt";
+    auto columnar_file = "dump_columnar_quant_run10.col";
+    auto text_out      = "dump_columnar_quant_text_out_run10.melt";
+    auto columnar_out  = "dump_columnar_quant_col_out_run10.melt";
+    auto fields        = "id type x y z vx vy vz";
+
+    generate_text_and_columnar_dump(text_file, columnar_file, fields,
+                                    "quantize * 0.01 quantize x 0.001 quantize y 0.001 "
+                                    "quantize z 0.001",
+                                    10);
+
+    ASSERT_FILE_EXISTS(columnar_file);
+
+    reread_dump(text_file, "native", 10, text_out);
+    auto ref = get_atoms();
+    reread_dump(columnar_file, "columnar", 10, columnar_out);
+    auto quant = get_atoms();
+
+    ASSERT_EQ(ref.size(), quant.size());
+    for (auto &atom : ref) {
+        auto &values = quant[atom.first];
+        for (int m = 0; m < 6; m++) {
+            double step = (m < 3) ? 0.001 : 0.01;
+            EXPECT_LE(fabs(atom.second[m] - values[m]), 0.5 * step + 1.0e-10);
+        }
+    }
+
+    delete_file(text_file);
+    delete_file(columnar_file);
+    delete_file(text_out);
+    delete_file(columnar_out);
+}
+
+TEST_F(DumpColumnarTest, no_gz)
+{
+    TEST_FAILURE(".*ERROR: Dump columnar cannot write gzipped files.*",
+                 command("dump id all columnar 1 dump.col.gz id x y z"););
+}
+
+int main(int argc, char **argv)
+{
+    MPI_Init(&argc, &argv);
+    ::testing::InitGoogleMock(&argc, argv);
+
+    // handle arguments passed via environment variable
+    if (const char *var = getenv("TEST_ARGS")) {
+        std::vector<std::string> env = utils::split_words(var);
+        for (auto arg : env) {
+            if (arg == "-v") {
+                verbose = true;
+            }
+        }
+    }
+
+    if ((argc > 1) && (strcmp(argv[1], "-v") == 0)) verbose = true;
+
+    int rv = RUN_ALL_TESTS();
+    MPI_Finalize();
+    return rv;
+}
@@ -0,0 +1,132 @@
+/* ----------------------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://lammps.sandia.gov/, Sandia National Laboratories
+   Steve Plimpton, sjplimp@sandia.gov
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+// compare sprintf() with the {fmt} library formats used for dump text output
+
+#include "lmptype.h"
+#include "fmt/format.h"
+#include "utils.h"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace LAMMPS_NS;
+using ::testing::StrEq;
+
+bool verbose = false;
+
+static const char *float_formats[] = {"%g ",   "%20.15g ", "%-12.5e ", "%+.3f ", "%10.3E",
+                                      "% .8g", "%G",       "%.0f",     "%e",     "%-+9.2f|"};
+static const char *int_formats[] = {"%d ", "%08d", "%-6d|", "%+d", "% 5i"};
+
+static std::vector<double> test_values()
+{
+    std::vector<double> values = {0.0,     -0.0,   1.0,     -1.0,      0.5,    1.0e-5,
+                                  -3.25e7, 1.0e15, 1.0e-15, 123456.78, M_PI,   -M_E,
+                                  9.9999995, 1.0e100, -2.5e-300, INFINITY, -INFINITY};
+    for (int i = 1; i < 200; ++i)
+        values.push_back(std::sin(0.37 * i) * std::pow(10.0, (i % 31) - 15));
+    return values;
+}
+
+TEST(DumpFormat, same_float)
+{
+    char ref[256];
+    for (auto pf : float_formats) {
+        std::string ff = utils::printf2fmt(pf, "eEfFgG");
+        ASSERT_FALSE(ff.empty()) << pf;
+        for (auto v : test_values()) {
+            sprintf(ref, pf, v);
+            ASSERT_THAT(fmt::format(ff, v), StrEq(ref)) << pf << " " << v;
+        }
+    }
+}
+
+TEST(DumpFormat, same_int)
+{
+    char ref[256];
+    const bigint values[] = {0, 1, -1, 42, -12345, 2147483647, -2147483647};
+    for (auto pf : int_formats) {
+        std::string ff = utils::printf2fmt(pf, "di");
+        ASSERT_FALSE(ff.empty()) << pf;
+        for (auto v : values) {
+            sprintf(ref, pf, (int)v);
+            ASSERT_THAT(fmt::format(ff, (int)v), StrEq(ref)) << pf << " " << v;
+        }
+    }
+
+    sprintf(ref, "%6s|%-6s|", "Ar", "Ne");
+    std::string ff = utils::printf2fmt("%6s|", "s") + utils::printf2fmt("%-6s|", "s");
+    ASSERT_THAT(fmt::format(ff, "Ar", "Ne"), StrEq(ref));
+}
+
+// micro-benchmark: format many values into one buffer like Dump::convert_string()
+// timings are printed with -v; only the identical output is checked
+
+TEST(DumpFormat, benchmark)
+{
+    const int nvalues = 200000;
+    std::vector<double> values(nvalues);
+    for (int i = 0; i < nvalues; ++i)
+        values[i] = std::sin(0.001 * i) * std::pow(10.0, (i % 7) - 3);
+
+    std::vector<char> buf1(48 * nvalues), buf2(48 * nvalues);
+    for (auto pf : {"%g ", "%20.15g ", "%-12.5e "}) {
+        std::string ff = utils::printf2fmt(pf, "eEfFgG");
+
+        auto t0 = std::chrono::steady_clock::now();
+        char *p = buf1.data();
+        for (auto v : values)
+            p += sprintf(p, pf, v);
+        auto t1 = std::chrono::steady_clock::now();
+        char *q = buf2.data();
+        for (auto v : values)
+            q = fmt::format_to(q, ff, v);
+        auto t2 = std::chrono::steady_clock::now();
+
+        ASSERT_EQ(p - buf1.data(), q - buf2.data());
+        ASSERT_EQ(memcmp(buf1.data(), buf2.data(), p - buf1.data()), 0);
+
+        if (verbose) {
+            double tsprintf = std::chrono::duration<double>(t1 - t0).count();
+            double tfmt     = std::chrono::duration<double>(t2 - t1).count();
+            fmt::print("format '{}': sprintf {:.4f}s  fmt {:.4f}s  speedup {:.2f}\n", pf,
+                       tsprintf, tfmt, tsprintf / tfmt);
+        }
+    }
+}
+
+int main(int argc, char **argv)
+{
+    ::testing::InitGoogleMock(&argc, argv);
+
+    // handle arguments passed via environment variable
+    if (const char *var = getenv("TEST_ARGS")) {
+        std::vector<std::string> env = utils::split_words(var);
+        for (auto arg : env) {
+            if (arg == "-v") {
+                verbose = true;
+            }
+        }
+    }
+
+    if ((argc > 1) && (strcmp(argv[1], "-v") == 0)) verbose = true;
+
+    return RUN_ALL_TESTS();
+}
@@ -257,6 +257,90 @@ TEST_F(ImageFlagsTest, read_data)
     ASSERT_EQ(imz,0);
 }
 
+TEST_F(ImageFlagsTest, read_data_parallel)
+{
+    if (!verbose) ::testing::internal::CaptureStdout();
+    lmp->input->one("clear");
+    lmp->input->one("units real");
+    lmp->input->one("dimension 3");
+    lmp->input->one("boundary p p p");
+    lmp->input->one("pair_style zero 2.0");
+    lmp->input->one("read_data test_image_flags.data parallel 1");
+    if (!verbose) ::testing::internal::GetCapturedStdout();
+
+    ASSERT_EQ(lmp->atom->natoms,2);
+
+    auto image = lmp->atom->image;
+    int imx = (image[0] & IMGMASK) - IMGMAX;
+    int imy = (image[0] >> IMGBITS & IMGMASK) - IMGMAX;
+    int imz = (image[0] >> IMG2BITS) - IMGMAX;
+
+    ASSERT_EQ(imx,-1);
+    ASSERT_EQ(imy,2);
+    ASSERT_EQ(imz,3);
+
+    imx = (image[1] & IMGMASK) - IMGMAX;
+    imy = (image[1] >> IMGBITS & IMGMASK) - IMGMAX;
+    imz = (image[1] >> IMG2BITS) - IMGMAX;
+
+    ASSERT_EQ(imx,-2);
+    ASSERT_EQ(imy,1);
+    ASSERT_EQ(imz,-1);
+}
+
+TEST_F(ImageFlagsTest, read_data_binary)
+{
+    if (!verbose) ::testing::internal::CaptureStdout();
+    lmp->input->one("write_data test_image_flags.bin binary");
+    lmp->input->one("clear");
+    lmp->input->one("units real");
+    lmp->input->one("dimension 3");
+    lmp->input->one("boundary p p p");
+    lmp->input->one("pair_style zero 2.0");
+    lmp->input->one("read_data test_image_flags.bin");
+    if (!verbose) ::testing::internal::GetCapturedStdout();
+
+    ASSERT_EQ(lmp->atom->natoms,2);
+    ASSERT_EQ(lmp->atom->x[1][2],1.9999);
+
+    auto image = lmp->atom->image;
+    int imx = (image[0] & IMGMASK) - IMGMAX;
+    int imy = (image[0] >> IMGBITS & IMGMASK) - IMGMAX;
+    int imz = (image[0] >> IMG2BITS) - IMGMAX;
+
+    ASSERT_EQ(imx,-1);
+    ASSERT_EQ(imy,2);
+    ASSERT_EQ(imz,3);
+
+    imx = (image[1] & IMGMASK) - IMGMAX;
+    imy = (image[1] >> IMGBITS & IMGMASK) - IMGMAX;
+    imz = (image[1] >> IMG2BITS) - IMGMAX;
+
+    ASSERT_EQ(imx,-2);
+    ASSERT_EQ(imy,1);
+    ASSERT_EQ(imz,-1);
+
+    if (!verbose) ::testing::internal::CaptureStdout();
+    lmp->input->one("clear");
+    lmp->input->one("units real");
+    lmp->input->one("dimension 3");
+    lmp->input->one("boundary p p p");
+    lmp->input->one("pair_style zero 2.0");
+    lmp->input->one("read_data test_image_flags.bin parallel 1");
+    if (!verbose) ::testing::internal::GetCapturedStdout();
+    remove("test_image_flags.bin");
+
+    ASSERT_EQ(lmp->atom->natoms,2);
+    image = lmp->atom->image;
+    imx = (image[1] & IMGMASK) - IMGMAX;
+    imy = (image[1] >> IMGBITS & IMGMASK) - IMGMAX;
+    imz = (image[1] >> IMG2BITS) - IMGMAX;
+
+    ASSERT_EQ(imx,-2);
+    ASSERT_EQ(imy,1);
+    ASSERT_EQ(imz,-1);
+}
+
 } // namespace LAMMPS_NS
 
 int main(int argc, char **argv)
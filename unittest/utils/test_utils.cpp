@@ -69,6 +69,24 @@ TEST(Utils, trim_comment)
     ASSERT_THAT(trimmed, StrEq("some text "));
 }
 
+TEST(Utils, printf2fmt)
+{
+    ASSERT_THAT(utils::printf2fmt("%g ", "eEfFgG"), StrEq("{:g} "));
+    ASSERT_THAT(utils::printf2fmt("%-12.5e", "eEfFgG"), StrEq("{:<12.5e}"));
+    ASSERT_THAT(utils::printf2fmt("%20.15g", "eEfFgG"), StrEq("{:>20.15g}"));
+    ASSERT_THAT(utils::printf2fmt("%+08d", "di"), StrEq("{:+08d}"));
+    ASSERT_THAT(utils::printf2fmt("%ld", "di"), StrEq("{:d}"));
+    ASSERT_THAT(utils::printf2fmt("%5s {x}", "s"), StrEq("{:>5s} {{x}}"));
+    ASSERT_THAT(utils::printf2fmt("100%% %i", "di"), StrEq("100% {:d}"));
+    ASSERT_THAT(utils::printf2fmt("%#g", "eEfFgG"), StrEq(""));
+    ASSERT_THAT(utils::printf2fmt("%012.6f", "eEfFgG"), StrEq(""));
+    ASSERT_THAT(utils::printf2fmt("%.3d", "di"), StrEq(""));
+    ASSERT_THAT(utils::printf2fmt("%*d", "di"), StrEq(""));
+    ASSERT_THAT(utils::printf2fmt("%d", "eEfFgG"), StrEq(""));
+    ASSERT_THAT(utils::printf2fmt("%g %g", "eEfFgG"), StrEq(""));
+    ASSERT_THAT(utils::printf2fmt("text", "eEfFgG"), StrEq(""));
+}
+
 TEST(Utils, has_utf8)
 {
     const char ascii_string[] = " -2";